@@ -0,0 +1,85 @@
+#ifndef LOBSTER_BATCH_ANALYZER_CPP
+#define LOBSTER_BATCH_ANALYZER_CPP
+#include <thread>
+#include "Utils/Utils.hpp"
+#include "Analytics/MonitorOutputsAnalyzer.hpp"
+#include "Analytics/LobsterBatchAnalyzer.hpp"
+
+namespace Analytics {
+std::string LobsterBatchResult::getAsJson() const {
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{\n"
+        "\"MessageFilePath\":\""   << Utils::Format::jsonEscaped(files.messageFilePath)   << "\",\n"
+        "\"OrderBookFilePath\":\"" << Utils::Format::jsonEscaped(files.orderBookFilePath) << "\",\n"
+        "\"NumRecords\":"          << numRecords                                        << ",\n";
+    if (isSuccess())
+        buffer << "\"Error\":null,\n\"StatsReport\":" << statsReport << "\n}";
+    else
+        buffer << "\"Error\":\"" << Utils::Format::jsonEscaped(error) << "\",\n\"StatsReport\":null\n}";
+    return buffer.str();
+}
+
+size_t LobsterBatchAnalyzer::getNumSucceeded() const {
+    return std::count_if(myResults.begin(), myResults.end(), [](const LobsterBatchResult& result) { return result.isSuccess(); });
+}
+
+uint64_t LobsterBatchAnalyzer::getNumRecords() const {
+    uint64_t numRecords = 0;
+    for (const auto& result : myResults)
+        numRecords += result.numRecords;
+    return numRecords;
+}
+
+const std::vector<LobsterBatchResult>& LobsterBatchAnalyzer::run(const std::vector<LobsterFilePair>& files) {
+    if (myConfig.chunkSize == 0)
+        Utils::Error::LIB_THROW("[LobsterBatchAnalyzer::run] Chunk size is zero.");
+    myResults.assign(files.size(), LobsterBatchResult());
+    myNextFileIndex = 0;
+    myNumWorkers = std::min(myConfig.numWorkers ? myConfig.numWorkers : Utils::Concurrency::num_cpus(), std::max(files.size(), size_t(1)));
+    std::vector<std::thread> workers;
+    workers.reserve(myNumWorkers - 1);
+    for (size_t workerIndex = 1; workerIndex < myNumWorkers; ++workerIndex)
+        workers.emplace_back(&LobsterBatchAnalyzer::runWorker, this, workerIndex, std::cref(files));
+    runWorker(0, files);
+    for (auto& worker : workers)
+        worker.join();
+    return myResults;
+}
+
+std::string LobsterBatchAnalyzer::getStatsReport() const {
+    std::ostringstream oss;
+    oss << "[";
+    for (size_t i = 0; i < myResults.size(); ++i)
+        oss << (i ? ",\n" : "\n") << myResults[i].getAsJson();
+    oss << "\n]";
+    return oss.str();
+}
+
+void LobsterBatchAnalyzer::runWorker(const size_t workerIndex, const std::vector<LobsterFilePair>& files) {
+    if (myConfig.isPinWorkers)
+        Utils::Concurrency::pin_current_thread(static_cast<int>(workerIndex % Utils::Concurrency::num_cpus()));
+    for (size_t i; (i = myNextFileIndex.fetch_add(1, std::memory_order_relaxed)) < files.size(); )
+        myResults[i] = analyze(files[i]);
+}
+
+LobsterBatchResult LobsterBatchAnalyzer::analyze(const LobsterFilePair& files) const {
+    LobsterBatchResult result;
+    result.files = files;
+    try {
+        FileMonitorOutputsAnalyzer analyzer(files.messageFilePath, FileMonitorOutputsAnalyzer::MonitorOutputsFileFormat::LOBSTER, files.orderBookFilePath);
+        result.files.orderBookFilePath = analyzer.getOrderBookFilePath();
+        analyzer.setConfig(myConfig.analyzerConfig);
+        analyzer.setStatsConfig(myConfig.statsConfig);
+        analyzer.runStreamingAnalytics(myConfig.chunkSize);
+        result.numRecords = analyzer.getNumRecords();
+        result.statsReport = analyzer.getStatsReport();
+    } catch (const std::exception& ex) {
+        result.error = ex.what();
+    } catch (...) {
+        result.error = "Unknown error.";
+    }
+    return result;
+}
+}
+
+#endif
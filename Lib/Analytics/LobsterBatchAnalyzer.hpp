@@ -0,0 +1,63 @@
+#ifndef LOBSTER_BATCH_ANALYZER_HPP
+#define LOBSTER_BATCH_ANALYZER_HPP
+#include "Utils/Utils.hpp"
+#include "Analytics/OrderBookDerivedAnalyticsUtils.hpp"
+#include "Analytics/MonitorOutputsAnalyzer.hpp"
+
+namespace Analytics {
+struct LobsterFilePair {
+    std::string messageFilePath;
+    std::string orderBookFilePath; // named after the message file if empty, see FileMonitorOutputsAnalyzer
+};
+
+struct LobsterBatchAnalyzerConfig {
+    size_t numWorkers = 0; // 0 for one per cpu, never more than the files
+    size_t chunkSize = FileMonitorOutputsAnalyzer::DEFAULT_CHUNK_SIZE; // records of a day held in memory at a time by a worker
+    bool isPinWorkers = false; // worker i on cpu i modulo the number of cpus
+    MonitorOutputsAnalyzerConfig analyzerConfig = MonitorOutputsAnalyzerConfig();
+    OrderBookDerivedStatsConfig statsConfig = OrderBookDerivedStatsConfig();
+};
+
+struct LobsterBatchResult {
+    LobsterFilePair files;
+    uint64_t numRecords = 0;
+    std::string statsReport; // as MonitorOutputsAnalyzerBase::getStatsReport, empty on error
+    std::string error;
+    bool isSuccess() const { return error.empty(); }
+    std::string getAsJson() const;
+};
+
+/* Runs the analytics of many LOBSTER ticker-days on a pool of worker threads. Each worker takes the next file pair off a shared index
+    and streams it through a FileMonitorOutputsAnalyzer of its own chunk by chunk, so that no more than numWorkers days are open at
+    a time, each with a chunk of traces in memory. The days share nothing but the index, hence the run scales with the workers up to
+    the cores or the disk. The calling thread is one of the workers. The results are kept in the order of the files whichever order
+    they finish in, and a day that fails to read or analyse records its error without stopping the others. */
+class LobsterBatchAnalyzer {
+public:
+    LobsterBatchAnalyzer(const LobsterBatchAnalyzerConfig& config = LobsterBatchAnalyzerConfig()) : myConfig(config) {}
+    LobsterBatchAnalyzer(const LobsterBatchAnalyzer&) = delete;
+    virtual ~LobsterBatchAnalyzer() = default;
+
+    LobsterBatchAnalyzerConfig& getConfig() { return myConfig; }
+    const LobsterBatchAnalyzerConfig& getConfig() const { return myConfig; }
+    size_t getNumWorkers() const { return myNumWorkers; } // of the last run
+    const std::vector<LobsterBatchResult>& getResults() const { return myResults; }
+    size_t getNumSucceeded() const;
+    size_t getNumFailed() const { return myResults.size() - getNumSucceeded(); }
+    uint64_t getNumRecords() const;
+
+    const std::vector<LobsterBatchResult>& run(const std::vector<LobsterFilePair>& files); // blocks until every day is analysed
+    std::string getStatsReport() const; // the results of the days as a json array in the order of the files
+
+private:
+    void runWorker(const size_t workerIndex, const std::vector<LobsterFilePair>& files);
+    LobsterBatchResult analyze(const LobsterFilePair& files) const;
+
+    LobsterBatchAnalyzerConfig myConfig;
+    size_t myNumWorkers = 0;
+    std::atomic<size_t> myNextFileIndex = 0;
+    std::vector<LobsterBatchResult> myResults; // each written by the worker of its file only
+};
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include "Analytics/OrderBookObservables.hpp"
 #include "Analytics/MatchingEngineMonitor.hpp"
 #include "Parser/LobsterDataParser.hpp"
+#include "Parser/LobsterDataWriter.hpp"
 
 namespace Analytics {
 MatchingEngineMonitor::MatchingEngineMonitor(const std::shared_ptr<Exchange::IMatchingEngine>& matchingEngine) :
@@ -13,10 +14,20 @@ MatchingEngineMonitor::MatchingEngineMonitor(const std::shared_ptr<Exchange::IMa
         Utils::Error::LIB_THROW("[MatchingEngineMonitor] Matching engine is null.");
     init();
     myMatchingEngine = matchingEngine;
-    // add the callback to the matching engine once, and manage its lifetime internally via start/stopMonitoring()
-    matchingEngine->addOrderProcessingCallback(myOrderProcessingCallback);
-    matchingEngine->addOrderBookDeltaCallback(myOrderBookDeltaCallback);
-    matchingEngine->addOrderEventLatencyCallback(myOrderEventLatencyCallback);
+    // the report subscription is managed internally via start/stopMonitoring()
+    startMonitoring();
+    myOrderEventLatencySubscriptionId = matchingEngine->subscribeOrderEventLatencies(
+        [this](const std::shared_ptr<const Exchange::OrderEventLatency>& latency) {
+            if (latency)
+                myOrderEventProcessingLatenciesCollector.addSample(std::make_shared<OrderEventProcessingLatency>(latency));
+        });
+    // TODO: subscribe to the engine-emitted deltas once OrderBookStatisticsByTimestamp can take in the delta and the last state to compute the next state
+}
+
+MatchingEngineMonitor::~MatchingEngineMonitor() {
+    stopMonitoring();
+    if (myOrderEventLatencySubscriptionId)
+        myMatchingEngine->unsubscribe(*myOrderEventLatencySubscriptionId);
 }
 
 const OrderBookTopLevelsSnapshot& MatchingEngineMonitor::getLastOrderBookTopLevelsSnapshot() const {
@@ -41,20 +52,6 @@ void MatchingEngineMonitor::init() {
     myOrderBookStatisticsCollector.setMaxHistory(myTimeSeriesCollectorMaxSize);
     myOrderEventProcessingLatenciesCollector.setMaxHistory(myTimeSeriesCollectorMaxSize);
     myOrderProcessingReportsCollector.setMaxHistory(myTimeSeriesCollectorMaxSize);
-    myOrderProcessingCallback = mySharedOrderProcessingCallback = std::make_shared<Exchange::OrderProcessingCallback>(
-        [this](const std::shared_ptr<const Exchange::OrderProcessingReport>& report) {
-            if (report)
-                report->dispatchTo(*this);
-        });
-    myOrderBookDeltaCallback = mySharedOrderBookDeltaCallback = std::make_shared<Exchange::OrderBookDeltaCallback>(
-        [/* this */](const std::shared_ptr<const Exchange::OrderBookSizeDelta>& /* delta */) {
-            // TODO: let OrderBookStatisticsByTimestamp take in the engine-emitted delta and the last state to compute the next state
-        });
-    myOrderEventLatencyCallback = std::make_shared<Exchange::OrderEventLatencyCallback>(
-        [this](const std::shared_ptr<const Exchange::OrderEventLatency>& latency) {
-            if (latency)
-                myOrderEventProcessingLatenciesCollector.addSample(std::make_shared<OrderEventProcessingLatency>(latency));
-        });
 }
 
 void MatchingEngineMonitor::reset(const bool keepLastSnapshot) {
@@ -75,14 +72,19 @@ void MatchingEngineMonitor::reset(const bool keepLastSnapshot) {
 }
 
 void MatchingEngineMonitor::startMonitoring() {
-    myOrderProcessingCallback = mySharedOrderProcessingCallback;
-    myOrderBookDeltaCallback = mySharedOrderBookDeltaCallback;
+    // cross trades carry nothing for the monitor
+    if (!myOrderProcessingSubscriptionId)
+        myOrderProcessingSubscriptionId = myMatchingEngine->subscribeOrderProcessingReports(
+            [this](const std::shared_ptr<const Exchange::OrderProcessingReport>& report) { report->dispatchTo(*this); },
+            Exchange::OrderProcessingReportFilter::allExcept({Exchange::OrderProcessingType::CROSS, Exchange::OrderProcessingType::NONE}));
     myMonitoringEnabled = true;
 }
 
 void MatchingEngineMonitor::stopMonitoring() {
-    myOrderProcessingCallback = nullptr;
-    myOrderBookDeltaCallback = nullptr;
+    if (myOrderProcessingSubscriptionId) {
+        myMatchingEngine->unsubscribe(*myOrderProcessingSubscriptionId);
+        myOrderProcessingSubscriptionId.reset();
+    }
     myMonitoringEnabled = false;
 }
 
@@ -92,6 +94,8 @@ void MatchingEngineMonitor::updateStatistics(const Exchange::OrderProcessingRepo
     myOrderBookStatisticsCollector.addSample(orderBookStats);
     myOrderProcessingReportsCollector.addSample(report.clone());
     myOrderBookAggregateStatisticsCache = myOrderBookAggregateStatistics;
+    if (myLobsterDataWriter)
+        makeLobsterRecords(report, *orderBookStats, [this](const auto& message, const auto& snapshot) { myLobsterDataWriter->write(message, snapshot); });
     if (myDebugMode) {
         *myLogger << Utils::Logger::LogLevel::DEBUG << "[MatchingEngineMonitor] Added new order book statistics snapshot:\n" << orderBookStats->getAsTable();
         *myLogger << Utils::Logger::LogLevel::DEBUG << "[MatchingEngineMonitor] Updated order book aggregate statistics:\n" << myOrderBookAggregateStatistics.getAsTable();
@@ -99,8 +103,16 @@ void MatchingEngineMonitor::updateStatistics(const Exchange::OrderProcessingRepo
 }
 
 void MatchingEngineMonitor::exportToLobsterDataParser(Parser::LobsterDataParser& parser) const {
+    forEachLobsterRecord([&parser](const auto& message, const auto& snapshot) { parser.addOrderBookMessageAndSnapshot(message, snapshot); });
+}
+
+void MatchingEngineMonitor::exportToLobsterDataWriter(Parser::LobsterDataWriter& writer) const {
+    forEachLobsterRecord([&writer](const auto& message, const auto& snapshot) { writer.write(message, snapshot); });
+}
+
+void MatchingEngineMonitor::forEachLobsterRecord(const LobsterRecordCallback& callback) const {
     if (myOrderProcessingReportsCollector.size() != myOrderBookStatisticsCollector.size())
-        Utils::Error::LIB_THROW("[MatchingEngineMonitor::exportToLobsterDataParser] Mismatched number of order processing reports (" +
+        Utils::Error::LIB_THROW("[MatchingEngineMonitor::forEachLobsterRecord] Mismatched number of order processing reports (" +
             std::to_string(myOrderProcessingReportsCollector.size()) + ") and order book statistics (" +
             std::to_string(myOrderBookStatisticsCollector.size()) + ").");
     const auto& reports = myOrderProcessingReportsCollector.getSamples();
@@ -110,33 +122,44 @@ void MatchingEngineMonitor::exportToLobsterDataParser(Parser::LobsterDataParser&
     for (; reportsIt != reports.end() && statsIt != stats.end(); ++reportsIt, ++statsIt) {
         if (!*reportsIt || !*statsIt)
             continue; // report and stat must be present at the same time
-        const auto& topLevelsSnapshot = (*statsIt)->topLevelsSnapshot;
-        const auto message = (*reportsIt)->makeLobsterMessage();
-        std::vector<uint32_t> bidPricesInt((*statsIt)->topLevelsSnapshot.bidBookTopPrices.size());
-        std::vector<uint32_t> askPricesInt((*statsIt)->topLevelsSnapshot.askBookTopPrices.size());
-        std::transform(
-            (*statsIt)->topLevelsSnapshot.bidBookTopPrices.begin(),
-            (*statsIt)->topLevelsSnapshot.bidBookTopPrices.end(),
-            bidPricesInt.begin(), [](double p){ return Utils::Maths::castDoublePriceAsInt<uint32_t>(p); });
-        std::transform(
-            (*statsIt)->topLevelsSnapshot.askBookTopPrices.begin(),
-            (*statsIt)->topLevelsSnapshot.askBookTopPrices.end(),
-            askPricesInt.begin(), [](double p){ return Utils::Maths::castDoublePriceAsInt<uint32_t>(p); });
-        auto snapshot = std::make_shared<const Parser::LobsterDataParser::OrderBookSnapshot>(
-            bidPricesInt, askPricesInt, topLevelsSnapshot.bidBookTopSizes, topLevelsSnapshot.askBookTopSizes);
-        if (message->isValid()) {
-            parser.addOrderBookMessageAndSnapshot(message, snapshot);
-        } else if (message->toSplitIntoDeleteAndAdd()) {
-            // split order modify and cancel/replace report into atomic delete and add messages
-            const auto atomMessages = (*reportsIt)->decomposeIntoAtomicReports();
-            if (atomMessages.size() == 2 &&
-                atomMessages[0]->orderProcessingType == Exchange::OrderProcessingType::CANCEL &&
-                atomMessages[1]->orderProcessingType == Exchange::OrderProcessingType::SUBMIT) {
-                const auto messageDel = atomMessages[0]->makeLobsterMessage();
-                const auto messageAdd = atomMessages[1]->makeLobsterMessage();
-                parser.addOrderBookMessageAndSnapshot(messageDel, nullptr);
-                parser.addOrderBookMessageAndSnapshot(messageAdd, snapshot);
-            }
+        makeLobsterRecords(**reportsIt, **statsIt, callback);
+    }
+}
+
+void MatchingEngineMonitor::makeLobsterRecords(const Exchange::OrderProcessingReport& report, const OrderBookStatisticsByTimestamp& stats,
+    const LobsterRecordCallback& callback) {
+    const auto& topLevelsSnapshot = stats.topLevelsSnapshot;
+    const auto message = report.makeLobsterMessage();
+    std::vector<uint32_t> bidPricesInt(topLevelsSnapshot.bidBookTopPrices.size());
+    std::vector<uint32_t> askPricesInt(topLevelsSnapshot.askBookTopPrices.size());
+    std::transform(
+        topLevelsSnapshot.bidBookTopPrices.begin(),
+        topLevelsSnapshot.bidBookTopPrices.end(),
+        bidPricesInt.begin(), [](double p){ return Utils::Maths::castDoublePriceAsInt<uint32_t>(p); });
+    std::transform(
+        topLevelsSnapshot.askBookTopPrices.begin(),
+        topLevelsSnapshot.askBookTopPrices.end(),
+        askPricesInt.begin(), [](double p){ return Utils::Maths::castDoublePriceAsInt<uint32_t>(p); });
+    auto snapshot = std::make_shared<const Parser::LobsterDataParser::OrderBookSnapshot>(
+        bidPricesInt, askPricesInt, topLevelsSnapshot.bidBookTopSizes, topLevelsSnapshot.askBookTopSizes);
+    if (message->isValid()) {
+        callback(message, snapshot);
+    } else if (message->toSplitIntoDeleteAndAdd()) {
+        // split order modify and cancel/replace report into atomic delete and add messages
+        const auto atomMessages = report.decomposeIntoAtomicReports();
+        if (atomMessages.size() == 2 &&
+            atomMessages[0]->orderProcessingType == Exchange::OrderProcessingType::CANCEL &&
+            atomMessages[1]->orderProcessingType == Exchange::OrderProcessingType::SUBMIT) {
+            const auto messageDel = atomMessages[0]->makeLobsterMessage();
+            // a submit report makes no message of its own, the add is that of the order it carries
+            const auto submitReport = std::dynamic_pointer_cast<const Exchange::LimitOrderSubmitReport>(atomMessages[1]);
+            if (!submitReport || !submitReport->order)
+                return;
+            const auto& order = submitReport->order;
+            const auto messageAdd = std::make_shared<const Parser::LobsterDataParser::OrderBookMessage>(submitReport->timestamp,
+                Parser::LobsterDataParser::MessageType::ORDER_ADD, order->getId(), order->getQuantity(), order->getIntPrice(), order->isBuy());
+            callback(messageDel, nullptr);
+            callback(messageAdd, snapshot);
         }
     }
 }
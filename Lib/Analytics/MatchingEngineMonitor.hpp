@@ -4,6 +4,7 @@
 #include "Exchange/MatchingEngineUtils.hpp"
 #include "Exchange/MatchingEngine.hpp"
 #include "Parser/LobsterDataParser.hpp"
+#include "Parser/LobsterDataWriter.hpp"
 #include "Analytics/OrderBookObservables.hpp"
 
 namespace Analytics {
@@ -20,7 +21,8 @@ public:
 
     MatchingEngineMonitor() = delete; // only permits construction from matching engine
     MatchingEngineMonitor(const std::shared_ptr<Exchange::IMatchingEngine>& matchingEngine);
-    virtual ~MatchingEngineMonitor() = default;
+    MatchingEngineMonitor(const MatchingEngineMonitor&) = delete; // the engine subscriptions are bound to this instance
+    virtual ~MatchingEngineMonitor();
 
     std::shared_ptr<Exchange::IMatchingEngine> getMatchingEngine() const { return myMatchingEngine; }
     std::shared_ptr<Utils::Logger::LoggerBase> getLogger() const { return myLogger; }
@@ -37,6 +39,7 @@ public:
     const Utils::Statistics::TimeSeriesCollector<Exchange::OrderProcessingReport>& getOrderProcessingReports() const { return myOrderProcessingReportsCollector; }
     const OrderBookTopLevelsSnapshot& getLastOrderBookTopLevelsSnapshot() const;
     bool isPriceWithinTopOfBook(const Market::Side side, const double price, const std::optional<Market::OrderType>& type = std::nullopt) const;
+    std::shared_ptr<Parser::LobsterDataWriter> getLobsterDataWriter() const { return myLobsterDataWriter; }
 
     void setMatchingEngine(const std::shared_ptr<Exchange::IMatchingEngine>& matchingEngine) { myMatchingEngine = matchingEngine; }
     void setLogger(const std::shared_ptr<Utils::Logger::LoggerBase>& logger) { myLogger = logger; }
@@ -52,6 +55,8 @@ public:
     }
     void setMinimumPriceTick(const double minPriceTick) { myMinimumPriceTick = minPriceTick; }
     void setOrderBookStatisticsTimestampStrategy(const OrderBookStatisticsTimestampStrategy strategy) { myOrderBookStatisticsTimestampStrategy = strategy; }
+    // streams each statistics update to the writer as it is logged, with the collectors bounded by setTimeSeriesCollectorMaxSize
+    void setLobsterDataWriter(const std::shared_ptr<Parser::LobsterDataWriter>& writer) { myLobsterDataWriter = writer; }
 
     virtual void init();
     virtual void reset(const bool keepLastSnapshot = false);
@@ -60,6 +65,7 @@ public:
     virtual void updateStatistics(const Exchange::OrderProcessingReport& report);
 
     virtual void exportToLobsterDataParser(Parser::LobsterDataParser& parser) const;
+    virtual void exportToLobsterDataWriter(Parser::LobsterDataWriter& writer) const; // record by record, with no copy into a parser
 
     // communicates with matching engine to keep order book stats in sync
     virtual void onOrderProcessingReport(const Exchange::OrderExecutionReport& report);
@@ -73,9 +79,18 @@ public:
     virtual void onOrderProcessingReport(const Exchange::OrderModifyQuantityReport& report);
 
 private:
+    using LobsterRecordCallback = std::function<void(const std::shared_ptr<const Parser::LobsterDataParser::OrderBookMessage>&,
+        const std::shared_ptr<const Parser::LobsterDataParser::OrderBookSnapshot>&)>;
+
+    void forEachLobsterRecord(const LobsterRecordCallback& callback) const;
+    // a record per report, two for a modify split into a delete and an add
+    static void makeLobsterRecords(const Exchange::OrderProcessingReport& report, const OrderBookStatisticsByTimestamp& stats,
+        const LobsterRecordCallback& callback);
+
     std::shared_ptr<Exchange::IMatchingEngine> myMatchingEngine;
     std::shared_ptr<Utils::Logger::LoggerBase> myLogger = std::make_shared<Utils::Logger::LoggerBase>();
     std::shared_ptr<const Utils::Counter::TimestampHandlerBase> myClockOverride; // optional clock override for timestamping statistics entries
+    std::shared_ptr<Parser::LobsterDataWriter> myLobsterDataWriter; // optional sink of the statistics updates in LOBSTER format
     std::shared_ptr<const Market::TradeBase> myLastTrade; // caches the last trade to uniquely count executions sent from both sides of the trade
     bool myDebugMode = false;
     bool myMonitoringEnabled = false;
@@ -88,12 +103,9 @@ private:
     Utils::Statistics::TimeSeriesCollector<OrderBookStatisticsByTimestamp> myOrderBookStatisticsCollector;
     Utils::Statistics::TimeSeriesCollector<OrderEventProcessingLatency> myOrderEventProcessingLatenciesCollector;
     Utils::Statistics::TimeSeriesCollector<Exchange::OrderProcessingReport> myOrderProcessingReportsCollector;
-    Exchange::CallbackSharedPtr<Exchange::OrderProcessingReport> myOrderProcessingCallback;
-    Exchange::CallbackSharedPtr<Exchange::OrderBookSizeDelta> myOrderBookDeltaCallback;
-    Exchange::CallbackSharedPtr<Exchange::OrderEventLatency> myOrderEventLatencyCallback;
-    // shared callbacks constructed once in init()
-    Exchange::CallbackSharedPtr<Exchange::OrderProcessingReport> mySharedOrderProcessingCallback;
-    Exchange::CallbackSharedPtr<Exchange::OrderBookSizeDelta> mySharedOrderBookDeltaCallback;
+    // the report subscription is only held while monitoring, the latency one for the lifetime of the monitor
+    std::optional<Exchange::SubscriptionId> myOrderProcessingSubscriptionId;
+    std::optional<Exchange::SubscriptionId> myOrderEventLatencySubscriptionId;
     OrderBookStatisticsTimestampStrategy myOrderBookStatisticsTimestampStrategy = OrderBookStatisticsTimestampStrategy::TOP_OF_BOOK_TICK;
 };
 }
@@ -1,5 +1,6 @@
 #ifndef MONITOR_OUTPUTS_ANALYZER_CPP
 #define MONITOR_OUTPUTS_ANALYZER_CPP
+#include <filesystem>
 #include "Utils/Utils.hpp"
 #include "Market/OrderUtils.hpp"
 #include "Analytics/MonitorOutputsAnalyzer.hpp"
@@ -48,10 +49,12 @@ void MonitorOutputsAnalyzerBase::clear() {
 
 void MonitorOutputsAnalyzerBase::runAnalytics() {
     // run analytic computations on order book traces
-    const auto& traces = getOrderBookTraces();
+    accumulateOrderBookTraces(getOrderBookTraces());
+    computeStats();
+}
+
+void MonitorOutputsAnalyzerBase::accumulateOrderBookTraces(const OrderBookTraces& traces) {
     const auto& accumulationMode = getConfig().statsAccumulationMode;
-    double bestBidPriceCache = Utils::Consts::NAN_DOUBLE;
-    double bestAskPriceCache = Utils::Consts::NAN_DOUBLE;
     const auto& reports = traces.orderProcessingReportsCollector.getSamples();
     const auto& stats = traces.orderBookStatisticsCollector.getSamples();
     auto reportsIt = reports.begin();
@@ -78,9 +81,9 @@ void MonitorOutputsAnalyzerBase::runAnalytics() {
                     stat->cumNumModifyPriceOrders + stat->cumNumModifyQuantityOrders) > 0; // only when at least an event has occurred
                 break;
             case MonitorOutputsAnalyzerConfig::OrderBookStatsAccumulationMode::LEVEL_ONE_TICK:
-                accumulate = (stat->bestBidPrice != bestBidPriceCache) || (stat->bestAskPrice != bestAskPriceCache);
-                bestBidPriceCache = stat->bestBidPrice;
-                bestAskPriceCache = stat->bestAskPrice;
+                accumulate = (stat->bestBidPrice != myBestBidPriceCache) || (stat->bestAskPrice != myBestAskPriceCache);
+                myBestBidPriceCache = stat->bestBidPrice;
+                myBestAskPriceCache = stat->bestAskPrice;
                 break;
             default:
                 break;
@@ -88,13 +91,17 @@ void MonitorOutputsAnalyzerBase::runAnalytics() {
         if (!accumulate)
             continue;
         myOrderDepthProfileStats.accumulate(stat->topLevelsSnapshot);
-        myOrderFlowMemoryStats.accumulate(*stat->lastTradeIsBuyInitiated ? 1 : -1);
+        if (stat->lastTradeIsBuyInitiated) // unset until the first trade
+            myOrderFlowMemoryStats.accumulate(*stat->lastTradeIsBuyInitiated ? 1 : -1);
         myPriceReturnScalingStats.accumulate(*stat);
         mySpreadStats.accumulate(stat->spread);
         myEventTimeStats.accumulate(*stat);
         myOrderImbalanceStats.accumulate(*stat);
         myPriceImpactStats.accumulate(*stat);
     }
+}
+
+void MonitorOutputsAnalyzerBase::computeStats() {
     myOrderDepthProfileStats.compute();
     myOrderFlowMemoryStats.compute();
     myPriceReturnScalingStats.compute();
@@ -103,6 +110,8 @@ void MonitorOutputsAnalyzerBase::runAnalytics() {
     myOrderLifetimeStats.compute();
     myOrderImbalanceStats.compute();
     myPriceImpactStats.compute();
+    myBestBidPriceCache = Utils::Consts::NAN_DOUBLE;
+    myBestAskPriceCache = Utils::Consts::NAN_DOUBLE;
 }
 
 std::string MonitorOutputsAnalyzerBase::getStatsReport() {
@@ -166,6 +175,126 @@ void MonitorOutputsAnalyzerBase::onOrderProcessingReport(const Exchange::OrderMo
 }
 
 
+bool LobsterOrderBookTracesBuilder::append(OrderBookTraces& traces, const OrderBookMessage& message, std::span<const uint32_t> snapshotRow) {
+    using MessageType = Parser::LobsterDataParser::MessageType;
+    if (message.messageType == MessageType::TRADING_HALT || message.messageType == MessageType::NONE)
+        return false;
+    auto stats = std::make_shared<OrderBookStatisticsByTimestamp>();
+    stats->timestampFrom = myTimestamp; // from-time exclusive
+    stats->timestampTo = message.timestamp; // to-time inclusive
+    myTimestamp = message.timestamp;
+    const double price = Utils::Maths::castIntPriceAsDouble(message.price);
+    switch (message.messageType) {
+        case MessageType::ORDER_ADD:
+            stats->cumNumNewLimitOrders = 1;
+            break;
+        case MessageType::ORDER_CANCEL:
+            stats->cumNumModifyQuantityOrders = 1; // partial cancel represented as a modify quantity order, as in the monitor
+            break;
+        case MessageType::ORDER_DELETE:
+            stats->cumNumCancelOrders = 1;
+            break;
+        case MessageType::ORDER_EXECUTE_VISIBLE:
+        case MessageType::ORDER_EXECUTE_HIDDEN:
+            stats->cumNumTrades = 1;
+            stats->cumTradeVolume = message.quantity;
+            stats->cumTradeNotional = price * message.quantity;
+            // the resting order is filled by the opposite side, whose order LOBSTER does not name
+            myLastTrade = std::make_shared<const Market::TradeBase>(++myNumTrades, message.timestamp, message.isBuy ? message.orderId : 0,
+                message.isBuy ? 0 : message.orderId, message.quantity, price, message.isBuy, !message.isBuy, !message.isBuy);
+            break;
+        default:
+            break;
+    }
+    // top levels of the row, skipping the empty levels of either side
+    const size_t numRowLevels = snapshotRow.size() / Parser::LobsterDataReader::FIELDS_PER_LEVEL;
+    const size_t numLevels = myNumLevels ? std::min(myNumLevels, numRowLevels) : numRowLevels;
+    auto& topLevels = stats->topLevelsSnapshot;
+    topLevels.numLevels = numLevels;
+    for (size_t level = 0; level < numLevels; ++level) {
+        const auto fields = snapshotRow.subspan(level * Parser::LobsterDataReader::FIELDS_PER_LEVEL, Parser::LobsterDataReader::FIELDS_PER_LEVEL);
+        if (fields[0] > 0 && fields[1] > 0) {
+            topLevels.askBookTopPrices.push_back(Utils::Maths::castIntPriceAsDouble(fields[0]));
+            topLevels.askBookTopSizes.push_back(fields[1]);
+        }
+        if (fields[2] > 0 && fields[3] > 0) {
+            topLevels.bidBookTopPrices.push_back(Utils::Maths::castIntPriceAsDouble(fields[2]));
+            topLevels.bidBookTopSizes.push_back(fields[3]);
+        }
+    }
+    // the top of book as the matching engine computes it
+    stats->bestBidPrice = topLevels.bidBookTopPrices.empty() ? Utils::Consts::NAN_DOUBLE : topLevels.bidBookTopPrices.front();
+    stats->bestAskPrice = topLevels.askBookTopPrices.empty() ? Utils::Consts::NAN_DOUBLE : topLevels.askBookTopPrices.front();
+    stats->bestBidSize = topLevels.bidBookTopSizes.empty() ? 0 : topLevels.bidBookTopSizes.front();
+    stats->bestAskSize = topLevels.askBookTopSizes.empty() ? 0 : topLevels.askBookTopSizes.front();
+    const double bestBidSize = static_cast<double>(stats->bestBidSize);
+    const double bestAskSize = static_cast<double>(stats->bestAskSize);
+    stats->midPrice = (stats->bestBidPrice + stats->bestAskPrice) / 2.0;
+    stats->microPrice = (stats->bestBidPrice * bestAskSize + stats->bestAskPrice * bestBidSize) / (bestBidSize + bestAskSize);
+    stats->spread = stats->bestAskPrice - stats->bestBidPrice;
+    stats->halfSpread = stats->spread / 2.0;
+    stats->orderImbalance = (bestBidSize - bestAskSize) / (bestBidSize + bestAskSize);
+    stats->lastTradePrice = myLastTrade ? myLastTrade->getPrice() : Utils::Consts::NAN_DOUBLE;
+    stats->lastTradeQuantity = myLastTrade ? myLastTrade->getQuantity() : 0;
+    stats->lastTradeIsBuyInitiated = myLastTrade ? std::optional<bool>(myLastTrade->getIsBuyInitiated()) : std::nullopt;
+    topLevels.lastTrade = myLastTrade;
+    traces.orderBookStatisticsCollector.addSample(stats);
+    traces.orderProcessingReportsCollector.addSample(makeReport(message)); // after the trade of an execution is made
+    ++myNumRecords;
+    return true;
+}
+
+bool LobsterOrderBookTracesBuilder::append(OrderBookTraces& traces, const OrderBookMessage& message, const OrderBookSnapshot& snapshot) {
+    // flattens the snapshot into a row of the reader layout - ask price, ask size, bid price, bid size of each level
+    const size_t numLevels = std::max(snapshot.askPrice.size(), snapshot.bidPrice.size());
+    mySnapshotRow.assign(numLevels * Parser::LobsterDataReader::FIELDS_PER_LEVEL, 0);
+    for (size_t level = 0; level < snapshot.askPrice.size(); ++level) {
+        mySnapshotRow[level * Parser::LobsterDataReader::FIELDS_PER_LEVEL] = snapshot.askPrice[level];
+        mySnapshotRow[level * Parser::LobsterDataReader::FIELDS_PER_LEVEL + 1] = snapshot.askSize[level];
+    }
+    for (size_t level = 0; level < snapshot.bidPrice.size(); ++level) {
+        mySnapshotRow[level * Parser::LobsterDataReader::FIELDS_PER_LEVEL + 2] = snapshot.bidPrice[level];
+        mySnapshotRow[level * Parser::LobsterDataReader::FIELDS_PER_LEVEL + 3] = snapshot.bidSize[level];
+    }
+    return append(traces, message, mySnapshotRow);
+}
+
+void LobsterOrderBookTracesBuilder::clear() {
+    myNumRecords = 0;
+    myNumTrades = 0;
+    myTimestamp = 0;
+    myLastTrade = nullptr;
+}
+
+std::shared_ptr<const Exchange::OrderProcessingReport> LobsterOrderBookTracesBuilder::makeReport(const OrderBookMessage& message) const {
+    using MessageType = Parser::LobsterDataParser::MessageType;
+    const uint64_t reportId = myNumRecords + 1;
+    const Market::Side side = message.isBuy ? Market::Side::BUY : Market::Side::SELL;
+    const double price = Utils::Maths::castIntPriceAsDouble(message.price);
+    const auto status = Exchange::OrderProcessingStatus::SUCCESS;
+    switch (message.messageType) {
+        case MessageType::ORDER_ADD:
+            return std::make_shared<const Exchange::LimitOrderPlacementReport>(reportId, message.timestamp, message.orderId, side, message.quantity, price, status);
+        case MessageType::ORDER_CANCEL:
+            return std::make_shared<const Exchange::OrderPartialCancelReport>(reportId, message.timestamp, message.orderId, side, Market::OrderType::LIMIT,
+                std::nullopt, price, message.quantity, status);
+        case MessageType::ORDER_DELETE:
+            return std::make_shared<const Exchange::OrderCancelReport>(reportId, message.timestamp, message.orderId, side, Market::OrderType::LIMIT,
+                message.quantity, price, status);
+        case MessageType::ORDER_EXECUTE_VISIBLE:
+        case MessageType::ORDER_EXECUTE_HIDDEN:
+            // LOBSTER names neither the taker nor whether the fill completes the resting order
+            return std::make_shared<const Exchange::OrderExecutionReport>(reportId, message.timestamp, message.orderId, Market::OrderType::LIMIT, side,
+                0 /* matchOrderId */, myNumTrades, message.quantity, price, true /* isMakerOrder */, Exchange::OrderExecutionType::NONE, status, myLastTrade);
+        case MessageType::CROSS_TRADE:
+            return std::make_shared<const Exchange::CrossTradeReport>(reportId, message.timestamp, message.quantity, price,
+                Exchange::ITCHEncoder::CrossCode::OPENING, status);
+        default:
+            Utils::Error::LIB_THROW("[LobsterOrderBookTracesBuilder::makeReport] Unsupported message type.");
+            return nullptr;
+    }
+}
+
 MatchingEngineMonitorOutputsAnalyzer::MatchingEngineMonitorOutputsAnalyzer(const std::shared_ptr<const MatchingEngineMonitor>& monitor) :
     myMonitor(monitor) {
     MonitorOutputsAnalyzerBase::init();
@@ -198,21 +327,84 @@ void LobsterDataParserOutputsAnalyzer::init() {
 }
 
 void LobsterDataParserOutputsAnalyzer::populateOrderBookTraces() {
-    // TODO: populate order book traces from lobster parser outputs
+    // populate order book traces from lobster parser outputs
+    auto& traces = getOrderBookTraces();
+    traces = OrderBookTraces();
+    const auto& messages = myParser->getOrderBookMessages();
+    const auto& snapshots = myParser->getOrderBookSnapshots();
+    if (messages.size() != snapshots.size())
+        Utils::Error::LIB_THROW("[LobsterDataParserOutputsAnalyzer::populateOrderBookTraces] Mismatched sizes between order book messages and snapshots in parser.");
+    // a message with no snapshot of its own takes that of the message after it, as LobsterDataWriter writes it - carried backwards in one pass
+    std::vector<const Parser::LobsterDataParser::OrderBookSnapshot*> messageSnapshots(snapshots.size(), nullptr);
+    const Parser::LobsterDataParser::OrderBookSnapshot* nextSnapshot = nullptr;
+    for (size_t i = snapshots.size(); i-- > 0;) {
+        if (snapshots[i])
+            nextSnapshot = snapshots[i].get();
+        messageSnapshots[i] = nextSnapshot;
+    }
+    LobsterOrderBookTracesBuilder builder;
+    const Parser::LobsterDataParser::OrderBookSnapshot emptySnapshot;
+    for (size_t i = 0; i < messages.size(); ++i)
+        if (messages[i])
+            builder.append(traces, *messages[i], messageSnapshots[i] ? *messageSnapshots[i] : emptySnapshot);
 }
 
-FileMonitorOutputsAnalyzer::FileMonitorOutputsAnalyzer(const std::string& filePath, const MonitorOutputsFileFormat fileFormat) :
-    myFilePath(filePath), myFileFormat(fileFormat) {
+FileMonitorOutputsAnalyzer::FileMonitorOutputsAnalyzer(const std::string& filePath, const MonitorOutputsFileFormat fileFormat, const std::string& orderBookFilePath) :
+    myFilePath(filePath), myOrderBookFilePath(orderBookFilePath), myFileFormat(fileFormat) {
     MonitorOutputsAnalyzerBase::init();
     init();
 }
 
 void FileMonitorOutputsAnalyzer::init() {
-    // TODO
+    if (myFilePath.empty())
+        Utils::Error::LIB_THROW("[FileMonitorOutputsAnalyzer] File path is empty.");
+    if (myFileFormat != MonitorOutputsFileFormat::LOBSTER)
+        Utils::Error::LIB_THROW("[FileMonitorOutputsAnalyzer] Unsupported file format.");
+    if (myOrderBookFilePath.empty()) {
+        // LOBSTER names the files of a day alike, e.g. AAPL_2012-06-21_34200000_57600000_message_10.csv and ..._orderbook_10.csv
+        std::filesystem::path path(myFilePath);
+        std::string fileName = path.filename().string();
+        const size_t pos = fileName.rfind("message");
+        if (pos == std::string::npos)
+            Utils::Error::LIB_THROW("[FileMonitorOutputsAnalyzer] Cannot name the order book file of " + myFilePath + ".");
+        fileName.replace(pos, std::string("message").size(), "orderbook");
+        myOrderBookFilePath = path.replace_filename(fileName).string();
+    }
 }
 
 void FileMonitorOutputsAnalyzer::populateOrderBookTraces() {
-    // TODO: populate order book traces from file monitor outputs
+    // populate order book traces from file monitor outputs
+    auto& traces = getOrderBookTraces();
+    traces = OrderBookTraces();
+    Parser::LobsterDataReader reader(myFilePath, myOrderBookFilePath);
+    myTracesBuilder.clear();
+    while (readLobsterTraces(reader, traces, DEFAULT_CHUNK_SIZE) > 0) {}
+    myNumRecords = reader.getNumRecords();
+}
+
+void FileMonitorOutputsAnalyzer::runStreamingAnalytics(const size_t chunkSize) {
+    if (chunkSize == 0)
+        Utils::Error::LIB_THROW("[FileMonitorOutputsAnalyzer::runStreamingAnalytics] Chunk size is zero.");
+    Parser::LobsterDataReader reader(myFilePath, myOrderBookFilePath);
+    myTracesBuilder.clear();
+    OrderBookTraces traces;
+    while (readLobsterTraces(reader, traces, chunkSize) > 0) {
+        accumulateOrderBookTraces(traces);
+        traces.orderBookStatisticsCollector.clear();
+        traces.orderProcessingReportsCollector.clear();
+    }
+    computeStats();
+    myNumRecords = reader.getNumRecords();
+}
+
+size_t FileMonitorOutputsAnalyzer::readLobsterTraces(Parser::LobsterDataReader& reader, OrderBookTraces& traces, const size_t chunkSize) {
+    const size_t snapshotSize = reader.getSnapshotSize();
+    myMessages.resize(chunkSize);
+    mySnapshotRows.resize(chunkSize * snapshotSize);
+    const size_t numRead = reader.read(myMessages, mySnapshotRows);
+    for (size_t i = 0; i < numRead; ++i)
+        myTracesBuilder.append(traces, myMessages[i], std::span<const uint32_t>(mySnapshotRows).subspan(i * snapshotSize, snapshotSize));
+    return numRead;
 }
 }
 
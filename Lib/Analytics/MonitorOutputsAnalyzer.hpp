@@ -3,6 +3,7 @@
 #include "Utils/Utils.hpp"
 #include "Exchange/MatchingEngineUtils.hpp"
 #include "Parser/LobsterDataParser.hpp"
+#include "Parser/LobsterDataReader.hpp"
 #include "Analytics/MatchingEngineMonitor.hpp"
 #include "Analytics/OrderBookDerivedAnalytics.hpp"
 #include "Analytics/OrderBookDerivedAnalyticsUtils.hpp"
@@ -55,8 +56,15 @@ public:
     virtual void onOrderProcessingReport(const Exchange::OrderModifyPriceReport& report);
     virtual void onOrderProcessingReport(const Exchange::OrderModifyQuantityReport& report);
 
+protected:
+    // runAnalytics split in two, so that traces too large to hold at once may be accumulated chunk after chunk before computing
+    void accumulateOrderBookTraces(const OrderBookTraces& traces);
+    void computeStats(); // also restarts the level-one tick detection for the next run
+
 private:
     OrderBookDerivedStatsConfig myStatsConfig = OrderBookDerivedStatsConfig();
+    double myBestBidPriceCache = Utils::Consts::NAN_DOUBLE; // of the last accumulated stats, across chunks
+    double myBestAskPriceCache = Utils::Consts::NAN_DOUBLE;
     // define all the analytic components here
     OrderDepthProfileStats myOrderDepthProfileStats = OrderDepthProfileStats();
     OrderFlowMemoryStats myOrderFlowMemoryStats = OrderFlowMemoryStats();
@@ -68,6 +76,34 @@ private:
     PriceImpactStats myPriceImpactStats = PriceImpactStats();
 };
 
+/* Translates LOBSTER records - a message and the order book after it - into the order book statistics and processing reports of the
+    traces, as the monitor would have logged them. The top levels, best prices and counters of a record come from its own message and
+    snapshot, the last trade is carried over from the executions before it. A LOBSTER execution is that of the resting limit order,
+    hence a trade initiated by the opposite side. Cross trades have no side and are left out of the trade counters, trading halts out
+    of the traces altogether. */
+class LobsterOrderBookTracesBuilder {
+public:
+    using OrderBookMessage = Parser::LobsterDataParser::OrderBookMessage;
+    using OrderBookSnapshot = Parser::LobsterDataParser::OrderBookSnapshot;
+    LobsterOrderBookTracesBuilder(const size_t numLevels = 0) : myNumLevels(numLevels) {} // 0 for all levels of the snapshots
+    size_t getNumLevels() const { return myNumLevels; }
+    uint64_t getNumRecords() const { return myNumRecords; } // appended to traces so far
+    // a flat snapshot row as LobsterDataReader reads it, returns false if the record is left out
+    bool append(OrderBookTraces& traces, const OrderBookMessage& message, std::span<const uint32_t> snapshotRow);
+    bool append(OrderBookTraces& traces, const OrderBookMessage& message, const OrderBookSnapshot& snapshot);
+    void clear();
+
+private:
+    std::shared_ptr<const Exchange::OrderProcessingReport> makeReport(const OrderBookMessage& message) const;
+
+    size_t myNumLevels = 0;
+    uint64_t myNumRecords = 0;
+    uint64_t myNumTrades = 0;
+    uint64_t myTimestamp = 0; // of the last record
+    std::shared_ptr<const Market::TradeBase> myLastTrade;
+    std::vector<uint32_t> mySnapshotRow;
+};
+
 class MatchingEngineMonitorOutputsAnalyzer : public MonitorOutputsAnalyzerBase {
 public:
     MatchingEngineMonitorOutputsAnalyzer() = delete; // only permits construction from monitor
@@ -96,21 +132,35 @@ private:
     std::shared_ptr<const Parser::LobsterDataParser> myParser;
 };
 
+/* Analyzes the outputs of a day written to files. For LOBSTER the file path is that of the messages, and the order book file is the
+    one named alike with "orderbook" in place of "message" unless given. runStreamingAnalytics reads the files a chunk of records
+    at a time and accumulates each chunk of traces as it goes, so that a whole day is never held in memory. */
 class FileMonitorOutputsAnalyzer : public MonitorOutputsAnalyzerBase {
 public:
     enum class MonitorOutputsFileFormat { LOBSTER, NONE };
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 1 << 14;
     FileMonitorOutputsAnalyzer() = delete; // only permits construction from file path
-    FileMonitorOutputsAnalyzer(const std::string& filePath, const MonitorOutputsFileFormat fileFormat);
+    FileMonitorOutputsAnalyzer(const std::string& filePath, const MonitorOutputsFileFormat fileFormat, const std::string& orderBookFilePath = "");
     virtual ~FileMonitorOutputsAnalyzer() = default;
     std::string getFilePath() const { return myFilePath; }
+    std::string getOrderBookFilePath() const { return myOrderBookFilePath; }
     MonitorOutputsFileFormat getFileFormat() const { return myFileFormat; }
+    uint64_t getNumRecords() const { return myNumRecords; } // read from the files in the last populate or run
     virtual void init() override;
     virtual void populateOrderBookTraces() override;
+    void runStreamingAnalytics(const size_t chunkSize = DEFAULT_CHUNK_SIZE); // runs analytics straight from the files
     static constexpr OrderBookTracesSource ourSource = OrderBookTracesSource::FILE;
 
 private:
+    size_t readLobsterTraces(Parser::LobsterDataReader& reader, OrderBookTraces& traces, const size_t chunkSize);
+
     std::string myFilePath;
+    std::string myOrderBookFilePath;
     MonitorOutputsFileFormat myFileFormat = MonitorOutputsFileFormat::NONE;
+    uint64_t myNumRecords = 0;
+    LobsterOrderBookTracesBuilder myTracesBuilder;
+    std::vector<Parser::LobsterDataParser::OrderBookMessage> myMessages; // of a chunk
+    std::vector<uint32_t> mySnapshotRows;
 };
 }
 
@@ -37,44 +37,44 @@ void OrderBookTopLevelsSnapshot::clear() {
 }
 
 std::string OrderBookTopLevelsSnapshot::getAsJson() const {
-    std::ostringstream oss;
-    oss << "{"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{"
     "\"NumLevels\":"  << numLevels << ","
     "\"IsFullBook\":" << isFullBook << ","
     "\"LastTrade\":"  << (lastTrade ? lastTrade->getAsJson() : "null") << ",";
-    oss << "\"BidBookTopLevels\":[";
+    buffer << "\"BidBookTopLevels\":[";
     for (size_t i = 0; i < bidBookTopPrices.size(); ++i) {
-        oss << "(" << bidBookTopPrices[i] << "," << bidBookTopSizes[i] << ")";
+        buffer << "(" << bidBookTopPrices[i] << "," << bidBookTopSizes[i] << ")";
         if (i < bidBookTopPrices.size() - 1)
-            oss << ",";
+            buffer << ",";
     }
-    oss << "],\"AskBookTopLevels\":[";
+    buffer << "],\"AskBookTopLevels\":[";
     for (size_t i = 0; i < askBookTopPrices.size(); ++i) {
-        oss << "(" << askBookTopPrices[i] << "," << askBookTopSizes[i] << ")";
+        buffer << "(" << askBookTopPrices[i] << "," << askBookTopSizes[i] << ")";
         if (i < askBookTopPrices.size() - 1)
-            oss << ",";
+            buffer << ",";
     }
-    oss << "]}";
-    return oss.str();
+    buffer << "]}";
+    return buffer.str();
 }
 
 std::string OrderBookTopLevelsSnapshot::getAsCsv() const {
     // format: BidNumLevels,AskNumLevels,BidPrice1,BidSize1,...,AskPrice1,AskSize1,...
     // note that the last trade information is omitted
-    std::ostringstream oss;
-    oss << bidBookTopPrices.size() << "," << askBookTopPrices.size() << ",";
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << bidBookTopPrices.size() << "," << askBookTopPrices.size() << ",";
     for (size_t i = 0; i < bidBookTopPrices.size(); ++i) {
-        oss << bidBookTopPrices[i] << "," << bidBookTopSizes[i];
+        buffer << bidBookTopPrices[i] << "," << bidBookTopSizes[i];
         if (i < bidBookTopPrices.size() - 1)
-            oss << ",";
+            buffer << ",";
     }
-    oss << ",";
+    buffer << ",";
     for (size_t i = 0; i < askBookTopPrices.size(); ++i) {
-        oss << askBookTopPrices[i] << "," << askBookTopSizes[i];
+        buffer << askBookTopPrices[i] << "," << askBookTopSizes[i];
         if (i < askBookTopPrices.size() - 1)
-            oss << ",";
+            buffer << ",";
     }
-    return oss.str();
+    return buffer.str();
 }
 
 std::string OrderBookTopLevelsSnapshot::getAsTable() const {
@@ -133,8 +133,8 @@ std::string OrderBookTopLevelsSnapshot::getAsTable() const {
 }
 
 std::string OrderBookAggregateStatistics::getAsJson() const {
-    std::ostringstream oss;
-    oss << "{"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{"
     "\"TimestampFrom\":"              << timestampFrom              << ","
     "\"TimestampTo\":"                << timestampTo                << ","
     "\"AggNumNewLimitOrders\":"       << aggNumNewLimitOrders       << ","
@@ -145,13 +145,13 @@ std::string OrderBookAggregateStatistics::getAsJson() const {
     "\"AggNumTrades\":"               << aggNumTrades               << ","
     "\"AggTradeVolume\":"             << aggTradeVolume             << ","
     "\"AggTradeNotional\":"           << aggTradeNotional;
-    oss << "}";
-    return oss.str();
+    buffer << "}";
+    return buffer.str();
 }
 
 std::string OrderBookAggregateStatistics::getAsCsv() const {
-    std::ostringstream oss;
-    oss <<
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer <<
     timestampFrom              << "," <<
     timestampTo                << "," <<
     aggNumNewLimitOrders       << "," <<
@@ -162,7 +162,7 @@ std::string OrderBookAggregateStatistics::getAsCsv() const {
     aggNumTrades               << "," <<
     aggTradeVolume             << "," <<
     aggTradeNotional;
-    return oss.str();
+    return buffer.str();
 }
 
 std::string OrderBookAggregateStatistics::getAsTable() const {
@@ -242,8 +242,8 @@ void OrderBookStatisticsByTimestamp::clear() {
 }
 
 std::string OrderBookStatisticsByTimestamp::getAsJson() const {
-    std::ostringstream oss;
-    oss << "{"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{"
     "\"TimestampFrom\":"              << timestampFrom              << ","
     "\"TimestampTo\":"                << timestampTo                << ","
     "\"CumNumNewLimitOrders\":"       << cumNumNewLimitOrders       << ","
@@ -265,14 +265,14 @@ std::string OrderBookStatisticsByTimestamp::getAsJson() const {
     "\"BestAskSize\":"                << bestAskSize                << ","
     "\"LastTradePrice\":"             << lastTradePrice             << ","
     "\"LastTradeQuantity\":"          << lastTradeQuantity          << ","
-    "\"TopLevelsSnapshot\":"          << topLevelsSnapshot;
-    oss << "}";
-    return oss.str();
+    "\"TopLevelsSnapshot\":"          << topLevelsSnapshot.getAsJson();
+    buffer << "}";
+    return buffer.str();
 }
 
 std::string OrderBookStatisticsByTimestamp::getAsCsv() const {
-    std::ostringstream oss;
-    oss <<
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer <<
     timestampFrom              << "," <<
     timestampTo                << "," <<
     cumNumNewLimitOrders       << "," <<
@@ -295,7 +295,7 @@ std::string OrderBookStatisticsByTimestamp::getAsCsv() const {
     lastTradePrice             << "," <<
     lastTradeQuantity          << "," <<
     topLevelsSnapshot.getAsCsv();
-    return oss.str();
+    return buffer.str();
 }
 
 std::string OrderBookStatisticsByTimestamp::getAsTable() const {
@@ -331,25 +331,25 @@ std::string OrderBookStatisticsByTimestamp::getAsTable() const {
 }
 
 std::string OrderEventProcessingLatency::getAsJson() const {
-    std::ostringstream oss;
-    oss << "{" <<
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{" <<
     "\"Timestamp\":"        << timestamp        << "," <<
     "\"EventId\":"          << eventId          << "," <<
     "\"LatencyNs\":"        << latency          << "," <<
     "\"EventType\":"        << eventType        << "," <<
     "\"Event\":"            << (event ? event->getAsJson() : "null");
-    oss << "}";
-    return oss.str();
+    buffer << "}";
+    return buffer.str();
 }
 
 std::string OrderEventProcessingLatency::getAsCsv() const {
-    std::ostringstream oss;
-    oss <<
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer <<
     timestamp << "," <<
     eventId   << "," <<
     latency   << "," <<
     eventType;
-    return oss.str();
+    return buffer.str();
 }
 
 std::string OrderEventProcessingLatency::getAsTable() const {
@@ -0,0 +1,33 @@
+#ifndef ITCH_DECODER_CPP
+#define ITCH_DECODER_CPP
+#include "Utils/Utils.hpp"
+#include "Exchange/ITCHEncoder.hpp"
+#include "Exchange/ITCHDecoder.hpp"
+
+namespace Exchange {
+size_t ITCHDecoder::getBinarySize(const char messageType) {
+    switch (messageType) {
+        case ITCHSystemView::ourType: return ITCHEncoder::ITCHSystemMessage::ourBinarySize;
+        case ITCHOrderAddView::ourType: return ITCHEncoder::ITCHOrderAddMessage::ourBinarySize;
+        case ITCHOrderAddWithMPIDView::ourType: return ITCHEncoder::ITCHOrderAddWithMPIDMessage::ourBinarySize;
+        case ITCHOrderExecuteView::ourType: return ITCHEncoder::ITCHOrderExecuteMessage::ourBinarySize;
+        case ITCHOrderExecuteWithPriceView::ourType: return ITCHEncoder::ITCHOrderExecuteWithPriceMessage::ourBinarySize;
+        case ITCHOrderDeleteView::ourType: return ITCHEncoder::ITCHOrderDeleteMessage::ourBinarySize;
+        case ITCHOrderCancelView::ourType: return ITCHEncoder::ITCHOrderCancelMessage::ourBinarySize;
+        case ITCHOrderReplaceView::ourType: return ITCHEncoder::ITCHOrderReplaceMessage::ourBinarySize;
+        case ITCHTradeView::ourType: return ITCHEncoder::ITCHTradeMessage::ourBinarySize;
+        case ITCHCrossTradeView::ourType: return ITCHEncoder::ITCHCrossTradeMessage::ourBinarySize;
+        case ITCHBrokenTradeView::ourType: return ITCHEncoder::ITCHBrokenTradeMessage::ourBinarySize;
+        default: return 0;
+    }
+}
+
+std::string_view ITCHDecoder::ITCHMessageView::getAlpha(const size_t offset, const size_t numBytes) const {
+    size_t length = numBytes;
+    while (length > 0 && data[offset + length - 1] == ' ')
+        --length;
+    return std::string_view(reinterpret_cast<const char*>(data + offset), length);
+}
+}
+
+#endif
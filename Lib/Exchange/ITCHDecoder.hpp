@@ -0,0 +1,244 @@
+#ifndef ITCH_DECODER_HPP
+#define ITCH_DECODER_HPP
+#include "Utils/Utils.hpp"
+#include "Exchange/ITCHEncoder.hpp"
+
+namespace Exchange {
+/* The reverse of ITCHEncoder::toBinary - reads binary ITCH 5.0 without materialising the messages. Each frame is handed to a visitor
+   as a view over the bytes it arrived in (an mmap'd file, a network buffer), the fields decoded from the big-endian layout only as
+   they are accessed. The views live on the stack and must not outlive the bytes. */
+struct ITCHDecoder {
+    static constexpr size_t MAX_CARRIED_FRAME_SIZE = 64; // no ITCH 5.0 message is longer
+
+    static uint64_t getBinary(const uint8_t* p, const size_t numBytes) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < numBytes; ++i)
+            value = (value << 8) | p[i];
+        return value;
+    }
+
+    // the size of the layout after the length prefix, 0 for the types not written by ITCHEncoder
+    static size_t getBinarySize(const char messageType);
+
+    /* A frame in place, the bytes after the length prefix */
+    struct ITCHMessageView {
+        ITCHMessageView(const uint8_t* data, const size_t size) : data(data), size(size) {}
+        char getType() const { return static_cast<char>(data[0]); }
+        uint16_t getStockLocate() const { return static_cast<uint16_t>(getBinary(data + 1, 2)); }
+        uint16_t getTrackingNumber() const { return static_cast<uint16_t>(getBinary(data + 3, 2)); }
+        uint64_t getTimestamp() const { return getBinary(data + 5, 6); }
+        uint64_t get(const size_t offset, const size_t numBytes) const { return getBinary(data + offset, numBytes); }
+        std::string_view getAlpha(const size_t offset, const size_t numBytes) const; // the trailing padding dropped
+        const uint8_t* data;
+        size_t size;
+    };
+
+    struct ITCHSystemView : public ITCHMessageView {
+        using ITCHMessageView::ITCHMessageView;
+        char getEventCode() const { return static_cast<char>(data[11]); }
+        static constexpr char ourType = 'S';
+    };
+
+    struct ITCHOrderAddView : public ITCHMessageView {
+        using ITCHMessageView::ITCHMessageView;
+        uint64_t getOrderId() const { return get(11, 8); }
+        bool isBuy() const { return data[19] == 'B'; }
+        uint32_t getQuantity() const { return static_cast<uint32_t>(get(20, 4)); }
+        std::string_view getSymbol() const { return getAlpha(24, 8); }
+        uint32_t getPrice() const { return static_cast<uint32_t>(get(32, 4)); } // double price x 10000
+        static constexpr char ourType = 'A';
+    };
+
+    struct ITCHOrderAddWithMPIDView : public ITCHOrderAddView {
+        using ITCHOrderAddView::ITCHOrderAddView;
+        std::string_view getMPID() const { return getAlpha(36, 4); }
+        static constexpr char ourType = 'F';
+    };
+
+    struct ITCHOrderExecuteView : public ITCHMessageView {
+        using ITCHMessageView::ITCHMessageView;
+        uint64_t getOrderId() const { return get(11, 8); }
+        uint32_t getFillQuantity() const { return static_cast<uint32_t>(get(19, 4)); }
+        uint64_t getMatchNumber() const { return get(23, 8); }
+        static constexpr char ourType = 'E';
+    };
+
+    struct ITCHOrderExecuteWithPriceView : public ITCHOrderExecuteView {
+        using ITCHOrderExecuteView::ITCHOrderExecuteView;
+        bool isPrintable() const { return data[31] == 'Y'; }
+        uint32_t getFillPrice() const { return static_cast<uint32_t>(get(32, 4)); }
+        static constexpr char ourType = 'C';
+    };
+
+    struct ITCHOrderDeleteView : public ITCHMessageView {
+        using ITCHMessageView::ITCHMessageView;
+        uint64_t getOrderId() const { return get(11, 8); }
+        static constexpr char ourType = 'D';
+    };
+
+    struct ITCHOrderCancelView : public ITCHOrderDeleteView {
+        using ITCHOrderDeleteView::ITCHOrderDeleteView;
+        uint32_t getCancelQuantity() const { return static_cast<uint32_t>(get(19, 4)); }
+        static constexpr char ourType = 'X';
+    };
+
+    struct ITCHOrderReplaceView : public ITCHMessageView {
+        using ITCHMessageView::ITCHMessageView;
+        uint64_t getOldOrderId() const { return get(11, 8); }
+        uint64_t getNewOrderId() const { return get(19, 8); }
+        uint32_t getQuantity() const { return static_cast<uint32_t>(get(27, 4)); }
+        uint32_t getPrice() const { return static_cast<uint32_t>(get(31, 4)); }
+        static constexpr char ourType = 'U';
+    };
+
+    struct ITCHTradeView : public ITCHMessageView {
+        using ITCHMessageView::ITCHMessageView;
+        uint64_t getOrderId() const { return get(11, 8); }
+        bool isBuy() const { return data[19] == 'B'; }
+        uint32_t getFillQuantity() const { return static_cast<uint32_t>(get(20, 4)); }
+        std::string_view getSymbol() const { return getAlpha(24, 8); }
+        uint32_t getFillPrice() const { return static_cast<uint32_t>(get(32, 4)); }
+        uint64_t getMatchNumber() const { return get(36, 8); }
+        static constexpr char ourType = 'P';
+    };
+
+    struct ITCHCrossTradeView : public ITCHMessageView {
+        using ITCHMessageView::ITCHMessageView;
+        uint64_t getCrossQuantity() const { return get(11, 8); }
+        std::string_view getSymbol() const { return getAlpha(19, 8); }
+        uint32_t getCrossPrice() const { return static_cast<uint32_t>(get(27, 4)); }
+        uint64_t getMatchNumber() const { return get(31, 8); }
+        char getCrossCode() const { return static_cast<char>(data[39]); }
+        static constexpr char ourType = 'Q';
+    };
+
+    struct ITCHBrokenTradeView : public ITCHMessageView {
+        using ITCHMessageView::ITCHMessageView;
+        uint64_t getMatchNumber() const { return get(11, 8); }
+        static constexpr char ourType = 'B';
+    };
+
+    /* Walks the length-prefixed frames of a byte stream delivered in any number of chunks, and calls the visitor with the typed
+       view of each. A frame cut at the end of a chunk is carried over to the next in a small buffer of its own, the only copy the
+       decoder makes. Frames of the types ITCHEncoder does not write (the rest of the ITCH 5.0 message set) are skipped, as are frames
+       longer than any ITCH message, while a frame too short for its type throws. */
+    class BinaryStreamDecoder {
+    public:
+        uint64_t getNumDecoded() const { return myNumDecoded; }
+        uint64_t getNumSkipped() const { return myNumSkipped; }
+        uint64_t getNumBytes() const { return myNumBytes; }
+        bool hasPartialFrame() const { return myNumCarried > 0 || myNumToSkip > 0; }
+        void reset() { myNumDecoded = myNumSkipped = myNumBytes = 0; myNumCarried = myNumToSkip = 0; }
+
+        // returns the number of frames handed to the visitor
+        template<typename Visitor>
+        size_t decode(const uint8_t* data, const size_t size, Visitor&& visitor) {
+            const uint64_t numDecodedBefore = myNumDecoded;
+            size_t offset = 0;
+            if (myNumToSkip > 0) { // the rest of a skipped frame
+                offset = std::min(myNumToSkip, size);
+                myNumToSkip -= offset;
+            }
+            if (myNumCarried > 0)
+                offset += completeCarriedFrame(data + offset, size - offset, visitor);
+            while (!hasPartialFrame() && offset < size) {
+                const size_t numLeft = size - offset;
+                if (numLeft < ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE) {
+                    carry(data + offset, numLeft);
+                    break;
+                }
+                const size_t frameSize = ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE + getBinary(data + offset, ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE);
+                if (frameSize > MAX_CARRIED_FRAME_SIZE) {
+                    offset += skip(frameSize, numLeft);
+                    continue;
+                }
+                if (numLeft < frameSize) {
+                    carry(data + offset, numLeft);
+                    break;
+                }
+                dispatch(data + offset + ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE, frameSize - ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE, visitor);
+                offset += frameSize;
+            }
+            myNumBytes += size;
+            return myNumDecoded - numDecodedBefore;
+        }
+
+    private:
+        void carry(const uint8_t* data, const size_t size) {
+            std::copy(data, data + size, myCarried.begin() + myNumCarried);
+            myNumCarried += size;
+        }
+
+        // tops up the carried frame from the head of the next chunk and returns the bytes taken from it
+        template<typename Visitor>
+        size_t completeCarriedFrame(const uint8_t* data, const size_t size, Visitor& visitor) {
+            size_t offset = 0;
+            if (myNumCarried < ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE) {
+                offset = std::min(ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE - myNumCarried, size);
+                carry(data, offset);
+                if (myNumCarried < ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE)
+                    return offset;
+            }
+            const size_t frameSize = ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE + getBinary(myCarried.data(), ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE);
+            if (frameSize > MAX_CARRIED_FRAME_SIZE) {
+                const size_t numCarried = myNumCarried;
+                myNumCarried = 0;
+                return offset + skip(frameSize - numCarried, size - offset);
+            }
+            const size_t numTaken = std::min(frameSize - myNumCarried, size - offset);
+            carry(data + offset, numTaken);
+            if (myNumCarried == frameSize) {
+                myNumCarried = 0;
+                dispatch(myCarried.data() + ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE, frameSize - ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE, visitor);
+            }
+            return offset + numTaken;
+        }
+
+        // a frame longer than any ITCH 5.0 message is not one of ours, returns the bytes of it in the chunk
+        size_t skip(const size_t frameSize, const size_t numLeft) {
+            const size_t numTaken = std::min(frameSize, numLeft);
+            myNumToSkip = frameSize - numTaken;
+            ++myNumSkipped;
+            return numTaken;
+        }
+
+        template<typename Visitor>
+        void dispatch(const uint8_t* data, const size_t size, Visitor& visitor) {
+            if (size == 0)
+                Utils::Error::LIB_THROW("[ITCHDecoder::BinaryStreamDecoder] Empty frame.");
+            const char messageType = static_cast<char>(data[0]);
+            const size_t binarySize = getBinarySize(messageType);
+            if (binarySize == 0) {
+                ++myNumSkipped;
+                return;
+            }
+            if (size < binarySize)
+                Utils::Error::LIB_THROW("[ITCHDecoder::BinaryStreamDecoder] Frame of type " + std::string(1, messageType) + " holds "
+                    + std::to_string(size) + " bytes, expected " + std::to_string(binarySize) + ".");
+            ++myNumDecoded;
+            switch (messageType) {
+                case ITCHSystemView::ourType: visitor(ITCHSystemView{data, size}); break;
+                case ITCHOrderAddView::ourType: visitor(ITCHOrderAddView{data, size}); break;
+                case ITCHOrderAddWithMPIDView::ourType: visitor(ITCHOrderAddWithMPIDView{data, size}); break;
+                case ITCHOrderExecuteView::ourType: visitor(ITCHOrderExecuteView{data, size}); break;
+                case ITCHOrderExecuteWithPriceView::ourType: visitor(ITCHOrderExecuteWithPriceView{data, size}); break;
+                case ITCHOrderDeleteView::ourType: visitor(ITCHOrderDeleteView{data, size}); break;
+                case ITCHOrderCancelView::ourType: visitor(ITCHOrderCancelView{data, size}); break;
+                case ITCHOrderReplaceView::ourType: visitor(ITCHOrderReplaceView{data, size}); break;
+                case ITCHTradeView::ourType: visitor(ITCHTradeView{data, size}); break;
+                case ITCHCrossTradeView::ourType: visitor(ITCHCrossTradeView{data, size}); break;
+                case ITCHBrokenTradeView::ourType: visitor(ITCHBrokenTradeView{data, size}); break;
+            }
+        }
+
+        std::array<uint8_t, MAX_CARRIED_FRAME_SIZE> myCarried{};
+        size_t myNumCarried = 0;
+        size_t myNumToSkip = 0;
+        uint64_t myNumDecoded = 0;
+        uint64_t myNumSkipped = 0;
+        uint64_t myNumBytes = 0;
+    };
+};
+}
+
+#endif
@@ -22,13 +22,55 @@ const std::string ITCHEncoder::ITCHBrokenTradeMessage::ourDescription
 
 std::ostream& operator<<(std::ostream& out, const ITCHEncoder::ITCHMessage& message) { return out << message.toString(); }
 
+namespace {
+// big-endian, the network byte order of ITCH
+inline uint8_t* putBinary(uint8_t* p, uint64_t value, const size_t numBytes) {
+    for (size_t i = numBytes; i-- > 0; value >>= 8)
+        p[i] = static_cast<uint8_t>(value & 0xFF);
+    return p + numBytes;
+}
+
+// alpha fields are left-justified and padded with spaces, the symbol is null-terminated in the message
+inline uint8_t* putAlpha(uint8_t* p, const char* chars, const size_t numBytes) {
+    size_t i = 0;
+    for (; i < numBytes && chars[i] != '\0'; ++i)
+        p[i] = static_cast<uint8_t>(chars[i]);
+    for (; i < numBytes; ++i)
+        p[i] = ' ';
+    return p + numBytes;
+}
+
+// writes the length prefix and the common header, null if the message does not fit
+inline uint8_t* putBinaryHeader(uint8_t* buffer, const size_t bufferSize, const size_t messageSize, const char messageType,
+    const uint64_t stockLocate, const uint64_t messageId, const uint64_t timestamp) {
+    if (!buffer || bufferSize < ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE + messageSize)
+        return nullptr;
+    uint8_t* p = putBinary(buffer, messageSize, 2);
+    *p++ = static_cast<uint8_t>(messageType);
+    p = putBinary(p, stockLocate & 0xFFFF, 2);
+    p = putBinary(p, messageId & 0xFFFF, 2); // tracking number
+    return putBinary(p, timestamp & 0xFFFFFFFFFFFF, 6);
+}
+
+template<typename E>
+inline uint8_t toBinaryCode(const E value) { return static_cast<uint8_t>(Utils::EnumStrings<E>::names[static_cast<size_t>(value)][0]); }
+}
+
 std::string ITCHEncoder::ITCHSystemMessage::toString() const {
-    std::ostringstream oss;
-    oss << "S|"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "S|"
         << messageId << "|"
         << timestamp << "|"
         << eventCode;
-    return oss.str();
+    return buffer.str();
+}
+
+size_t ITCHEncoder::ITCHSystemMessage::toBinary(uint8_t* buffer, const size_t bufferSize) const {
+    uint8_t* p = putBinaryHeader(buffer, bufferSize, ourBinarySize, 'S', 0, messageId, timestamp);
+    if (!p)
+        return 0;
+    *p = toBinaryCode(eventCode);
+    return BINARY_LENGTH_PREFIX_SIZE + ourBinarySize;
 }
 
 std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHOrderAddMessage::makeEvent() const {
@@ -38,17 +80,29 @@ std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHOrderAddMessage::makeEv
 }
 
 std::string ITCHEncoder::ITCHOrderAddMessage::toString() const {
-    std::ostringstream oss;
-    oss << "A|"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "A|"
         << messageId              << "|"
         << timestamp              << "|"
         << agentId                << "|"
-        << std::string(symbol)    << "|"
+        << std::string_view(symbol, strnlen(symbol, 8)) << "|"
         << orderId                << "|"
         << (isBuy ? 'B' : 'S')    << "|"
         << quantity               << "|"
-        << std::fixed << std::setprecision(2) << Utils::Maths::castIntPriceAsDouble(price);
-    return oss.str();
+        << Utils::Format::fixed(Utils::Maths::castIntPriceAsDouble(price), 2);
+    return buffer.str();
+}
+
+size_t ITCHEncoder::ITCHOrderAddMessage::toBinary(uint8_t* buffer, const size_t bufferSize) const {
+    uint8_t* p = putBinaryHeader(buffer, bufferSize, ourBinarySize, 'A', agentId, messageId, timestamp);
+    if (!p)
+        return 0;
+    p = putBinary(p, orderId, 8);
+    *p++ = isBuy ? 'B' : 'S';
+    p = putBinary(p, quantity, 4);
+    p = putAlpha(p, symbol, 8);
+    putBinary(p, price, 4);
+    return BINARY_LENGTH_PREFIX_SIZE + ourBinarySize;
 }
 
 std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHOrderAddWithMPIDMessage::makeEvent() const {
@@ -58,18 +112,31 @@ std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHOrderAddWithMPIDMessage
 }
 
 std::string ITCHEncoder::ITCHOrderAddWithMPIDMessage::toString() const {
-    std::ostringstream oss;
-    oss << "F|"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "F|"
         << messageId              << "|"
         << timestamp              << "|"
         << agentId                << "|"
-        << std::string(symbol)    << "|"
+        << std::string_view(symbol, strnlen(symbol, 8)) << "|"
         << orderId                << "|"
         << (isBuy ? 'B' : 'S')    << "|"
         << quantity               << "|"
-        << std::fixed << std::setprecision(2) << Utils::Maths::castIntPriceAsDouble(price) << "|"
-        << std::string(mpid, 4);
-    return oss.str();
+        << Utils::Format::fixed(Utils::Maths::castIntPriceAsDouble(price), 2) << "|"
+        << std::string_view(mpid, 4);
+    return buffer.str();
+}
+
+size_t ITCHEncoder::ITCHOrderAddWithMPIDMessage::toBinary(uint8_t* buffer, const size_t bufferSize) const {
+    uint8_t* p = putBinaryHeader(buffer, bufferSize, ourBinarySize, 'F', agentId, messageId, timestamp);
+    if (!p)
+        return 0;
+    p = putBinary(p, orderId, 8);
+    *p++ = isBuy ? 'B' : 'S';
+    p = putBinary(p, quantity, 4);
+    p = putAlpha(p, symbol, 8);
+    p = putBinary(p, price, 4);
+    putAlpha(p, mpid, 4);
+    return BINARY_LENGTH_PREFIX_SIZE + ourBinarySize;
 }
 
 std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHOrderExecuteMessage::makeEvent() const {
@@ -80,15 +147,25 @@ std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHOrderExecuteMessage::ma
 }
 
 std::string ITCHEncoder::ITCHOrderExecuteMessage::toString() const {
-    std::ostringstream oss;
-    oss << "E|"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "E|"
         << messageId      << "|"
         << timestamp      << "|"
         << agentId        << "|"
         << orderId        << "|"
         << matchOrderId   << "|"
         << fillQuantity;
-    return oss.str();
+    return buffer.str();
+}
+
+size_t ITCHEncoder::ITCHOrderExecuteMessage::toBinary(uint8_t* buffer, const size_t bufferSize) const {
+    uint8_t* p = putBinaryHeader(buffer, bufferSize, ourBinarySize, 'E', agentId, messageId, timestamp);
+    if (!p)
+        return 0;
+    p = putBinary(p, orderId, 8);
+    p = putBinary(p, fillQuantity, 4);
+    putBinary(p, matchOrderId, 8); // match number
+    return BINARY_LENGTH_PREFIX_SIZE + ourBinarySize;
 }
 
 std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHOrderExecuteWithPriceMessage::makeEvent() const {
@@ -97,16 +174,28 @@ std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHOrderExecuteWithPriceMe
 }
 
 std::string ITCHEncoder::ITCHOrderExecuteWithPriceMessage::toString() const {
-    std::ostringstream oss;
-    oss << "C|"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "C|"
         << messageId      << "|"
         << timestamp      << "|"
         << agentId        << "|"
         << orderId        << "|"
         << matchOrderId   << "|"
         << fillQuantity   << "|"
-        << std::fixed << std::setprecision(2) << Utils::Maths::castIntPriceAsDouble(fillPrice);
-    return oss.str();
+        << Utils::Format::fixed(Utils::Maths::castIntPriceAsDouble(fillPrice), 2);
+    return buffer.str();
+}
+
+size_t ITCHEncoder::ITCHOrderExecuteWithPriceMessage::toBinary(uint8_t* buffer, const size_t bufferSize) const {
+    uint8_t* p = putBinaryHeader(buffer, bufferSize, ourBinarySize, 'C', agentId, messageId, timestamp);
+    if (!p)
+        return 0;
+    p = putBinary(p, orderId, 8);
+    p = putBinary(p, fillQuantity, 4);
+    p = putBinary(p, matchOrderId, 8); // match number
+    *p++ = 'Y'; // printable
+    putBinary(p, fillPrice, 4);
+    return BINARY_LENGTH_PREFIX_SIZE + ourBinarySize;
 }
 
 std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHOrderDeleteMessage::makeEvent() const {
@@ -114,13 +203,21 @@ std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHOrderDeleteMessage::mak
 }
 
 std::string ITCHEncoder::ITCHOrderDeleteMessage::toString() const {
-    std::ostringstream oss;
-    oss << "D|"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "D|"
         << messageId << "|"
         << timestamp << "|"
         << agentId   << "|"
         << orderId;
-    return oss.str();
+    return buffer.str();
+}
+
+size_t ITCHEncoder::ITCHOrderDeleteMessage::toBinary(uint8_t* buffer, const size_t bufferSize) const {
+    uint8_t* p = putBinaryHeader(buffer, bufferSize, ourBinarySize, 'D', agentId, messageId, timestamp);
+    if (!p)
+        return 0;
+    putBinary(p, orderId, 8);
+    return BINARY_LENGTH_PREFIX_SIZE + ourBinarySize;
 }
 
 std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHOrderCancelMessage::makeEvent() const {
@@ -128,14 +225,23 @@ std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHOrderCancelMessage::mak
 }
 
 std::string ITCHEncoder::ITCHOrderCancelMessage::toString() const {
-    std::ostringstream oss;
-    oss << "X|"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "X|"
         << messageId      << "|"
         << timestamp      << "|"
         << agentId        << "|"
         << orderId        << "|"
         << cancelQuantity;
-    return oss.str();
+    return buffer.str();
+}
+
+size_t ITCHEncoder::ITCHOrderCancelMessage::toBinary(uint8_t* buffer, const size_t bufferSize) const {
+    uint8_t* p = putBinaryHeader(buffer, bufferSize, ourBinarySize, 'X', agentId, messageId, timestamp);
+    if (!p)
+        return 0;
+    p = putBinary(p, orderId, 8);
+    putBinary(p, cancelQuantity, 4);
+    return BINARY_LENGTH_PREFIX_SIZE + ourBinarySize;
 }
 
 std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHOrderReplaceMessage::makeEvent() const {
@@ -143,16 +249,27 @@ std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHOrderReplaceMessage::ma
 }
 
 std::string ITCHEncoder::ITCHOrderReplaceMessage::toString() const {
-    std::ostringstream oss;
-    oss << "U|"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "U|"
         << messageId      << "|"
         << timestamp      << "|"
         << agentId        << "|"
         << oldOrderId     << "|"
         << newOrderId     << "|"
         << quantity       << "|"
-        << std::fixed << std::setprecision(2) << Utils::Maths::castIntPriceAsDouble(price);
-    return oss.str();
+        << Utils::Format::fixed(Utils::Maths::castIntPriceAsDouble(price), 2);
+    return buffer.str();
+}
+
+size_t ITCHEncoder::ITCHOrderReplaceMessage::toBinary(uint8_t* buffer, const size_t bufferSize) const {
+    uint8_t* p = putBinaryHeader(buffer, bufferSize, ourBinarySize, 'U', agentId, messageId, timestamp);
+    if (!p)
+        return 0;
+    p = putBinary(p, oldOrderId, 8);
+    p = putBinary(p, newOrderId, 8);
+    p = putBinary(p, quantity, 4);
+    putBinary(p, price, 4);
+    return BINARY_LENGTH_PREFIX_SIZE + ourBinarySize;
 }
 
 std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHTradeMessage::makeEvent() const {
@@ -163,28 +280,54 @@ std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHTradeMessage::makeEvent
 }
 
 std::string ITCHEncoder::ITCHTradeMessage::toString() const {
-    std::ostringstream oss;
-    oss << "P|"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "P|"
         << messageId      << "|"
         << timestamp      << "|"
         << agentId        << "|"
         << orderId        << "|"
         << matchOrderId   << "|"
         << fillQuantity   << "|"
-        << std::fixed << std::setprecision(2) << Utils::Maths::castIntPriceAsDouble(fillPrice);
-    return oss.str();
+        << Utils::Format::fixed(Utils::Maths::castIntPriceAsDouble(fillPrice), 2);
+    return buffer.str();
+}
+
+size_t ITCHEncoder::ITCHTradeMessage::toBinary(uint8_t* buffer, const size_t bufferSize) const {
+    // the message carries neither the side nor the symbol of the match, which go out as a buy of the default symbol
+    uint8_t* p = putBinaryHeader(buffer, bufferSize, ourBinarySize, 'P', agentId, messageId, timestamp);
+    if (!p)
+        return 0;
+    p = putBinary(p, orderId, 8);
+    *p++ = 'B';
+    p = putBinary(p, fillQuantity, 4);
+    p = putAlpha(p, DEFAULT_SYMBOL, 8);
+    p = putBinary(p, fillPrice, 4);
+    putBinary(p, matchOrderId, 8); // match number
+    return BINARY_LENGTH_PREFIX_SIZE + ourBinarySize;
 }
 
 std::string ITCHEncoder::ITCHCrossTradeMessage::toString() const {
-    std::ostringstream oss;
-    oss << "Q|"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "Q|"
         << messageId           << "|"
         << timestamp           << "|"
-        << std::string(symbol) << "|"
+        << std::string_view(symbol, strnlen(symbol, 8)) << "|"
         << crossQuantity       << "|"
-        << std::fixed << std::setprecision(2) << Utils::Maths::castIntPriceAsDouble(crossPrice) << "|"
+        << Utils::Format::fixed(Utils::Maths::castIntPriceAsDouble(crossPrice), 2) << "|"
         << crossCode;
-    return oss.str();
+    return buffer.str();
+}
+
+size_t ITCHEncoder::ITCHCrossTradeMessage::toBinary(uint8_t* buffer, const size_t bufferSize) const {
+    uint8_t* p = putBinaryHeader(buffer, bufferSize, ourBinarySize, 'Q', 0, messageId, timestamp);
+    if (!p)
+        return 0;
+    p = putBinary(p, crossQuantity, 8);
+    p = putAlpha(p, symbol, 8);
+    p = putBinary(p, crossPrice, 4);
+    p = putBinary(p, messageId, 8); // match number
+    *p = toBinaryCode(crossCode);
+    return BINARY_LENGTH_PREFIX_SIZE + ourBinarySize;
 }
 
 std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHBrokenTradeMessage::makeEvent() const {
@@ -192,19 +335,154 @@ std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHBrokenTradeMessage::mak
 }
 
 std::string ITCHEncoder::ITCHBrokenTradeMessage::toString() const {
-    std::ostringstream oss;
-    oss << "B|"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "B|"
         << messageId      << "|"
         << timestamp      << "|"
         << tradeId;
-    return oss.str();
+    return buffer.str();
+}
+
+size_t ITCHEncoder::ITCHBrokenTradeMessage::toBinary(uint8_t* buffer, const size_t bufferSize) const {
+    uint8_t* p = putBinaryHeader(buffer, bufferSize, ourBinarySize, 'B', 0, messageId, timestamp);
+    if (!p)
+        return 0;
+    putBinary(p, tradeId, 8); // match number
+    return BINARY_LENGTH_PREFIX_SIZE + ourBinarySize;
+}
+
+ITCHEncoder::ITCHMessageValue::ITCHMessageValue(const ITCHMessage& message) :
+    messageId(message.messageId), timestamp(message.timestamp), messageType(message.messageType) {
+    std::memset(static_cast<void*>(&orderAdd), 0, sizeof(orderAdd)); // the largest layout, so that no byte is left undefined
+    switch (messageType) {
+        case MessageType::SYSTEM:
+            system.eventCode = static_cast<const ITCHSystemMessage&>(message).eventCode;
+            break;
+        case MessageType::ORDER_ADD:
+        case MessageType::ORDER_ADD_WITH_MPID: {
+            const auto& add = static_cast<const ITCHOrderAddMessage&>(message);
+            orderAdd.agentId = add.agentId;
+            orderAdd.orderId = add.orderId;
+            orderAdd.quantity = add.quantity;
+            orderAdd.price = add.price;
+            orderAdd.isBuy = add.isBuy;
+            std::copy(add.symbol, add.symbol + 8, orderAdd.symbol);
+            if (messageType == MessageType::ORDER_ADD_WITH_MPID) {
+                const auto& mpid = static_cast<const ITCHOrderAddWithMPIDMessage&>(message).mpid;
+                std::copy(mpid, mpid + 4, orderAdd.mpid);
+            }
+            break;
+        }
+        case MessageType::ORDER_EXECUTE:
+        case MessageType::ORDER_EXECUTE_WITH_PRICE:
+        case MessageType::TRADE: {
+            const auto& execute = static_cast<const ITCHOrderExecuteMessage&>(message);
+            orderExecute.agentId = execute.agentId;
+            orderExecute.orderId = execute.orderId;
+            orderExecute.matchOrderId = execute.matchOrderId;
+            orderExecute.fillQuantity = execute.fillQuantity;
+            if (messageType != MessageType::ORDER_EXECUTE)
+                orderExecute.fillPrice = static_cast<const ITCHOrderExecuteWithPriceMessage&>(message).fillPrice;
+            break;
+        }
+        case MessageType::ORDER_DELETE:
+        case MessageType::ORDER_CANCEL: {
+            const auto& remove = static_cast<const ITCHOrderDeleteMessage&>(message);
+            orderDelete.agentId = remove.agentId;
+            orderDelete.orderId = remove.orderId;
+            if (messageType == MessageType::ORDER_CANCEL)
+                orderDelete.cancelQuantity = static_cast<const ITCHOrderCancelMessage&>(message).cancelQuantity;
+            break;
+        }
+        case MessageType::ORDER_REPLACE: {
+            const auto& replace = static_cast<const ITCHOrderReplaceMessage&>(message);
+            orderReplace.agentId = replace.agentId;
+            orderReplace.oldOrderId = replace.oldOrderId;
+            orderReplace.newOrderId = replace.newOrderId;
+            orderReplace.quantity = replace.quantity;
+            orderReplace.price = replace.price;
+            break;
+        }
+        case MessageType::CROSS_TRADE: {
+            const auto& cross = static_cast<const ITCHCrossTradeMessage&>(message);
+            std::copy(cross.symbol, cross.symbol + 8, crossTrade.symbol);
+            crossTrade.crossQuantity = cross.crossQuantity;
+            crossTrade.crossPrice = cross.crossPrice;
+            crossTrade.crossCode = cross.crossCode;
+            break;
+        }
+        case MessageType::BROKEN_TRADE:
+            brokenTrade.tradeId = static_cast<const ITCHBrokenTradeMessage&>(message).tradeId;
+            break;
+    }
+}
+
+// the calls through the visited message are qualified, hence bound at compile time rather than through the vtable
+std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::ITCHMessageValue::makeMessage() const {
+    return visit([](const auto& message) -> std::shared_ptr<ITCHMessage> { return std::make_shared<std::decay_t<decltype(message)>>(message); });
+}
+
+bool ITCHEncoder::ITCHMessageValue::isOrderOperation() const {
+    return visit([](const auto& message) { using Message = std::decay_t<decltype(message)>; return message.Message::isOrderOperation(); });
+}
+
+std::shared_ptr<Market::OrderEventBase> ITCHEncoder::ITCHMessageValue::makeEvent() const {
+    return visit([](const auto& message) { using Message = std::decay_t<decltype(message)>; return message.Message::makeEvent(); });
+}
+
+std::optional<uint64_t> ITCHEncoder::ITCHMessageValue::getOrderId() const {
+    return visit([](const auto& message) { using Message = std::decay_t<decltype(message)>; return message.Message::getOrderId(); });
+}
+
+std::optional<uint64_t> ITCHEncoder::ITCHMessageValue::getMatchOrderId() const {
+    return visit([](const auto& message) { using Message = std::decay_t<decltype(message)>; return message.Message::getMatchOrderId(); });
+}
+
+std::string ITCHEncoder::ITCHMessageValue::toString() const {
+    return visit([](const auto& message) { using Message = std::decay_t<decltype(message)>; return message.Message::toString(); });
+}
+
+size_t ITCHEncoder::ITCHMessageValue::toBinary(uint8_t* buffer, const size_t bufferSize) const {
+    return visit([=](const auto& message) { using Message = std::decay_t<decltype(message)>; return message.Message::toBinary(buffer, bufferSize); });
+}
+
+size_t ITCHEncoder::ITCHMessageValue::getBinarySize() const {
+    return visit([](const auto& message) { return std::decay_t<decltype(message)>::ourBinarySize; });
+}
+
+size_t ITCHEncoder::encodeBinary(const std::vector<std::shared_ptr<const ITCHMessage>>& messages, uint8_t* buffer, const size_t bufferSize, size_t& numEncoded) {
+    size_t numBytes = 0;
+    numEncoded = 0;
+    for (const auto& message : messages) {
+        if (!message)
+            continue;
+        const size_t n = message->toBinary(buffer + numBytes, bufferSize - numBytes);
+        if (!n)
+            break;
+        numBytes += n;
+        ++numEncoded;
+    }
+    return numBytes;
 }
 
-std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::encodeReport(const Exchange::OrderExecutionReport& report) {
+size_t ITCHEncoder::encodeBinary(const std::vector<ITCHMessageValue>& messages, uint8_t* buffer, const size_t bufferSize, size_t& numEncoded) {
+    size_t numBytes = 0;
+    numEncoded = 0;
+    for (const auto& message : messages) {
+        const size_t n = message.toBinary(buffer + numBytes, bufferSize - numBytes);
+        if (!n)
+            break;
+        numBytes += n;
+        ++numEncoded;
+    }
+    return numBytes;
+}
+
+std::optional<ITCHEncoder::ITCHMessageValue> ITCHEncoder::encodeReportAsValue(const Exchange::OrderExecutionReport& report) {
     if (report.status != Exchange::OrderProcessingStatus::SUCCESS)
-        return nullptr;
+        return std::nullopt;
     if (report.orderType == Market::OrderType::LIMIT) {
-        return std::make_shared<ITCHOrderExecuteWithPriceMessage>(
+        return ITCHMessageValue(ITCHOrderExecuteWithPriceMessage(
             report.reportId,
             report.timestamp,
             report.agentIdHash.value_or(ITCHEncoder::DEFAULT_AGENT_ID),
@@ -212,9 +490,9 @@ std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::encodeReport(const Exchan
             report.matchOrderId,
             report.filledQuantity,
             Utils::Maths::castDoublePriceAsInt<uint32_t>(report.filledPrice)
-        );
+        ));
     } else if (report.orderType == Market::OrderType::MARKET) {
-        return std::make_shared<ITCHTradeMessage>(
+        return ITCHMessageValue(ITCHTradeMessage(
             report.reportId,
             report.timestamp,
             report.agentIdHash.value_or(ITCHEncoder::DEFAULT_AGENT_ID),
@@ -222,19 +500,19 @@ std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::encodeReport(const Exchan
             report.matchOrderId,
             report.filledQuantity,
             Utils::Maths::castDoublePriceAsInt<uint32_t>(report.filledPrice)
-        );
+        ));
     }
-    return nullptr;
+    return std::nullopt;
 }
 
-std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::encodeReport(const Exchange::LimitOrderSubmitReport& report) {
+std::optional<ITCHEncoder::ITCHMessageValue> ITCHEncoder::encodeReportAsValue(const Exchange::LimitOrderSubmitReport& report) {
     if (report.status != Exchange::OrderProcessingStatus::SUCCESS)
-        return nullptr;
+        return std::nullopt;
     const auto& order = report.order;
     if (!order)
         Utils::Error::LIB_THROW("ITCHEncoder::encodeReport: LimitOrderSubmitReport order is null");
     const auto& metaInfo = order->getMetaInfo();
-    return std::make_shared<ITCHOrderAddMessage>(
+    return ITCHMessageValue(ITCHOrderAddMessage(
         report.reportId,
         report.timestamp,
         report.agentIdHash.value_or(ITCHEncoder::DEFAULT_AGENT_ID),
@@ -243,18 +521,18 @@ std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::encodeReport(const Exchan
         order->isBuy(),
         order->getQuantity(),
         order->getIntPrice()
-    );
+    ));
 }
 
-std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::encodeReport(const Exchange::MarketOrderSubmitReport& /* report */) {
+std::optional<ITCHEncoder::ITCHMessageValue> ITCHEncoder::encodeReportAsValue(const Exchange::MarketOrderSubmitReport& /* report */) {
     // no encoding for market submit reports - relegated to execution reports
-    return nullptr;
+    return std::nullopt;
 }
 
-std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::encodeReport(const Exchange::OrderModifyPriceReport& report) {
+std::optional<ITCHEncoder::ITCHMessageValue> ITCHEncoder::encodeReportAsValue(const Exchange::OrderModifyPriceReport& report) {
     if (report.status != Exchange::OrderProcessingStatus::SUCCESS)
-        return nullptr;
-    return std::make_shared<ITCHOrderReplaceMessage>(
+        return std::nullopt;
+    return ITCHMessageValue(ITCHOrderReplaceMessage(
         report.reportId,
         report.timestamp,
         report.agentIdHash.value_or(ITCHEncoder::DEFAULT_AGENT_ID),
@@ -262,13 +540,13 @@ std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::encodeReport(const Exchan
         report.orderId,
         report.orderQuantity,
         Utils::Maths::castDoublePriceAsInt<uint32_t>(report.modifiedPrice)
-    );
+    ));
 }
 
-std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::encodeReport(const Exchange::OrderModifyQuantityReport& report) {
+std::optional<ITCHEncoder::ITCHMessageValue> ITCHEncoder::encodeReportAsValue(const Exchange::OrderModifyQuantityReport& report) {
     if (report.status != Exchange::OrderProcessingStatus::SUCCESS)
-        return nullptr;
-    return std::make_shared<ITCHOrderReplaceMessage>(
+        return std::nullopt;
+    return ITCHMessageValue(ITCHOrderReplaceMessage(
         report.reportId,
         report.timestamp,
         report.agentIdHash.value_or(ITCHEncoder::DEFAULT_AGENT_ID),
@@ -276,36 +554,36 @@ std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::encodeReport(const Exchan
         report.orderId,
         report.modifiedQuantity,
         Utils::Maths::castDoublePriceAsInt<uint32_t>(report.orderPrice)
-    );
+    ));
 }
 
-std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::encodeReport(const Exchange::OrderCancelReport& report) {
+std::optional<ITCHEncoder::ITCHMessageValue> ITCHEncoder::encodeReportAsValue(const Exchange::OrderCancelReport& report) {
     if (report.status != Exchange::OrderProcessingStatus::SUCCESS)
-        return nullptr;
-    return std::make_shared<ITCHOrderDeleteMessage>(
+        return std::nullopt;
+    return ITCHMessageValue(ITCHOrderDeleteMessage(
         report.reportId,
         report.timestamp,
         report.agentIdHash.value_or(ITCHEncoder::DEFAULT_AGENT_ID),
         report.orderId
-    );
+    ));
 }
 
-std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::encodeReport(const Exchange::OrderPartialCancelReport& report) {
+std::optional<ITCHEncoder::ITCHMessageValue> ITCHEncoder::encodeReportAsValue(const Exchange::OrderPartialCancelReport& report) {
     if (report.status != Exchange::OrderProcessingStatus::SUCCESS)
-        return nullptr;
-    return std::make_shared<ITCHOrderCancelMessage>(
+        return std::nullopt;
+    return ITCHMessageValue(ITCHOrderCancelMessage(
         report.reportId,
         report.timestamp,
         report.agentIdHash.value_or(ITCHEncoder::DEFAULT_AGENT_ID),
         report.orderId,
         report.cancelQuantity
-    );
+    ));
 }
 
-std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::encodeReport(const Exchange::OrderCancelAndReplaceReport& report) {
+std::optional<ITCHEncoder::ITCHMessageValue> ITCHEncoder::encodeReportAsValue(const Exchange::OrderCancelAndReplaceReport& report) {
     if (report.status != Exchange::OrderProcessingStatus::SUCCESS)
-        return nullptr;
-    return std::make_shared<ITCHOrderReplaceMessage>(
+        return std::nullopt;
+    return ITCHMessageValue(ITCHOrderReplaceMessage(
         report.reportId,
         report.timestamp,
         report.agentIdHash.value_or(ITCHEncoder::DEFAULT_AGENT_ID),
@@ -313,7 +591,20 @@ std::shared_ptr<ITCHEncoder::ITCHMessage> ITCHEncoder::encodeReport(const Exchan
         report.newOrderId,
         report.newQuantity,
         Utils::Maths::castDoublePriceAsInt<uint32_t>(report.newPrice)
-    );
+    ));
+}
+
+std::optional<ITCHEncoder::ITCHMessageValue> ITCHEncoder::encodeReportAsValue(const Exchange::CrossTradeReport& report) {
+    if (report.status != Exchange::OrderProcessingStatus::SUCCESS)
+        return std::nullopt;
+    return ITCHMessageValue(ITCHCrossTradeMessage(
+        report.reportId,
+        report.timestamp,
+        ITCHEncoder::DEFAULT_SYMBOL,
+        report.crossQuantity,
+        Utils::Maths::castDoublePriceAsInt<uint32_t>(report.crossPrice),
+        report.crossCode
+    ));
 }
 }
 
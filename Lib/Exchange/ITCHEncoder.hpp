@@ -12,10 +12,16 @@ struct OrderModifyQuantityReport;
 struct OrderCancelReport;
 struct OrderPartialCancelReport;
 struct OrderCancelAndReplaceReport;
+struct CrossTradeReport;
 
 struct ITCHEncoder {
     static constexpr uint64_t DEFAULT_AGENT_ID = 0;
     static constexpr char DEFAULT_SYMBOL[8] = "0000000";
+    // the ITCH 5.0 wire format - every message is framed by a 2-byte big-endian length and opens with the message type, the stock
+    // locate, the tracking number and a 48-bit timestamp
+    static constexpr size_t BINARY_LENGTH_PREFIX_SIZE = 2;
+    static constexpr size_t BINARY_HEADER_SIZE = 11;
+    static constexpr size_t MAX_BINARY_MESSAGE_SIZE = 44; // the trade message
 
     enum class EventCode { MARKET_OPEN, MARKET_CLOSE };
     enum class CrossCode { OPENING, CLOSING, HALT, IPO };
@@ -46,6 +52,11 @@ struct ITCHEncoder {
         virtual std::optional<uint64_t> getOrderId() const { return std::nullopt; }
         virtual std::optional<uint64_t> getMatchOrderId() const { return std::nullopt; }
         virtual std::string toString() const = 0;
+        /* Writes the length-prefixed big-endian ITCH 5.0 layout into the buffer and returns the number of bytes written, or 0 if the
+           buffer is too small. The stock locate is the low 16 bits of the agent id (0 where the message has none), the tracking number
+           the low 16 bits of the message id and the timestamp is cut to 48 bits. */
+        virtual size_t toBinary(uint8_t* buffer, const size_t bufferSize) const = 0;
+        virtual size_t getBinarySize() const = 0; // excludes the length prefix
         MessageType messageType;
         uint64_t messageId;
         uint64_t timestamp;
@@ -59,8 +70,11 @@ struct ITCHEncoder {
         }
         virtual ~ITCHSystemMessage() = default;
         virtual std::string toString() const override;
+        virtual size_t toBinary(uint8_t* buffer, const size_t bufferSize) const override;
+        virtual size_t getBinarySize() const override { return ourBinarySize; }
         static constexpr MessageType ourType = MessageType::SYSTEM;
         static const std::string ourDescription;
+        static constexpr size_t ourBinarySize = 12;
         EventCode eventCode;
     };
 
@@ -78,8 +92,11 @@ struct ITCHEncoder {
         virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
         virtual std::optional<uint64_t> getOrderId() const override { return orderId; }
         virtual std::string toString() const override;
+        virtual size_t toBinary(uint8_t* buffer, const size_t bufferSize) const override;
+        virtual size_t getBinarySize() const override { return ourBinarySize; }
         static constexpr MessageType ourType = MessageType::ORDER_ADD;
         static const std::string ourDescription;
+        static constexpr size_t ourBinarySize = 36;
         uint64_t agentId; // aka. stock locate
         char symbol[8];
         uint64_t orderId;
@@ -99,8 +116,11 @@ struct ITCHEncoder {
         virtual ~ITCHOrderAddWithMPIDMessage() = default;
         virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
         virtual std::string toString() const override;
+        virtual size_t toBinary(uint8_t* buffer, const size_t bufferSize) const override;
+        virtual size_t getBinarySize() const override { return ourBinarySize; }
         static constexpr MessageType ourType = MessageType::ORDER_ADD_WITH_MPID;
         static const std::string ourDescription;
+        static constexpr size_t ourBinarySize = 40;
         char mpid[4]; // market participant id, aka. attribution
     };
 
@@ -117,8 +137,11 @@ struct ITCHEncoder {
         virtual std::optional<uint64_t> getOrderId() const override { return orderId; }
         virtual std::optional<uint64_t> getMatchOrderId() const override { return matchOrderId; }
         virtual std::string toString() const override;
+        virtual size_t toBinary(uint8_t* buffer, const size_t bufferSize) const override;
+        virtual size_t getBinarySize() const override { return ourBinarySize; }
         static constexpr MessageType ourType = MessageType::ORDER_EXECUTE;
         static const std::string ourDescription;
+        static constexpr size_t ourBinarySize = 31;
         uint64_t agentId;
         uint64_t orderId;
         uint64_t matchOrderId;
@@ -135,8 +158,11 @@ struct ITCHEncoder {
         virtual ~ITCHOrderExecuteWithPriceMessage() = default;
         virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
         virtual std::string toString() const override;
+        virtual size_t toBinary(uint8_t* buffer, const size_t bufferSize) const override;
+        virtual size_t getBinarySize() const override { return ourBinarySize; }
         static constexpr MessageType ourType = MessageType::ORDER_EXECUTE_WITH_PRICE;
         static const std::string ourDescription;
+        static constexpr size_t ourBinarySize = 36;
         uint32_t fillPrice;
     };
 
@@ -151,8 +177,11 @@ struct ITCHEncoder {
         virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
         virtual std::optional<uint64_t> getOrderId() const override { return orderId; }
         virtual std::string toString() const override;
+        virtual size_t toBinary(uint8_t* buffer, const size_t bufferSize) const override;
+        virtual size_t getBinarySize() const override { return ourBinarySize; }
         static constexpr MessageType ourType = MessageType::ORDER_DELETE;
         static const std::string ourDescription;
+        static constexpr size_t ourBinarySize = 19;
         uint64_t agentId;
         uint64_t orderId;
     };
@@ -167,8 +196,11 @@ struct ITCHEncoder {
         virtual ~ITCHOrderCancelMessage() = default;
         virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
         virtual std::string toString() const override;
+        virtual size_t toBinary(uint8_t* buffer, const size_t bufferSize) const override;
+        virtual size_t getBinarySize() const override { return ourBinarySize; }
         static constexpr MessageType ourType = MessageType::ORDER_CANCEL;
         static const std::string ourDescription;
+        static constexpr size_t ourBinarySize = 23;
         uint32_t cancelQuantity;
     };
 
@@ -184,8 +216,11 @@ struct ITCHEncoder {
         virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
         virtual std::optional<uint64_t> getOrderId() const override { return oldOrderId; }
         virtual std::string toString() const override;
+        virtual size_t toBinary(uint8_t* buffer, const size_t bufferSize) const override;
+        virtual size_t getBinarySize() const override { return ourBinarySize; }
         static constexpr MessageType ourType = MessageType::ORDER_REPLACE;
         static const std::string ourDescription;
+        static constexpr size_t ourBinarySize = 35;
         uint64_t agentId;
         uint64_t oldOrderId;
         uint64_t newOrderId;
@@ -206,8 +241,11 @@ struct ITCHEncoder {
         virtual bool isOrderOperation() const override { return true; } // this message implies the market order submit event
         virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
         virtual std::string toString() const override;
+        virtual size_t toBinary(uint8_t* buffer, const size_t bufferSize) const override;
+        virtual size_t getBinarySize() const override { return ourBinarySize; }
         static constexpr MessageType ourType = MessageType::TRADE;
         static const std::string ourDescription;
+        static constexpr size_t ourBinarySize = 44;
     };
 
     /* Open/close crosses message */
@@ -220,9 +258,12 @@ struct ITCHEncoder {
             std::copy(symbol, symbol + 8, this->symbol);
         }
         virtual ~ITCHCrossTradeMessage() = default;
-        virtual std::string toString() const;
+        virtual std::string toString() const override;
+        virtual size_t toBinary(uint8_t* buffer, const size_t bufferSize) const override;
+        virtual size_t getBinarySize() const override { return ourBinarySize; }
         static constexpr MessageType ourType = MessageType::CROSS_TRADE;
         static const std::string ourDescription;
+        static constexpr size_t ourBinarySize = 40;
         char symbol[8];
         uint32_t crossQuantity;
         uint32_t crossPrice;
@@ -239,19 +280,140 @@ struct ITCHEncoder {
         virtual ~ITCHBrokenTradeMessage() = default;
         virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
         virtual std::string toString() const override;
+        virtual size_t toBinary(uint8_t* buffer, const size_t bufferSize) const override;
+        virtual size_t getBinarySize() const override { return ourBinarySize; }
         static constexpr MessageType ourType = MessageType::BROKEN_TRADE;
         static const std::string ourDescription;
+        static constexpr size_t ourBinarySize = 19;
         uint64_t tradeId;
     };
 
-    static std::shared_ptr<ITCHMessage> encodeReport(const Exchange::OrderExecutionReport& report);
-    static std::shared_ptr<ITCHMessage> encodeReport(const Exchange::LimitOrderSubmitReport& report);
-    static std::shared_ptr<ITCHMessage> encodeReport(const Exchange::MarketOrderSubmitReport& report);
-    static std::shared_ptr<ITCHMessage> encodeReport(const Exchange::OrderModifyPriceReport& report);
-    static std::shared_ptr<ITCHMessage> encodeReport(const Exchange::OrderModifyQuantityReport& report);
-    static std::shared_ptr<ITCHMessage> encodeReport(const Exchange::OrderCancelReport& report);
-    static std::shared_ptr<ITCHMessage> encodeReport(const Exchange::OrderPartialCancelReport& report);
-    static std::shared_ptr<ITCHMessage> encodeReport(const Exchange::OrderCancelAndReplaceReport& report);
+    /* The ITCH messages as one value type - a tagged union of the fixed layouts, with neither vtable nor heap object, so that a
+       message log is held contiguously at one cache line per message and processed with a switch on the type. The polymorphic
+       messages above stay as the adapters: visit builds the one of the type on the stack and calls through it non-virtually, so
+       that both forms share one implementation of each operation. */
+    struct ITCHMessageValue {
+        struct System {
+            EventCode eventCode;
+        };
+        struct OrderAdd { // A, F
+            uint64_t agentId;
+            uint64_t orderId;
+            uint32_t quantity;
+            uint32_t price;
+            char symbol[8];
+            char mpid[4]; // F only
+            bool isBuy;
+        };
+        struct OrderExecute { // E, C, P
+            uint64_t agentId;
+            uint64_t orderId;
+            uint64_t matchOrderId;
+            uint32_t fillQuantity;
+            uint32_t fillPrice; // C, P only
+        };
+        struct OrderDelete { // D, X
+            uint64_t agentId;
+            uint64_t orderId;
+            uint32_t cancelQuantity; // X only
+        };
+        struct OrderReplace {
+            uint64_t agentId;
+            uint64_t oldOrderId;
+            uint64_t newOrderId;
+            uint32_t quantity;
+            uint32_t price;
+        };
+        struct CrossTrade {
+            char symbol[8];
+            uint32_t crossQuantity;
+            uint32_t crossPrice;
+            CrossCode crossCode;
+        };
+        struct BrokenTrade {
+            uint64_t tradeId;
+        };
+
+        ITCHMessageValue() = default;
+        ITCHMessageValue(const ITCHMessage& message);
+        std::shared_ptr<ITCHMessage> makeMessage() const;
+        bool isOrderOperation() const;
+        std::shared_ptr<Market::OrderEventBase> makeEvent() const;
+        std::optional<uint64_t> getOrderId() const;
+        std::optional<uint64_t> getMatchOrderId() const;
+        std::string toString() const;
+        size_t toBinary(uint8_t* buffer, const size_t bufferSize) const;
+        size_t getBinarySize() const;
+
+        // calls the visitor with the polymorphic message of the type, a temporary on the stack
+        template<typename Visitor>
+        decltype(auto) visit(Visitor&& visitor) const {
+            switch (messageType) {
+                case MessageType::SYSTEM:
+                    return visitor(ITCHSystemMessage(messageId, timestamp, system.eventCode));
+                case MessageType::ORDER_ADD:
+                    return visitor(ITCHOrderAddMessage(messageId, timestamp, orderAdd.agentId, orderAdd.symbol, orderAdd.orderId, orderAdd.isBuy,
+                        orderAdd.quantity, orderAdd.price));
+                case MessageType::ORDER_ADD_WITH_MPID:
+                    return visitor(ITCHOrderAddWithMPIDMessage(messageId, timestamp, orderAdd.agentId, orderAdd.symbol, orderAdd.orderId, orderAdd.isBuy,
+                        orderAdd.quantity, orderAdd.price, orderAdd.mpid));
+                case MessageType::ORDER_EXECUTE:
+                    return visitor(ITCHOrderExecuteMessage(messageId, timestamp, orderExecute.agentId, orderExecute.orderId, orderExecute.matchOrderId,
+                        orderExecute.fillQuantity));
+                case MessageType::ORDER_EXECUTE_WITH_PRICE:
+                    return visitor(ITCHOrderExecuteWithPriceMessage(messageId, timestamp, orderExecute.agentId, orderExecute.orderId, orderExecute.matchOrderId,
+                        orderExecute.fillQuantity, orderExecute.fillPrice));
+                case MessageType::ORDER_DELETE:
+                    return visitor(ITCHOrderDeleteMessage(messageId, timestamp, orderDelete.agentId, orderDelete.orderId));
+                case MessageType::ORDER_CANCEL:
+                    return visitor(ITCHOrderCancelMessage(messageId, timestamp, orderDelete.agentId, orderDelete.orderId, orderDelete.cancelQuantity));
+                case MessageType::ORDER_REPLACE:
+                    return visitor(ITCHOrderReplaceMessage(messageId, timestamp, orderReplace.agentId, orderReplace.oldOrderId, orderReplace.newOrderId,
+                        orderReplace.quantity, orderReplace.price));
+                case MessageType::TRADE:
+                    return visitor(ITCHTradeMessage(messageId, timestamp, orderExecute.agentId, orderExecute.orderId, orderExecute.matchOrderId,
+                        orderExecute.fillQuantity, orderExecute.fillPrice));
+                case MessageType::CROSS_TRADE:
+                    return visitor(ITCHCrossTradeMessage(messageId, timestamp, crossTrade.symbol, crossTrade.crossQuantity, crossTrade.crossPrice,
+                        crossTrade.crossCode));
+                case MessageType::BROKEN_TRADE:
+                    break;
+            }
+            return visitor(ITCHBrokenTradeMessage(messageId, timestamp, brokenTrade.tradeId));
+        }
+
+        uint64_t messageId = 0;
+        uint64_t timestamp = 0;
+        MessageType messageType = MessageType::SYSTEM;
+        union {
+            System system;
+            OrderAdd orderAdd;
+            OrderExecute orderExecute;
+            OrderDelete orderDelete;
+            OrderReplace orderReplace;
+            CrossTrade crossTrade;
+            BrokenTrade brokenTrade;
+        };
+    };
+    static_assert(sizeof(ITCHMessageValue) == 64);
+
+    static std::optional<ITCHMessageValue> encodeReportAsValue(const Exchange::OrderExecutionReport& report);
+    static std::optional<ITCHMessageValue> encodeReportAsValue(const Exchange::LimitOrderSubmitReport& report);
+    static std::optional<ITCHMessageValue> encodeReportAsValue(const Exchange::MarketOrderSubmitReport& report);
+    static std::optional<ITCHMessageValue> encodeReportAsValue(const Exchange::OrderModifyPriceReport& report);
+    static std::optional<ITCHMessageValue> encodeReportAsValue(const Exchange::OrderModifyQuantityReport& report);
+    static std::optional<ITCHMessageValue> encodeReportAsValue(const Exchange::OrderCancelReport& report);
+    static std::optional<ITCHMessageValue> encodeReportAsValue(const Exchange::OrderPartialCancelReport& report);
+    static std::optional<ITCHMessageValue> encodeReportAsValue(const Exchange::OrderCancelAndReplaceReport& report);
+    static std::optional<ITCHMessageValue> encodeReportAsValue(const Exchange::CrossTradeReport& report);
+    template<typename Report>
+    static std::shared_ptr<ITCHMessage> encodeReport(const Report& report) {
+        const auto value = encodeReportAsValue(report);
+        return value ? value->makeMessage() : nullptr;
+    }
+    // writes the messages back to back until the buffer is full and returns the number of bytes written, null messages are skipped
+    static size_t encodeBinary(const std::vector<std::shared_ptr<const ITCHMessage>>& messages, uint8_t* buffer, const size_t bufferSize, size_t& numEncoded);
+    static size_t encodeBinary(const std::vector<ITCHMessageValue>& messages, uint8_t* buffer, const size_t bufferSize, size_t& numEncoded);
 };
 
 std::ostream& operator<<(std::ostream& out, const ITCHEncoder::ITCHMessage& message);
@@ -0,0 +1,216 @@
+#ifndef ITCH_JOURNAL_CPP
+#define ITCH_JOURNAL_CPP
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Utils/Utils.hpp"
+#include "Exchange/ITCHEncoder.hpp"
+#include "Exchange/MatchingEngine.hpp"
+#include "Exchange/ITCHJournal.hpp"
+
+namespace Exchange {
+ITCHJournalWriter::ITCHJournalWriter(const ITCHJournalConfig& config) :
+    myConfig(config) {
+    if (myConfig.filePath.empty())
+        Utils::Error::LIB_THROW("[ITCHJournalWriter] File path is empty.");
+    if (myConfig.bufferSize < ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE + ITCHEncoder::MAX_BINARY_MESSAGE_SIZE)
+        Utils::Error::LIB_THROW("[ITCHJournalWriter] Buffer size " + std::to_string(myConfig.bufferSize) + " cannot hold a message.");
+    for (auto& buffer : myBuffers)
+        buffer.data = std::make_unique<uint8_t[]>(myConfig.bufferSize);
+    openFile(0); // on the calling thread, so that a bad path throws here
+    myIOThread = std::thread([this]() { runIOThread(); });
+}
+
+ITCHJournalWriter::~ITCHJournalWriter() {
+    try {
+        close();
+    } catch (const std::exception&) {
+    }
+}
+
+uint64_t ITCHJournalWriter::getNumBytesWritten() const {
+    std::lock_guard<std::mutex> lock(myMutex);
+    return myNumBytesWritten;
+}
+
+uint64_t ITCHJournalWriter::getNumBuffersWritten() const {
+    std::lock_guard<std::mutex> lock(myMutex);
+    return myNumBuffersWritten;
+}
+
+uint64_t ITCHJournalWriter::getNumStalls() const {
+    std::lock_guard<std::mutex> lock(myMutex);
+    return myNumStalls;
+}
+
+std::vector<std::string> ITCHJournalWriter::getFilePaths() const {
+    std::lock_guard<std::mutex> lock(myMutex);
+    return myFilePaths;
+}
+
+void ITCHJournalWriter::attach(const std::shared_ptr<IMatchingEngine>& matchingEngine) {
+    if (!matchingEngine)
+        Utils::Error::LIB_THROW("[ITCHJournalWriter::attach] Matching engine is null.");
+    if (!isOpen())
+        Utils::Error::LIB_THROW("[ITCHJournalWriter::attach] Journal is closed.");
+    detach();
+    myMatchingEngine = matchingEngine;
+    mySubscriptionId = myMatchingEngine->subscribeITCHMessages([this](const std::shared_ptr<const ITCHEncoder::ITCHMessage>& message) {
+        if (message)
+            write(*message);
+    });
+}
+
+void ITCHJournalWriter::detach() {
+    if (!myMatchingEngine)
+        return;
+    if (mySubscriptionId)
+        myMatchingEngine->unsubscribe(*mySubscriptionId);
+    mySubscriptionId.reset();
+    myMatchingEngine.reset();
+}
+
+void ITCHJournalWriter::write(const ITCHEncoder::ITCHMessage& message) {
+    if (!isOpen())
+        Utils::Error::LIB_THROW("[ITCHJournalWriter::write] Journal is closed.");
+    const size_t frameSize = ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE + message.getBinarySize();
+    if (myConfig.maxFileSize > 0 && myFileBytes > 0 && myFileBytes + frameSize > myConfig.maxFileSize) {
+        submit(true);
+        myFileBytes = 0;
+    }
+    if (myBuffers[myActiveIndex].size + frameSize > myConfig.bufferSize)
+        submit(false);
+    Buffer& buffer = myBuffers[myActiveIndex];
+    buffer.size += message.toBinary(buffer.data.get() + buffer.size, myConfig.bufferSize - buffer.size);
+    myFileBytes += frameSize;
+    myNumBytesEncoded += frameSize;
+    ++myNumMessages;
+}
+
+void ITCHJournalWriter::write(const ITCHMessageLog& messageLog) {
+    for (const auto& message : messageLog)
+        if (message)
+            write(*message);
+}
+
+void ITCHJournalWriter::flush() {
+    if (!isOpen())
+        return;
+    if (myBuffers[myActiveIndex].size > 0)
+        submit(false);
+    std::unique_lock<std::mutex> lock(myMutex);
+    myCondition.wait(lock, [this]() { return myInFlight == nullptr; });
+    lock.unlock();
+    rethrowIOError();
+}
+
+void ITCHJournalWriter::close() {
+    if (!isOpen())
+        return;
+    detach();
+    std::exception_ptr error;
+    try {
+        flush();
+    } catch (...) {
+        error = std::current_exception(); // the I/O thread is stopped all the same
+    }
+    {
+        std::lock_guard<std::mutex> lock(myMutex);
+        myIsStopping = true;
+    }
+    myCondition.notify_all();
+    myIOThread.join();
+    if (!error && myConfig.syncPolicy != ITCHJournalConfig::SyncPolicy::NONE)
+        syncFile();
+    ::close(myFd);
+    myFd = -1;
+    if (error)
+        std::rethrow_exception(error);
+}
+
+std::string ITCHJournalWriter::getRotatedFilePath(const size_t fileIndex) const {
+    return fileIndex == 0 ? myConfig.filePath : myConfig.filePath + "." + std::to_string(fileIndex);
+}
+
+void ITCHJournalWriter::openFile(const size_t fileIndex) {
+    const std::string filePath = getRotatedFilePath(fileIndex);
+    myFd = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (myFd < 0)
+        Utils::Error::LIB_THROW("[ITCHJournalWriter] Cannot open file " + filePath + ": " + std::strerror(errno));
+    std::lock_guard<std::mutex> lock(myMutex);
+    myFilePaths.push_back(filePath);
+}
+
+void ITCHJournalWriter::syncFile() {
+    if (::fdatasync(myFd) != 0)
+        Utils::Error::LIB_THROW("[ITCHJournalWriter] Cannot sync file: " + std::string(std::strerror(errno)));
+}
+
+void ITCHJournalWriter::submit(const bool isRotateAfter) {
+    std::unique_lock<std::mutex> lock(myMutex);
+    if (myInFlight) {
+        ++myNumStalls;
+        myCondition.wait(lock, [this]() { return myInFlight == nullptr; });
+    }
+    Buffer& buffer = myBuffers[myActiveIndex];
+    buffer.isRotateAfter = isRotateAfter;
+    myInFlight = &buffer;
+    myActiveIndex ^= 1; // emptied by the I/O thread when it was last written
+    lock.unlock();
+    myCondition.notify_all();
+    rethrowIOError();
+}
+
+void ITCHJournalWriter::runIOThread() {
+    Utils::Concurrency::apply_thread_config(myConfig.ioThread);
+    size_t fileIndex = 0;
+    while (true) {
+        Buffer* buffer = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(myMutex);
+            myCondition.wait(lock, [this]() { return myInFlight != nullptr || myIsStopping; });
+            if (!myInFlight)
+                return;
+            buffer = myInFlight;
+        }
+        std::exception_ptr error;
+        try {
+            writeBuffer(*buffer);
+            if (myConfig.syncPolicy == ITCHJournalConfig::SyncPolicy::EVERY_BUFFER)
+                syncFile();
+            if (buffer->isRotateAfter) {
+                if (myConfig.syncPolicy != ITCHJournalConfig::SyncPolicy::NONE)
+                    syncFile();
+                ::close(myFd);
+                openFile(++fileIndex);
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        {
+            std::lock_guard<std::mutex> lock(myMutex);
+            if (error && !myIOError)
+                myIOError = error;
+            myNumBytesWritten += buffer->size;
+            ++myNumBuffersWritten;
+            buffer->size = 0;
+            buffer->isRotateAfter = false;
+            myInFlight = nullptr;
+        }
+        myCondition.notify_all();
+    }
+}
+
+void ITCHJournalWriter::writeBuffer(const Buffer& buffer) {
+    Utils::IO::writeAll(myFd, buffer.data.get(), buffer.size, myFilePaths.back()); // only the io thread appends to the paths
+}
+
+void ITCHJournalWriter::rethrowIOError() {
+    std::lock_guard<std::mutex> lock(myMutex);
+    if (myIOError)
+        std::rethrow_exception(myIOError);
+}
+}
+
+#endif
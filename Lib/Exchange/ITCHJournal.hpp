@@ -0,0 +1,97 @@
+#ifndef ITCH_JOURNAL_HPP
+#define ITCH_JOURNAL_HPP
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include "Utils/Utils.hpp"
+#include "Exchange/ITCHEncoder.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+namespace Exchange {
+struct ITCHJournalConfig {
+    enum class SyncPolicy { NONE, ON_ROTATE, EVERY_BUFFER }; // when the written bytes are forced to the disk, beyond NONE also on close
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    std::string filePath; // the first file, the n-th file rotated to has the suffix .n
+    size_t bufferSize = DEFAULT_BUFFER_SIZE; // each of the two
+    size_t maxFileSize = 0; // 0 never rotates, files are cut between messages so that each decodes on its own
+    SyncPolicy syncPolicy = SyncPolicy::ON_ROTATE;
+    Utils::Concurrency::ThreadConfig ioThread;
+};
+
+/* Records the ITCH stream of a matching engine to disk in the binary ITCH 5.0 format of ITCHEncoder::toBinary, in bounded memory.
+   Messages are encoded into the active one of two buffers on the thread that dispatches them, and a full buffer is handed to a
+   background I/O thread that writes it out with write(2) while the other one fills up. Should the writer fall a whole buffer behind,
+   the hand-off waits for it (counted as a stall) rather than allocating more. A write error on the I/O thread is rethrown on the next
+   call from the producing side. */
+class ITCHJournalWriter {
+public:
+    ITCHJournalWriter() = delete;
+    ITCHJournalWriter(const ITCHJournalConfig& config);
+    ITCHJournalWriter(const ITCHJournalWriter&) = delete; // the engine subscription is bound to this instance
+    virtual ~ITCHJournalWriter();
+
+    const ITCHJournalConfig& getConfig() const { return myConfig; }
+    std::shared_ptr<IMatchingEngine> getMatchingEngine() const { return myMatchingEngine; }
+    bool isAttached() const { return myMatchingEngine != nullptr; }
+    bool isOpen() const { return myIOThread.joinable(); }
+    uint64_t getNumMessages() const { return myNumMessages; }
+    uint64_t getNumBytesEncoded() const { return myNumBytesEncoded; }
+    uint64_t getNumBytesWritten() const;
+    uint64_t getNumBuffersWritten() const;
+    uint64_t getNumStalls() const; // hand-offs that waited for the I/O thread
+    std::vector<std::string> getFilePaths() const; // the files written so far, in order
+
+    void attach(const std::shared_ptr<IMatchingEngine>& matchingEngine);
+    void detach();
+    void write(const ITCHEncoder::ITCHMessage& message);
+    void write(const ITCHMessageLog& messageLog); // e.g. the log of an engine that ran without the journal
+    void flush(); // returns once everything written so far has reached the file
+    void close(); // detaches, flushes and syncs the last file
+
+private:
+    struct Buffer {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size = 0;
+        bool isRotateAfter = false; // the file is full once the buffer is written
+    };
+
+    std::string getRotatedFilePath(const size_t fileIndex) const;
+    void openFile(const size_t fileIndex);
+    void syncFile();
+    void submit(const bool isRotateAfter); // hands the active buffer to the I/O thread, waits while the other is in flight
+    void runIOThread();
+    void writeBuffer(const Buffer& buffer);
+    void rethrowIOError();
+
+    const ITCHJournalConfig myConfig;
+    std::shared_ptr<IMatchingEngine> myMatchingEngine;
+    std::optional<SubscriptionId> mySubscriptionId;
+    // producer side
+    std::array<Buffer, 2> myBuffers;
+    size_t myActiveIndex = 0;
+    uint64_t myFileBytes = 0; // encoded into the current file so far
+    uint64_t myNumMessages = 0;
+    uint64_t myNumBytesEncoded = 0;
+    // shared with the I/O thread
+    mutable std::mutex myMutex;
+    std::condition_variable myCondition;
+    Buffer* myInFlight = nullptr;
+    bool myIsStopping = false;
+    std::exception_ptr myIOError;
+    std::vector<std::string> myFilePaths;
+    uint64_t myNumBytesWritten = 0;
+    uint64_t myNumBuffersWritten = 0;
+    uint64_t myNumStalls = 0;
+    // I/O thread side
+    int myFd = -1;
+    std::thread myIOThread;
+};
+}
+
+template<>
+struct Utils::EnumStrings<Exchange::ITCHJournalConfig::SyncPolicy> {
+    inline static constexpr std::array<const char*, 3> names = { "NONE", "ON_ROTATE", "EVERY_BUFFER" };
+};
+
+#endif
@@ -0,0 +1,334 @@
+#ifndef ITCH_REPLAYER_CPP
+#define ITCH_REPLAYER_CPP
+#include <bit>
+#include "Utils/Utils.hpp"
+#include "Exchange/ITCHEncoder.hpp"
+#include "Exchange/ITCHDecoder.hpp"
+#include "Exchange/MatchingEngine.hpp"
+#include "Exchange/ITCHReplayer.hpp"
+
+namespace Exchange {
+void ITCHOrderReferenceTable::insert(const uint64_t orderId, const bool isBuy, const uint32_t quantity, const uint32_t price) {
+    if (!quantity) {
+        erase(orderId);
+        return;
+    }
+    if (2 * (mySize + 1) > mySlots.size())
+        rehash(2 * mySlots.size());
+    size_t slot = getSlot(orderId);
+    while (mySlots[slot].quantity && mySlots[slot].orderId != orderId)
+        slot = (slot + 1) & myMask;
+    Entry& entry = mySlots[slot];
+    if (!entry.quantity)
+        ++mySize;
+    entry.orderId = orderId;
+    entry.price = price;
+    entry.quantity = std::min<uint32_t>(quantity, (1u << 31) - 1);
+    entry.isBuy = isBuy;
+}
+
+void ITCHOrderReferenceTable::erase(const uint64_t orderId) {
+    size_t hole = getSlot(orderId);
+    for (; mySlots[hole].orderId != orderId || !mySlots[hole].quantity; hole = (hole + 1) & myMask)
+        if (!mySlots[hole].quantity)
+            return;
+    // shifts back each entry of the run that may take the hole without leaving the probe path from its home slot
+    for (size_t slot = (hole + 1) & myMask; mySlots[slot].quantity; slot = (slot + 1) & myMask) {
+        const size_t home = getSlot(mySlots[slot].orderId);
+        if (((slot - home) & myMask) >= ((slot - hole) & myMask)) {
+            mySlots[hole] = mySlots[slot];
+            hole = slot;
+        }
+    }
+    mySlots[hole].quantity = 0;
+    --mySize;
+}
+
+void ITCHOrderReferenceTable::clear() {
+    for (Entry& entry : mySlots)
+        entry.quantity = 0;
+    mySize = 0;
+}
+
+void ITCHOrderReferenceTable::reserve(const size_t numOrders) {
+    if (2 * numOrders > mySlots.size())
+        rehash(2 * numOrders);
+}
+
+void ITCHOrderReferenceTable::rehash(const size_t capacity) {
+    size_t newCapacity = 16;
+    while (newCapacity < capacity)
+        newCapacity *= 2;
+    std::vector<Entry> slots(newCapacity, Entry{0, 0, 0, 0});
+    std::swap(mySlots, slots);
+    myMask = newCapacity - 1;
+    myShift = 64 - std::countr_zero(newCapacity);
+    mySize = 0;
+    for (const Entry& entry : slots)
+        if (entry.quantity)
+            insert(entry.orderId, entry.isBuy, entry.quantity, entry.price);
+}
+
+ITCHReplayer::ITCHReplayer(const std::shared_ptr<MatchingEngineBase>& matchingEngine, const ITCHReplayConfig& config) :
+    myConfig(config),
+    myMatchingEngine(matchingEngine),
+    myPool(std::make_shared<Utils::Memory::ObjectPool>()) {
+    if (!myMatchingEngine)
+        Utils::Error::LIB_THROW("[ITCHReplayer] Matching engine is null.");
+    myOrderReferenceTable.reserve(myConfig.numOrders);
+}
+
+void ITCHReplayer::replay(const ITCHEncoder::ITCHMessage& message) {
+    replay(ITCHEncoder::ITCHMessageValue(message)); // no heap, and the one switch on the type
+}
+
+void ITCHReplayer::replay(const ITCHEncoder::ITCHMessageValue& message) {
+    using MessageType = ITCHEncoder::MessageType;
+    ++myNumMessages;
+    const uint64_t eventId = message.messageId;
+    const uint64_t timestamp = message.timestamp;
+    switch (message.messageType) {
+        case MessageType::ORDER_ADD:
+        case MessageType::ORDER_ADD_WITH_MPID: {
+            const auto& add = message.orderAdd;
+            onAdd(eventId, timestamp, add.orderId, add.isBuy, add.quantity, add.price);
+            break;
+        }
+        case MessageType::ORDER_EXECUTE: {
+            const auto& execute = message.orderExecute;
+            onExecute(eventId, timestamp, execute.orderId, execute.matchOrderId, execute.fillQuantity, std::nullopt);
+            break;
+        }
+        case MessageType::ORDER_EXECUTE_WITH_PRICE: {
+            const auto& execute = message.orderExecute;
+            onExecute(eventId, timestamp, execute.orderId, execute.matchOrderId, execute.fillQuantity, execute.fillPrice);
+            break;
+        }
+        case MessageType::TRADE: {
+            const auto& trade = message.orderExecute;
+            onTrade(eventId, timestamp, trade.orderId, trade.matchOrderId, true /* as toBinary writes it */, trade.fillQuantity, trade.fillPrice);
+            break;
+        }
+        case MessageType::ORDER_DELETE:
+            onDelete(eventId, timestamp, message.orderDelete.orderId);
+            break;
+        case MessageType::ORDER_CANCEL:
+            onCancel(eventId, timestamp, message.orderDelete.orderId, message.orderDelete.cancelQuantity);
+            break;
+        case MessageType::ORDER_REPLACE: {
+            const auto& replace = message.orderReplace;
+            onReplace(eventId, timestamp, replace.oldOrderId, replace.newOrderId, replace.quantity, replace.price);
+            break;
+        }
+        case MessageType::BROKEN_TRADE:
+            onBrokenTrade(eventId, timestamp, message.brokenTrade.tradeId);
+            break;
+        default: // the system and cross messages leave the book alone
+            break;
+    }
+}
+
+void ITCHReplayer::replay(const ITCHMessageLog& messageLog) {
+    myExecutionLog.reserve(myExecutionLog.size() + (myConfig.isLogExecutions ? messageLog.size() / 4 : 0));
+    for (const auto& message : messageLog)
+        if (message)
+            replay(*message);
+}
+
+void ITCHReplayer::replay(const ITCHMessageValueLog& messageValueLog) {
+    myExecutionLog.reserve(myExecutionLog.size() + (myConfig.isLogExecutions ? messageValueLog.size() / 4 : 0));
+    for (const auto& message : messageValueLog)
+        replay(message);
+}
+
+uint64_t ITCHReplayer::replayBinary(const std::vector<std::span<const uint8_t>>& chunks) {
+    ITCHDecoder::BinaryStreamDecoder decoder;
+    auto replayView = [&](const auto& message) {
+        using View = std::decay_t<decltype(message)>;
+        ++myNumMessages;
+        const uint64_t eventId = decoder.getNumDecoded(); // the tracking number only keeps 16 bits of the message id
+        const uint64_t timestamp = message.getTimestamp();
+        if constexpr (std::is_base_of_v<ITCHDecoder::ITCHOrderAddView, View>)
+            onAdd(eventId, timestamp, message.getOrderId(), message.isBuy(), message.getQuantity(), message.getPrice());
+        else if constexpr (std::is_same_v<ITCHDecoder::ITCHOrderExecuteView, View>)
+            onExecute(eventId, timestamp, message.getOrderId(), message.getMatchNumber(), message.getFillQuantity(), std::nullopt);
+        else if constexpr (std::is_same_v<ITCHDecoder::ITCHOrderExecuteWithPriceView, View>)
+            onExecute(eventId, timestamp, message.getOrderId(), message.getMatchNumber(), message.getFillQuantity(), message.getFillPrice());
+        else if constexpr (std::is_same_v<ITCHDecoder::ITCHTradeView, View>)
+            onTrade(eventId, timestamp, message.getOrderId(), message.getMatchNumber(), message.isBuy(), message.getFillQuantity(), message.getFillPrice());
+        else if constexpr (std::is_same_v<ITCHDecoder::ITCHOrderDeleteView, View>)
+            onDelete(eventId, timestamp, message.getOrderId());
+        else if constexpr (std::is_same_v<ITCHDecoder::ITCHOrderCancelView, View>)
+            onCancel(eventId, timestamp, message.getOrderId(), message.getCancelQuantity());
+        else if constexpr (std::is_same_v<ITCHDecoder::ITCHOrderReplaceView, View>)
+            onReplace(eventId, timestamp, message.getOldOrderId(), message.getNewOrderId(), message.getQuantity(), message.getPrice());
+        else if constexpr (std::is_same_v<ITCHDecoder::ITCHBrokenTradeView, View>)
+            onBrokenTrade(eventId, timestamp, message.getMatchNumber());
+    };
+    for (const auto& chunk : chunks)
+        decoder.decode(chunk.data(), chunk.size(), replayView);
+    if (decoder.hasPartialFrame())
+        Utils::Error::LIB_THROW("[ITCHReplayer::replayBinary] The binary ITCH stream ends in the middle of a frame.");
+    return decoder.getNumDecoded();
+}
+
+uint64_t ITCHReplayer::replayBinaryFile(const std::string& filePath) {
+    const Utils::IO::MappedFile file(filePath);
+    return replayBinary({std::span<const uint8_t>(file.getData(), file.getSize())});
+}
+
+void ITCHReplayer::reset() {
+    myOrderReferenceTable.clear();
+    myExecutionLog.clear();
+    myLastMatch = {};
+    myNumMessages = myNumEvents = myNumUnknownOrders = 0;
+    myNumExecutions.fill(0);
+}
+
+void ITCHReplayer::onAdd(const uint64_t eventId, const uint64_t timestamp, const uint64_t orderId, const bool isBuy, const uint32_t quantity, const uint32_t price) {
+    myOrderReferenceTable.insert(orderId, isBuy, quantity, price);
+    const auto order = Utils::Memory::makePooledShared<Market::LimitOrder>(myPool, orderId, timestamp, isBuy ? Market::Side::BUY : Market::Side::SELL,
+        quantity, Utils::Maths::castIntPriceAsDouble(price));
+    process(Utils::Memory::makePooledShared<Market::OrderSubmitEvent>(myPool, eventId, orderId, timestamp, order));
+}
+
+void ITCHReplayer::onExecute(const uint64_t eventId, const uint64_t timestamp, const uint64_t orderId, const uint64_t matchNumber, const uint32_t quantity,
+    const std::optional<uint32_t> price) {
+    ITCHOrderReferenceTable::Entry* entry = myOrderReferenceTable.find(orderId);
+    if (isOtherHalf(orderId, matchNumber, quantity)) {
+        if (entry)
+            fill(*entry, quantity);
+        return;
+    }
+    if (!entry) {
+        ++myNumUnknownOrders;
+        return;
+    }
+    const ITCHOrderReferenceTable::Entry resting = *entry;
+    // the engine is ahead of the table where replaying the order that caused the fill has already made it
+    const ITCHExecution::Resolution resolution = getEngineQuantity(orderId) < resting.quantity ?
+        ITCHExecution::Resolution::IMPLIED : execute(eventId, timestamp, orderId, matchNumber, resting, quantity);
+    fill(*entry, quantity); // the engine leaves the table alone
+    myLastMatch = {orderId, matchNumber, quantity};
+    logExecution({timestamp, orderId, matchNumber, quantity, price.value_or(resting.price), static_cast<bool>(resting.isBuy), resolution});
+}
+
+void ITCHReplayer::onTrade(const uint64_t eventId, const uint64_t timestamp, const uint64_t orderId, const uint64_t matchNumber, const bool isBuy,
+    const uint32_t quantity, const uint32_t price) {
+    if (isOtherHalf(orderId, matchNumber, quantity)) {
+        if (ITCHOrderReferenceTable::Entry* entry = myOrderReferenceTable.find(orderId))
+            fill(*entry, quantity);
+        return;
+    }
+    const ITCHOrderReferenceTable::Entry* resting = myConfig.source == ITCHReplayConfig::Source::ENGINE ? myOrderReferenceTable.find(matchNumber) : nullptr;
+    if (!resting) {
+        logExecution({timestamp, orderId, matchNumber, quantity, price, isBuy, ITCHExecution::Resolution::OFF_BOOK});
+        return;
+    }
+    // the resting order is filled in the table by its own execution message, the other half
+    const ITCHOrderReferenceTable::Entry entry = *resting;
+    const ITCHExecution::Resolution resolution = getEngineQuantity(matchNumber) < entry.quantity ?
+        ITCHExecution::Resolution::IMPLIED : execute(eventId, timestamp, matchNumber, orderId, entry, quantity);
+    myLastMatch = {orderId, matchNumber, quantity};
+    logExecution({timestamp, matchNumber, orderId, quantity, price, static_cast<bool>(entry.isBuy), resolution});
+}
+
+void ITCHReplayer::onCancel(const uint64_t eventId, const uint64_t timestamp, const uint64_t orderId, const uint32_t quantity) {
+    ITCHOrderReferenceTable::Entry* entry = myOrderReferenceTable.find(orderId);
+    if (!entry) {
+        ++myNumUnknownOrders;
+        return;
+    }
+    if (quantity >= entry->quantity)
+        process(Utils::Memory::makePooledShared<Market::OrderCancelEvent>(myPool, eventId, orderId, timestamp));
+    else
+        process(Utils::Memory::makePooledShared<Market::OrderPartialCancelEvent>(myPool, eventId, orderId, timestamp, quantity));
+    fill(*entry, quantity);
+}
+
+void ITCHReplayer::onDelete(const uint64_t eventId, const uint64_t timestamp, const uint64_t orderId) {
+    if (!myOrderReferenceTable.find(orderId)) {
+        ++myNumUnknownOrders;
+        return;
+    }
+    process(Utils::Memory::makePooledShared<Market::OrderCancelEvent>(myPool, eventId, orderId, timestamp));
+    myOrderReferenceTable.erase(orderId);
+}
+
+void ITCHReplayer::onReplace(const uint64_t eventId, const uint64_t timestamp, const uint64_t oldOrderId, const uint64_t newOrderId, const uint32_t quantity,
+    const uint32_t price) {
+    const ITCHOrderReferenceTable::Entry* entry = myOrderReferenceTable.find(oldOrderId);
+    if (!entry) {
+        ++myNumUnknownOrders;
+        return;
+    }
+    const bool isBuy = entry->isBuy; // the replacement keeps the side, which the message leaves out
+    process(Utils::Memory::makePooledShared<Market::OrderCancelAndReplaceEvent>(myPool, eventId, oldOrderId, timestamp, newOrderId, quantity,
+        Utils::Maths::castIntPriceAsDouble(price)));
+    myOrderReferenceTable.erase(oldOrderId);
+    myOrderReferenceTable.insert(newOrderId, isBuy, quantity, price);
+}
+
+void ITCHReplayer::onBrokenTrade(const uint64_t eventId, const uint64_t timestamp, const uint64_t matchNumber) {
+    process(Utils::Memory::makePooledShared<Market::BrokenTradeEvent>(myPool, eventId, 0 /* orderId */, timestamp, matchNumber));
+}
+
+ITCHExecution::Resolution ITCHReplayer::execute(const uint64_t eventId, const uint64_t timestamp, const uint64_t orderId, const uint64_t takerId,
+    const ITCHOrderReferenceTable::Entry& entry, const uint32_t quantity) {
+    const uint32_t engineQuantity = getEngineQuantity(orderId);
+    if (quantity <= engineQuantity && isTopOfBook(orderId, entry.isBuy)) {
+        const auto order = Utils::Memory::makePooledShared<Market::MarketOrder>(myPool, takerId, timestamp, entry.isBuy ? Market::Side::SELL : Market::Side::BUY, quantity);
+        process(Utils::Memory::makePooledShared<Market::OrderSubmitEvent>(myPool, eventId, takerId, timestamp, order));
+        return ITCHExecution::Resolution::MARKET_ORDER;
+    }
+    if (quantity >= engineQuantity)
+        process(Utils::Memory::makePooledShared<Market::OrderCancelEvent>(myPool, eventId, orderId, timestamp));
+    else
+        process(Utils::Memory::makePooledShared<Market::OrderPartialCancelEvent>(myPool, eventId, orderId, timestamp, quantity));
+    return ITCHExecution::Resolution::CANCEL;
+}
+
+bool ITCHReplayer::isOtherHalf(const uint64_t orderId, const uint64_t matchNumber, const uint32_t quantity) {
+    // ITCHEncoder reports both orders of a fill one after the other, each naming the other - a venue reports a fill once
+    if (myConfig.source != ITCHReplayConfig::Source::ENGINE)
+        return false;
+    const bool isOtherHalf = orderId == myLastMatch.matchOrderId && matchNumber == myLastMatch.orderId && quantity == myLastMatch.quantity;
+    if (isOtherHalf)
+        myLastMatch = {};
+    return isOtherHalf;
+}
+
+void ITCHReplayer::fill(ITCHOrderReferenceTable::Entry& entry, const uint32_t quantity) {
+    if (quantity >= entry.quantity)
+        myOrderReferenceTable.erase(entry.orderId);
+    else
+        entry.quantity -= quantity;
+}
+
+void ITCHReplayer::logExecution(const ITCHExecution& execution) {
+    ++myNumExecutions[static_cast<size_t>(execution.resolution)];
+    if (myConfig.isLogExecutions)
+        myExecutionLog.push_back(execution);
+}
+
+uint32_t ITCHReplayer::getEngineQuantity(const uint64_t orderId) const {
+    const OrderIndex& lookup = myMatchingEngine->getLimitOrderLookup();
+    const auto it = lookup.find(orderId);
+    return it == lookup.end() ? 0 : (*it->second.second)->getQuantity();
+}
+
+bool ITCHReplayer::isTopOfBook(const uint64_t orderId, const bool isBuy) const {
+    // reads through the top-of-book accessor rather than the book itself, which holds only the materialized levels of a fork
+    const auto topOrder = isBuy ? myMatchingEngine->getBestBidTopOrder() : myMatchingEngine->getBestAskTopOrder();
+    return topOrder.second && topOrder.second->getId() == orderId;
+}
+
+void ITCHReplayer::process(const std::shared_ptr<const Market::OrderEventBase>& event) {
+    ++myNumEvents;
+    if (myMatchingEngine->isDebugMode())
+        *myMatchingEngine->getLogger() << Utils::Logger::LogLevel::DEBUG << "[ITCHReplayer] Processing order event: " << *event;
+    myMatchingEngine->process(event);
+}
+}
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef ITCH_REPLAYER_HPP
+#define ITCH_REPLAYER_HPP
+#include "Utils/Utils.hpp"
+#include "Exchange/ITCHEncoder.hpp"
+#include "Exchange/ITCHDecoder.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+namespace Exchange {
+/* The open orders of an ITCH stream by order reference number - the side, the price in integer ticks and the shares left - in a
+   flat open-addressing table with linear probing. Slots are 16 bytes, erased with a backward shift so that no tombstones build up,
+   and the table doubles past half full. The quantity is kept in 31 bits, a slot with none left being empty. */
+class ITCHOrderReferenceTable {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 10;
+
+    struct Entry {
+        uint64_t orderId;
+        uint32_t price; // double price x 10000
+        uint32_t quantity : 31;
+        uint32_t isBuy : 1;
+    };
+
+    ITCHOrderReferenceTable(const size_t capacity = DEFAULT_CAPACITY) { rehash(capacity); }
+
+    size_t size() const { return mySize; }
+    size_t capacity() const { return mySlots.size(); }
+    bool empty() const { return mySize == 0; }
+
+    Entry* find(const uint64_t orderId) {
+        for (size_t slot = getSlot(orderId); ; slot = (slot + 1) & myMask) {
+            Entry& entry = mySlots[slot];
+            if (!entry.quantity)
+                return nullptr;
+            if (entry.orderId == orderId)
+                return &entry;
+        }
+    }
+    const Entry* find(const uint64_t orderId) const { return const_cast<ITCHOrderReferenceTable*>(this)->find(orderId); }
+
+    void insert(const uint64_t orderId, const bool isBuy, const uint32_t quantity, const uint32_t price); // overwrites, erases on no quantity
+    void erase(const uint64_t orderId);
+    void clear();
+    void reserve(const size_t numOrders); // room for as many orders without a rehash
+
+    template<typename Visitor>
+    void forEach(Visitor&& visitor) const {
+        for (const Entry& entry : mySlots)
+            if (entry.quantity)
+                visitor(entry);
+    }
+
+private:
+    size_t getSlot(const uint64_t orderId) const { return (orderId * 0x9E3779B97F4A7C15ull) >> myShift; } // Fibonacci hashing
+    void rehash(const size_t capacity);
+
+    std::vector<Entry> mySlots;
+    size_t myMask = 0;
+    int myShift = 64;
+    size_t mySize = 0;
+};
+
+struct ITCHReplayConfig {
+    /* ENGINE reads ITCH as ITCHEncoder writes it - a fill is reported on both of its orders, the match number naming the other one,
+       and a trade message stands for the market order that took out the resting order it names. VENUE reads ITCH as an exchange
+       publishes it - a fill is reported once, on the resting order, and a trade message is the execution of a non-displayed order,
+       off the book. */
+    enum class Source { ENGINE, VENUE };
+
+    Source source = Source::ENGINE;
+    size_t numOrders = ITCHOrderReferenceTable::DEFAULT_CAPACITY / 2; // the open orders the table is sized for up front
+    bool isLogExecutions = true;
+};
+
+/* A fill reconstructed from an execution or trade message, with the side and price of the resting order looked up where the message
+   leaves them out. How it reached the book: IMPLIED if the engine had already matched it in replaying the order that caused it,
+   MARKET_ORDER if it was replayed as a market order against the order at the top of the book, CANCEL if the order was elsewhere in
+   its queue and the shares were taken off it instead, and OFF_BOOK for a trade of no resting order. */
+struct ITCHExecution {
+    enum class Resolution { IMPLIED, MARKET_ORDER, CANCEL, OFF_BOOK };
+    uint64_t timestamp;
+    uint64_t orderId; // the order of the first report of the fill, the resting one for a trade message
+    uint64_t matchNumber; // the other order in an ENGINE stream
+    uint32_t quantity;
+    uint32_t price;
+    bool isBuy; // the side of the order
+    Resolution resolution;
+};
+
+using ITCHExecutionLog = std::vector<ITCHExecution>;
+
+/* Replays an ITCH stream through a matching engine at O(1) per message. The adds, deletes, cancels and replaces become the order
+   events of ITCHMessage::makeEvent, while the executions and trades, which refer to the orders by reference number only, are
+   resolved against the order reference table into market orders, or cancels where a market order would not hit the same order.
+   Each execution is checked against the engine first, so that the fills the engine already made in replaying a crossing order are
+   not made twice. Events are allocated from a pool of the replayer. The call auction is not replayed - the ITCH stream does not
+   open it - so a stream with a cross replays its orders continuously. */
+class ITCHReplayer {
+public:
+    ITCHReplayer() = delete;
+    ITCHReplayer(const std::shared_ptr<MatchingEngineBase>& matchingEngine, const ITCHReplayConfig& config = {});
+    ITCHReplayer(const ITCHReplayer&) = delete;
+    virtual ~ITCHReplayer() = default;
+
+    const ITCHReplayConfig& getConfig() const { return myConfig; }
+    std::shared_ptr<MatchingEngineBase> getMatchingEngine() const { return myMatchingEngine; }
+    const ITCHOrderReferenceTable& getOrderReferenceTable() const { return myOrderReferenceTable; }
+    const ITCHExecutionLog& getExecutionLog() const { return myExecutionLog; }
+    uint64_t getNumMessages() const { return myNumMessages; }
+    uint64_t getNumEvents() const { return myNumEvents; } // processed by the engine
+    uint64_t getNumExecutions(const ITCHExecution::Resolution resolution) const { return myNumExecutions[static_cast<size_t>(resolution)]; }
+    uint64_t getNumUnknownOrders() const { return myNumUnknownOrders; } // messages skipped for an order reference never added
+
+    void replay(const ITCHEncoder::ITCHMessage& message);
+    void replay(const ITCHEncoder::ITCHMessageValue& message);
+    void replay(const ITCHMessageLog& messageLog);
+    void replay(const ITCHMessageValueLog& messageValueLog);
+    // decodes in place as MatchingEngineBase::buildFromITCHBinary does, returns the number of messages decoded
+    uint64_t replayBinary(const std::vector<std::span<const uint8_t>>& chunks);
+    uint64_t replayBinaryFile(const std::string& filePath);
+    void reset(); // clears the table, the log and the counters, not the engine
+
+private:
+    struct Match { // the last fill, whose other half may follow
+        uint64_t orderId = 0;
+        uint64_t matchOrderId = 0;
+        uint32_t quantity = 0;
+    };
+
+    void onAdd(const uint64_t eventId, const uint64_t timestamp, const uint64_t orderId, const bool isBuy, const uint32_t quantity, const uint32_t price);
+    void onExecute(const uint64_t eventId, const uint64_t timestamp, const uint64_t orderId, const uint64_t matchNumber, const uint32_t quantity,
+        const std::optional<uint32_t> price);
+    void onTrade(const uint64_t eventId, const uint64_t timestamp, const uint64_t orderId, const uint64_t matchNumber, const bool isBuy,
+        const uint32_t quantity, const uint32_t price);
+    void onCancel(const uint64_t eventId, const uint64_t timestamp, const uint64_t orderId, const uint32_t quantity);
+    void onDelete(const uint64_t eventId, const uint64_t timestamp, const uint64_t orderId);
+    void onReplace(const uint64_t eventId, const uint64_t timestamp, const uint64_t oldOrderId, const uint64_t newOrderId, const uint32_t quantity,
+        const uint32_t price);
+    void onBrokenTrade(const uint64_t eventId, const uint64_t timestamp, const uint64_t matchNumber);
+    // fills the resting order, by a market order of the takerId if it tops its side of the book and by a cancel otherwise
+    ITCHExecution::Resolution execute(const uint64_t eventId, const uint64_t timestamp, const uint64_t orderId, const uint64_t takerId,
+        const ITCHOrderReferenceTable::Entry& entry, const uint32_t quantity);
+    bool isOtherHalf(const uint64_t orderId, const uint64_t matchNumber, const uint32_t quantity);
+    void fill(ITCHOrderReferenceTable::Entry& entry, const uint32_t quantity); // takes the shares off the table entry
+    void logExecution(const ITCHExecution& execution);
+    uint32_t getEngineQuantity(const uint64_t orderId) const;
+    bool isTopOfBook(const uint64_t orderId, const bool isBuy) const;
+    void process(const std::shared_ptr<const Market::OrderEventBase>& event);
+
+    const ITCHReplayConfig myConfig;
+    std::shared_ptr<MatchingEngineBase> myMatchingEngine;
+    std::shared_ptr<Utils::Memory::ObjectPool> myPool;
+    ITCHOrderReferenceTable myOrderReferenceTable;
+    ITCHExecutionLog myExecutionLog;
+    Match myLastMatch;
+    uint64_t myNumMessages = 0;
+    uint64_t myNumEvents = 0;
+    std::array<uint64_t, 4> myNumExecutions{};
+    uint64_t myNumUnknownOrders = 0;
+};
+}
+
+template<>
+struct Utils::EnumStrings<Exchange::ITCHReplayConfig::Source> {
+    inline static constexpr std::array<const char*, 2> names = { "ENGINE", "VENUE" };
+};
+
+template<>
+struct Utils::EnumStrings<Exchange::ITCHExecution::Resolution> {
+    inline static constexpr std::array<const char*, 4> names = { "IMPLIED", "MARKET_ORDER", "CANCEL", "OFF_BOOK" };
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef MARKET_DATA_FEED_CPP
+#define MARKET_DATA_FEED_CPP
+#include "Utils/Utils.hpp"
+#include "Exchange/MatchingEngineUtils.hpp"
+#include "Exchange/MatchingEngine.hpp"
+#include "Exchange/MarketDataFeed.hpp"
+
+namespace Exchange {
+using Utils::operator<<;
+
+SharedMemoryMarketDataPublisher::SharedMemoryMarketDataPublisher(const std::string& name, const size_t capacity) :
+    myRing(name, capacity) {}
+
+SharedMemoryMarketDataPublisher::~SharedMemoryMarketDataPublisher() {
+    detach();
+}
+
+void SharedMemoryMarketDataPublisher::attach(const std::shared_ptr<IMatchingEngine>& matchingEngine) {
+    if (!matchingEngine)
+        Utils::Error::LIB_THROW("[SharedMemoryMarketDataPublisher::attach] Matching engine is null.");
+    detach();
+    myMatchingEngine = matchingEngine;
+    // the report of an entry is dispatched before its delta, so the deltas are stamped with the time of their report
+    mySubscriptionIds.push_back(myMatchingEngine->subscribeOrderProcessingReports(
+        [this](const std::shared_ptr<const OrderProcessingReport>& report) { onOrderProcessingReport(report); },
+        OrderProcessingReportFilter::allExcept({OrderProcessingType::NONE})));
+    mySubscriptionIds.push_back(myMatchingEngine->subscribeOrderBookDeltas(
+        [this](const std::shared_ptr<const OrderBookSizeDelta>& delta) { onOrderBookDelta(delta); }));
+}
+
+void SharedMemoryMarketDataPublisher::detach() {
+    if (!myMatchingEngine)
+        return;
+    for (const auto id : mySubscriptionIds)
+        myMatchingEngine->unsubscribe(id);
+    mySubscriptionIds.clear();
+    myMatchingEngine.reset();
+}
+
+uint64_t SharedMemoryMarketDataPublisher::publish(MarketDataRecord record) {
+    record.sequence = myRing.published() + 1;
+    return myRing.publish(record);
+}
+
+void SharedMemoryMarketDataPublisher::onOrderProcessingReport(const std::shared_ptr<const OrderProcessingReport>& report) {
+    if (!report)
+        return;
+    myLastTimestamp = report->timestamp;
+    if (report->orderProcessingType != OrderProcessingType::EXECUTE)
+        return;
+    const auto& execution = static_cast<const OrderExecutionReport&>(*report);
+    if (!execution.isMakerOrder || execution.status != OrderProcessingStatus::SUCCESS)
+        return;
+    publish({0, execution.timestamp, execution.reportId, execution.orderId, execution.matchOrderId,
+        Utils::Maths::castDoublePriceAsInt<int64_t>(execution.filledPrice), execution.filledQuantity,
+        MarketDataRecord::RecordType::TRADE, execution.orderSide, OrderBookSizeDelta::DeltaType::NONE, false});
+}
+
+void SharedMemoryMarketDataPublisher::onOrderBookDelta(const std::shared_ptr<const OrderBookSizeDelta>& delta) {
+    if (!delta || delta->type == OrderBookSizeDelta::DeltaType::NONE)
+        return;
+    publish({0, myLastTimestamp, delta->reportId, delta->orderId, 0,
+        Utils::Maths::castDoublePriceAsInt<int64_t>(delta->price), delta->sizeDelta,
+        MarketDataRecord::RecordType::BOOK_DELTA, delta->side, delta->type, delta->isLastInBatch});
+}
+
+size_t SharedMemoryMarketDataReader::drain(std::vector<MarketDataRecord>& records) {
+    size_t numOverruns = 0;
+    MarketDataRecord record;
+    while (true) {
+        const auto status = poll(record);
+        if (status == Utils::Concurrency::ShmReadStatus::EMPTY)
+            return numOverruns;
+        if (status == Utils::Concurrency::ShmReadStatus::OVERRUN)
+            ++numOverruns;
+        else
+            records.push_back(record);
+    }
+}
+
+std::ostream& operator<<(std::ostream& out, const MarketDataRecord& record) {
+    out << record.sequence << "|" << record.recordType << "|" << record.reportId << "|" << record.orderId << "|" << record.side << "|";
+    if (record.recordType == MarketDataRecord::RecordType::BOOK_DELTA)
+        out << (record.deltaType == OrderBookSizeDelta::DeltaType::ADD ? "+" : "-") << record.size;
+    else
+        out << record.size << "|" << record.matchOrderId;
+    return out << "|" << std::fixed << std::setprecision(2) << Utils::Maths::castIntPriceAsDouble(record.price)
+        << (record.isLastInBatch ? "|last" : "");
+}
+}
+
+#endif
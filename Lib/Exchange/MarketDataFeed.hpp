@@ -0,0 +1,89 @@
+#ifndef MARKET_DATA_FEED_HPP
+#define MARKET_DATA_FEED_HPP
+#include "Utils/Utils.hpp"
+#include "Utils/SharedMemoryUtils.hpp"
+#include "Exchange/MatchingEngineUtils.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+namespace Exchange {
+/* A compact fixed-size record of the engine output for out-of-process consumers: a book size delta (enough to rebuild the L2 book)
+   or a trade, the latter sent once per match from the maker side. Prices are in integer ticks of 1/10000 as in the ITCH messages. */
+struct MarketDataRecord {
+    enum class RecordType : uint8_t { BOOK_DELTA, TRADE };
+    uint64_t sequence;  // numbered by the feed from 1, gapless as published
+    uint64_t timestamp; // of the last report seen, coalesced deltas carry that of the event they net
+    uint64_t reportId;
+    uint64_t orderId;
+    uint64_t matchOrderId; // taker order id of a trade
+    int64_t price;
+    uint32_t size; // size delta or fill quantity
+    RecordType recordType;
+    Market::Side side;
+    OrderBookSizeDelta::DeltaType deltaType;
+    bool isLastInBatch;
+};
+
+/* Publishes the book deltas and trades of a matching engine into a POSIX shared-memory broadcast ring, that any number of processes
+   follow with a SharedMemoryMarketDataReader. The records are written from wherever the engine runs its subscriptions, which is the
+   consumer thread for the SPSC and disruptor engines, and the writer never waits for the readers. */
+class SharedMemoryMarketDataPublisher {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+
+    SharedMemoryMarketDataPublisher() = delete;
+    SharedMemoryMarketDataPublisher(const std::string& name, const size_t capacity = DEFAULT_CAPACITY);
+    SharedMemoryMarketDataPublisher(const SharedMemoryMarketDataPublisher&) = delete; // the engine subscriptions are bound to this instance
+    virtual ~SharedMemoryMarketDataPublisher();
+
+    const std::string& getName() const { return myRing.name(); }
+    size_t getCapacity() const { return myRing.capacity(); }
+    uint64_t getNumPublished() const { return myRing.published(); }
+    std::shared_ptr<IMatchingEngine> getMatchingEngine() const { return myMatchingEngine; }
+    bool isAttached() const { return myMatchingEngine != nullptr; }
+
+    void attach(const std::shared_ptr<IMatchingEngine>& matchingEngine);
+    void detach();
+    uint64_t publish(MarketDataRecord record); // numbers the record and returns its sequence
+
+private:
+    void onOrderProcessingReport(const std::shared_ptr<const OrderProcessingReport>& report);
+    void onOrderBookDelta(const std::shared_ptr<const OrderBookSizeDelta>& delta);
+
+    Utils::Concurrency::ShmBroadcastRingWriter<MarketDataRecord> myRing;
+    std::shared_ptr<IMatchingEngine> myMatchingEngine;
+    std::vector<SubscriptionId> mySubscriptionIds;
+    uint64_t myLastTimestamp = 0;
+};
+
+/* Follows a shared-memory market data feed from its oldest retained record. A reader lapped by the publisher gets OVERRUN once,
+   with the number of records lost added up in getNumMissedRecords, and then carries on from the oldest record still in the ring -
+   a consumer rebuilding the book should then resynchronize from a snapshot. */
+class SharedMemoryMarketDataReader {
+public:
+    SharedMemoryMarketDataReader() = delete;
+    SharedMemoryMarketDataReader(const std::string& name) : myRing(name) {}
+
+    const std::string& getName() const { return myRing.name(); }
+    size_t getCapacity() const { return myRing.capacity(); }
+    uint64_t getNextSequence() const { return myRing.next_sequence(); }
+    uint64_t getNumPublished() const { return myRing.published(); }
+    uint64_t getLag() const { return myRing.lag(); }
+    uint64_t getNumOverruns() const { return myRing.num_overruns(); }
+    uint64_t getNumMissedRecords() const { return myRing.num_missed(); }
+
+    Utils::Concurrency::ShmReadStatus poll(MarketDataRecord& record) { return myRing.poll(record); }
+    size_t drain(std::vector<MarketDataRecord>& records); // appends whatever is readable now, returns the number of overruns met
+
+private:
+    Utils::Concurrency::ShmBroadcastRingReader<MarketDataRecord> myRing;
+};
+
+std::ostream& operator<<(std::ostream& out, const MarketDataRecord& record);
+}
+
+template<>
+struct Utils::EnumStrings<Exchange::MarketDataRecord::RecordType> {
+    inline static constexpr std::array<const char*, 2> names = { "BOOK_DELTA", "TRADE" };
+};
+
+#endif
@@ -13,6 +13,24 @@ std::ostream& operator<<(std::ostream& out, const IMatchingEngine& matchingEngin
     return matchingEngine.orderBookSnapshot(out);
 }
 
+OrderProcessingReportFilter::OrderProcessingReportFilter(const std::initializer_list<OrderProcessingType>& types, const std::optional<Market::Side>& side) :
+    typeMask(0), side(side) {
+    for (const auto type : types)
+        typeMask |= 1u << static_cast<uint32_t>(type);
+}
+
+OrderProcessingReportFilter OrderProcessingReportFilter::allExcept(const std::initializer_list<OrderProcessingType>& types, const std::optional<Market::Side>& side) {
+    OrderProcessingReportFilter filter(types, side);
+    filter.typeMask = ~filter.typeMask;
+    return filter;
+}
+
+bool OrderProcessingReportFilter::accepts(const OrderProcessingReport* report) const {
+    if (!acceptsType(report ? report->orderProcessingType : OrderProcessingType::NONE))
+        return false;
+    return !side || (report && report->orderSide == *side);
+}
+
 IMatchingEngine::IMatchingEngine(const IMatchingEngine& matchingEngine) :
     mySymbol(matchingEngine.mySymbol),
     myExchangeId(matchingEngine.myExchangeId),
@@ -49,7 +67,18 @@ MatchingEngineBase::MatchingEngineBase(const MatchingEngineBase& matchingEngine)
     myOrderProcessingReportLog(matchingEngine.myOrderProcessingReportLog),
     myOrderBookSizeDeltaLog(matchingEngine.myOrderBookSizeDeltaLog),
     myITCHMessageLog(matchingEngine.myITCHMessageLog),
-    myRemovedLimitOrderLog(matchingEngine.myRemovedLimitOrderLog) {
+    myITCHMessageValueLog(matchingEngine.myITCHMessageValueLog),
+    myRemovedLimitOrderLog(matchingEngine.myRemovedLimitOrderLog),
+    myBidPriceLadder(matchingEngine.myBidPriceLadder),
+    myAskPriceLadder(matchingEngine.myAskPriceLadder),
+    myBookStateHash(matchingEngine.myBookStateHash),
+    myForkParent(matchingEngine.myForkParent),
+    myForkParentBookStateHash(matchingEngine.myForkParentBookStateHash),
+    myMaterializedBidLevels(matchingEngine.myMaterializedBidLevels),
+    myMaterializedAskLevels(matchingEngine.myMaterializedAskLevels),
+    myAuctionCrossCode(matchingEngine.myAuctionCrossCode),
+    myCoalesceBookDeltas(matchingEngine.myCoalesceBookDeltas),
+    myCompactITCHMessageLog(matchingEngine.myCompactITCHMessageLog) {
     *getLogger() << Utils::Logger::LogLevel::INFO << "[MatchingEngineBase] Copy constructor leaves out the order processing callback - re-establish it if needed.";
     // construct myLimitOrderLookup by traversing each individual order in the bid and ask books
     for (auto& priceQueuePair : myBidBook) {
@@ -70,6 +99,36 @@ MatchingEngineBase::MatchingEngineBase(const MatchingEngineBase& matchingEngine)
             ++it;
         }
     }
+    setTopOfBookSnapshotLevels(matchingEngine.myTopOfBookSnapshotLevels); // readers of the original are not handed the copy
+    init();
+}
+
+MatchingEngineBase::MatchingEngineBase(const MatchingEngineBase& parent, const bool includeLogs) :
+    IMatchingEngine(parent),
+    myBidBookSize(parent.myBidBookSize),
+    myAskBookSize(parent.myAskBookSize),
+    myBidPriceLadder(parent.myBidPriceLadder),
+    myAskPriceLadder(parent.myAskPriceLadder),
+    myBookStateHash(parent.myBookStateHash),
+    myForkParent(&parent),
+    myForkParentBookStateHash(parent.myBookStateHash),
+    myAuctionCrossCode(parent.myAuctionCrossCode),
+    myCoalesceBookDeltas(parent.myCoalesceBookDeltas),
+    myCompactITCHMessageLog(parent.myCompactITCHMessageLog) {
+    // the queues and lookup are left empty - levels are copied over from the parent upon first touch
+    for (const auto& order : parent.myMarketQueue)
+        myMarketQueue.push_back(order->copy(myReportPool));
+    if (includeLogs) {
+        myTradeLog = parent.myTradeLog;
+        myOrderEventLog = parent.myOrderEventLog;
+        myOrderProcessingReportLog = parent.myOrderProcessingReportLog;
+        myOrderBookSizeDeltaLog = parent.myOrderBookSizeDeltaLog;
+        myOrderEventLatencyLog = parent.myOrderEventLatencyLog;
+        myITCHMessageLog = parent.myITCHMessageLog;
+        myITCHMessageValueLog = parent.myITCHMessageValueLog;
+        myRemovedLimitOrderLog = parent.myRemovedLimitOrderLog;
+    }
+    setTopOfBookSnapshotLevels(parent.myTopOfBookSnapshotLevels);
     init();
 }
 
@@ -92,13 +151,13 @@ MatchingEngineBase::MatchingEngineBase(const OrderProcessingReportLog& orderProc
 
 DescOrderBook MatchingEngineBase::getBidBook(const size_t numLevels) const {
     DescOrderBook bidBook;
-    if (numLevels == 0 || myBidBook.empty())
+    if (numLevels == 0 || myBidBookSize.empty())
         return bidBook;
     size_t levels = 0;
-    for (const auto& priceQueuePair : myBidBook) {
+    for (const auto& priceSizePair : myBidBookSize) {
         if (levels >= numLevels)
             break;
-        bidBook.insert(priceQueuePair);
+        bidBook.insert({priceSizePair.first, *findLimitQueue(Market::Side::BUY, priceSizePair.first)});
         ++levels;
     }
     return bidBook;
@@ -106,13 +165,13 @@ DescOrderBook MatchingEngineBase::getBidBook(const size_t numLevels) const {
 
 AscOrderBook MatchingEngineBase::getAskBook(const size_t numLevels) const {
     AscOrderBook askBook;
-    if (numLevels == 0 || myAskBook.empty())
+    if (numLevels == 0 || myAskBookSize.empty())
         return askBook;
     size_t levels = 0;
-    for (const auto& priceQueuePair : myAskBook) {
+    for (const auto& priceSizePair : myAskBookSize) {
         if (levels >= numLevels)
             break;
-        askBook.insert(priceQueuePair);
+        askBook.insert({priceSizePair.first, *findLimitQueue(Market::Side::SELL, priceSizePair.first)});
         ++levels;
     }
     return askBook;
@@ -282,9 +341,8 @@ std::vector<uint32_t> MatchingEngineBase::getAskBookSizeVector(const size_t numL
 
 std::vector<uint64_t> MatchingEngineBase::getBidOrderIdsAt(const PriceLevel price, const std::optional<uint32_t>& totalSize) const {
     std::vector<uint64_t> orderIds;
-    const auto it = myBidBook.find(price);
-    if (it != myBidBook.end()) {
-        const LimitQueue& limitQueue = it->second;
+    if (const LimitQueue* queue = findLimitQueue(Market::Side::BUY, price)) {
+        const LimitQueue& limitQueue = *queue;
         if (totalSize.has_value()) {
             uint32_t cumSize = 0;
             for (const auto& order : limitQueue) {
@@ -303,9 +361,8 @@ std::vector<uint64_t> MatchingEngineBase::getBidOrderIdsAt(const PriceLevel pric
 
 std::vector<uint64_t> MatchingEngineBase::getAskOrderIdsAt(const PriceLevel price, const std::optional<uint32_t>& totalSize) const {
     std::vector<uint64_t> orderIds;
-    const auto it = myAskBook.find(price);
-    if (it != myAskBook.end()) {
-        const LimitQueue& limitQueue = it->second;
+    if (const LimitQueue* queue = findLimitQueue(Market::Side::SELL, price)) {
+        const LimitQueue& limitQueue = *queue;
         if (totalSize.has_value()) {
             uint32_t cumSize = 0;
             for (const auto& order : limitQueue) {
@@ -335,17 +392,17 @@ std::pair<const PriceLevel, uint32_t> MatchingEngineBase::getBestAskPriceAndSize
 }
 
 std::pair<const PriceLevel, const std::shared_ptr<const Market::LimitOrder>> MatchingEngineBase::getBestBidTopOrder() const {
-    if (myBidBook.empty())
+    if (myBidBookSize.empty())
         return {Utils::Consts::NAN_DOUBLE, nullptr};
-    const auto& it = myBidBook.begin();
-    return {it->first, it->second.front()};
+    const PriceLevel price = myBidBookSize.begin()->first;
+    return {price, findLimitQueue(Market::Side::BUY, price)->front()};
 }
 
 std::pair<const PriceLevel, const std::shared_ptr<const Market::LimitOrder>> MatchingEngineBase::getBestAskTopOrder() const {
-    if (myAskBook.empty())
+    if (myAskBookSize.empty())
         return {Utils::Consts::NAN_DOUBLE, nullptr};
-    const auto& it = myAskBook.begin();
-    return {it->first, it->second.front()};
+    const PriceLevel price = myAskBookSize.begin()->first;
+    return {price, findLimitQueue(Market::Side::SELL, price)->front()};
 }
 
 BestBidAsk MatchingEngineBase::getBestBidAsk() const {
@@ -380,8 +437,14 @@ double MatchingEngineBase::getBidPriceAtLevel(const size_t level) const {
         *getLogger() << Utils::Logger::LogLevel::WARNING << "[MatchingEngineBase::getBidPriceAtLevel] Invalid level: " << level;
         return Utils::Consts::NAN_DOUBLE;
     }
-    auto it = myBidBookSize.begin();
-    std::advance(it, level);
+    // the ladder counts levels up from the lowest price, then walks the few levels sharing the tick (off-tick prices)
+    const double tick = myBidPriceLadder.getPriceTick();
+    const long long levelTick = myBidPriceLadder.findTickOfNthLevel(myBidBookSize.size() - level);
+    const size_t numLevelsAbove = myBidBookSize.size() - myBidPriceLadder.getNumLevelsBelowTick(levelTick) - myBidPriceLadder.getNumLevelsAt(levelTick);
+    auto it = myBidBookSize.lower_bound((levelTick + 0.5) * tick);
+    while (it != myBidBookSize.end() && myBidPriceLadder.getTick(it->first) > levelTick)
+        ++it;
+    std::advance(it, level - numLevelsAbove);
     return it->first;
 }
 
@@ -390,11 +453,47 @@ double MatchingEngineBase::getAskPriceAtLevel(const size_t level) const {
         *getLogger() << Utils::Logger::LogLevel::WARNING << "[MatchingEngineBase::getAskPriceAtLevel] Invalid level: " << level;
         return Utils::Consts::NAN_DOUBLE;
     }
-    auto it = myAskBookSize.begin();
-    std::advance(it, level);
+    const double tick = myAskPriceLadder.getPriceTick();
+    const long long levelTick = myAskPriceLadder.findTickOfNthLevel(level + 1);
+    const size_t numLevelsBelow = myAskPriceLadder.getNumLevelsBelowTick(levelTick);
+    auto it = myAskBookSize.lower_bound((levelTick - 0.5) * tick);
+    while (it != myAskBookSize.end() && myAskPriceLadder.getTick(it->first) < levelTick)
+        ++it;
+    std::advance(it, level - numLevelsBelow);
     return it->first;
 }
 
+double MatchingEngineBase::getBidPriceToFill(const uint32_t quantity) const {
+    if (quantity == 0 || quantity > myBidPriceLadder.getTotalSize())
+        return Utils::Consts::NAN_DOUBLE;
+    // the quantity is walked down from the best bid, i.e. it ends at the n-th unit counting up from the lowest price
+    const double tick = myBidPriceLadder.getPriceTick();
+    const uint64_t totalSize = myBidPriceLadder.getTotalSize();
+    const long long fillTick = myBidPriceLadder.findTickOfNthUnit(totalSize - quantity + 1);
+    const uint64_t sizeAbove = totalSize - myBidPriceLadder.getSizeBelowTick(fillTick) - myBidPriceLadder.getSizeAt(fillTick);
+    uint64_t remainingQuantity = quantity - sizeAbove;
+    auto it = myBidBookSize.lower_bound((fillTick + 0.5) * tick);
+    while (it != myBidBookSize.end() && myBidPriceLadder.getTick(it->first) > fillTick)
+        ++it;
+    for (; it != myBidBookSize.end() && it->second < remainingQuantity; ++it)
+        remainingQuantity -= it->second;
+    return it != myBidBookSize.end() ? it->first : Utils::Consts::NAN_DOUBLE;
+}
+
+double MatchingEngineBase::getAskPriceToFill(const uint32_t quantity) const {
+    if (quantity == 0 || quantity > myAskPriceLadder.getTotalSize())
+        return Utils::Consts::NAN_DOUBLE;
+    const double tick = myAskPriceLadder.getPriceTick();
+    const long long fillTick = myAskPriceLadder.findTickOfNthUnit(quantity);
+    uint64_t remainingQuantity = quantity - myAskPriceLadder.getSizeBelowTick(fillTick);
+    auto it = myAskBookSize.lower_bound((fillTick - 0.5) * tick);
+    while (it != myAskBookSize.end() && myAskPriceLadder.getTick(it->first) < fillTick)
+        ++it;
+    for (; it != myAskBookSize.end() && it->second < remainingQuantity; ++it)
+        remainingQuantity -= it->second;
+    return it != myAskBookSize.end() ? it->first : Utils::Consts::NAN_DOUBLE;
+}
+
 double MatchingEngineBase::getSpread() const {
     return getBestAskPrice() - getBestBidPrice();
 }
@@ -449,18 +548,66 @@ uint32_t MatchingEngineBase::getLastTradeSize() const {
     return lastTrade ? lastTrade->getQuantity() : 0;
 }
 
+uint32_t MatchingEngineBase::getBidDepthWithinTicks(const uint32_t numTicks) const {
+    if (myBidBookSize.empty())
+        return 0;
+    const long long bestTick = myBidPriceLadder.getTick(myBidBookSize.begin()->first);
+    return static_cast<uint32_t>(myBidPriceLadder.getSizeInTickRange(bestTick - numTicks, bestTick));
+}
+
+uint32_t MatchingEngineBase::getAskDepthWithinTicks(const uint32_t numTicks) const {
+    if (myAskBookSize.empty())
+        return 0;
+    const long long bestTick = myAskPriceLadder.getTick(myAskBookSize.begin()->first);
+    return static_cast<uint32_t>(myAskPriceLadder.getSizeInTickRange(bestTick, bestTick + numTicks));
+}
+
+uint32_t MatchingEngineBase::getBidDepthInRange(const PriceLevel priceFrom, const PriceLevel priceTo) const {
+    return static_cast<uint32_t>(myBidPriceLadder.getSizeInTickRange(myBidPriceLadder.getTick(priceFrom), myBidPriceLadder.getTick(priceTo)));
+}
+
+uint32_t MatchingEngineBase::getAskDepthInRange(const PriceLevel priceFrom, const PriceLevel priceTo) const {
+    return static_cast<uint32_t>(myAskPriceLadder.getSizeInTickRange(myAskPriceLadder.getTick(priceFrom), myAskPriceLadder.getTick(priceTo)));
+}
+
 size_t MatchingEngineBase::getNumberOfBidPriceLevels() const {
-    return myBidBook.size();
+    return myBidBookSize.size();
 }
 
 size_t MatchingEngineBase::getNumberOfAskPriceLevels() const {
-    return myAskBook.size();
+    return myAskBookSize.size();
 }
 
 size_t MatchingEngineBase::getNumberOfTrades() const {
     return myTradeLog.size();
 }
 
+uint64_t MatchingEngineBase::getBookStateHash() const {
+    return myBookStateHash;
+}
+
+uint64_t MatchingEngineBase::computeBookStateHash() const {
+    uint64_t hash = 0;
+    for (const auto& priceSizePair : myBidBookSize)
+        if (const LimitQueue* limitQueue = findLimitQueue(Market::Side::BUY, priceSizePair.first))
+            for (const auto& order : *limitQueue)
+                hash ^= hashRestingOrder(order->getSide(), priceSizePair.first, order->getId(), order->getQuantity());
+    for (const auto& priceSizePair : myAskBookSize)
+        if (const LimitQueue* limitQueue = findLimitQueue(Market::Side::SELL, priceSizePair.first))
+            for (const auto& order : *limitQueue)
+                hash ^= hashRestingOrder(order->getSide(), priceSizePair.first, order->getId(), order->getQuantity());
+    return hash;
+}
+
+uint64_t MatchingEngineBase::hashRestingOrder(const Market::Side side, const PriceLevel price, const uint64_t orderId, const uint32_t quantity) {
+    // hash on the integer price so that prices equal up to floating point noise hash to the same value
+    uint64_t hash = Utils::Maths::mixHash64(orderId);
+    hash = Utils::Maths::combineHash64(hash, static_cast<uint64_t>(side));
+    hash = Utils::Maths::combineHash64(hash, Utils::Maths::castDoublePriceAsInt<uint64_t>(price));
+    hash = Utils::Maths::combineHash64(hash, quantity);
+    return hash;
+}
+
 std::optional<bool> MatchingEngineBase::getLastTradeIsBuyInitiated() const {
     const auto& lastTrade = getLastTrade();
     return lastTrade ? std::optional<bool>(lastTrade->getIsBuyInitiated()) : std::nullopt;
@@ -472,12 +619,83 @@ std::shared_ptr<const Market::TradeBase> MatchingEngineBase::getLastTrade() cons
     return myTradeLog.back();
 }
 
+const LimitQueue* MatchingEngineBase::findLimitQueue(const Market::Side side, const PriceLevel price) const {
+    if (!isLevelMaterialized(side, price))
+        return myForkParent->findLimitQueue(side, price);
+    if (side == Market::Side::BUY) {
+        const auto it = myBidBook.find(price);
+        return it != myBidBook.end() ? &it->second : nullptr;
+    }
+    const auto it = myAskBook.find(price);
+    return it != myAskBook.end() ? &it->second : nullptr;
+}
+
+std::shared_ptr<const Market::LimitOrder> MatchingEngineBase::findLimitOrder(const uint64_t orderId) const {
+    const auto it = myLimitOrderLookup.find(orderId);
+    if (it != myLimitOrderLookup.end())
+        return *it->second.second;
+    if (!myForkParent)
+        return nullptr;
+    // a parent order only survives in the fork as long as the fork has not taken over its level
+    const auto order = myForkParent->findLimitOrder(orderId);
+    return order && !isLevelMaterialized(order->getSide(), order->getPrice()) ? order : nullptr;
+}
+
+bool MatchingEngineBase::isLevelMaterialized(const Market::Side side, const PriceLevel price) const {
+    if (!myForkParent)
+        return true;
+    const auto& materializedLevels = side == Market::Side::BUY ? myMaterializedBidLevels : myMaterializedAskLevels;
+    return materializedLevels.find(Utils::Maths::castDoublePriceAsInt<int64_t>(price)) != materializedLevels.end();
+}
+
+void MatchingEngineBase::materializeLevel(const Market::Side side, const PriceLevel price) {
+    if (!myForkParent)
+        return;
+    auto& materializedLevels = side == Market::Side::BUY ? myMaterializedBidLevels : myMaterializedAskLevels;
+    if (!materializedLevels.insert(Utils::Maths::castDoublePriceAsInt<int64_t>(price)).second)
+        return;
+    if (myForkParent->getBookStateHash() != myForkParentBookStateHash)
+        Utils::Error::LIB_THROW("[MatchingEngineBase::materializeLevel] Fork parent book has changed since the fork was taken.");
+    const LimitQueue* parentQueue = myForkParent->findLimitQueue(side, price);
+    if (!parentQueue)
+        return;
+    LimitQueue& limitQueue = side == Market::Side::BUY ? myBidBook[price] : myAskBook[price];
+    for (const auto& order : *parentQueue) {
+        limitQueue.push_back(order->copy(myReportPool)); // deep copy so that fills and events in the fork never leak into the parent
+        myLimitOrderLookup[order->getId()] = {&limitQueue, std::prev(limitQueue.end())};
+    }
+}
+
+uint64_t MatchingEngineBase::getFillableQuantity(const Market::Side side, const PriceLevel price) const {
+    uint64_t fillableQuantity = 0;
+    for (const auto& marketOrder : myMarketQueue) // the queued market orders are matched first
+        if (marketOrder->getSide() != side)
+            fillableQuantity += marketOrder->getQuantity();
+    // the ladder sums the opposite levels strictly better than the limit tick, then the few levels sharing the tick are walked
+    if (side == Market::Side::BUY) {
+        const long long limitTick = myAskPriceLadder.getTick(price);
+        fillableQuantity += myAskPriceLadder.getSizeBelowTick(limitTick);
+        for (auto it = myAskBookSize.lower_bound((limitTick - 0.5) * myAskPriceLadder.getPriceTick()); it != myAskBookSize.end() && it->first <= price; ++it)
+            if (myAskPriceLadder.getTick(it->first) == limitTick)
+                fillableQuantity += it->second;
+    } else if (side == Market::Side::SELL) {
+        const long long limitTick = myBidPriceLadder.getTick(price);
+        fillableQuantity += myBidPriceLadder.getTotalSize() - myBidPriceLadder.getSizeBelowTick(limitTick) - myBidPriceLadder.getSizeAt(limitTick);
+        for (auto it = myBidBookSize.lower_bound((limitTick + 0.5) * myBidPriceLadder.getPriceTick()); it != myBidBookSize.end() && it->first >= price; ++it)
+            if (myBidPriceLadder.getTick(it->first) == limitTick)
+                fillableQuantity += it->second;
+    }
+    return fillableQuantity;
+}
+
 void MatchingEngineBase::process(const std::shared_ptr<const Market::OrderBase>& order) {
     if (!order) {
         *getLogger() << Utils::Logger::LogLevel::WARNING << "[MatchingEngineBase::process] Order is null.";
         return;
     }
     order->submit(*this); // relegate the order processing to OrderBase since it knows about the order type
+    flushCoalescedBookDeltas();
+    publishTopOfBookSnapshot();
 }
 
 void MatchingEngineBase::process(const std::shared_ptr<const Market::OrderEventBase>& event) {
@@ -491,11 +709,17 @@ void MatchingEngineBase::process(const std::shared_ptr<const Market::OrderEventB
     if (event->isSubmit()) {
         process(event->getOrder());
         auto end = std::chrono::high_resolution_clock::now();
-        logOrderEventLatency({ std::make_shared<OrderEventLatency>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), event) });
+        logOrderEventLatency({ Utils::Memory::makePooledShared<OrderEventLatency>(myReportPool, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), event) });
         return;
     }
     // limit order events handling
-    const auto& it = myLimitOrderLookup.find(event->getOrderId());
+    auto it = myLimitOrderLookup.find(event->getOrderId());
+    if (it == myLimitOrderLookup.end() && isFork()) { // the order may still rest in a level owned by the parent
+        if (const auto order = findLimitOrder(event->getOrderId())) {
+            materializeLevel(order->getSide(), order->getPrice());
+            it = myLimitOrderLookup.find(event->getOrderId());
+        }
+    }
     if (it != myLimitOrderLookup.end()) {
         auto& queueOrderPair = it->second;
         auto& queue = queueOrderPair.first;
@@ -507,18 +731,26 @@ void MatchingEngineBase::process(const std::shared_ptr<const Market::OrderEventB
         const uint32_t oldQuantity = order->getQuantity();
         order->executeOrderEvent(*event);
         order->setTimestamp(clockTick());
+        toggleBookStateHash(side, oldPrice, oldId, oldQuantity);
         if (order->isAlive()) { // order event is not a cancellation
             const uint64_t newId = order->getId();
             const double newPrice = order->getPrice();
             const uint32_t newQuantity = order->getQuantity();
+            toggleBookStateHash(side, newPrice, newId, newQuantity);
+            if (isFork() && !isLevelMaterialized(side, newPrice)) {
+                materializeLevel(side, newPrice);
+                it = myLimitOrderLookup.find(oldId); // lookup insertions may rehash and invalidate the iterator
+            }
             queue->erase(orderIt);
             LimitQueue& newQueue = order->isBuy() ? myBidBook[newPrice] : myAskBook[newPrice];
             newQueue.push_back(order);
             if (order->isBuy()) {
                 uint32_t& bidBookSizeAtNewPrice = myBidBookSize[newPrice];
                 uint32_t& bidBookSizeAtOldPrice = myBidBookSize[oldPrice];
+                updatePriceLadder(side, newPrice, newQuantity, bidBookSizeAtNewPrice == 0 ? 1 : 0);
                 bidBookSizeAtNewPrice += newQuantity;
                 bidBookSizeAtOldPrice -= oldQuantity;
+                updatePriceLadder(side, oldPrice, -static_cast<int64_t>(oldQuantity), bidBookSizeAtOldPrice == 0 ? -1 : 0);
                 if (bidBookSizeAtOldPrice == 0) {
                     myBidBookSize.erase(oldPrice);
                     myBidBook.erase(oldPrice);
@@ -526,8 +758,10 @@ void MatchingEngineBase::process(const std::shared_ptr<const Market::OrderEventB
             } else {
                 uint32_t& askBookSizeAtNewPrice = myAskBookSize[newPrice];
                 uint32_t& askBookSizeAtOldPrice = myAskBookSize[oldPrice];
+                updatePriceLadder(side, newPrice, newQuantity, askBookSizeAtNewPrice == 0 ? 1 : 0);
                 askBookSizeAtNewPrice += newQuantity;
                 askBookSizeAtOldPrice -= oldQuantity;
+                updatePriceLadder(side, oldPrice, -static_cast<int64_t>(oldQuantity), askBookSizeAtOldPrice == 0 ? -1 : 0);
                 if (askBookSizeAtOldPrice == 0) {
                     myAskBookSize.erase(oldPrice);
                     myAskBook.erase(oldPrice);
@@ -539,14 +773,14 @@ void MatchingEngineBase::process(const std::shared_ptr<const Market::OrderEventB
                 const uint64_t reportId = generateReportId();
                 logOrderProcessingReport({
                     generateOrderBookDeltaId(),
-                    std::make_shared<OrderCancelAndReplaceReport>(reportId, clockTick(), oldId, side, Market::OrderType::LIMIT, newId, newQuantity, newPrice, OrderProcessingStatus::SUCCESS),
-                    std::make_shared<OrderBookSizeDelta>(reportId, oldId, side, oldPrice, OrderBookSizeDelta::DeltaType::REMOVE, oldQuantity), // cancel
+                    Utils::Memory::makePooledShared<OrderCancelAndReplaceReport>(myReportPool, reportId, clockTick(), oldId, side, Market::OrderType::LIMIT, newId, newQuantity, newPrice, OrderProcessingStatus::SUCCESS),
+                    Utils::Memory::makePooledShared<OrderBookSizeDelta>(myReportPool, reportId, oldId, side, oldPrice, OrderBookSizeDelta::DeltaType::REMOVE, oldQuantity), // cancel
                     BestBidAsk({ false })
                 });
                 logOrderProcessingReport({
                     generateOrderBookDeltaId(),
                     nullptr /* report */,
-                    std::make_shared<OrderBookSizeDelta>(reportId, newId, side, newPrice, OrderBookSizeDelta::DeltaType::ADD, newQuantity), // replace
+                    Utils::Memory::makePooledShared<OrderBookSizeDelta>(myReportPool, reportId, newId, side, newPrice, OrderBookSizeDelta::DeltaType::ADD, newQuantity), // replace
                     getBestBidAsk()
                 });
             } else { // order price/quantity (only one of them!) gets modified
@@ -557,28 +791,28 @@ void MatchingEngineBase::process(const std::shared_ptr<const Market::OrderEventB
                 if (newPrice != oldPrice)
                     logOrderProcessingReport({
                         generateOrderBookDeltaId(),
-                        std::make_shared<OrderModifyPriceReport>(reportId, clockTick(), oldId, side, oldQuantity, newPrice, OrderProcessingStatus::SUCCESS),
-                        std::make_shared<OrderBookSizeDelta>(reportId, oldId, side, oldPrice, OrderBookSizeDelta::DeltaType::REMOVE, oldQuantity), // cancel
+                        Utils::Memory::makePooledShared<OrderModifyPriceReport>(myReportPool, reportId, clockTick(), oldId, side, oldQuantity, newPrice, OrderProcessingStatus::SUCCESS),
+                        Utils::Memory::makePooledShared<OrderBookSizeDelta>(myReportPool, reportId, oldId, side, oldPrice, OrderBookSizeDelta::DeltaType::REMOVE, oldQuantity), // cancel
                         BestBidAsk({ false })
                     });
                 else if (newQuantity < oldQuantity)
                     logOrderProcessingReport({
                         generateOrderBookDeltaId(),
-                        std::make_shared<OrderPartialCancelReport>(reportId, clockTick(), oldId, side, Market::OrderType::LIMIT, oldQuantity, oldPrice, oldQuantity - newQuantity, OrderProcessingStatus::SUCCESS),
-                        std::make_shared<OrderBookSizeDelta>(reportId, oldId, side, oldPrice, OrderBookSizeDelta::DeltaType::REMOVE, oldQuantity), // cancel
+                        Utils::Memory::makePooledShared<OrderPartialCancelReport>(myReportPool, reportId, clockTick(), oldId, side, Market::OrderType::LIMIT, oldQuantity, oldPrice, oldQuantity - newQuantity, OrderProcessingStatus::SUCCESS),
+                        Utils::Memory::makePooledShared<OrderBookSizeDelta>(myReportPool, reportId, oldId, side, oldPrice, OrderBookSizeDelta::DeltaType::REMOVE, oldQuantity), // cancel
                         BestBidAsk({ false })
                     });
                 else if (newQuantity > oldQuantity)
                     logOrderProcessingReport({
                         generateOrderBookDeltaId(),
-                        std::make_shared<OrderModifyQuantityReport>(reportId, clockTick(), oldId, side, oldPrice, newQuantity, OrderProcessingStatus::SUCCESS),
-                        std::make_shared<OrderBookSizeDelta>(reportId, oldId, side, oldPrice, OrderBookSizeDelta::DeltaType::REMOVE, oldQuantity), // cancel
+                        Utils::Memory::makePooledShared<OrderModifyQuantityReport>(myReportPool, reportId, clockTick(), oldId, side, oldPrice, newQuantity, OrderProcessingStatus::SUCCESS),
+                        Utils::Memory::makePooledShared<OrderBookSizeDelta>(myReportPool, reportId, oldId, side, oldPrice, OrderBookSizeDelta::DeltaType::REMOVE, oldQuantity), // cancel
                         BestBidAsk({ false })
                     });
                 logOrderProcessingReport({
                     generateOrderBookDeltaId(),
                     nullptr /* report */,
-                    std::make_shared<OrderBookSizeDelta>(reportId, oldId, side, newPrice, OrderBookSizeDelta::DeltaType::ADD, newQuantity), // replace
+                    Utils::Memory::makePooledShared<OrderBookSizeDelta>(myReportPool, reportId, oldId, side, newPrice, OrderBookSizeDelta::DeltaType::ADD, newQuantity), // replace
                     getBestBidAsk()
                 });
             }
@@ -589,6 +823,7 @@ void MatchingEngineBase::process(const std::shared_ptr<const Market::OrderEventB
             if (order->isBuy()) {
                 uint32_t& bidBookSizeAtOldPrice = myBidBookSize[oldPrice];
                 bidBookSizeAtOldPrice -= oldQuantity;
+                updatePriceLadder(side, oldPrice, -static_cast<int64_t>(oldQuantity), bidBookSizeAtOldPrice == 0 ? -1 : 0);
                 if (bidBookSizeAtOldPrice == 0) {
                     myBidBookSize.erase(oldPrice);
                     myBidBook.erase(oldPrice);
@@ -596,6 +831,7 @@ void MatchingEngineBase::process(const std::shared_ptr<const Market::OrderEventB
             } else {
                 uint32_t& askBookSizeAtOldPrice = myAskBookSize[oldPrice];
                 askBookSizeAtOldPrice -= oldQuantity;
+                updatePriceLadder(side, oldPrice, -static_cast<int64_t>(oldQuantity), askBookSizeAtOldPrice == 0 ? -1 : 0);
                 if (askBookSizeAtOldPrice == 0) {
                     myAskBookSize.erase(oldPrice);
                     myAskBook.erase(oldPrice);
@@ -604,15 +840,17 @@ void MatchingEngineBase::process(const std::shared_ptr<const Market::OrderEventB
             const uint64_t reportId = generateReportId();
             logOrderProcessingReport({
                 generateOrderBookDeltaId(),
-                std::make_shared<OrderCancelReport>(reportId, clockTick(), oldId, side, Market::OrderType::LIMIT, oldQuantity, oldPrice, OrderProcessingStatus::SUCCESS),
-                std::make_shared<OrderBookSizeDelta>(reportId, oldId, side, oldPrice, OrderBookSizeDelta::DeltaType::REMOVE, oldQuantity),
+                Utils::Memory::makePooledShared<OrderCancelReport>(myReportPool, reportId, clockTick(), oldId, side, Market::OrderType::LIMIT, oldQuantity, oldPrice, OrderProcessingStatus::SUCCESS),
+                Utils::Memory::makePooledShared<OrderBookSizeDelta>(myReportPool, reportId, oldId, side, oldPrice, OrderBookSizeDelta::DeltaType::REMOVE, oldQuantity),
                 getBestBidAsk()
             });
         }
     }
     // TODO: market order events handling
+    flushCoalescedBookDeltas();
+    publishTopOfBookSnapshot();
     auto end = std::chrono::high_resolution_clock::now();
-    logOrderEventLatency({ std::make_shared<OrderEventLatency>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), event) });
+    logOrderEventLatency({ Utils::Memory::makePooledShared<OrderEventLatency>(myReportPool, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), event) });
 }
 
 void MatchingEngineBase::build(const OrderEventLog& orderEventLog) {
@@ -642,25 +880,73 @@ void MatchingEngineBase::build(const ITCHMessageLog& itchMessageLog) {
     }
 }
 
+void MatchingEngineBase::build(const ITCHMessageValueLog& itchMessageValueLog) {
+    for (const auto& message : itchMessageValueLog) {
+        if (isDebugMode())
+            *getLogger() << Utils::Logger::LogLevel::DEBUG << "[MatchingEngineBase] Processing ITCH message: " << message.toString();
+        process(message.makeEvent());
+    }
+}
+
+uint64_t MatchingEngineBase::buildFromITCHBinary(const std::vector<std::span<const uint8_t>>& chunks) {
+    // the events and orders come out of a pool instead of one heap allocation each, the messages are never built at all
+    const auto pool = std::make_shared<Utils::Memory::ObjectPool>();
+    ITCHDecoder::BinaryStreamDecoder decoder;
+    auto replay = [&](const auto& message) {
+        using View = std::decay_t<decltype(message)>;
+        const uint64_t eventId = decoder.getNumDecoded(); // the tracking number only keeps 16 bits of the message id
+        const uint64_t timestamp = message.getTimestamp();
+        std::shared_ptr<Market::OrderEventBase> event;
+        if constexpr (std::is_base_of_v<ITCHDecoder::ITCHOrderAddView, View>) {
+            const auto order = Utils::Memory::makePooledShared<Market::LimitOrder>(pool, message.getOrderId(), timestamp,
+                message.isBuy() ? Market::Side::BUY : Market::Side::SELL, message.getQuantity(), Utils::Maths::castIntPriceAsDouble(message.getPrice()));
+            event = Utils::Memory::makePooledShared<Market::OrderSubmitEvent>(pool, eventId, message.getOrderId(), timestamp, order);
+        } else if constexpr (std::is_same_v<ITCHDecoder::ITCHOrderCancelView, View>) {
+            event = Utils::Memory::makePooledShared<Market::OrderPartialCancelEvent>(pool, eventId, message.getOrderId(), timestamp, message.getCancelQuantity());
+        } else if constexpr (std::is_same_v<ITCHDecoder::ITCHOrderDeleteView, View>) {
+            event = Utils::Memory::makePooledShared<Market::OrderCancelEvent>(pool, eventId, message.getOrderId(), timestamp);
+        } else if constexpr (std::is_same_v<ITCHDecoder::ITCHOrderReplaceView, View>) {
+            event = Utils::Memory::makePooledShared<Market::OrderCancelAndReplaceEvent>(pool, eventId, message.getOldOrderId(), timestamp,
+                message.getNewOrderId(), message.getQuantity(), Utils::Maths::castIntPriceAsDouble(message.getPrice()));
+        } else if constexpr (std::is_same_v<ITCHDecoder::ITCHBrokenTradeView, View>) {
+            event = Utils::Memory::makePooledShared<Market::BrokenTradeEvent>(pool, eventId, 0 /* orderId */, timestamp, message.getMatchNumber());
+        }
+        // as with ITCHMessage::makeEvent, executions and trades are implied by the orders that caused them
+        if (!event)
+            return;
+        if (isDebugMode())
+            *getLogger() << Utils::Logger::LogLevel::DEBUG << "[MatchingEngineBase] Processing binary ITCH message " << message.getType() << ": " << *event;
+        process(event);
+    };
+    for (const auto& chunk : chunks)
+        decoder.decode(chunk.data(), chunk.size(), replay);
+    if (decoder.hasPartialFrame())
+        Utils::Error::LIB_THROW("[MatchingEngineBase::buildFromITCHBinary] The binary ITCH stream ends in the middle of a frame.");
+    return decoder.getNumDecoded();
+}
+
+uint64_t MatchingEngineBase::buildFromITCHBinaryFile(const std::string& filePath) {
+    const Utils::IO::MappedFile file(filePath);
+    return buildFromITCHBinary({std::span<const uint8_t>(file.getData(), file.getSize())});
+}
+
 std::ostream& MatchingEngineBase::orderBookSnapshot(std::ostream& out) const {
     const OrderBookDisplayConfig& config = getOrderBookDisplayConfig();
     if (config.isShowOrderBook()) {
-        auto bidIt = myBidBook.begin();
-        auto askIt = myAskBook.begin();
+        auto bidIt = myBidBookSize.begin();
+        auto askIt = myAskBookSize.begin();
         if (config.isAggregateOrderBook()) {
             if (config.isPrintAsciiOrderBook()) {
                 uint level = 1;
                 std::vector<OrderLevel> bidLevels;
                 std::vector<OrderLevel> askLevels;
-                while (bidIt != myBidBook.end() || askIt != myAskBook.end()) {
-                    if (bidIt != myBidBook.end()) {
-                        const uint32_t bidSize = myBidBookSize.at(bidIt->first);
-                        bidLevels.push_back({bidIt->first, bidSize});
+                while (bidIt != myBidBookSize.end() || askIt != myAskBookSize.end()) {
+                    if (bidIt != myBidBookSize.end()) {
+                        bidLevels.push_back({bidIt->first, bidIt->second});
                         ++bidIt;
                     }
-                    if (askIt != myAskBook.end()) {
-                        const uint32_t askSize = myAskBookSize.at(askIt->first);
-                        askLevels.push_back({askIt->first, askSize});
+                    if (askIt != myAskBookSize.end()) {
+                        askLevels.push_back({askIt->first, askIt->second});
                         ++askIt;
                     }
                     if (++level > config.getOrderBookLevels())
@@ -672,9 +958,9 @@ std::ostream& MatchingEngineBase::orderBookSnapshot(std::ostream& out) const {
                 out << "================= Order Book Snapshot ===================\n";
                 out << "  BID Size | BID Price || Level || ASK Price | ASK Size  \n";
                 out << "---------------------------------------------------------\n";
-                while (bidIt != myBidBook.end() || askIt != myAskBook.end()) {
-                    if (bidIt != myBidBook.end()) {
-                        const uint32_t bidSize = myBidBookSize.at(bidIt->first);
+                while (bidIt != myBidBookSize.end() || askIt != myAskBookSize.end()) {
+                    if (bidIt != myBidBookSize.end()) {
+                        const uint32_t bidSize = bidIt->second;
                         out << std::setw(9) << bidSize << "  | "
                             << std::fixed << std::setprecision(2)
                             << std::setw(8) << bidIt->first << "  || ";
@@ -683,8 +969,8 @@ std::ostream& MatchingEngineBase::orderBookSnapshot(std::ostream& out) const {
                         out << "           |           || ";
                     }
                     out << std::setw(5) << level << " || ";
-                    if (askIt != myAskBook.end()) {
-                        const uint32_t askSize = myAskBookSize.at(askIt->first);
+                    if (askIt != myAskBookSize.end()) {
+                        const uint32_t askSize = askIt->second;
                         out << std::setw(8) << askIt->first << "  | "
                             << std::setw(8) << askSize << "  \n";
                         ++askIt;
@@ -701,13 +987,13 @@ std::ostream& MatchingEngineBase::orderBookSnapshot(std::ostream& out) const {
             out << "================= Bid Book Snapshot ===================\n";
             out << " Level || BID Price | BID Size | BID Order (Id,Time|Size)\n";
             out << "-------------------------------------------------------\n";
-            while (bidIt != myBidBook.end()) {
+            while (bidIt != myBidBookSize.end()) {
                 out << std::setw(6) << level << " || "
                     << std::fixed << std::setprecision(2)
                     << std::setw(9) << bidIt->first << " | ";
-                const uint32_t bidSize = myBidBookSize.at(bidIt->first);
+                const uint32_t bidSize = bidIt->second;
                 out << std::setw(8) << bidSize << " | ";
-                for (const auto& order : bidIt->second) {
+                for (const auto& order : *findLimitQueue(Market::Side::BUY, bidIt->first)) {
                     out << "(" << order->getId() << "," << order->getTimestamp() << "|" << order->getQuantity() << ") ";
                 }
                 out << "\n";
@@ -720,13 +1006,13 @@ std::ostream& MatchingEngineBase::orderBookSnapshot(std::ostream& out) const {
             out << "================= Ask Book Snapshot ===================\n";
             out << " Level || ASK Price | ASK Size | ASK Order (Id,Time|Size)\n";
             out << "-------------------------------------------------------\n";
-            while (askIt != myAskBook.end()) {
+            while (askIt != myAskBookSize.end()) {
                 out << std::setw(6) << level << " || "
                     << std::fixed << std::setprecision(2)
                     << std::setw(9) << askIt->first << " | ";
-                const uint32_t askSize = myAskBookSize.at(askIt->first);
+                const uint32_t askSize = askIt->second;
                 out << std::setw(8) << askSize << " | ";
-                for (const auto& order : askIt->second) {
+                for (const auto& order : *findLimitQueue(Market::Side::SELL, askIt->first)) {
                     out << "(" << order->getId() << "," << order->getTimestamp() << "|" << order->getQuantity() << ") ";
                 }
                 out << "\n";
@@ -826,22 +1112,51 @@ void MatchingEngineBase::reserve(const size_t numOrdersEstimate) {
     myOrderEventLatencyLog.reserve(numOrdersEstimate);
     myOrderProcessingReportLog.reserve(2 * numOrdersEstimate);
     myOrderBookSizeDeltaLog.reserve(2 * numOrdersEstimate);
-    myITCHMessageLog.reserve(2 * numOrdersEstimate);
+    if (myCompactITCHMessageLog)
+        myITCHMessageValueLog.reserve(2 * numOrdersEstimate);
+    else
+        myITCHMessageLog.reserve(2 * numOrdersEstimate);
     myRemovedLimitOrderLog.reserve(numOrdersEstimate);
     myLimitOrderLookup.reserve(numOrdersEstimate);
 }
 
+void MatchingEngineBase::setMinimumPriceTick(const double minimumPriceTick) {
+    if (!(minimumPriceTick > 0))
+        Utils::Error::LIB_THROW("[MatchingEngineBase::setMinimumPriceTick] Minimum price tick must be positive.");
+    myBidPriceLadder = PriceLadderIndex(minimumPriceTick, myBidPriceLadder.getMaxSpan());
+    myAskPriceLadder = PriceLadderIndex(minimumPriceTick, myAskPriceLadder.getMaxSpan());
+    for (const auto& [price, size] : myBidBookSize)
+        myBidPriceLadder.update(price, size, 1);
+    for (const auto& [price, size] : myAskBookSize)
+        myAskPriceLadder.update(price, size, 1);
+}
+
 void MatchingEngineBase::stateConsistencyCheck() const {
     const bool isFIFOBook = getOrderMatchingStrategy() == Exchange::OrderMatchingStrategy::FIFO;
     std::set<uint64_t> orderIds;
-    if (myBidBook.size() != myBidBookSize.size()) // checks for consistency in the number of price levels
+    if (myBidBook.size() != myBidBookSize.size() && !isFork()) // checks for consistency in the number of price levels (a fork holds the touched levels only)
         Utils::Error::LIB_THROW("[MatchingEngineBase::init] Bid book size mismatch: " + std::to_string(myBidBook.size()) + " vs " + std::to_string(myBidBookSize.size()) + ".");
-    if (myAskBook.size() != myAskBookSize.size())
+    if (myAskBook.size() != myAskBookSize.size() && !isFork())
         Utils::Error::LIB_THROW("[MatchingEngineBase::init] Ask book size mismatch: " + std::to_string(myAskBook.size()) + " vs " + std::to_string(myAskBookSize.size()) + ".");
-    for (const auto& priceQueuePair : myBidBook) {
-        const PriceLevel priceLevel = priceQueuePair.first;
-        const LimitQueue& limitQueue = priceQueuePair.second;
-        const uint32_t queueSize = myBidBookSize.at(priceLevel);
+    if (myBookStateHash != computeBookStateHash()) // checks for the incrementally maintained book state hash
+        Utils::Error::LIB_THROW("[MatchingEngineBase::init] Book state hash mismatch: " + std::to_string(myBookStateHash) + " vs " + std::to_string(computeBookStateHash()) + ".");
+    uint64_t bidBookSizeTotal = 0, askBookSizeTotal = 0; // checks for the incrementally maintained price ladders
+    for (const auto& priceSizePair : myBidBookSize)
+        bidBookSizeTotal += priceSizePair.second;
+    for (const auto& priceSizePair : myAskBookSize)
+        askBookSizeTotal += priceSizePair.second;
+    if (myBidPriceLadder.getNumLevels() != myBidBookSize.size() || myBidPriceLadder.getTotalSize() != bidBookSizeTotal)
+        Utils::Error::LIB_THROW("[MatchingEngineBase::init] Bid price ladder mismatch: " + std::to_string(myBidPriceLadder.getNumLevels()) + " levels of total size " + std::to_string(myBidPriceLadder.getTotalSize()) + " vs " + std::to_string(myBidBookSize.size()) + " levels of total size " + std::to_string(bidBookSizeTotal) + ".");
+    if (myAskPriceLadder.getNumLevels() != myAskBookSize.size() || myAskPriceLadder.getTotalSize() != askBookSizeTotal)
+        Utils::Error::LIB_THROW("[MatchingEngineBase::init] Ask price ladder mismatch: " + std::to_string(myAskPriceLadder.getNumLevels()) + " levels of total size " + std::to_string(myAskPriceLadder.getTotalSize()) + " vs " + std::to_string(myAskBookSize.size()) + " levels of total size " + std::to_string(askBookSizeTotal) + ".");
+    for (const auto& priceSizePair : myBidBookSize) {
+        const PriceLevel priceLevel = priceSizePair.first;
+        const uint32_t queueSize = priceSizePair.second;
+        const LimitQueue* queue = findLimitQueue(Market::Side::BUY, priceLevel);
+        if (!queue) // checks for price levels missing in the book
+            Utils::Error::LIB_THROW("[MatchingEngineBase::init] Missing bid queue at price level " + std::to_string(priceLevel) + ".");
+        const LimitQueue& limitQueue = *queue;
+        const bool isOwnedLevel = isLevelMaterialized(Market::Side::BUY, priceLevel); // orders in levels read through from a fork parent are not indexed
         auto it = limitQueue.begin();
         uint64_t priorOrderTimestamp = 0;
         uint32_t cumQueueSize = 0;
@@ -852,12 +1167,11 @@ void MatchingEngineBase::stateConsistencyCheck() const {
             const auto orderId = order->getId();
             const auto orderTimestamp = order->getTimestamp();
             const auto orderQuantity = order->getQuantity();
-            const auto& orderIndex = myLimitOrderLookup.at(orderId);
             if (orderIds.find(orderId) != orderIds.end()) // checks for duplicate order id
                 Utils::Error::LIB_THROW("[MatchingEngineBase::init] Duplicate order id found in bid book: " + std::to_string(orderId) + ".");
             if (isFIFOBook && order->getTimestamp() < priorOrderTimestamp) // checks for order timestamp sorting
                 Utils::Error::LIB_THROW("[MatchingEngineBase::init] Orders in bid book are not sorted by timestamp: " + std::to_string(orderId) + ".");
-            if (orderIndex.first != &limitQueue || orderIndex.second != it) // checks for order index consistency
+            if (isOwnedLevel && (myLimitOrderLookup.at(orderId).first != &limitQueue || myLimitOrderLookup.at(orderId).second != it)) // checks for order index consistency
                 Utils::Error::LIB_THROW("[MatchingEngineBase::init] Order lookup index mismatch for order id: " + std::to_string(orderId) + ".");
             orderIds.insert(orderId);
             priorOrderTimestamp = orderTimestamp;
@@ -867,10 +1181,14 @@ void MatchingEngineBase::stateConsistencyCheck() const {
         if (cumQueueSize != queueSize) // checks for order queue size consistency
             Utils::Error::LIB_THROW("[MatchingEngineBase::init] Bid book size mismatch at price level " + std::to_string(priceLevel) + ": expected " + std::to_string(queueSize) + ", got " + std::to_string(cumQueueSize) + ".");
     }
-    for (const auto& priceQueuePair : myAskBook) {
-        const PriceLevel priceLevel = priceQueuePair.first;
-        const LimitQueue& limitQueue = priceQueuePair.second;
-        const uint32_t queueSize = myAskBookSize.at(priceLevel);
+    for (const auto& priceSizePair : myAskBookSize) {
+        const PriceLevel priceLevel = priceSizePair.first;
+        const uint32_t queueSize = priceSizePair.second;
+        const LimitQueue* queue = findLimitQueue(Market::Side::SELL, priceLevel);
+        if (!queue) // checks for price levels missing in the book
+            Utils::Error::LIB_THROW("[MatchingEngineBase::init] Missing ask queue at price level " + std::to_string(priceLevel) + ".");
+        const LimitQueue& limitQueue = *queue;
+        const bool isOwnedLevel = isLevelMaterialized(Market::Side::SELL, priceLevel); // orders in levels read through from a fork parent are not indexed
         auto it = limitQueue.begin();
         uint64_t priorOrderTimestamp = 0;
         uint32_t cumQueueSize = 0;
@@ -881,12 +1199,11 @@ void MatchingEngineBase::stateConsistencyCheck() const {
             const auto orderId = order->getId();
             const auto orderTimestamp = order->getTimestamp();
             const auto orderQuantity = order->getQuantity();
-            const auto& orderIndex = myLimitOrderLookup.at(orderId);
             if (orderIds.find(orderId) != orderIds.end()) // checks for duplicate order id
                 Utils::Error::LIB_THROW("[MatchingEngineBase::init] Duplicate order id found in ask book: " + std::to_string(orderId) + ".");
             if (isFIFOBook && order->getTimestamp() < priorOrderTimestamp) // checks for order timestamp sorting
                 Utils::Error::LIB_THROW("[MatchingEngineBase::init] Orders in ask book are not sorted by timestamp: " + std::to_string(orderId) + ".");
-            if (orderIndex.first != &limitQueue || orderIndex.second != it) // checks for order index consistency
+            if (isOwnedLevel && (myLimitOrderLookup.at(orderId).first != &limitQueue || myLimitOrderLookup.at(orderId).second != it)) // checks for order index consistency
                 Utils::Error::LIB_THROW("[MatchingEngineBase::init] Order lookup index mismatch for order id: " + std::to_string(orderId) + ".");
             orderIds.insert(orderId);
             priorOrderTimestamp = orderTimestamp;
@@ -906,7 +1223,8 @@ void MatchingEngineBase::stateConsistencyCheck() const {
 }
 
 void MatchingEngineBase::init() {
-    stateConsistencyCheck();
+    if (!isFork()) // a full check would defeat the O(1) fork, the parent was already checked on its construction
+        stateConsistencyCheck();
 }
 
 void MatchingEngineBase::reset() {
@@ -921,9 +1239,20 @@ void MatchingEngineBase::reset() {
     myOrderProcessingReportLog.clear();
     myOrderBookSizeDeltaLog.clear();
     myITCHMessageLog.clear();
+    myITCHMessageValueLog.clear();
     myRemovedLimitOrderLog.clear();
     myLimitOrderLookup.clear();
+    myBidPriceLadder.clear();
+    myAskPriceLadder.clear();
+    myBookStateHash = 0;
+    myForkParent = nullptr;
+    myForkParentBookStateHash = 0;
+    myMaterializedBidLevels.clear();
+    myMaterializedAskLevels.clear();
+    myAuctionCrossCode.reset();
+    myCoalescedBookDeltas.clear();
     IMatchingEngine::reset();
+    publishTopOfBookSnapshot();
 }
 
 std::string MatchingEngineBase::getAsJson() const {
@@ -945,6 +1274,37 @@ std::string MatchingEngineBase::getAsJson() const {
     return oss.str();
 }
 
+template<typename OrderBookType, typename OrderBookSizeType>
+std::shared_ptr<Market::LimitOrder> MatchingEngineBase::executeTopLimitOrder(
+    const Market::Side side,
+    OrderBookType& orderBook,
+    OrderBookSizeType& orderBookSize,
+    const uint32_t quantity) {
+    LimitQueue& limitQueue = orderBook.begin()->second;
+    uint32_t& orderSizeTotal = orderBookSize.begin()->second;
+    auto order = limitQueue.front(); // owns the order
+    const uint64_t orderId = order->getId();
+    const double price = order->getPrice();
+    toggleBookStateHash(side, price, orderId, order->getQuantity());
+    order->setQuantity(order->getQuantity() - quantity);
+    orderSizeTotal -= quantity;
+    updatePriceLadder(side, price, -static_cast<int64_t>(quantity), orderSizeTotal == 0 ? -1 : 0);
+    if (order->getQuantity()) {
+        order->setOrderState(Market::OrderState::PARTIAL_FILLED);
+        toggleBookStateHash(side, price, orderId, order->getQuantity());
+    } else {
+        order->setOrderState(Market::OrderState::FILLED);
+        myRemovedLimitOrderLog.push_back(order);
+        myLimitOrderLookup.erase(orderId);
+        limitQueue.pop_front();
+    }
+    if (!orderSizeTotal) {
+        orderBook.erase(orderBook.begin());
+        orderBookSize.erase(orderBookSize.begin());
+    }
+    return order;
+}
+
 template<typename OrderBookType, typename OrderBookSizeType>
 void MatchingEngineBase::fillOrderByMatchingTopLimitQueue(
     const std::shared_ptr<Market::OrderBase>& order,
@@ -953,6 +1313,8 @@ void MatchingEngineBase::fillOrderByMatchingTopLimitQueue(
     OrderBookSizeType& orderBookSize) {
     const uint64_t orderId = order->getId();
     const bool isIncomingOrderBuy = order->isBuy();
+    if (isFork()) // the best level is always owned by the fork once materialized
+        materializeLevel(isIncomingOrderBuy ? Market::Side::SELL : Market::Side::BUY, orderBookSize.begin()->first);
     LimitQueue& matchQueue = orderBook.begin()->second;
     uint32_t& matchSizeTotal = orderBookSize.begin()->second;
     auto queueIt = matchQueue.begin();
@@ -963,6 +1325,7 @@ void MatchingEngineBase::fillOrderByMatchingTopLimitQueue(
             *getLogger() << Utils::Logger::LogLevel::DEBUG << "[MatchingEngineBase] Matching order: " << *matchOrder;
         const uint32_t matchQuantity = matchOrder->getQuantity();
         uint32_t filledQuantity = 0;
+        toggleBookStateHash(matchOrder->getSide(), matchOrder->getPrice(), matchOrderId, matchQuantity);
         if (matchQuantity <= unfilledQuantity) {
             filledQuantity = matchQuantity;
             unfilledQuantity -= matchQuantity;
@@ -977,8 +1340,10 @@ void MatchingEngineBase::fillOrderByMatchingTopLimitQueue(
             matchSizeTotal -= unfilledQuantity;
             matchOrder->setQuantity(matchQuantity - unfilledQuantity);
             matchOrder->setOrderState(Market::OrderState::PARTIAL_FILLED);
+            toggleBookStateHash(matchOrder->getSide(), matchOrder->getPrice(), matchOrderId, matchOrder->getQuantity());
             unfilledQuantity = 0;
         }
+        updatePriceLadder(matchOrder->getSide(), matchOrder->getPrice(), -static_cast<int64_t>(filledQuantity), matchSizeTotal == 0 ? -1 : 0);
         if (!matchSizeTotal) {
             orderBook.erase(orderBook.begin());
             orderBookSize.erase(orderBookSize.begin());
@@ -986,9 +1351,9 @@ void MatchingEngineBase::fillOrderByMatchingTopLimitQueue(
         // internal log of executed trades
         std::shared_ptr<const Market::TradeBase> trade;
         if (isIncomingOrderBuy)
-            trade = std::make_shared<const Market::TradeBase>(generateTradeId(), clockTick(), orderId, matchOrderId, filledQuantity, matchOrder->getPrice(), order->isLimitOrder(), true, true);
+            trade = Utils::Memory::makePooledShared<Market::TradeBase>(myReportPool, generateTradeId(), clockTick(), orderId, matchOrderId, filledQuantity, matchOrder->getPrice(), order->isLimitOrder(), true, true);
         else
-            trade = std::make_shared<const Market::TradeBase>(generateTradeId(), clockTick(), matchOrderId, orderId, filledQuantity, matchOrder->getPrice(), true, order->isLimitOrder(), false);
+            trade = Utils::Memory::makePooledShared<Market::TradeBase>(myReportPool, generateTradeId(), clockTick(), matchOrderId, orderId, filledQuantity, matchOrder->getPrice(), true, order->isLimitOrder(), false);
         myTradeLog.push_back(trade);
         // external callback of executed trades
         const OrderExecutionType takerOrderExecType = unfilledQuantity == 0 ? OrderExecutionType::FILLED : OrderExecutionType::PARTIAL_FILLED;
@@ -997,14 +1362,14 @@ void MatchingEngineBase::fillOrderByMatchingTopLimitQueue(
         const uint64_t makerReportId = generateReportId();
         logOrderProcessingReport({ // incoming taker order
             generateOrderBookDeltaId(),
-            std::make_shared<OrderExecutionReport>(takerReportId, clockTick(), orderId, order->getOrderType(), order->getSide(), matchOrderId, trade->getId(), trade->getQuantity(), trade->getPrice(), false, takerOrderExecType, OrderProcessingStatus::SUCCESS),
+            Utils::Memory::makePooledShared<OrderExecutionReport>(myReportPool, takerReportId, clockTick(), orderId, order->getOrderType(), order->getSide(), matchOrderId, trade->getId(), trade->getQuantity(), trade->getPrice(), false, takerOrderExecType, OrderProcessingStatus::SUCCESS),
             nullptr /* delta */, // null book delta as the order is off the book
             BestBidAsk({ false })
         });
         logOrderProcessingReport({ // resting maker order (limit order)
             generateOrderBookDeltaId(),
-            std::make_shared<OrderExecutionReport>(makerReportId, clockTick(), matchOrderId, Market::OrderType::LIMIT, matchOrder->getSide(), orderId, trade->getId(), trade->getQuantity(), trade->getPrice(), true, makerOrderExecType, OrderProcessingStatus::SUCCESS),
-            std::make_shared<OrderBookSizeDelta>(makerReportId, matchOrderId, matchOrder->getSide(), trade->getPrice(), OrderBookSizeDelta::DeltaType::REMOVE, trade->getQuantity()),
+            Utils::Memory::makePooledShared<OrderExecutionReport>(myReportPool, makerReportId, clockTick(), matchOrderId, Market::OrderType::LIMIT, matchOrder->getSide(), orderId, trade->getId(), trade->getQuantity(), trade->getPrice(), true, makerOrderExecType, OrderProcessingStatus::SUCCESS),
+            Utils::Memory::makePooledShared<OrderBookSizeDelta>(myReportPool, makerReportId, matchOrderId, matchOrder->getSide(), trade->getPrice(), OrderBookSizeDelta::DeltaType::REMOVE, trade->getQuantity()),
             getBestBidAsk()
         });
         if (isDebugMode())
@@ -1024,8 +1389,10 @@ void MatchingEngineBase::placeLimitOrderToLimitOrderBook(
         if (unfilledQuantity < originalQuantity)
             order->setOrderState(Market::OrderState::PARTIAL_FILLED);
         limitQueue.push_back(order);
+        updatePriceLadder(order->getSide(), order->getPrice(), order->getQuantity(), orderSizeTotal == 0 ? 1 : 0);
         orderSizeTotal += order->getQuantity();
         myLimitOrderLookup[order->getId()] = {&limitQueue, std::prev(limitQueue.end())};
+        toggleBookStateHash(order->getSide(), order->getPrice(), order->getId(), order->getQuantity());
         if (isDebugMode())
             *getLogger() << Utils::Logger::LogLevel::DEBUG << "[MatchingEngineBase] Placed order in limit order book: " << *order;
     } else {
@@ -1068,16 +1435,16 @@ void MatchingEngineBase::executeAgainstQueuedMarketOrders(
         // internal log of executed trades
         std::shared_ptr<const Market::TradeBase> trade;
         if (order->isBuy()) // limit buy, market sell
-            trade = std::make_shared<const Market::TradeBase>(generateTradeId(), clockTick(), order->getId(), marketOrderId, filledQuantity, order->getPrice(), true, false, true);
+            trade = Utils::Memory::makePooledShared<Market::TradeBase>(myReportPool, generateTradeId(), clockTick(), order->getId(), marketOrderId, filledQuantity, order->getPrice(), true, false, true);
         else // limit sell, market buy
-            trade = std::make_shared<const Market::TradeBase>(generateTradeId(), clockTick(), marketOrderId, order->getId(), filledQuantity, order->getPrice(), false, true, false);
+            trade = Utils::Memory::makePooledShared<Market::TradeBase>(myReportPool, generateTradeId(), clockTick(), marketOrderId, order->getId(), filledQuantity, order->getPrice(), false, true, false);
         myTradeLog.push_back(trade);
         // external callback of executed trades
         const OrderExecutionType takerOrderExecType = unfilledQuantity == 0 ? OrderExecutionType::FILLED : OrderExecutionType::PARTIAL_FILLED;
         const OrderExecutionType makerOrderExecType = marketOrder->getQuantity() == 0 ? OrderExecutionType::FILLED : OrderExecutionType::PARTIAL_FILLED;
         // null book delta here as the incoming (new) limit order off the book executes against the existing queued market orders
-        logOrderProcessingReport({ generateOrderBookDeltaId(), std::make_shared<OrderExecutionReport>(generateReportId(), clockTick(), orderId, Market::OrderType::LIMIT, order->getSide(), marketOrderId, trade->getId(), trade->getQuantity(), trade->getPrice(), true, takerOrderExecType, OrderProcessingStatus::SUCCESS), nullptr /* delta */, BestBidAsk({ false }) }); // incoming maker order (limit order)
-        logOrderProcessingReport({ generateOrderBookDeltaId(), std::make_shared<OrderExecutionReport>(generateReportId(), clockTick(), marketOrderId, Market::OrderType::MARKET, marketOrder->getSide(), orderId, trade->getId(), trade->getQuantity(), trade->getPrice(), false, makerOrderExecType, OrderProcessingStatus::SUCCESS), nullptr /* delta */, BestBidAsk({ false }) }); // resting taker order
+        logOrderProcessingReport({ generateOrderBookDeltaId(), Utils::Memory::makePooledShared<OrderExecutionReport>(myReportPool, generateReportId(), clockTick(), orderId, Market::OrderType::LIMIT, order->getSide(), marketOrderId, trade->getId(), trade->getQuantity(), trade->getPrice(), true, takerOrderExecType, OrderProcessingStatus::SUCCESS), nullptr /* delta */, BestBidAsk({ false }) }); // incoming maker order (limit order)
+        logOrderProcessingReport({ generateOrderBookDeltaId(), Utils::Memory::makePooledShared<OrderExecutionReport>(myReportPool, generateReportId(), clockTick(), marketOrderId, Market::OrderType::MARKET, marketOrder->getSide(), orderId, trade->getId(), trade->getQuantity(), trade->getPrice(), false, makerOrderExecType, OrderProcessingStatus::SUCCESS), nullptr /* delta */, BestBidAsk({ false }) }); // resting taker order
         if (isDebugMode())
             *getLogger() << Utils::Logger::LogLevel::DEBUG << "[MatchingEngineBase] Trade executed: " << *trade;
     }
@@ -1103,26 +1470,331 @@ void MatchingEngineBase::placeMarketOrderToMarketOrderQueue(
     }
 }
 
+bool MatchingEngineBase::rejectOnPreTradeCheck(const std::shared_ptr<Market::LimitOrder>& order) {
+    const Market::TimeInForce timeInForce = order->getTimeInForce();
+    std::string rejectReason;
+    if (isInAuction()) { // the book may be crossed during the auction, only the immediate orders are turned away
+        if (!order->canRest())
+            rejectReason = "Immediate order cannot be accepted during the auction.";
+    } else if (timeInForce == Market::TimeInForce::FOK && getFillableQuantity(order->getSide(), order->getPrice()) < order->getQuantity())
+        rejectReason = "Fill-or-kill order cannot be filled entirely.";
+    else if (timeInForce == Market::TimeInForce::POST_ONLY && getFillableQuantity(order->getSide(), order->getPrice()) > 0)
+        rejectReason = "Post-only order would take liquidity.";
+    if (rejectReason.empty())
+        return false;
+    if (isDebugMode())
+        *getLogger() << Utils::Logger::LogLevel::DEBUG << "[MatchingEngineBase] Rejected order: " << *order << " - " << rejectReason;
+    order->setTimestamp(clockTick());
+    order->setOrderState(Market::OrderState::CANCELLED);
+    // null book delta as the rejected order never touches the book
+    logOrderProcessingReport({ generateOrderBookDeltaId(), Utils::Memory::makePooledShared<LimitOrderSubmitReport>(myReportPool, generateReportId(), clockTick(), order->getId(), order->getSide(), order->copy(myReportPool), OrderProcessingStatus::FAILURE, std::nullopt, rejectReason), nullptr /* delta */, BestBidAsk({ false }) });
+    return true;
+}
+
+void MatchingEngineBase::cancelUnfilledQuantity(const std::shared_ptr<Market::LimitOrder>& order, const uint32_t unfilledQuantity) {
+    order->setQuantity(unfilledQuantity);
+    order->setTimestamp(clockTick());
+    order->setOrderState(Market::OrderState::CANCELLED);
+    myRemovedLimitOrderLog.push_back(order);
+    if (isDebugMode())
+        *getLogger() << Utils::Logger::LogLevel::DEBUG << "[MatchingEngineBase] Cancelled unfilled quantity: " << *order;
+    // null book delta as the remainder is never placed in the book
+    logOrderProcessingReport({
+        generateOrderBookDeltaId(),
+        Utils::Memory::makePooledShared<OrderCancelReport>(myReportPool, generateReportId(), clockTick(), order->getId(), order->getSide(), Market::OrderType::LIMIT, unfilledQuantity, order->getPrice(), OrderProcessingStatus::SUCCESS),
+        nullptr /* delta */,
+        getBestBidAsk()
+    });
+}
+
+void MatchingEngineBase::startAuction(const ITCHEncoder::CrossCode crossCode) {
+    if (isInAuction())
+        Utils::Error::LIB_THROW("[MatchingEngineBase::startAuction] Matching engine is already in auction.");
+    myAuctionCrossCode = crossCode;
+}
+
+AuctionEquilibrium MatchingEngineBase::computeAuctionEquilibrium(const std::optional<double>& referencePrice) const {
+    AuctionEquilibrium equilibrium;
+    uint64_t marketBuyQuantity = 0, marketSellQuantity = 0;
+    for (const auto& order : myMarketQueue)
+        (order->isBuy() ? marketBuyQuantity : marketSellQuantity) += order->getQuantity();
+    // candidate prices are the levels inside the crossed range, open ended on the side of any queued market orders
+    const double lowestPrice = marketSellQuantity ? Utils::Consts::NEG_INF_DOUBLE : (myAskBookSize.empty() ? Utils::Consts::POS_INF_DOUBLE : myAskBookSize.begin()->first);
+    const double highestPrice = marketBuyQuantity ? Utils::Consts::POS_INF_DOUBLE : (myBidBookSize.empty() ? Utils::Consts::NEG_INF_DOUBLE : myBidBookSize.begin()->first);
+    if (lowestPrice > highestPrice)
+        return equilibrium;
+    uint64_t bidSizeInRange = 0;
+    for (auto it = myBidBookSize.begin(); it != myBidBookSize.end() && it->first >= lowestPrice; ++it)
+        bidSizeInRange += it->second;
+    const double reference = referencePrice.value_or(getLastTradePrice());
+    // one ascending merge over both books, with the supply curve accumulated upwards and the demand curve drained upwards
+    uint64_t askSizeAtOrBelow = 0, bidSizeBelow = 0;
+    auto askIt = myAskBookSize.begin();
+    auto bidIt = std::make_reverse_iterator(myBidBookSize.upper_bound(lowestPrice));
+    while (true) {
+        const bool hasAsk = askIt != myAskBookSize.end() && askIt->first <= highestPrice;
+        const bool hasBid = bidIt != myBidBookSize.rend() && bidIt->first <= highestPrice;
+        if (!hasAsk && !hasBid)
+            break;
+        const double price = !hasBid || (hasAsk && askIt->first < bidIt->first) ? askIt->first : bidIt->first;
+        if (hasAsk && askIt->first == price)
+            askSizeAtOrBelow += (askIt++)->second;
+        const uint64_t buyQuantity = marketBuyQuantity + bidSizeInRange - bidSizeBelow;
+        const uint64_t sellQuantity = marketSellQuantity + askSizeAtOrBelow;
+        if (hasBid && bidIt->first == price)
+            bidSizeBelow += (bidIt++)->second;
+        const uint64_t matchedQuantity = std::min(buyQuantity, sellQuantity);
+        if (!matchedQuantity)
+            continue;
+        const uint64_t imbalance = buyQuantity > sellQuantity ? buyQuantity - sellQuantity : sellQuantity - buyQuantity;
+        bool isBetter = matchedQuantity > equilibrium.matchedQuantity;
+        if (matchedQuantity == equilibrium.matchedQuantity) {
+            if (imbalance < equilibrium.getImbalance())
+                isBetter = true;
+            else if (imbalance == equilibrium.getImbalance() && buyQuantity > sellQuantity) // a buy surplus pushes the price up
+                isBetter = true;
+            else if (imbalance == equilibrium.getImbalance() && buyQuantity == sellQuantity && !std::isnan(reference))
+                isBetter = std::abs(price - reference) < std::abs(equilibrium.price - reference);
+        }
+        if (isBetter)
+            equilibrium = { price, static_cast<uint32_t>(matchedQuantity), static_cast<uint32_t>(buyQuantity), static_cast<uint32_t>(sellQuantity) };
+    }
+    return equilibrium;
+}
+
+AuctionEquilibrium MatchingEngineBase::uncrossAuction(const std::optional<double>& referencePrice) {
+    if (!isInAuction())
+        Utils::Error::LIB_THROW("[MatchingEngineBase::uncrossAuction] Matching engine is not in auction.");
+    const AuctionEquilibrium equilibrium = computeAuctionEquilibrium(referencePrice);
+    const ITCHEncoder::CrossCode crossCode = *myAuctionCrossCode;
+    const double crossPrice = equilibrium.price;
+    myAuctionCrossCode.reset();
+    auto nextMarketOrder = [this](MarketQueue::iterator it, const Market::Side side) {
+        while (it != myMarketQueue.end() && (*it)->getSide() != side)
+            ++it;
+        return it;
+    };
+    // queued market orders go first, then the limit orders in price-time priority, all filled at the single cross price
+    auto buyIt = nextMarketOrder(myMarketQueue.begin(), Market::Side::BUY);
+    auto sellIt = nextMarketOrder(myMarketQueue.begin(), Market::Side::SELL);
+    uint32_t unmatchedQuantity = equilibrium.matchedQuantity;
+    while (unmatchedQuantity) {
+        const bool isBuyMarketOrder = buyIt != myMarketQueue.end();
+        const bool isSellMarketOrder = sellIt != myMarketQueue.end();
+        if (isFork() && !isBuyMarketOrder)
+            materializeLevel(Market::Side::BUY, myBidBookSize.begin()->first);
+        if (isFork() && !isSellMarketOrder)
+            materializeLevel(Market::Side::SELL, myAskBookSize.begin()->first);
+        std::shared_ptr<Market::OrderBase> buyOrder = isBuyMarketOrder ? std::shared_ptr<Market::OrderBase>(*buyIt) : myBidBook.begin()->second.front();
+        std::shared_ptr<Market::OrderBase> sellOrder = isSellMarketOrder ? std::shared_ptr<Market::OrderBase>(*sellIt) : myAskBook.begin()->second.front();
+        const uint32_t filledQuantity = std::min({ unmatchedQuantity, buyOrder->getQuantity(), sellOrder->getQuantity() });
+        const auto trade = Utils::Memory::makePooledShared<Market::TradeBase>(myReportPool, generateTradeId(), clockTick(), buyOrder->getId(), sellOrder->getId(), filledQuantity, crossPrice,
+            !isBuyMarketOrder, !isSellMarketOrder, equilibrium.buyQuantity > equilibrium.sellQuantity);
+        myTradeLog.push_back(trade);
+        for (const Market::Side side : { Market::Side::BUY, Market::Side::SELL }) {
+            const bool isBuy = side == Market::Side::BUY;
+            const bool isMarketOrder = isBuy ? isBuyMarketOrder : isSellMarketOrder;
+            const std::shared_ptr<Market::OrderBase>& order = isBuy ? buyOrder : sellOrder;
+            const uint64_t matchOrderId = isBuy ? sellOrder->getId() : buyOrder->getId();
+            const double orderPrice = order->getPrice(); // the resting price, where the book delta applies
+            if (isMarketOrder) {
+                auto& marketIt = isBuy ? buyIt : sellIt;
+                order->setQuantity(order->getQuantity() - filledQuantity);
+                order->setOrderState(order->getQuantity() ? Market::OrderState::PARTIAL_FILLED : Market::OrderState::FILLED);
+                if (!order->getQuantity())
+                    marketIt = nextMarketOrder(myMarketQueue.erase(marketIt), side);
+            } else if (isBuy) {
+                executeTopLimitOrder(side, myBidBook, myBidBookSize, filledQuantity);
+            } else {
+                executeTopLimitOrder(side, myAskBook, myAskBookSize, filledQuantity);
+            }
+            const uint64_t reportId = generateReportId();
+            logOrderProcessingReport({
+                generateOrderBookDeltaId(),
+                Utils::Memory::makePooledShared<OrderExecutionReport>(myReportPool, reportId, clockTick(), order->getId(), order->getOrderType(), side, matchOrderId, trade->getId(), filledQuantity, crossPrice, !isMarketOrder,
+                    order->getQuantity() ? OrderExecutionType::PARTIAL_FILLED : OrderExecutionType::FILLED, OrderProcessingStatus::SUCCESS),
+                isMarketOrder ? nullptr : Utils::Memory::makePooledShared<OrderBookSizeDelta>(myReportPool, reportId, order->getId(), side, orderPrice, OrderBookSizeDelta::DeltaType::REMOVE, filledQuantity),
+                isBuy ? BestBidAsk({ false }) : getBestBidAsk()
+            });
+        }
+        unmatchedQuantity -= filledQuantity;
+        if (isDebugMode())
+            *getLogger() << Utils::Logger::LogLevel::DEBUG << "[MatchingEngineBase] Auction trade executed: " << *trade;
+    }
+    // market orders left unexecuted by the cross are cancelled
+    for (const auto& order : myMarketQueue) {
+        order->setOrderState(Market::OrderState::CANCELLED);
+        logOrderProcessingReport({
+            generateOrderBookDeltaId(),
+            Utils::Memory::makePooledShared<OrderCancelReport>(myReportPool, generateReportId(), clockTick(), order->getId(), order->getSide(), Market::OrderType::MARKET, order->getQuantity(), std::nullopt, OrderProcessingStatus::SUCCESS),
+            nullptr /* delta */,
+            BestBidAsk({ false })
+        });
+    }
+    myMarketQueue.clear();
+    if (equilibrium.isCrossed())
+        logOrderProcessingReport({
+            generateOrderBookDeltaId(),
+            Utils::Memory::makePooledShared<CrossTradeReport>(myReportPool, generateReportId(), clockTick(), equilibrium.matchedQuantity, crossPrice, crossCode, OrderProcessingStatus::SUCCESS),
+            nullptr /* delta */,
+            getBestBidAsk()
+        });
+    flushCoalescedBookDeltas();
+    publishTopOfBookSnapshot();
+    return equilibrium;
+}
+
 void MatchingEngineBase::logOrderProcessingReport(LoggedOrderProcessingReport loggedReport) {
+    if (myCoalesceBookDeltas && loggedReport.delta) {
+        coalesceBookDelta(*loggedReport.delta);
+        loggedReport.delta = nullptr;
+        if (!loggedReport.report)
+            return; // a delta-only entry is folded into the batch altogether
+    }
+    publishOrderProcessingReport(std::move(loggedReport));
+}
+
+void MatchingEngineBase::coalesceBookDelta(const OrderBookSizeDelta& delta) {
+    const int64_t sizeDelta = delta.type == OrderBookSizeDelta::DeltaType::ADD ? delta.sizeDelta : -static_cast<int64_t>(delta.sizeDelta);
+    // an input event touches a handful of levels at most, hence the linear search
+    for (auto& levelDelta : myCoalescedBookDeltas) {
+        if (levelDelta.side == delta.side && levelDelta.price == delta.price) {
+            levelDelta.netSizeDelta += sizeDelta;
+            levelDelta.reportId = delta.reportId;
+            levelDelta.orderId = delta.orderId;
+            return;
+        }
+    }
+    myCoalescedBookDeltas.push_back({delta.side, delta.price, sizeDelta, delta.reportId, delta.orderId});
+}
+
+void MatchingEngineBase::setTopOfBookSnapshotLevels(const size_t numLevels) {
+    if (numLevels > TopOfBookSnapshot::MAX_LEVELS)
+        Utils::Error::LIB_THROW("[MatchingEngineBase::setTopOfBookSnapshotLevels] Number of levels " + std::to_string(numLevels) + " exceeds the maximum of " + std::to_string(TopOfBookSnapshot::MAX_LEVELS) + ".");
+    myTopOfBookSnapshotLevels = numLevels;
+    if (!numLevels) {
+        myTopOfBookSnapshot.reset(); // readers still holding the lock keep the last snapshot
+        return;
+    }
+    if (!myTopOfBookSnapshot)
+        myTopOfBookSnapshot = std::make_shared<TopOfBookSnapshotLock>();
+    publishTopOfBookSnapshot();
+}
+
+TopOfBookSnapshot MatchingEngineBase::getTopOfBookSnapshot() const {
+    const auto snapshotLock = myTopOfBookSnapshot;
+    return snapshotLock ? snapshotLock->load() : TopOfBookSnapshot();
+}
+
+void MatchingEngineBase::publishTopOfBookSnapshot() {
+    if (!myTopOfBookSnapshot)
+        return;
+    TopOfBookSnapshot snapshot;
+    snapshot.sequence = myTopOfBookSnapshot->version();
+    snapshot.timestamp = getCurrentTimestamp();
+    snapshot.lastTradePrice = getLastTradePrice();
+    for (auto it = myBidBookSize.begin(); it != myBidBookSize.end() && snapshot.numBidLevels < myTopOfBookSnapshotLevels; ++it)
+        snapshot.bidLevels[snapshot.numBidLevels++] = {it->first, it->second};
+    for (auto it = myAskBookSize.begin(); it != myAskBookSize.end() && snapshot.numAskLevels < myTopOfBookSnapshotLevels; ++it)
+        snapshot.askLevels[snapshot.numAskLevels++] = {it->first, it->second};
+    myTopOfBookSnapshot->store(snapshot);
+}
+
+void MatchingEngineBase::flushCoalescedBookDeltas() {
+    if (myCoalescedBookDeltas.empty())
+        return;
+    // levels that net out to nothing are left out, the last delta emitted closes the batch
+    std::vector<std::shared_ptr<OrderBookSizeDelta>> deltas;
+    for (const auto& levelDelta : myCoalescedBookDeltas)
+        if (levelDelta.netSizeDelta != 0)
+            deltas.push_back(Utils::Memory::makePooledShared<OrderBookSizeDelta>(myReportPool, levelDelta.reportId, levelDelta.orderId, levelDelta.side, levelDelta.price,
+                levelDelta.netSizeDelta > 0 ? OrderBookSizeDelta::DeltaType::ADD : OrderBookSizeDelta::DeltaType::REMOVE,
+                static_cast<uint32_t>(std::abs(levelDelta.netSizeDelta))));
+    myCoalescedBookDeltas.clear();
+    if (deltas.empty())
+        return;
+    deltas.back()->isLastInBatch = true;
+    const BestBidAsk bestBidAsk = getBestBidAsk();
+    for (const auto& delta : deltas)
+        publishOrderProcessingReport({ generateOrderBookDeltaId(), nullptr /* report */, delta, bestBidAsk });
+}
+
+void MatchingEngineBase::publishOrderProcessingReport(LoggedOrderProcessingReport loggedReport) {
     const auto& report = loggedReport.report; // either of the report or the delta might be null
     const auto& delta = loggedReport.delta;
-    const auto& message = report ? report->makeITCHMessage() : nullptr;
+    std::shared_ptr<const ITCHEncoder::ITCHMessage> message;
+    if (myCompactITCHMessageLog) {
+        const auto value = report ? report->makeITCHMessageValue() : std::nullopt;
+        if (value) {
+            myITCHMessageValueLog.push_back(*value);
+            if (!myITCHMessageSubscriptions.empty())
+                message = value->makeMessage();
+        }
+    } else {
+        message = report ? report->makeITCHMessage() : nullptr;
+        myITCHMessageLog.push_back(message);
+    }
     myOrderProcessingReportLog.push_back(report);
     myOrderBookSizeDeltaLog.push_back(delta);
-    myITCHMessageLog.push_back(message);
-    for (const auto& callback : myOrderProcessingCallbacks)
-        if (callback && *callback) (*callback)(report);
-    for (const auto& callback : myOrderBookSizeDeltaCallbacks)
-        if (callback && *callback) (*callback)(delta);
-    for (const auto& callback : myITCHMessageCallbacks)
-        if (callback && *callback) (*callback)(message);
+    myOrderProcessingSubscriptions.dispatch(report.get(), report);
+    myOrderBookDeltaSubscriptions.dispatch(report.get(), delta);
+    myITCHMessageSubscriptions.dispatch(report.get(), message);
 }
 
 void MatchingEngineBase::logOrderEventLatency(LoggedOrderEventLatency loggedLatency) {
     const auto& latency = loggedLatency.latency;
     myOrderEventLatencyLog.push_back(latency);
-    for (const auto& callback : myOrderEventLatencyCallbacks)
-        if (callback && *callback) (*callback)(latency);
+    myOrderEventLatencySubscriptions.dispatch(latency);
+}
+
+// the shared_ptr callbacks are kept alive by the subscription and stay switchable by their owners
+void MatchingEngineBase::addOrderProcessingCallback(const CallbackSharedPtr<OrderProcessingReport>& callback) {
+    subscribeOrderProcessingReports([callback](const auto& report) { if (callback && *callback) (*callback)(report); });
+}
+
+void MatchingEngineBase::addOrderBookDeltaCallback(const CallbackSharedPtr<OrderBookSizeDelta>& callback) {
+    subscribeOrderBookDeltas([callback](const auto& delta) { if (callback && *callback) (*callback)(delta); });
+}
+
+void MatchingEngineBase::addOrderEventLatencyCallback(const CallbackSharedPtr<OrderEventLatency>& callback) {
+    subscribeOrderEventLatencies([callback](const auto& latency) { if (callback && *callback) (*callback)(latency); });
+}
+
+void MatchingEngineBase::addITCHMessageCallback(const CallbackSharedPtr<ITCHEncoder::ITCHMessage>& callback) {
+    subscribeITCHMessages([callback](const auto& message) { if (callback && *callback) (*callback)(message); });
+}
+
+SubscriptionId MatchingEngineBase::subscribeOrderProcessingReports(const OrderProcessingCallback& callback, const OrderProcessingReportFilter& filter) {
+    if (!callback)
+        Utils::Error::LIB_THROW("[MatchingEngineBase::subscribeOrderProcessingReports] Callback is empty.");
+    myOrderProcessingSubscriptions.add(++myLastSubscriptionId, callback, filter);
+    return myLastSubscriptionId;
+}
+
+SubscriptionId MatchingEngineBase::subscribeOrderBookDeltas(const OrderBookDeltaCallback& callback, const OrderProcessingReportFilter& filter) {
+    if (!callback)
+        Utils::Error::LIB_THROW("[MatchingEngineBase::subscribeOrderBookDeltas] Callback is empty.");
+    myOrderBookDeltaSubscriptions.add(++myLastSubscriptionId, callback, filter);
+    return myLastSubscriptionId;
+}
+
+SubscriptionId MatchingEngineBase::subscribeITCHMessages(const ITCHMessageCallback& callback, const OrderProcessingReportFilter& filter) {
+    if (!callback)
+        Utils::Error::LIB_THROW("[MatchingEngineBase::subscribeITCHMessages] Callback is empty.");
+    myITCHMessageSubscriptions.add(++myLastSubscriptionId, callback, filter);
+    return myLastSubscriptionId;
+}
+
+SubscriptionId MatchingEngineBase::subscribeOrderEventLatencies(const OrderEventLatencyCallback& callback) {
+    if (!callback)
+        Utils::Error::LIB_THROW("[MatchingEngineBase::subscribeOrderEventLatencies] Callback is empty.");
+    myOrderEventLatencySubscriptions.add(++myLastSubscriptionId, callback, OrderProcessingReportFilter({OrderProcessingType::NONE})); // not driven by reports
+    return myLastSubscriptionId;
+}
+
+bool MatchingEngineBase::unsubscribe(const SubscriptionId subscriptionId) {
+    return myOrderProcessingSubscriptions.remove(subscriptionId) || myOrderBookDeltaSubscriptions.remove(subscriptionId) ||
+        myITCHMessageSubscriptions.remove(subscriptionId) || myOrderEventLatencySubscriptions.remove(subscriptionId);
 }
 
 MatchingEngineFIFO::MatchingEngineFIFO() :
@@ -1135,6 +1807,11 @@ MatchingEngineFIFO::MatchingEngineFIFO(const MatchingEngineFIFO& matchingEngine)
     init();
 }
 
+MatchingEngineFIFO::MatchingEngineFIFO(const MatchingEngineFIFO& parent, const bool includeLogs) :
+    MatchingEngineBase(parent, includeLogs) {
+    init();
+}
+
 void MatchingEngineFIFO::addToLimitOrderBook(std::shared_ptr<Market::LimitOrder> order) {
     if (isDebugMode())
         *getLogger() << Utils::Logger::LogLevel::DEBUG << "[MatchingEngineFIFO] Add to limit order book: " << *order;
@@ -1151,30 +1828,41 @@ void MatchingEngineFIFO::addToLimitOrderBook(std::shared_ptr<Market::LimitOrder>
     MarketQueue& marketQueue = accessMarketQueue();
     LimitQueue dummyQueue; // avoids the creation of a new queue if the entire order is filled
     uint32_t dummySize = 0;
+    const bool isRestingOrder = order->canRest();
+    if (rejectOnPreTradeCheck(order))
+        return;
     // null book delta as the actual book state changes happen inside the fill/place operations
-    logOrderProcessingReport({ generateOrderBookDeltaId(), std::make_shared<LimitOrderSubmitReport>(generateReportId(), clockTick(), id, side, order->copy(), OrderProcessingStatus::SUCCESS), nullptr /* delta */, BestBidAsk({ false }) });
-    executeAgainstQueuedMarketOrders(order, unfilledQuantity, marketQueue);
+    logOrderProcessingReport({ generateOrderBookDeltaId(), Utils::Memory::makePooledShared<LimitOrderSubmitReport>(getReportPool(), generateReportId(), clockTick(), id, side, order->copy(getReportPool()), OrderProcessingStatus::SUCCESS), nullptr /* delta */, BestBidAsk({ false }) });
+    const bool isMatching = !isInAuction(); // orders accumulate in the book during the auction
+    if (isMatching)
+        executeAgainstQueuedMarketOrders(order, unfilledQuantity, marketQueue);
     if (side == Market::Side::BUY) {
-        while (unfilledQuantity && !askBook.empty() && price >= askBook.begin()->first)
+        while (unfilledQuantity && isMatching && !askBookSize.empty() && price >= askBookSize.begin()->first)
             fillOrderByMatchingTopLimitQueue(order, unfilledQuantity, askBook, askBookSize);
-        if (unfilledQuantity)
+        if (unfilledQuantity && isRestingOrder && isFork())
+            materializeLevel(side, price);
+        if (unfilledQuantity && isRestingOrder)
             placeLimitOrderToLimitOrderBook(order, unfilledQuantity, bidBookSize[price], bidBook[price]);
-        else
+        else if (!unfilledQuantity)
             placeLimitOrderToLimitOrderBook(order, 0, dummySize, dummyQueue);
     } else if (side == Market::Side::SELL) {
-        while (unfilledQuantity && !bidBook.empty() && price <= bidBook.begin()->first)
+        while (unfilledQuantity && isMatching && !bidBookSize.empty() && price <= bidBookSize.begin()->first)
             fillOrderByMatchingTopLimitQueue(order, unfilledQuantity, bidBook, bidBookSize);
-        if (unfilledQuantity)
+        if (unfilledQuantity && isRestingOrder && isFork())
+            materializeLevel(side, price);
+        if (unfilledQuantity && isRestingOrder)
             placeLimitOrderToLimitOrderBook(order, unfilledQuantity, askBookSize[price], askBook[price]);
-        else
+        else if (!unfilledQuantity)
             placeLimitOrderToLimitOrderBook(order, 0, dummySize, dummyQueue);
     }
-    if (unfilledQuantity) {
+    if (unfilledQuantity && !isRestingOrder) {
+        cancelUnfilledQuantity(order, unfilledQuantity);
+    } else if (unfilledQuantity) {
         const uint64_t reportId = generateReportId();
         logOrderProcessingReport({
             generateOrderBookDeltaId(),
-            std::make_shared<LimitOrderPlacementReport>(reportId, clockTick(), id, side, unfilledQuantity, price, OrderProcessingStatus::SUCCESS),
-            std::make_shared<OrderBookSizeDelta>(reportId, id, side, price, OrderBookSizeDelta::DeltaType::ADD, unfilledQuantity),
+            Utils::Memory::makePooledShared<LimitOrderPlacementReport>(getReportPool(), reportId, clockTick(), id, side, unfilledQuantity, price, OrderProcessingStatus::SUCCESS),
+            Utils::Memory::makePooledShared<OrderBookSizeDelta>(getReportPool(), reportId, id, side, price, OrderBookSizeDelta::DeltaType::ADD, unfilledQuantity),
             getBestBidAsk()
         });
     }
@@ -1193,13 +1881,13 @@ void MatchingEngineFIFO::executeMarketOrder(std::shared_ptr<Market::MarketOrder>
     AscOrderBookSize& askBookSize = accessAskBookSize();
     MarketQueue& marketQueue = accessMarketQueue();
     // null book delta as the actual book state changes happen inside the fill/place operations
-    logOrderProcessingReport({ generateOrderBookDeltaId(), std::make_shared<MarketOrderSubmitReport>(generateReportId(), clockTick(), order->getId(), side, order->copy(), OrderProcessingStatus::SUCCESS), nullptr /* delta */, BestBidAsk({ false }) });
+    logOrderProcessingReport({ generateOrderBookDeltaId(), Utils::Memory::makePooledShared<MarketOrderSubmitReport>(getReportPool(), generateReportId(), clockTick(), order->getId(), side, order->copy(getReportPool()), OrderProcessingStatus::SUCCESS), nullptr /* delta */, BestBidAsk({ false }) });
     if (side == Market::Side::BUY) {
-        while (unfilledQuantity && !askBook.empty())
+        while (unfilledQuantity && !isInAuction() && !askBookSize.empty())
             fillOrderByMatchingTopLimitQueue(order, unfilledQuantity, askBook, askBookSize);
         placeMarketOrderToMarketOrderQueue(order, unfilledQuantity, marketQueue);
     } else if (side == Market::Side::SELL) {
-        while (unfilledQuantity && !bidBook.empty())
+        while (unfilledQuantity && !isInAuction() && !bidBookSize.empty())
             fillOrderByMatchingTopLimitQueue(order, unfilledQuantity, bidBook, bidBookSize);
         placeMarketOrderToMarketOrderQueue(order, unfilledQuantity, marketQueue);
     }
@@ -1216,24 +1904,176 @@ MatchingEngineFIFOSpsc::MatchingEngineFIFOSpsc() :
 }
 
 MatchingEngineFIFOSpsc::MatchingEngineFIFOSpsc(const MatchingEngineFIFOSpsc& matchingEngine) :
-    MatchingEngineFIFO(matchingEngine) {
+    MatchingEngineFIFO(matchingEngine),
+    myConsumerThreadConfig(matchingEngine.myConsumerThreadConfig) {
     init();
+    setQueueCapacity(matchingEngine.myOrderProcessingReportQueue->capacity(), matchingEngine.myOrderProcessingReportQueue->policy());
+}
+
+MatchingEngineFIFOSpsc::~MatchingEngineFIFOSpsc() {
+    stopConsumerThread();
+}
+
+void MatchingEngineFIFOSpsc::startConsumerThread() {
+    if (isConsumerThreadRunning())
+        Utils::Error::LIB_THROW("[MatchingEngineFIFOSpsc::startConsumerThread] Consumer thread is already running.");
+    myIsConsumerStopRequested.store(false, std::memory_order_release);
+    myConsumerThread = std::thread(&MatchingEngineFIFOSpsc::runConsumer, this);
+}
+
+void MatchingEngineFIFOSpsc::stopConsumerThread() {
+    if (!isConsumerThreadRunning())
+        return;
+    myIsConsumerStopRequested.store(true, std::memory_order_release);
+    myWakeSignal.notify();
+    myConsumerThread.join();
+}
+
+void MatchingEngineFIFOSpsc::setQueueCapacity(const size_t capacity, const Utils::Concurrency::OverflowPolicy overflowPolicy) {
+    if (isConsumerThreadRunning())
+        Utils::Error::LIB_THROW("[MatchingEngineFIFOSpsc::setQueueCapacity] Cannot resize the queues while the consumer thread is running.");
+    if ((myOrderProcessingReportQueue && !myOrderProcessingReportQueue->empty()) || (myOrderEventLatencyQueue && !myOrderEventLatencyQueue->empty()))
+        Utils::Error::LIB_THROW("[MatchingEngineFIFOSpsc::setQueueCapacity] Cannot resize the queues before they are drained.");
+    // the rings are first touched on the cpu of the consumer, which reads every slot of them
+    Utils::Concurrency::run_on_cpu(myConsumerThreadConfig.numa_local ? myConsumerThreadConfig.cpu : -1, [&]() {
+        myOrderProcessingReportQueue = std::make_unique<Utils::Concurrency::SpscBoundedRingBuffer<LoggedOrderProcessingReport>>(capacity, overflowPolicy);
+        myOrderEventLatencyQueue = std::make_unique<Utils::Concurrency::SpscBoundedRingBuffer<LoggedOrderEventLatency>>(capacity, overflowPolicy);
+    });
+}
+
+void MatchingEngineFIFOSpsc::setConsumerThreadConfig(const Utils::Concurrency::ThreadConfig& config) {
+    if (isConsumerThreadRunning())
+        Utils::Error::LIB_THROW("[MatchingEngineFIFOSpsc::setConsumerThreadConfig] Cannot configure the consumer thread while it is running.");
+    const bool isReplaced = config.numa_local != myConsumerThreadConfig.numa_local || config.cpu != myConsumerThreadConfig.cpu;
+    myConsumerThreadConfig = config;
+    if (!isReplaced)
+        return;
+    dispatchQueued(); // the queued structs reach their subscribers before the queues they sit in are re-placed
+    setQueueCapacity(myOrderProcessingReportQueue->capacity(), myOrderProcessingReportQueue->policy());
 }
 
-void MatchingEngineFIFOSpsc::logOrderProcessingReport(LoggedOrderProcessingReport loggedReport) {
+void MatchingEngineFIFOSpsc::flush() {
+    if (!isConsumerThreadRunning()) {
+        dispatchQueued();
+        return;
+    }
+    // dropped structs never reach the consumer
+    while (myNumDispatched.load(std::memory_order_acquire) + getNumDropped() < myNumQueued)
+        std::this_thread::yield();
+}
+
+size_t MatchingEngineFIFOSpsc::drain() {
+    if (isConsumerThreadRunning())
+        Utils::Error::LIB_THROW("[MatchingEngineFIFOSpsc::drain] Cannot drain while the consumer thread is running.");
+    return dispatchQueued();
+}
+
+size_t MatchingEngineFIFOSpsc::dispatchQueued() {
+    // the base class implementation is the actual dissemination - logs and callbacks
+    size_t numDispatched = 0;
+    LoggedOrderProcessingReport loggedReport;
+    while (myOrderProcessingReportQueue->try_pop(loggedReport)) {
+        MatchingEngineFIFO::publishOrderProcessingReport(std::move(loggedReport));
+        ++numDispatched;
+    }
+    LoggedOrderEventLatency loggedLatency;
+    while (myOrderEventLatencyQueue->try_pop(loggedLatency)) {
+        MatchingEngineFIFO::logOrderEventLatency(std::move(loggedLatency));
+        ++numDispatched;
+    }
+    myNumDispatched.fetch_add(numDispatched, std::memory_order_release);
+    return numDispatched;
+}
+
+void MatchingEngineFIFOSpsc::runConsumer() {
+    Utils::Concurrency::apply_thread_config(myConsumerThreadConfig);
+    Utils::Concurrency::IdleStrategy idleStrategy(myConsumerThreadConfig, &myWakeSignal);
+    while (true) {
+        const uint32_t epoch = myWakeSignal.epoch(); // read ahead of the look for work so that no wake-up is lost
+        if (myIsConsumerStopRequested.load(std::memory_order_acquire))
+            break;
+        if (dispatchQueued())
+            idleStrategy.reset();
+        else
+            idleStrategy.idle(epoch);
+    }
+    dispatchQueued(); // anything queued before the stop request
+}
+
+void MatchingEngineFIFOSpsc::publishOrderProcessingReport(LoggedOrderProcessingReport loggedReport) {
     // dump report to SPSC buffer and return immediately
-    myOrderProcessingReportQueue.push(std::move(loggedReport));
+    if (!isConsumerThreadRunning() && myOrderProcessingReportQueue->policy() == Utils::Concurrency::OverflowPolicy::BLOCK && myOrderProcessingReportQueue->full())
+        dispatchQueued(); // nobody else would ever free a slot
+    myOrderProcessingReportQueue->push(std::move(loggedReport));
+    ++myNumQueued;
+    notifyConsumer();
 }
 
 void MatchingEngineFIFOSpsc::logOrderEventLatency(LoggedOrderEventLatency loggedLatency) {
     // dump latency to SPSC buffer and return immediately
-    myOrderEventLatencyQueue.push(std::move(loggedLatency));
+    if (!isConsumerThreadRunning() && myOrderEventLatencyQueue->policy() == Utils::Concurrency::OverflowPolicy::BLOCK && myOrderEventLatencyQueue->full())
+        dispatchQueued();
+    myOrderEventLatencyQueue->push(std::move(loggedLatency));
+    ++myNumQueued;
+    notifyConsumer();
 }
 
 void MatchingEngineFIFOSpsc::reserve(const size_t numOrdersEstimate) {
+    // the queues are bounded rings sized by setQueueCapacity, independent of the number of orders
     MatchingEngineFIFO::reserve(numOrdersEstimate);
-    myOrderProcessingReportQueue.reserve(2 * numOrdersEstimate);
-    myOrderEventLatencyQueue.reserve(2 * numOrdersEstimate);
+}
+
+MatchingEngineFIFODisruptor::MatchingEngineFIFODisruptor() :
+    MatchingEngineFIFO() {
+    init();
+}
+
+MatchingEngineFIFODisruptor::MatchingEngineFIFODisruptor(const MatchingEngineFIFODisruptor& matchingEngine) :
+    MatchingEngineFIFO(matchingEngine) {
+    init();
+    setOutputRingCapacity(matchingEngine.myOutputRing->capacity());
+}
+
+MatchingEngineFIFODisruptor::~MatchingEngineFIFODisruptor() {
+    stopConsumerThreads();
+}
+
+void MatchingEngineFIFODisruptor::setOutputRingCapacity(const size_t capacity, const int cpu) {
+    if (myOutputRing->num_consumers() > 0)
+        Utils::Error::LIB_THROW("[MatchingEngineFIFODisruptor::setOutputRingCapacity] Cannot resize the output ring once consumers are added.");
+    Utils::Concurrency::run_on_cpu(cpu, [&]() { myOutputRing = std::make_unique<Utils::Concurrency::SpmcDisruptorRing<LoggedEngineOutput>>(capacity); });
+}
+
+size_t MatchingEngineFIFODisruptor::addOutputConsumer(const OutputHandler& handler, const std::vector<size_t>& dependencies) {
+    return myOutputRing->add_consumer(handler, dependencies);
+}
+
+size_t MatchingEngineFIFODisruptor::addEngineLogConsumer(const std::vector<size_t>& dependencies) {
+    // the base class implementation is the actual dissemination - logs and callbacks
+    return myOutputRing->add_consumer([this](const LoggedEngineOutput& output) {
+        if (output.loggedReport.report || output.loggedReport.delta) // delta-only entries carry the replace and coalesced deltas
+            MatchingEngineFIFO::publishOrderProcessingReport(output.loggedReport);
+        if (output.loggedLatency.latency)
+            MatchingEngineFIFO::logOrderEventLatency(output.loggedLatency);
+    }, dependencies);
+}
+
+void MatchingEngineFIFODisruptor::startConsumerThreads() {
+    if (isConsumerThreadsRunning())
+        Utils::Error::LIB_THROW("[MatchingEngineFIFODisruptor::startConsumerThreads] Consumer threads are already running.");
+    myOutputRing->start();
+}
+
+void MatchingEngineFIFODisruptor::stopConsumerThreads() {
+    myOutputRing->stop();
+}
+
+void MatchingEngineFIFODisruptor::publishOrderProcessingReport(LoggedOrderProcessingReport loggedReport) {
+    myOutputRing->publish(LoggedEngineOutput{std::move(loggedReport), {}});
+}
+
+void MatchingEngineFIFODisruptor::logOrderEventLatency(LoggedOrderEventLatency loggedLatency) {
+    myOutputRing->publish(LoggedEngineOutput{{}, std::move(loggedLatency)});
 }
 }
 
@@ -6,6 +6,7 @@
 #include "Market/Trade.hpp"
 #include "Exchange/MatchingEngineUtils.hpp"
 #include "Exchange/ITCHEncoder.hpp"
+#include "Exchange/ITCHDecoder.hpp"
 
 namespace Exchange {
 using PriceLevel = double;
@@ -16,6 +17,7 @@ using OrderEventLog = std::vector<std::shared_ptr<const Market::OrderEventBase>>
 using OrderProcessingReportLog = std::vector<std::shared_ptr<const OrderProcessingReport>>;
 using OrderBookSizeDeltaLog = std::vector<std::shared_ptr<const OrderBookSizeDelta>>;
 using ITCHMessageLog = std::vector<std::shared_ptr<const ITCHEncoder::ITCHMessage>>;
+using ITCHMessageValueLog = std::vector<ITCHEncoder::ITCHMessageValue>; // contiguous, one cache line per message
 using RemovedLimitOrderLog = std::vector<std::shared_ptr<const Market::LimitOrder>>;
 using DescOrderBook = std::map<PriceLevel, LimitQueue, std::greater<double>>;
 using AscOrderBook = std::map<PriceLevel, LimitQueue>;
@@ -32,6 +34,54 @@ using OrderProcessingCallback = CallbackFunction<OrderProcessingReport>; // comm
 using OrderBookDeltaCallback = CallbackFunction<OrderBookSizeDelta>; // communicates with MatchingEngineMonitor
 using OrderEventLatencyCallback = CallbackFunction<OrderEventLatency>; // communicates with MatchingEngineMonitor
 using ITCHMessageCallback = CallbackFunction<ITCHEncoder::ITCHMessage>;
+using SubscriptionId = uint64_t; // token returned on subscription and handed back to unsubscribe
+using TopOfBookSnapshotLock = Utils::Concurrency::SeqLock<TopOfBookSnapshot>;
+
+/* Selects by report type and side which reports a subscriber is called with - the book deltas and ITCH messages are selected
+   by the report they are emitted with. A null report falls under OrderProcessingType::NONE and never matches a side. */
+struct OrderProcessingReportFilter {
+    OrderProcessingReportFilter() = default;
+    OrderProcessingReportFilter(const std::initializer_list<OrderProcessingType>& types, const std::optional<Market::Side>& side = std::nullopt);
+    static OrderProcessingReportFilter allExcept(const std::initializer_list<OrderProcessingType>& types, const std::optional<Market::Side>& side = std::nullopt);
+    bool acceptsType(const OrderProcessingType type) const { return typeMask & (1u << static_cast<uint32_t>(type)); }
+    bool accepts(const OrderProcessingReport* report) const;
+    uint32_t typeMask = ~0u; // one bit per OrderProcessingType
+    std::optional<Market::Side> side;
+};
+
+/* Subscribers bucketed by report type so that a report only ever reaches the interested ones, each called directly in the order
+   of subscription. Not to be modified from within a callback. */
+template<typename T>
+class SubscriptionList {
+public:
+    bool empty() const { return std::all_of(mySubscriptionsByType.begin(), mySubscriptionsByType.end(), [](const auto& subscriptions) { return subscriptions.empty(); }); }
+    void add(const SubscriptionId id, const CallbackFunction<T>& callback, const OrderProcessingReportFilter& filter = {}) {
+        for (size_t type = 0; type < NUM_TYPES; ++type)
+            if (filter.acceptsType(static_cast<OrderProcessingType>(type)))
+                mySubscriptionsByType[type].push_back({id, filter.side, callback});
+    }
+    bool remove(const SubscriptionId id) {
+        bool removed = false;
+        for (auto& subscriptions : mySubscriptionsByType)
+            removed |= std::erase_if(subscriptions, [id](const Subscription& subscription) { return subscription.id == id; }) > 0;
+        return removed;
+    }
+    void dispatch(const OrderProcessingReport* report, const std::shared_ptr<const T>& payload) const {
+        const auto type = static_cast<size_t>(report ? report->orderProcessingType : OrderProcessingType::NONE);
+        for (const auto& subscription : mySubscriptionsByType[type])
+            if (!subscription.side || (report && report->orderSide == *subscription.side))
+                subscription.callback(payload);
+    }
+    void dispatch(const std::shared_ptr<const T>& payload) const { dispatch(nullptr, payload); } // for the streams not driven by reports
+private:
+    struct Subscription {
+        SubscriptionId id;
+        std::optional<Market::Side> side;
+        CallbackFunction<T> callback;
+    };
+    static constexpr size_t NUM_TYPES = static_cast<size_t>(OrderProcessingType::NONE) + 1;
+    std::array<std::vector<Subscription>, NUM_TYPES> mySubscriptionsByType;
+};
 
 /* A logger struct to store the order report and its associated order book size delta, emitted immediately
    from the matching engine right after processing the order event. */
@@ -46,6 +96,11 @@ struct LoggedOrderEventLatency {
     std::shared_ptr<const OrderEventLatency> latency;
 };
 
+struct LoggedEngineOutput {
+    LoggedOrderProcessingReport loggedReport; // report and delta are null for a latency
+    LoggedOrderEventLatency loggedLatency; // latency is null for a report
+};
+
 class IMatchingEngine {
 public:
     IMatchingEngine() = default;
@@ -91,6 +146,8 @@ public:
     virtual double getBestAskPrice() const = 0;
     virtual double getBidPriceAtLevel(const size_t level) const = 0;
     virtual double getAskPriceAtLevel(const size_t level) const = 0;
+    virtual double getBidPriceToFill(const uint32_t quantity) const = 0; // worst price reached by a market sell of the given quantity, NaN if the book is too thin
+    virtual double getAskPriceToFill(const uint32_t quantity) const = 0;
     virtual double getSpread() const = 0;
     virtual double getHalfSpread() const = 0;
     virtual double getMidPrice() const = 0;
@@ -102,12 +159,22 @@ public:
     virtual uint32_t getBidSize(const PriceLevel& priceLevel) const = 0;
     virtual uint32_t getAskSize(const PriceLevel& priceLevel) const = 0;
     virtual uint32_t getLastTradeSize() const = 0;
+    virtual uint32_t getBidDepthWithinTicks(const uint32_t numTicks) const = 0; // total size within numTicks ticks of the best price, both ends inclusive
+    virtual uint32_t getAskDepthWithinTicks(const uint32_t numTicks) const = 0;
+    virtual uint32_t getBidDepthInRange(const PriceLevel priceFrom, const PriceLevel priceTo) const = 0; // total size within [priceFrom, priceTo] to the tick
+    virtual uint32_t getAskDepthInRange(const PriceLevel priceFrom, const PriceLevel priceTo) const = 0;
     virtual size_t getNumberOfBidPriceLevels() const = 0;
     virtual size_t getNumberOfAskPriceLevels() const = 0;
     virtual size_t getNumberOfTrades() const = 0;
+    // order-independent hash of the price-level contents - the side, price, id and size of every resting limit order - so that equal books
+    // give equal hashes; it does not cover the time priority of the orders within their levels nor the queued market orders, so that books
+    // differing only in those hash equal
+    virtual uint64_t getBookStateHash() const = 0;
+    virtual double getMinimumPriceTick() const = 0;
     virtual std::optional<bool> getLastTradeIsBuyInitiated() const = 0;
     virtual std::shared_ptr<const Market::TradeBase> getLastTrade() const = 0;
     virtual std::shared_ptr<IMatchingEngine> clone() const = 0;
+    virtual std::shared_ptr<IMatchingEngine> fork(const bool includeLogs = false) const = 0; // cheap copy-on-write copy for what-if evaluation
     virtual void process(const std::shared_ptr<const Market::OrderBase>& order) = 0;
     virtual void process(const std::shared_ptr<const Market::OrderEventBase>& event) = 0; // OrderEventManager comminucates with MatchingEngine via this process method
     virtual void addToLimitOrderBook(std::shared_ptr<Market::LimitOrder> order) = 0; // left pure virtual unless the order matching strategy is defined
@@ -116,7 +183,13 @@ public:
     virtual void addOrderBookDeltaCallback(const CallbackSharedPtr<OrderBookSizeDelta>& callback) = 0;
     virtual void addOrderEventLatencyCallback(const CallbackSharedPtr<OrderEventLatency>& callback) = 0;
     virtual void addITCHMessageCallback(const CallbackSharedPtr<ITCHEncoder::ITCHMessage>& callback) = 0;
+    virtual SubscriptionId subscribeOrderProcessingReports(const OrderProcessingCallback& callback, const OrderProcessingReportFilter& filter = {}) = 0;
+    virtual SubscriptionId subscribeOrderBookDeltas(const OrderBookDeltaCallback& callback, const OrderProcessingReportFilter& filter = {}) = 0;
+    virtual SubscriptionId subscribeITCHMessages(const ITCHMessageCallback& callback, const OrderProcessingReportFilter& filter = {}) = 0;
+    virtual SubscriptionId subscribeOrderEventLatencies(const OrderEventLatencyCallback& callback) = 0;
+    virtual bool unsubscribe(const SubscriptionId subscriptionId) = 0; // returns false if the token is unknown
     virtual void reserve(const size_t numOrdersEstimate) = 0; // reserves memory for various data structures (e.g. vector, unordered_map)
+    virtual void setMinimumPriceTick(const double minimumPriceTick) = 0; // the tick of the price ladders behind the depth queries
     virtual void stateConsistencyCheck() const = 0; // checks the internal state of the matching engine for consistency
     virtual void init() = 0; // state consistency checks and class flags initialization called in every derived constructor
     virtual void reset(); // empties out the order book, trade log, market queue, world clock, logger, etc.
@@ -143,15 +216,21 @@ private:
 /* A simple MatchingEngine implmentation with O(1) order operations, including
    submission, cancellation, modification, BBO fetch etc. The order book state
    may be completely re-constructed if one gets the order events log, order reports
-   log, or the ITCH messages log. */
+   log, or the ITCH messages log.
+   A fork copies only the price level sizes and reads every other level through from its parent engine, copying a
+   level (and its orders) into its own book the first time it is touched by a fill, placement or order event. The
+   parent must outlive the fork and stay unmodified while the fork is in use. */
 class MatchingEngineBase : public IMatchingEngine {
 public:
     MatchingEngineBase();
     MatchingEngineBase(const MatchingEngineBase& matchingEngine);
+    MatchingEngineBase(const MatchingEngineBase& parent, const bool includeLogs); // fork constructor
     MatchingEngineBase(const bool debugMode) : IMatchingEngine(debugMode) {}
     MatchingEngineBase(const OrderEventLog& orderEventLog);
     MatchingEngineBase(const OrderProcessingReportLog& orderProcessingReportLog);
     virtual ~MatchingEngineBase() = default;
+    // for a fork the books hold only the levels materialized so far, the levels still read through from the parent are missing -
+    // use the book size maps, the level counts and the top-of-book accessors, which all cover the whole fork book
     const DescOrderBook& getBidBook() const { return myBidBook; }
     const AscOrderBook& getAskBook() const { return myAskBook; }
     const DescOrderBookSize& getBidBookSize() const { return myBidBookSize; }
@@ -163,11 +242,33 @@ public:
     const OrderBookSizeDeltaLog& getOrderBookSizeDeltaLog() const { return myOrderBookSizeDeltaLog; }
     const OrderEventLatencyLog& getOrderEventLatencyLog() const { return myOrderEventLatencyLog; }
     const ITCHMessageLog& getITCHMessageLog() const { return myITCHMessageLog; }
+    const ITCHMessageValueLog& getITCHMessageValueLog() const { return myITCHMessageValueLog; }
     const RemovedLimitOrderLog& getRemovedLimitOrderLog() const { return myRemovedLimitOrderLog; }
     const OrderIndex& getLimitOrderLookup() const { return myLimitOrderLookup; }
-    std::vector<CallbackSharedPtr<OrderProcessingReport>> getOrderProcessingCallbacks() const { return myOrderProcessingCallbacks; }
-    std::vector<CallbackSharedPtr<OrderEventLatency>> getOrderEventLatencyCallbacks() const { return myOrderEventLatencyCallbacks; }
-    std::vector<CallbackSharedPtr<ITCHEncoder::ITCHMessage>> getITCHMessageCallbacks() const { return myITCHMessageCallbacks; }
+    const PriceLadderIndex& getBidPriceLadder() const { return myBidPriceLadder; }
+    const PriceLadderIndex& getAskPriceLadder() const { return myAskPriceLadder; }
+    const MatchingEngineBase* getForkParent() const { return myForkParent; }
+    const std::shared_ptr<Utils::Memory::ObjectPool>& getReportPool() const { return myReportPool; }
+    void setReportPool(const std::shared_ptr<Utils::Memory::ObjectPool>& reportPool) { myReportPool = reportPool; } // null allocates from the heap
+    bool isFork() const { return myForkParent != nullptr; }
+    bool isInAuction() const { return myAuctionCrossCode.has_value(); }
+    std::optional<ITCHEncoder::CrossCode> getAuctionCrossCode() const { return myAuctionCrossCode; }
+    bool isCoalesceBookDeltas() const { return myCoalesceBookDeltas; }
+    void setCoalesceBookDeltas(const bool coalesceBookDeltas) { flushCoalescedBookDeltas(); myCoalesceBookDeltas = coalesceBookDeltas; }
+    bool isCompactITCHMessageLog() const { return myCompactITCHMessageLog; }
+    // the ITCH messages are logged by value into the ITCH message value log instead, the message log is left empty and the
+    // polymorphic messages are only made for the ITCH subscribers, if any
+    void setCompactITCHMessageLog(const bool compactITCHMessageLog) { myCompactITCHMessageLog = compactITCHMessageLog; }
+    void flushCoalescedBookDeltas(); // emits one net delta per touched level as delta-only entries, called at the end of every input event
+    size_t getTopOfBookSnapshotLevels() const { return myTopOfBookSnapshotLevels; }
+    void setTopOfBookSnapshotLevels(const size_t numLevels); // 0 turns the snapshot off, at most TopOfBookSnapshot::MAX_LEVELS
+    std::shared_ptr<const TopOfBookSnapshotLock> getTopOfBookSnapshotLock() const { return myTopOfBookSnapshot; } // null while off, readers may keep it past the engine
+    TopOfBookSnapshot getTopOfBookSnapshot() const; // callable from any thread as long as the levels are not changed meanwhile
+    void publishTopOfBookSnapshot(); // called at the end of every input event while on
+    const SubscriptionList<OrderProcessingReport>& getOrderProcessingSubscriptions() const { return myOrderProcessingSubscriptions; }
+    const SubscriptionList<OrderBookSizeDelta>& getOrderBookDeltaSubscriptions() const { return myOrderBookDeltaSubscriptions; }
+    const SubscriptionList<ITCHEncoder::ITCHMessage>& getITCHMessageSubscriptions() const { return myITCHMessageSubscriptions; }
+    const SubscriptionList<OrderEventLatency>& getOrderEventLatencySubscriptions() const { return myOrderEventLatencySubscriptions; }
     void setBidBook(const DescOrderBook& bidBook) { myBidBook = bidBook; }
     void setAskBook(const AscOrderBook& askBook) { myAskBook = askBook; }
     void setMarketQueue(const MarketQueue& marketQueue) { myMarketQueue = marketQueue; }
@@ -177,6 +278,7 @@ public:
     void setOrderBookSizeDeltaLog(const OrderBookSizeDeltaLog& orderBookSizeDeltaLog) { myOrderBookSizeDeltaLog = orderBookSizeDeltaLog; }
     void setOrderEventLatencyLog(const OrderEventLatencyLog& orderEventLatencyLog) { myOrderEventLatencyLog = orderEventLatencyLog; }
     void setITCHMessageLog(const ITCHMessageLog& itchMessageLog) { myITCHMessageLog = itchMessageLog; }
+    void setITCHMessageValueLog(const ITCHMessageValueLog& itchMessageValueLog) { myITCHMessageValueLog = itchMessageValueLog; }
     void setRemovedLimitOrderLog(const RemovedLimitOrderLog& removedLimitOrderLog) { myRemovedLimitOrderLog = removedLimitOrderLog; }
     void setLimitOrderLookup(const OrderIndex& limitOrderLookup) { myLimitOrderLookup = limitOrderLookup; }
     DescOrderBook getBidBook(const size_t numLevels) const;
@@ -206,6 +308,8 @@ public:
     double getBestAskPrice() const override;
     double getBidPriceAtLevel(const size_t level) const override;
     double getAskPriceAtLevel(const size_t level) const override;
+    double getBidPriceToFill(const uint32_t quantity) const override;
+    double getAskPriceToFill(const uint32_t quantity) const override;
     double getSpread() const override;
     double getHalfSpread() const override;
     double getMidPrice() const override;
@@ -217,28 +321,53 @@ public:
     uint32_t getBidSize(const PriceLevel& priceLevel) const override;
     uint32_t getAskSize(const PriceLevel& priceLevel) const override;
     uint32_t getLastTradeSize() const override;
+    uint32_t getBidDepthWithinTicks(const uint32_t numTicks) const override;
+    uint32_t getAskDepthWithinTicks(const uint32_t numTicks) const override;
+    uint32_t getBidDepthInRange(const PriceLevel priceFrom, const PriceLevel priceTo) const override;
+    uint32_t getAskDepthInRange(const PriceLevel priceFrom, const PriceLevel priceTo) const override;
     size_t getNumberOfBidPriceLevels() const override;
     size_t getNumberOfAskPriceLevels() const override;
     size_t getNumberOfTrades() const override;
+    uint64_t getBookStateHash() const override;
+    double getMinimumPriceTick() const override { return myBidPriceLadder.getPriceTick(); }
     std::optional<bool> getLastTradeIsBuyInitiated() const override;
     std::shared_ptr<const Market::TradeBase> getLastTrade() const override;
+    const LimitQueue* findLimitQueue(const Market::Side side, const PriceLevel price) const; // reads through to the fork parent for levels not yet materialized
+    std::shared_ptr<const Market::LimitOrder> findLimitOrder(const uint64_t orderId) const;
+    uint64_t getFillableQuantity(const Market::Side side, const PriceLevel price) const; // quantity an incoming limit order could take at once, takes O(log N)
+    void startAuction(const ITCHEncoder::CrossCode crossCode = ITCHEncoder::CrossCode::OPENING); // orders rest and queue without matching until the uncrossing
+    AuctionEquilibrium computeAuctionEquilibrium(const std::optional<double>& referencePrice = std::nullopt) const; // indicative clearing price, one pass over the crossed levels
+    AuctionEquilibrium uncrossAuction(const std::optional<double>& referencePrice = std::nullopt); // executes at the clearing price and resumes continuous matching
     virtual void process(const std::shared_ptr<const Market::OrderBase>& order) override;
     virtual void process(const std::shared_ptr<const Market::OrderEventBase>& event) override;
     virtual void build(const OrderEventLog& orderEventLog); // builds the book given some user-input order events stream
     virtual void build(const OrderProcessingReportLog& orderProcessingReportLog);
     virtual void build(const ITCHMessageLog& itchMessageLog);
+    virtual void build(const ITCHMessageValueLog& itchMessageValueLog);
+    // replays binary ITCH straight from the bytes into the same events as the message log, returns the number of messages decoded
+    virtual uint64_t buildFromITCHBinary(const std::vector<std::span<const uint8_t>>& chunks);
+    virtual uint64_t buildFromITCHBinaryFile(const std::string& filePath); // mmap'd
     template<typename OrderBookType, typename OrderBookSizeType>
     void fillOrderByMatchingTopLimitQueue(const std::shared_ptr<Market::OrderBase>& order, uint32_t& unfilledQuantity, OrderBookType& orderBook, OrderBookSizeType& orderBookSize);
     void executeAgainstQueuedMarketOrders(const std::shared_ptr<Market::LimitOrder>& order, uint32_t& unfilledQuantity, MarketQueue& marketQueue);
     virtual void placeLimitOrderToLimitOrderBook(std::shared_ptr<Market::LimitOrder>& order, const uint32_t unfilledQuantity, uint32_t& orderSizeTotal, LimitQueue& limitQueue);
     virtual void placeMarketOrderToMarketOrderQueue(std::shared_ptr<Market::MarketOrder>& order, const uint32_t unfilledQuantity, MarketQueue& marketQueue);
-    virtual void addOrderProcessingCallback(const CallbackSharedPtr<OrderProcessingReport>& callback) override { myOrderProcessingCallbacks.push_back(callback); }
-    virtual void addOrderBookDeltaCallback(const CallbackSharedPtr<OrderBookSizeDelta>& callback) override { myOrderBookSizeDeltaCallbacks.push_back(callback); }
-    virtual void addOrderEventLatencyCallback(const CallbackSharedPtr<OrderEventLatency>& callback) override { myOrderEventLatencyCallbacks.push_back(callback); }
-    virtual void addITCHMessageCallback(const CallbackSharedPtr<ITCHEncoder::ITCHMessage>& callback) override { myITCHMessageCallbacks.push_back(callback); }
-    virtual void logOrderProcessingReport(LoggedOrderProcessingReport loggedReport);
+    uint64_t computeBookStateHash() const; // re-computes the book state hash from scratch by traversing both books, takes O(N)
+    static uint64_t hashRestingOrder(const Market::Side side, const PriceLevel price, const uint64_t orderId, const uint32_t quantity);
+    virtual void addOrderProcessingCallback(const CallbackSharedPtr<OrderProcessingReport>& callback) override;
+    virtual void addOrderBookDeltaCallback(const CallbackSharedPtr<OrderBookSizeDelta>& callback) override;
+    virtual void addOrderEventLatencyCallback(const CallbackSharedPtr<OrderEventLatency>& callback) override;
+    virtual void addITCHMessageCallback(const CallbackSharedPtr<ITCHEncoder::ITCHMessage>& callback) override;
+    virtual SubscriptionId subscribeOrderProcessingReports(const OrderProcessingCallback& callback, const OrderProcessingReportFilter& filter = {}) override;
+    virtual SubscriptionId subscribeOrderBookDeltas(const OrderBookDeltaCallback& callback, const OrderProcessingReportFilter& filter = {}) override;
+    virtual SubscriptionId subscribeITCHMessages(const ITCHMessageCallback& callback, const OrderProcessingReportFilter& filter = {}) override;
+    virtual SubscriptionId subscribeOrderEventLatencies(const OrderEventLatencyCallback& callback) override;
+    virtual bool unsubscribe(const SubscriptionId subscriptionId) override;
+    void logOrderProcessingReport(LoggedOrderProcessingReport loggedReport); // folds the deltas into the batch in coalescing mode, then publishes
+    virtual void publishOrderProcessingReport(LoggedOrderProcessingReport loggedReport);
     virtual void logOrderEventLatency(LoggedOrderEventLatency loggedLatency);
     virtual void reserve(const size_t numOrdersEstimate) override;
+    virtual void setMinimumPriceTick(const double minimumPriceTick) override; // rebuilds the price ladders from the size maps, takes O(N)
     virtual void stateConsistencyCheck() const override;
     virtual void init() override;
     virtual void reset() override;
@@ -256,8 +385,19 @@ protected:
     OrderBookSizeDeltaLog& accessOrderBookSizeDeltaLog() { return myOrderBookSizeDeltaLog; }
     OrderEventLatencyLog& accessOrderEventLatencyLog() { return myOrderEventLatencyLog; }
     ITCHMessageLog& accessITCHMessageLog() { return myITCHMessageLog; }
+    ITCHMessageValueLog& accessITCHMessageValueLog() { return myITCHMessageValueLog; }
     RemovedLimitOrderLog& accessRemovedLimitOrderLog() { return myRemovedLimitOrderLog; }
     OrderIndex& accessLimitOrderLookup() { return myLimitOrderLookup; }
+    // XOR is its own inverse - the same call both adds and removes a resting order from the hash
+    void toggleBookStateHash(const Market::Side side, const PriceLevel price, const uint64_t orderId, const uint32_t quantity) { myBookStateHash ^= hashRestingOrder(side, price, orderId, quantity); }
+    bool isLevelMaterialized(const Market::Side side, const PriceLevel price) const;
+    void materializeLevel(const Market::Side side, const PriceLevel price); // copy-on-write of a parent level into the fork, no-op once materialized
+    template<typename OrderBookType, typename OrderBookSizeType>
+    std::shared_ptr<Market::LimitOrder> executeTopLimitOrder(const Market::Side side, OrderBookType& orderBook, OrderBookSizeType& orderBookSize, const uint32_t quantity);
+    bool rejectOnPreTradeCheck(const std::shared_ptr<Market::LimitOrder>& order); // FOK and post-only checks ahead of any book change
+    void cancelUnfilledQuantity(const std::shared_ptr<Market::LimitOrder>& order, const uint32_t unfilledQuantity); // drops an IOC/FOK remainder off the book
+    void updatePriceLadder(const Market::Side side, const PriceLevel price, const int64_t sizeDelta, const int32_t levelDelta) { (side == Market::Side::BUY ? myBidPriceLadder : myAskPriceLadder).update(price, sizeDelta, levelDelta); }
+    void coalesceBookDelta(const OrderBookSizeDelta& delta);
 private:
     // each order processing must remember to update ALL the following data structures at once, each operation takes O(1)
     DescOrderBook myBidBook;
@@ -271,24 +411,55 @@ private:
     OrderBookSizeDeltaLog myOrderBookSizeDeltaLog;
     OrderEventLatencyLog myOrderEventLatencyLog;
     ITCHMessageLog myITCHMessageLog; // another equivalent representation of the order processing report, trimmed and standardized
+    ITCHMessageValueLog myITCHMessageValueLog; // the same in compact mode, without the reports that make no message
     RemovedLimitOrderLog myRemovedLimitOrderLog;
     OrderIndex myLimitOrderLookup;
+    PriceLadderIndex myBidPriceLadder; // cumulative depth over the tick ladder mirroring the size maps, for O(log N) depth queries
+    PriceLadderIndex myAskPriceLadder;
+    // the reports, deltas and order copies made here are drawn from and recycled into this pool, owned by the thread calling process -
+    // every engine, a copy or a fork included, starts with a pool of its own
+    std::shared_ptr<Utils::Memory::ObjectPool> myReportPool = std::make_shared<Utils::Memory::ObjectPool>();
+    uint64_t myBookStateHash = 0; // Zobrist-style XOR over the resting orders, updated in O(1) on every order add/remove/resize - a queue position would cost O(queue) per removal
+    // copy-on-write fork state - the materialized level sets are keyed by int price and keep the levels the fork has emptied since
+    const MatchingEngineBase* myForkParent = nullptr;
+    uint64_t myForkParentBookStateHash = 0; // guards against the parent book changing underneath the fork
+    std::unordered_set<int64_t> myMaterializedBidLevels; // keyed by the 64-bit integer price, which does not wrap at high prices
+    std::unordered_set<int64_t> myMaterializedAskLevels;
+    std::optional<ITCHEncoder::CrossCode> myAuctionCrossCode; // set while in the call auction phase
+    // coalescing mode - the per-fill and per-modify deltas of an input event are netted per price level instead of published one by one
+    struct CoalescedBookDelta {
+        Market::Side side;
+        PriceLevel price;
+        int64_t netSizeDelta;
+        uint64_t reportId; // of the last report touching the level
+        uint64_t orderId;
+    };
+    bool myCoalesceBookDeltas = false;
+    bool myCompactITCHMessageLog = false;
+    std::vector<CoalescedBookDelta> myCoalescedBookDeltas;
+    // seqlock-protected copy of the top levels for readers on other threads, published by the thread calling process
+    size_t myTopOfBookSnapshotLevels = 0;
+    std::shared_ptr<TopOfBookSnapshotLock> myTopOfBookSnapshot;
     // the order processing callback can be as complicated as it gets (e.g. the report routed to various handlers)
     // but the exposed interface must be simple
-    std::vector<CallbackSharedPtr<OrderProcessingReport>> myOrderProcessingCallbacks;
-    std::vector<CallbackSharedPtr<OrderBookSizeDelta>> myOrderBookSizeDeltaCallbacks;
-    std::vector<CallbackSharedPtr<OrderEventLatency>> myOrderEventLatencyCallbacks;
-    std::vector<CallbackSharedPtr<ITCHEncoder::ITCHMessage>> myITCHMessageCallbacks;
+    SubscriptionId myLastSubscriptionId = 0;
+    SubscriptionList<OrderProcessingReport> myOrderProcessingSubscriptions;
+    SubscriptionList<OrderBookSizeDelta> myOrderBookDeltaSubscriptions;
+    SubscriptionList<ITCHEncoder::ITCHMessage> myITCHMessageSubscriptions;
+    SubscriptionList<OrderEventLatency> myOrderEventLatencySubscriptions;
 };
 
 class MatchingEngineFIFO : public MatchingEngineBase {
 public:
     MatchingEngineFIFO();
     MatchingEngineFIFO(const MatchingEngineFIFO& matchingEngine);
+    MatchingEngineFIFO(const MatchingEngineFIFO& parent, const bool includeLogs);
     MatchingEngineFIFO(const bool debugMode) : MatchingEngineBase(debugMode) {}
     MatchingEngineFIFO(const OrderProcessingReportLog& orderProcessingReportLog) : MatchingEngineBase(orderProcessingReportLog) {}
     virtual ~MatchingEngineFIFO() = default;
     virtual std::shared_ptr<IMatchingEngine> clone() const override { return std::make_shared<MatchingEngineFIFO>(*this); }
+    // also used by MatchingEngineFIFOSpsc, a fork carries no callbacks so there is nothing to disseminate off the hot path
+    virtual std::shared_ptr<IMatchingEngine> fork(const bool includeLogs = false) const override { return std::make_shared<MatchingEngineFIFO>(*this, includeLogs); }
     virtual void addToLimitOrderBook(std::shared_ptr<Market::LimitOrder> order) override;
     virtual void executeMarketOrder(std::shared_ptr<Market::MarketOrder> order) override;
     virtual void init() override;
@@ -296,22 +467,82 @@ public:
 
 /* An SPSC concurrency model of the FIFO engine - the "producer" that dumps the order processing report and event latency structs
    into the pre-allocated buffers and return immediately to process ensuing orders, whereas callbacks as the "consumer" operate in a parallel
-   manner to consume the dumped structs. The latter is orders of magnitude slower due to book state copying e.g. OrderBookTopLevelsSnapshot. */
+   manner to consume the dumped structs. The latter is orders of magnitude slower due to book state copying e.g. OrderBookTopLevelsSnapshot.
+   The consumer is either a dedicated thread owned by the engine (startConsumerThread) or the caller itself (drain). Either way the consumer
+   appends to the engine logs and runs the report, book delta, ITCH and latency callbacks, so the logs are only to be read after a flush and
+   the callbacks must not read the live book state. The buffers are bounded rings whose overflow policy decides between blocking the matching
+   thread, dropping the oldest structs and spilling to an overflow arena - a full blocking ring without a consumer thread is drained inline.
+   The consumer thread config sets the cpu the consumer is pinned to, the NUMA node the buffers are placed on and how the consumer idles. */
 class MatchingEngineFIFOSpsc : public MatchingEngineFIFO {
 public:
     MatchingEngineFIFOSpsc();
     MatchingEngineFIFOSpsc(const MatchingEngineFIFOSpsc& matchingEngine);
     MatchingEngineFIFOSpsc(const bool debugMode) : MatchingEngineFIFO(debugMode) {}
     MatchingEngineFIFOSpsc(const OrderProcessingReportLog& orderProcessingReportLog) : MatchingEngineFIFO(orderProcessingReportLog) {}
-    virtual ~MatchingEngineFIFOSpsc() = default;
+    virtual ~MatchingEngineFIFOSpsc();
     virtual std::shared_ptr<IMatchingEngine> clone() const override { return std::make_shared<MatchingEngineFIFOSpsc>(*this); }
+    bool isConsumerThreadRunning() const { return myConsumerThread.joinable(); }
+    uint64_t getNumQueued() const { return myNumQueued; } // producer side count
+    uint64_t getNumDispatched() const { return myNumDispatched.load(std::memory_order_acquire); }
+    uint64_t getNumDropped() const { return myOrderProcessingReportQueue->num_dropped() + myOrderEventLatencyQueue->num_dropped(); }
+    const Utils::Concurrency::SpscBoundedRingBuffer<LoggedOrderProcessingReport>& getOrderProcessingReportQueue() const { return *myOrderProcessingReportQueue; }
+    const Utils::Concurrency::SpscBoundedRingBuffer<LoggedOrderEventLatency>& getOrderEventLatencyQueue() const { return *myOrderEventLatencyQueue; }
+    const Utils::Concurrency::ThreadConfig& getConsumerThreadConfig() const { return myConsumerThreadConfig; }
+    uint64_t getNumConsumerSleeps() const { return myWakeSignal.num_sleeps(); }
+    void setQueueCapacity(const size_t capacity, const Utils::Concurrency::OverflowPolicy overflowPolicy = Utils::Concurrency::OverflowPolicy::BLOCK);
+    void setConsumerThreadConfig(const Utils::Concurrency::ThreadConfig& config); // drains and re-places the buffers on the NUMA node of the consumer
+    void startConsumerThread(); // spawns the consumer thread that drains the buffers off the matching thread
+    void stopConsumerThread(); // dispatches whatever is left in the buffers and joins the consumer thread
+    void flush(); // blocks until everything queued so far is dispatched, drains on the calling thread if no consumer thread runs
+    size_t drain(); // dispatches all the queued structs on the calling thread when no consumer thread runs, returns the number dispatched
     virtual void init() override { MatchingEngineFIFO::init(); }
-    virtual void logOrderProcessingReport(LoggedOrderProcessingReport loggedReport) override;
+    virtual void publishOrderProcessingReport(LoggedOrderProcessingReport loggedReport) override;
     virtual void logOrderEventLatency(LoggedOrderEventLatency loggedLatency) override;
     virtual void reserve(const size_t numOrdersEstimate) override;
 private:
-    Utils::Concurrency::SpscPreallocatedBuffer<LoggedOrderProcessingReport> myOrderProcessingReportQueue;
-    Utils::Concurrency::SpscPreallocatedBuffer<LoggedOrderEventLatency> myOrderEventLatencyQueue;
+    void runConsumer();
+    size_t dispatchQueued(); // the consumer side of drain, called by the one consumer only
+    void notifyConsumer() { if (myConsumerThreadConfig.wait_strategy == Utils::Concurrency::WaitStrategy::FUTEX) myWakeSignal.notify(); }
+    std::unique_ptr<Utils::Concurrency::SpscBoundedRingBuffer<LoggedOrderProcessingReport>> myOrderProcessingReportQueue =
+        std::make_unique<Utils::Concurrency::SpscBoundedRingBuffer<LoggedOrderProcessingReport>>();
+    std::unique_ptr<Utils::Concurrency::SpscBoundedRingBuffer<LoggedOrderEventLatency>> myOrderEventLatencyQueue =
+        std::make_unique<Utils::Concurrency::SpscBoundedRingBuffer<LoggedOrderEventLatency>>();
+    uint64_t myNumQueued = 0; // producer only
+    std::atomic<uint64_t> myNumDispatched{0};
+    std::atomic<bool> myIsConsumerStopRequested{false};
+    std::thread myConsumerThread;
+    Utils::Concurrency::ThreadConfig myConsumerThreadConfig;
+    Utils::Concurrency::WakeSignal myWakeSignal;
+};
+
+/* A fan-out model of the FIFO engine - every report and latency is published once into a disruptor ring, and each output consumer
+   (monitor, order event manager, journal writer, risk) handles it in place on its own thread. The engine logs and callbacks are one
+   such consumer (addEngineLogConsumer) and can be made to depend on e.g. a journal writer, which then persists a report before the
+   order event manager gets to acknowledge it. Without an engine log consumer the engine logs and callbacks stay empty. Before the
+   consumer threads start the consumers run inline on the matching thread. */
+class MatchingEngineFIFODisruptor : public MatchingEngineFIFO {
+public:
+    using OutputHandler = std::function<void(const LoggedEngineOutput&)>;
+    MatchingEngineFIFODisruptor();
+    MatchingEngineFIFODisruptor(const MatchingEngineFIFODisruptor& matchingEngine); // the consumers are not carried over
+    MatchingEngineFIFODisruptor(const bool debugMode) : MatchingEngineFIFO(debugMode) {}
+    virtual ~MatchingEngineFIFODisruptor();
+    virtual std::shared_ptr<IMatchingEngine> clone() const override { return std::make_shared<MatchingEngineFIFODisruptor>(*this); }
+    bool isConsumerThreadsRunning() const { return myOutputRing->running(); }
+    const Utils::Concurrency::SpmcDisruptorRing<LoggedEngineOutput>& getOutputRing() const { return *myOutputRing; }
+    void setOutputRingCapacity(const size_t capacity, const int cpu = -1); // a cpu places the ring on its NUMA node
+    size_t addOutputConsumer(const OutputHandler& handler, const std::vector<size_t>& dependencies = {}); // returns the consumer id
+    void setConsumerThreadConfig(const size_t consumerId, const Utils::Concurrency::ThreadConfig& config) { myOutputRing->set_thread_config(consumerId, config); }
+    size_t addEngineLogConsumer(const std::vector<size_t>& dependencies = {});
+    void startConsumerThreads();
+    void stopConsumerThreads(); // the consumers handle everything published so far before their threads are joined
+    void flush() const { myOutputRing->flush(); }
+    virtual void init() override { MatchingEngineFIFO::init(); }
+    virtual void publishOrderProcessingReport(LoggedOrderProcessingReport loggedReport) override;
+    virtual void logOrderEventLatency(LoggedOrderEventLatency loggedLatency) override;
+private:
+    std::unique_ptr<Utils::Concurrency::SpmcDisruptorRing<LoggedEngineOutput>> myOutputRing =
+        std::make_unique<Utils::Concurrency::SpmcDisruptorRing<LoggedEngineOutput>>();
 };
 
 std::ostream& operator<<(std::ostream& out, const IMatchingEngine& matchingEngine);
@@ -0,0 +1,241 @@
+#ifndef MATCHING_ENGINE_GATEWAY_CPP
+#define MATCHING_ENGINE_GATEWAY_CPP
+#include "Utils/Utils.hpp"
+#include "Market/Order.hpp"
+#include "Market/OrderEvent.hpp"
+#include "Exchange/MatchingEngineUtils.hpp"
+#include "Exchange/MatchingEngine.hpp"
+#include "Exchange/MatchingEngineGateway.hpp"
+
+namespace Exchange {
+using Utils::operator<<;
+
+MatchingEngineGateway::Session::Session(MatchingEngineGateway& gateway, const uint64_t sessionId, const size_t reportChannelCapacity) :
+    myGateway(gateway), mySessionId(sessionId), myReportChannel(reportChannelCapacity, Utils::Concurrency::OverflowPolicy::SPILL) {}
+
+MatchingEngineGateway& MatchingEngineGateway::Session::getGateway() const {
+    if (isClosed())
+        Utils::Error::LIB_THROW("[MatchingEngineGateway::Session] Session " + std::to_string(mySessionId) + " is closed, its gateway is gone.");
+    return myGateway;
+}
+
+std::shared_ptr<const Market::OrderSubmitEvent> MatchingEngineGateway::Session::submitLimitOrder(const Market::Side side, const uint32_t quantity,
+    const double price, const Market::TimeInForce timeInForce) {
+    auto& gateway = getGateway();
+    const auto& order = std::make_shared<Market::LimitOrder>(gateway.generateOrderId(), gateway.clockTick(), side, quantity,
+        Utils::Maths::roundPriceToTick(price, gateway.getMinimumPriceTick()));
+    order->setTimeInForce(timeInForce);
+    const auto& event = std::make_shared<const Market::OrderSubmitEvent>(gateway.generateEventId(), order->getId(), order->getTimestamp(), order);
+    submit(event);
+    return event;
+}
+
+std::shared_ptr<const Market::OrderSubmitEvent> MatchingEngineGateway::Session::submitMarketOrder(const Market::Side side, const uint32_t quantity) {
+    auto& gateway = getGateway();
+    const auto& order = std::make_shared<Market::MarketOrder>(gateway.generateOrderId(), gateway.clockTick(), side, quantity);
+    const auto& event = std::make_shared<const Market::OrderSubmitEvent>(gateway.generateEventId(), order->getId(), order->getTimestamp(), order);
+    submit(event);
+    return event;
+}
+
+std::shared_ptr<const Market::OrderCancelEvent> MatchingEngineGateway::Session::cancelOrder(const uint64_t orderId) {
+    auto& gateway = getGateway();
+    const auto& event = std::make_shared<const Market::OrderCancelEvent>(gateway.generateEventId(), orderId, gateway.clockTick());
+    submit(event);
+    return event;
+}
+
+std::shared_ptr<const Market::OrderModifyPriceEvent> MatchingEngineGateway::Session::modifyOrderPrice(const uint64_t orderId, const double modifiedPrice) {
+    auto& gateway = getGateway();
+    const auto& event = std::make_shared<const Market::OrderModifyPriceEvent>(gateway.generateEventId(), orderId, gateway.clockTick(),
+        Utils::Maths::roundPriceToTick(modifiedPrice, gateway.getMinimumPriceTick()));
+    submit(event);
+    return event;
+}
+
+std::shared_ptr<const Market::OrderModifyQuantityEvent> MatchingEngineGateway::Session::modifyOrderQuantity(const uint64_t orderId, const uint32_t modifiedQuantity) {
+    auto& gateway = getGateway();
+    const auto& event = std::make_shared<const Market::OrderModifyQuantityEvent>(gateway.generateEventId(), orderId, gateway.clockTick(), modifiedQuantity);
+    submit(event);
+    return event;
+}
+
+void MatchingEngineGateway::Session::submit(const std::shared_ptr<const Market::OrderEventBase>& event) {
+    if (!event)
+        Utils::Error::LIB_THROW("[MatchingEngineGateway::Session::submit] Order event is null.");
+    auto& gateway = getGateway();
+    gateway.myIngressQueue->push({event, this});
+    ++myNumSubmitted;
+    if (gateway.myMatchingThreadConfig.wait_strategy == Utils::Concurrency::WaitStrategy::FUTEX)
+        gateway.myWakeSignal.notify();
+}
+
+void MatchingEngineGateway::Session::flush() {
+    while (getNumProcessed() < myNumSubmitted) {
+        if (!getGateway().tryDrain())
+            std::this_thread::yield();
+    }
+}
+
+MatchingEngineGateway::MatchingEngineGateway(const std::shared_ptr<IMatchingEngine>& matchingEngine, const size_t queueCapacity) :
+    myMatchingEngine(matchingEngine), myIngressQueue(std::make_unique<Utils::Concurrency::MpscBoundedQueue<IngressRequest>>(queueCapacity)) {
+    if (!matchingEngine)
+        Utils::Error::LIB_THROW("[MatchingEngineGateway] Matching engine is null.");
+    myBatch.reserve(myMaxBatchSize);
+    myOrderProcessingSubscriptionId = myMatchingEngine->subscribeOrderProcessingReports(
+        [this](const std::shared_ptr<const OrderProcessingReport>& report) { routeReport(report); },
+        OrderProcessingReportFilter::allExcept({OrderProcessingType::CROSS, OrderProcessingType::NONE}));
+}
+
+MatchingEngineGateway::~MatchingEngineGateway() {
+    stop();
+    myMatchingEngine->unsubscribe(myOrderProcessingSubscriptionId);
+    std::lock_guard<std::mutex> lock(mySessionsMutex);
+    for (const auto& session : mySessions)
+        session->myIsClosed.store(true, std::memory_order_release);
+}
+
+size_t MatchingEngineGateway::getNumSessions() const {
+    std::lock_guard<std::mutex> lock(mySessionsMutex);
+    return mySessions.size();
+}
+
+std::shared_ptr<MatchingEngineGateway::Session> MatchingEngineGateway::openSession(const size_t reportChannelCapacity) {
+    std::lock_guard<std::mutex> lock(mySessionsMutex);
+    mySessions.push_back(std::make_shared<Session>(*this, mySessions.size(), reportChannelCapacity));
+    return mySessions.back();
+}
+
+void MatchingEngineGateway::setMatchingThreadConfig(const Utils::Concurrency::ThreadConfig& config) {
+    if (isRunning())
+        Utils::Error::LIB_THROW("[MatchingEngineGateway::setMatchingThreadConfig] Cannot configure the matching thread while it is running.");
+    myMatchingThreadConfig = config;
+    if (!config.numa_local || config.cpu < 0)
+        return;
+    if (!myIngressQueue->empty())
+        Utils::Error::LIB_THROW("[MatchingEngineGateway::setMatchingThreadConfig] Cannot re-place the ingress queue before it is drained.");
+    const size_t capacity = myIngressQueue->capacity();
+    Utils::Concurrency::run_on_cpu(config.cpu, [&]() { myIngressQueue = std::make_unique<Utils::Concurrency::MpscBoundedQueue<IngressRequest>>(capacity); });
+}
+
+void MatchingEngineGateway::start() {
+    std::lock_guard<std::mutex> lock(myDrainMutex); // waits out any inline drain
+    if (isRunning())
+        Utils::Error::LIB_THROW("[MatchingEngineGateway::start] Matching thread is already running.");
+    myIsStopRequested.store(false, std::memory_order_release);
+    myMatchingThread = std::thread(&MatchingEngineGateway::runMatching, this);
+    myIsRunning.store(true, std::memory_order_release);
+}
+
+void MatchingEngineGateway::stop() {
+    if (!isRunning())
+        return;
+    myIsStopRequested.store(true, std::memory_order_release);
+    myWakeSignal.notify();
+    myMatchingThread.join();
+    myIsRunning.store(false, std::memory_order_release);
+}
+
+size_t MatchingEngineGateway::drain() {
+    std::lock_guard<std::mutex> lock(myDrainMutex);
+    if (isRunning())
+        Utils::Error::LIB_THROW("[MatchingEngineGateway::drain] Cannot drain while the matching thread is running.");
+    return drainBatches();
+}
+
+bool MatchingEngineGateway::tryDrain() {
+    std::lock_guard<std::mutex> lock(myDrainMutex);
+    if (isRunning())
+        return false;
+    drainBatches();
+    return true;
+}
+
+size_t MatchingEngineGateway::drainBatches() {
+    size_t numProcessed = 0;
+    while (const size_t n = processBatch())
+        numProcessed += n;
+    return numProcessed;
+}
+
+size_t MatchingEngineGateway::processBatch() {
+    myBatch.clear();
+    const size_t n = myIngressQueue->pop_batch(myBatch, myMaxBatchSize);
+    if (n == 0)
+        return 0;
+    for (const auto& request : myBatch)
+        processRequest(request);
+    myNumBatches.fetch_add(1, std::memory_order_release);
+    return n;
+}
+
+void MatchingEngineGateway::processRequest(const IngressRequest& request) {
+    const auto& [event, session] = request;
+    // a submission must not take over a live order, an event must not touch the order of another session
+    const auto [it, isUnknownOrder] = myOrderOwners.try_emplace(event->getOrderId(), session);
+    if (isUnknownOrder || (!event->isSubmit() && it->second == session)) {
+        myMatchingEngine->process(event);
+        // the reports of an event on an unknown order were routed back to its sender, which does not own the order thereafter
+        if (isUnknownOrder && !event->isSubmit())
+            myOrderOwners.erase(event->getOrderId());
+    } else {
+        session->myNumRejected.fetch_add(1, std::memory_order_release);
+        myNumRejected.fetch_add(1, std::memory_order_release);
+    }
+    session->myNumProcessed.fetch_add(1, std::memory_order_release);
+    myNumProcessed.fetch_add(1, std::memory_order_release);
+}
+
+void MatchingEngineGateway::routeReport(const std::shared_ptr<const OrderProcessingReport>& report) {
+    if (!report)
+        return;
+    const auto it = myOrderOwners.find(report->orderId);
+    if (it == myOrderOwners.end())
+        return;
+    Session* owner = it->second;
+    owner->myReportChannel.push(std::shared_ptr<const OrderProcessingReport>(report));
+    // the owners are dropped upon the last report of an order, so that the map only holds the live orders
+    bool isLastReport = false;
+    switch (report->orderProcessingType) {
+    case OrderProcessingType::EXECUTE: {
+        const OrderExecutionType executionType = static_cast<const OrderExecutionReport&>(*report).orderExecutionType;
+        isLastReport = executionType == OrderExecutionType::FILLED || executionType == OrderExecutionType::CANCELLED || executionType == OrderExecutionType::REJECTED;
+        break;
+    }
+    case OrderProcessingType::CANCEL:
+        isLastReport = report->status == OrderProcessingStatus::SUCCESS;
+        break;
+    case OrderProcessingType::CANCEL_REPLACE:
+        if (report->status == OrderProcessingStatus::SUCCESS) {
+            const uint64_t newOrderId = static_cast<const OrderCancelAndReplaceReport&>(*report).newOrderId;
+            myOrderOwners[newOrderId] = owner;
+            isLastReport = newOrderId != report->orderId;
+        }
+        break;
+    case OrderProcessingType::SUBMIT:
+        isLastReport = report->status == OrderProcessingStatus::FAILURE;
+        break;
+    default:
+        break;
+    }
+    if (isLastReport)
+        myOrderOwners.erase(report->orderId);
+}
+
+void MatchingEngineGateway::runMatching() {
+    Utils::Concurrency::apply_thread_config(myMatchingThreadConfig);
+    Utils::Concurrency::IdleStrategy idleStrategy(myMatchingThreadConfig, &myWakeSignal);
+    while (true) {
+        const uint32_t epoch = myWakeSignal.epoch(); // read ahead of the look for work so that no wake-up is lost
+        if (myIsStopRequested.load(std::memory_order_acquire))
+            break;
+        if (processBatch())
+            idleStrategy.reset();
+        else
+            idleStrategy.idle(epoch);
+    }
+    while (processBatch()); // anything submitted before the stop request
+}
+}
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef MATCHING_ENGINE_GATEWAY_HPP
+#define MATCHING_ENGINE_GATEWAY_HPP
+#include "Utils/Utils.hpp"
+#include "Market/Order.hpp"
+#include "Market/OrderEvent.hpp"
+#include "Exchange/MatchingEngineUtils.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+namespace Exchange {
+/* An order entry gateway in front of a matching engine: any number of producer threads submit order events through their own sessions
+   into a bounded MPSC ingress queue, and a single matching thread dequeues them in batches and is the only one to call process on
+   the engine. Every session gets the reports of its own orders back on its own SPSC channel, which spills rather than blocks so that
+   a slow strategy never stalls the matching thread. A session may only touch the orders it owns - events on orders of other sessions
+   are rejected at the gateway. The gateway must be the only entry to the engine, and the engine must run its subscriptions on the
+   matching thread (e.g. MatchingEngineFIFO). Without the matching thread the caller drains the queue itself, which is deterministic -
+   the drains of concurrent callers are serialized so that the queue keeps a single consumer. An order is owned by its session from
+   its submission to its last report (filled, cancelled or rejected), and a submission of an order id still owned is rejected.
+   The matching thread config pins the matching thread, places the ingress queue on its NUMA node and sets how it idles. */
+class MatchingEngineGateway {
+public:
+    using ReportChannel = Utils::Concurrency::SpscBoundedRingBuffer<std::shared_ptr<const OrderProcessingReport>>;
+    static constexpr size_t DEFAULT_QUEUE_CAPACITY = 1 << 16;
+    static constexpr size_t DEFAULT_REPORT_CHANNEL_CAPACITY = 1 << 12;
+    static constexpr size_t DEFAULT_MAX_BATCH_SIZE = 64;
+
+    /* The handle of one producer, to be used from a single thread. The order and event ids are unique across the sessions of a gateway.
+       A session may outlive its gateway: the gateway closes its sessions when destroyed, and a closed session throws on every call
+       that would reach the gateway. The gateway must not be destroyed while a call of its sessions is in flight. */
+    class Session {
+    public:
+        Session(MatchingEngineGateway& gateway, const uint64_t sessionId, const size_t reportChannelCapacity);
+        Session(const Session&) = delete;
+        uint64_t getSessionId() const { return mySessionId; }
+        uint64_t getNumSubmitted() const { return myNumSubmitted; }
+        uint64_t getNumProcessed() const { return myNumProcessed.load(std::memory_order_acquire); }
+        uint64_t getNumRejected() const { return myNumRejected.load(std::memory_order_acquire); }
+        bool isClosed() const { return myIsClosed.load(std::memory_order_acquire); }
+        const ReportChannel& getReportChannel() const { return myReportChannel; }
+        std::shared_ptr<const Market::OrderSubmitEvent> submitLimitOrder(const Market::Side side, const uint32_t quantity, const double price,
+            const Market::TimeInForce timeInForce = Market::TimeInForce::GTC);
+        std::shared_ptr<const Market::OrderSubmitEvent> submitMarketOrder(const Market::Side side, const uint32_t quantity);
+        std::shared_ptr<const Market::OrderCancelEvent> cancelOrder(const uint64_t orderId);
+        std::shared_ptr<const Market::OrderModifyPriceEvent> modifyOrderPrice(const uint64_t orderId, const double modifiedPrice);
+        std::shared_ptr<const Market::OrderModifyQuantityEvent> modifyOrderQuantity(const uint64_t orderId, const uint32_t modifiedQuantity);
+        void submit(const std::shared_ptr<const Market::OrderEventBase>& event); // blocks while the ingress queue is full
+        bool pollReport(std::shared_ptr<const OrderProcessingReport>& report) { return myReportChannel.try_pop(report); }
+        void flush(); // blocks until every event submitted so far is processed, drains the gateway inline if its matching thread is not running
+    private:
+        friend class MatchingEngineGateway;
+        MatchingEngineGateway& getGateway() const; // throws once the gateway is closed
+        MatchingEngineGateway& myGateway;
+        const uint64_t mySessionId;
+        uint64_t myNumSubmitted = 0; // producer only
+        std::atomic<uint64_t> myNumProcessed{0};
+        std::atomic<uint64_t> myNumRejected{0};
+        std::atomic<bool> myIsClosed{false}; // set by the destructor of the gateway, whose reference is dangling from then on
+        ReportChannel myReportChannel;
+    };
+
+    MatchingEngineGateway() = delete;
+    MatchingEngineGateway(const std::shared_ptr<IMatchingEngine>& matchingEngine, const size_t queueCapacity = DEFAULT_QUEUE_CAPACITY);
+    MatchingEngineGateway(const MatchingEngineGateway&) = delete; // the engine subscription is bound to this instance
+    virtual ~MatchingEngineGateway();
+
+    std::shared_ptr<IMatchingEngine> getMatchingEngine() const { return myMatchingEngine; }
+    const Utils::Concurrency::MpscBoundedQueue<std::pair<std::shared_ptr<const Market::OrderEventBase>, Session*>>& getIngressQueue() const { return *myIngressQueue; }
+    const Utils::Concurrency::ThreadConfig& getMatchingThreadConfig() const { return myMatchingThreadConfig; }
+    uint64_t getNumMatchingThreadSleeps() const { return myWakeSignal.num_sleeps(); }
+    size_t getNumSessions() const;
+    size_t getMaxBatchSize() const { return myMaxBatchSize; }
+    double getMinimumPriceTick() const { return myMinimumPriceTick; }
+    uint64_t getNumProcessed() const { return myNumProcessed.load(std::memory_order_acquire); }
+    uint64_t getNumBatches() const { return myNumBatches.load(std::memory_order_acquire); }
+    uint64_t getNumRejected() const { return myNumRejected.load(std::memory_order_acquire); }
+    size_t getNumOwnedOrders() const { return myOrderOwners.size(); } // only while the matching thread is not running
+    bool isRunning() const { return myIsRunning.load(std::memory_order_acquire); }
+    void setMaxBatchSize(const size_t maxBatchSize) { myMaxBatchSize = std::max<size_t>(maxBatchSize, 1); }
+    void setMinimumPriceTick(const double minimumPriceTick) { myMinimumPriceTick = minimumPriceTick; }
+    void setMatchingThreadConfig(const Utils::Concurrency::ThreadConfig& config); // re-places the empty ingress queue on the NUMA node of the matching thread
+
+    std::shared_ptr<Session> openSession(const size_t reportChannelCapacity = DEFAULT_REPORT_CHANNEL_CAPACITY);
+    void start(); // spawns the matching thread
+    void stop(); // processes whatever is left in the ingress queue and joins the matching thread
+    size_t drain(); // processes the queued events on the calling thread when the matching thread is not running, returns the number processed
+    bool tryDrain(); // same as drain but returns false instead of throwing when the matching thread is running
+
+private:
+    using IngressRequest = std::pair<std::shared_ptr<const Market::OrderEventBase>, Session*>;
+    uint64_t generateOrderId() { return myNextOrderId.fetch_add(1, std::memory_order_relaxed); }
+    uint64_t generateEventId() { return myNextEventId.fetch_add(1, std::memory_order_relaxed); }
+    uint64_t clockTick() { return myClock.fetch_add(1, std::memory_order_relaxed) + 1; }
+    size_t drainBatches();
+    size_t processBatch();
+    void processRequest(const IngressRequest& request);
+    void routeReport(const std::shared_ptr<const OrderProcessingReport>& report);
+    void runMatching();
+
+    std::shared_ptr<IMatchingEngine> myMatchingEngine;
+    std::unique_ptr<Utils::Concurrency::MpscBoundedQueue<IngressRequest>> myIngressQueue;
+    std::vector<std::shared_ptr<Session>> mySessions;
+    mutable std::mutex mySessionsMutex;
+    std::unordered_map<uint64_t, Session*> myOrderOwners; // matching thread only, the orders still live in the engine
+    std::vector<IngressRequest> myBatch; // matching thread only
+    std::mutex myDrainMutex; // held by the inline drains and by start, so that the ingress queue never has two consumers
+    SubscriptionId myOrderProcessingSubscriptionId = 0;
+    size_t myMaxBatchSize = DEFAULT_MAX_BATCH_SIZE;
+    double myMinimumPriceTick = 0.01;
+    std::atomic<uint64_t> myNextOrderId{0};
+    std::atomic<uint64_t> myNextEventId{0};
+    std::atomic<uint64_t> myClock{0};
+    std::atomic<uint64_t> myNumProcessed{0};
+    std::atomic<uint64_t> myNumBatches{0};
+    std::atomic<uint64_t> myNumRejected{0};
+    std::atomic<bool> myIsStopRequested{false};
+    std::atomic<bool> myIsRunning{false};
+    std::thread myMatchingThread;
+    Utils::Concurrency::ThreadConfig myMatchingThreadConfig;
+    Utils::Concurrency::WakeSignal myWakeSignal;
+};
+}
+
+#endif
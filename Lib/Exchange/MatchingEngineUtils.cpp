@@ -13,6 +13,16 @@ using Utils::operator<<;
 
 std::ostream& operator<<(std::ostream& out, const OrderProcessingReport& report) { return out << report.getAsJson(); }
 
+std::ostream& operator<<(std::ostream& out, const TopOfBookSnapshot& snapshot) {
+    out << "{\"Sequence\":" << snapshot.sequence << ",\"Timestamp\":" << snapshot.timestamp << ",\"Bids\":[";
+    for (uint32_t i = 0; i < snapshot.numBidLevels; ++i)
+        out << (i ? "," : "") << "[" << snapshot.bidLevels[i].price << "," << snapshot.bidLevels[i].size << "]";
+    out << "],\"Asks\":[";
+    for (uint32_t i = 0; i < snapshot.numAskLevels; ++i)
+        out << (i ? "," : "") << "[" << snapshot.askLevels[i].price << "," << snapshot.askLevels[i].size << "]";
+    return out << "],\"LastTradePrice\":" << snapshot.lastTradePrice << "}";
+}
+
 std::string generateBar(const uint32_t size, const uint32_t maxSize, const size_t maxWidth, const char symbol) {
     const size_t barWidth = (maxSize == 0) ? 0 : static_cast<size_t>((static_cast<double>(size) / maxSize) * maxWidth);
     return std::string(barWidth, symbol);
@@ -107,6 +117,196 @@ void OrderBookDisplayConfig::setDebugMode(const bool debugMode) {
     }
 }
 
+size_t PriceLadderIndex::getNumAllocatedBlocks() const {
+    return static_cast<size_t>(std::count_if(myBlocks.begin(), myBlocks.end(), [](const auto& block) { return block != nullptr; }));
+}
+
+void PriceLadderIndex::update(const double price, const int64_t sizeDelta, const int32_t levelDelta) {
+    const long long tick = getTick(price);
+    if (isCovered(tick) || recenter(tick)) {
+        addToLadder(tick, sizeDelta, levelDelta);
+    } else {
+        OverflowTick& overflowTick = myOverflowTicks[tick];
+        overflowTick.size += sizeDelta;
+        overflowTick.numLevels += levelDelta;
+        myNumOverflowLevels = static_cast<size_t>(static_cast<long long>(myNumOverflowLevels) + levelDelta);
+        if (overflowTick.size == 0 && overflowTick.numLevels == 0)
+            myOverflowTicks.erase(tick);
+    }
+    myTotalSize = static_cast<uint64_t>(static_cast<int64_t>(myTotalSize) + sizeDelta);
+    myNumLevels = static_cast<size_t>(static_cast<long long>(myNumLevels) + levelDelta);
+}
+
+uint64_t PriceLadderIndex::getSizeInTickRange(const long long tickFrom, const long long tickTo) const {
+    if (tickFrom > tickTo)
+        return 0;
+    int64_t size = 0;
+    const long long from = std::max(tickFrom, myBaseTick);
+    const long long to = std::min(tickTo, myBaseTick + static_cast<long long>(getSpan()) - 1);
+    if (!myBlocks.empty() && from <= to)
+        size += getLadderSizePrefix(static_cast<size_t>(to - myBaseTick)) - (from > myBaseTick ? getLadderSizePrefix(static_cast<size_t>(from - myBaseTick - 1)) : 0);
+    for (auto it = myOverflowTicks.lower_bound(tickFrom); it != myOverflowTicks.end() && it->first <= tickTo; ++it)
+        size += it->second.size;
+    return static_cast<uint64_t>(size);
+}
+
+uint64_t PriceLadderIndex::getSizeBelowTick(const long long tick) const {
+    return getSizeInTickRange(std::numeric_limits<long long>::min(), tick - 1);
+}
+
+size_t PriceLadderIndex::getNumLevelsAt(const long long tick) const {
+    if (!isCovered(tick)) {
+        const auto it = myOverflowTicks.find(tick);
+        return it != myOverflowTicks.end() ? static_cast<size_t>(it->second.numLevels) : 0;
+    }
+    const size_t slot = static_cast<size_t>(tick - myBaseTick);
+    const auto& block = myBlocks[slot / BLOCK_SPAN];
+    return block ? static_cast<size_t>(block->levelTree.rangeSum(slot % BLOCK_SPAN, slot % BLOCK_SPAN)) : 0;
+}
+
+size_t PriceLadderIndex::getNumLevelsBelowTick(const long long tick) const {
+    size_t numLevels = 0;
+    for (auto it = myOverflowTicks.begin(); it != myOverflowTicks.end() && it->first < tick; ++it)
+        numLevels += static_cast<size_t>(it->second.numLevels);
+    if (myBlocks.empty() || tick <= myBaseTick)
+        return numLevels;
+    const long long to = std::min(tick - 1, myBaseTick + static_cast<long long>(getSpan()) - 1);
+    return numLevels + static_cast<size_t>(getLadderLevelsPrefix(static_cast<size_t>(to - myBaseTick)));
+}
+
+long long PriceLadderIndex::findTickOfNthLevel(const size_t n) const {
+    if (n == 0 || n > myNumLevels)
+        Utils::Error::LIB_THROW("[PriceLadderIndex::findTickOfNthLevel] Level " + std::to_string(n) + " is out of range.");
+    return findTickOfNth(n, true);
+}
+
+long long PriceLadderIndex::findTickOfNthUnit(const uint64_t n) const {
+    if (n == 0 || n > myTotalSize)
+        Utils::Error::LIB_THROW("[PriceLadderIndex::findTickOfNthUnit] Unit " + std::to_string(n) + " is out of range.");
+    return findTickOfNth(n, false);
+}
+
+long long PriceLadderIndex::findTickOfNth(uint64_t n, const bool countLevels) const {
+    // the overflow ticks below the ladder come first, then the ladder itself, then the overflow ticks above it
+    auto it = myOverflowTicks.begin();
+    auto countAt = [countLevels](const auto& it) { return static_cast<uint64_t>(countLevels ? it->second.numLevels : it->second.size); };
+    for (; it != myOverflowTicks.end() && it->first < myBaseTick; ++it) {
+        if (n <= countAt(it))
+            return it->first;
+        n -= countAt(it);
+    }
+    if (!myBlocks.empty()) {
+        const size_t lastBlock = myBlocks.size() - 1;
+        const uint64_t ladderCount = countLevels ? static_cast<uint64_t>(myBlockLevelTree.prefixSum(lastBlock)) : static_cast<uint64_t>(myBlockSizeTree.prefixSum(lastBlock));
+        if (n <= ladderCount) {
+            // the block first, then the tick within the block
+            const size_t block = countLevels ? myBlockLevelTree.lowerBound(static_cast<int32_t>(n)) : myBlockSizeTree.lowerBound(static_cast<int64_t>(n));
+            if (block > 0)
+                n -= countLevels ? static_cast<uint64_t>(myBlockLevelTree.prefixSum(block - 1)) : static_cast<uint64_t>(myBlockSizeTree.prefixSum(block - 1));
+            const Block& ladderBlock = *myBlocks[block];
+            const size_t slot = countLevels ? ladderBlock.levelTree.lowerBound(static_cast<int32_t>(n)) : ladderBlock.sizeTree.lowerBound(static_cast<int64_t>(n));
+            return myBaseTick + static_cast<long long>(block * BLOCK_SPAN + slot);
+        }
+        n -= ladderCount;
+    }
+    for (; it != myOverflowTicks.end(); ++it) {
+        if (n <= countAt(it))
+            return it->first;
+        n -= countAt(it);
+    }
+    Utils::Error::LIB_THROW("[PriceLadderIndex::findTickOfNth] Ladder and overflow ticks are out of sync.");
+    return 0;
+}
+
+bool PriceLadderIndex::recenter(const long long tick) {
+    const long long blockSpan = static_cast<long long>(BLOCK_SPAN);
+    const long long tickBlock = tick >= 0 ? tick / blockSpan : -((-tick + blockSpan - 1) / blockSpan); // floor division
+    if (myBlocks.empty() || myNumLevels == myNumOverflowLevels) {
+        // an empty ladder is re-centered on the tick from scratch, which keeps it following the book as it drifts
+        myBlocks.assign(ourInitialNumBlocks, nullptr);
+        myBaseTick = (tickBlock - static_cast<long long>(ourInitialNumBlocks / 2)) * blockSpan;
+    } else {
+        // doubles the number of blocks until the tick is covered, keeping the ladder centered on the range of blocks seen so far
+        const long long baseBlock = myBaseTick / blockSpan;
+        const long long lo = std::min(baseBlock, tickBlock);
+        const long long hi = std::max(baseBlock + static_cast<long long>(myBlocks.size()), tickBlock + 1);
+        const size_t maxNumBlocks = myMaxSpan / BLOCK_SPAN;
+        if (static_cast<unsigned long long>(hi - lo) > maxNumBlocks)
+            return false;
+        size_t numBlocks = myBlocks.size();
+        while (static_cast<long long>(numBlocks) < 2 * (hi - lo) && numBlocks < maxNumBlocks)
+            numBlocks = std::min(2 * numBlocks, maxNumBlocks);
+        const long long newBaseBlock = lo - (static_cast<long long>(numBlocks) - (hi - lo)) / 2;
+        // the blocks themselves are moved over as they are, only the new empty blocks are added around them
+        std::vector<std::shared_ptr<Block>> blocks(numBlocks);
+        std::move(myBlocks.begin(), myBlocks.end(), blocks.begin() + (baseBlock - newBaseBlock));
+        myBlocks = std::move(blocks);
+        myBaseTick = newBaseBlock * blockSpan;
+    }
+    std::vector<int64_t> blockSizes(myBlocks.size(), 0);
+    std::vector<int32_t> blockLevels(myBlocks.size(), 0);
+    for (size_t i = 0; i < myBlocks.size(); ++i) {
+        if (myBlocks[i]) {
+            blockSizes[i] = myBlocks[i]->totalSize;
+            blockLevels[i] = myBlocks[i]->numLevels;
+        }
+    }
+    myBlockSizeTree.build(blockSizes);
+    myBlockLevelTree.build(blockLevels);
+    // the overflow ticks now covered move into the ladder
+    const long long endTick = myBaseTick + static_cast<long long>(getSpan());
+    for (auto it = myOverflowTicks.lower_bound(myBaseTick); it != myOverflowTicks.end() && it->first < endTick;) {
+        addToLadder(it->first, it->second.size, it->second.numLevels);
+        myNumOverflowLevels -= static_cast<size_t>(it->second.numLevels);
+        it = myOverflowTicks.erase(it);
+    }
+    return true;
+}
+
+void PriceLadderIndex::addToLadder(const long long tick, const int64_t sizeDelta, const int32_t levelDelta) {
+    const size_t slot = static_cast<size_t>(tick - myBaseTick);
+    const size_t blockIndex = slot / BLOCK_SPAN;
+    Block& block = getMutableBlock(blockIndex);
+    block.sizeTree.add(slot % BLOCK_SPAN, sizeDelta);
+    block.levelTree.add(slot % BLOCK_SPAN, levelDelta);
+    block.totalSize += sizeDelta;
+    block.numLevels += levelDelta;
+    myBlockSizeTree.add(blockIndex, sizeDelta);
+    myBlockLevelTree.add(blockIndex, levelDelta);
+}
+
+PriceLadderIndex::Block& PriceLadderIndex::getMutableBlock(const size_t block) {
+    std::shared_ptr<Block>& ladderBlock = myBlocks[block];
+    if (!ladderBlock)
+        ladderBlock = std::make_shared<Block>();
+    else if (ladderBlock.use_count() > 1)
+        ladderBlock = std::make_shared<Block>(*ladderBlock);
+    return *ladderBlock;
+}
+
+int64_t PriceLadderIndex::getLadderSizePrefix(const size_t slot) const {
+    const size_t block = slot / BLOCK_SPAN;
+    const int64_t blocksBelow = block > 0 ? myBlockSizeTree.prefixSum(block - 1) : 0;
+    return blocksBelow + (myBlocks[block] ? myBlocks[block]->sizeTree.prefixSum(slot % BLOCK_SPAN) : 0);
+}
+
+int32_t PriceLadderIndex::getLadderLevelsPrefix(const size_t slot) const {
+    const size_t block = slot / BLOCK_SPAN;
+    const int32_t blocksBelow = block > 0 ? myBlockLevelTree.prefixSum(block - 1) : 0;
+    return blocksBelow + (myBlocks[block] ? myBlocks[block]->levelTree.prefixSum(slot % BLOCK_SPAN) : 0);
+}
+
+void PriceLadderIndex::clear() {
+    myBaseTick = 0;
+    myTotalSize = 0;
+    myNumLevels = 0;
+    myBlocks.clear();
+    myBlockSizeTree.clear();
+    myBlockLevelTree.clear();
+    myOverflowTicks.clear();
+    myNumOverflowLevels = 0;
+}
+
 void OrderExecutionReport::dispatchTo(Market::OrderEventManagerBase& orderEventManager) const {
     orderEventManager.onOrderProcessingReport(*this);
 }
@@ -136,13 +336,17 @@ std::shared_ptr<ITCHEncoder::ITCHMessage> OrderExecutionReport::makeITCHMessage(
     return ITCHEncoder::encodeReport(*this);
 }
 
+std::optional<ITCHEncoder::ITCHMessageValue> OrderExecutionReport::makeITCHMessageValue() const {
+    return ITCHEncoder::encodeReportAsValue(*this);
+}
+
 std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> OrderExecutionReport::makeLobsterMessage() const {
     return std::make_shared<Parser::LobsterDataParser::OrderBookMessage>(*this);
 }
 
 std::string OrderExecutionReport::getAsJson() const {
-    std::ostringstream oss;
-    oss << "{"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{"
         "\"ReportId\":"              << reportId             << ","
         "\"Timestamp\":"             << timestamp            << ","
         "\"OrderId\":"               << orderId              << ","
@@ -159,8 +363,8 @@ std::string OrderExecutionReport::getAsJson() const {
         "\"AgentIdHash\":"           << agentIdHash.value_or(0) << ","
         "\"Latency\":"               << latency.value_or(0)  << ","
         "\"Message\":\""             << message.value_or("") << "\"";
-    oss << "}";
-    return oss.str();
+    buffer << "}";
+    return buffer.str();
 }
 
 void LimitOrderSubmitReport::dispatchTo(Market::OrderEventManagerBase& orderEventManager) const {
@@ -183,25 +387,29 @@ std::shared_ptr<ITCHEncoder::ITCHMessage> LimitOrderSubmitReport::makeITCHMessag
     return ITCHEncoder::encodeReport(*this);
 }
 
+std::optional<ITCHEncoder::ITCHMessageValue> LimitOrderSubmitReport::makeITCHMessageValue() const {
+    return ITCHEncoder::encodeReportAsValue(*this);
+}
+
 std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> LimitOrderSubmitReport::makeLobsterMessage() const {
     return std::make_shared<Parser::LobsterDataParser::OrderBookMessage>(*this);
 }
 
 std::string LimitOrderSubmitReport::getAsJson() const {
-    std::ostringstream oss;
-    oss << "{"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{"
         "\"ReportId\":"              << reportId             << ","
         "\"Timestamp\":"             << timestamp            << ","
         "\"OrderId\":"               << orderId              << ","
         "\"OrderSide\":\""           << orderSide            << "\","
-        "\"Order\":"                 << *order               << ","
+        "\"Order\":"                 << order->getAsJson()   << ","
         "\"OrderProcessingType\":\"" << orderProcessingType  << "\","
         "\"Status\":\""              << status               << "\","
         "\"AgentIdHash\":"           << agentIdHash.value_or(0) << ","
         "\"Latency\":"               << latency.value_or(0)  << ","
         "\"Message\":\""             << message.value_or("") << "\"";
-    oss << "}";
-    return oss.str();
+    buffer << "}";
+    return buffer.str();
 }
 
 void LimitOrderPlacementReport::dispatchTo(Analytics::MatchingEngineMonitor& matchingEngineMonitor) const {
@@ -217,8 +425,8 @@ std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> LimitOrderPlacement
 }
 
 std::string LimitOrderPlacementReport::getAsJson() const {
-    std::ostringstream oss;
-    oss << "{"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{"
         "\"ReportId\":"              << reportId             << ","
         "\"Timestamp\":"             << timestamp            << ","
         "\"OrderId\":"               << orderId              << ","
@@ -230,8 +438,8 @@ std::string LimitOrderPlacementReport::getAsJson() const {
         "\"AgentIdHash\":"           << agentIdHash.value_or(0) << ","
         "\"Latency\":"               << latency.value_or(0)  << ","
         "\"Message\":\""             << message.value_or("") << "\"";
-    oss << "}";
-    return oss.str();
+    buffer << "}";
+    return buffer.str();
 }
 
 void MarketOrderSubmitReport::dispatchTo(Market::OrderEventManagerBase& orderEventManager) const {
@@ -254,25 +462,29 @@ std::shared_ptr<ITCHEncoder::ITCHMessage> MarketOrderSubmitReport::makeITCHMessa
     return ITCHEncoder::encodeReport(*this);
 }
 
+std::optional<ITCHEncoder::ITCHMessageValue> MarketOrderSubmitReport::makeITCHMessageValue() const {
+    return ITCHEncoder::encodeReportAsValue(*this);
+}
+
 std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> MarketOrderSubmitReport::makeLobsterMessage() const {
     return std::make_shared<Parser::LobsterDataParser::OrderBookMessage>(*this);
 }
 
 std::string MarketOrderSubmitReport::getAsJson() const {
-    std::ostringstream oss;
-    oss << "{"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{"
         "\"ReportId\":"              << reportId             << ","
         "\"Timestamp\":"             << timestamp            << ","
         "\"OrderId\":"               << orderId              << ","
         "\"OrderSide\":\""           << orderSide            << "\","
-        "\"Order\":"                 << *order               << ","
+        "\"Order\":"                 << order->getAsJson()   << ","
         "\"OrderProcessingType\":\"" << orderProcessingType  << "\","
         "\"Status\":\""              << status               << "\","
         "\"AgentIdHash\":"           << agentIdHash.value_or(0) << ","
         "\"Latency\":"               << latency.value_or(0)  << ","
         "\"Message\":\""             << message.value_or("") << "\"";
-    oss << "}";
-    return oss.str();
+    buffer << "}";
+    return buffer.str();
 }
 
 void OrderCancelReport::dispatchTo(Market::OrderEventManagerBase& orderEventManager) const {
@@ -295,13 +507,17 @@ std::shared_ptr<ITCHEncoder::ITCHMessage> OrderCancelReport::makeITCHMessage() c
     return ITCHEncoder::encodeReport(*this);
 }
 
+std::optional<ITCHEncoder::ITCHMessageValue> OrderCancelReport::makeITCHMessageValue() const {
+    return ITCHEncoder::encodeReportAsValue(*this);
+}
+
 std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> OrderCancelReport::makeLobsterMessage() const {
     return std::make_shared<Parser::LobsterDataParser::OrderBookMessage>(*this);
 }
 
 std::string OrderCancelReport::getAsJson() const {
-    std::ostringstream oss;
-    oss << "{"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{"
         "\"ReportId\":"              << reportId             << ","
         "\"Timestamp\":"             << timestamp            << ","
         "\"OrderId\":"               << orderId              << ","
@@ -312,8 +528,37 @@ std::string OrderCancelReport::getAsJson() const {
         "\"AgentIdHash\":"           << agentIdHash.value_or(0) << ","
         "\"Latency\":"               << latency.value_or(0)  << ","
         "\"Message\":\""             << message.value_or("") << "\"";
-    oss << "}";
-    return oss.str();
+    buffer << "}";
+    return buffer.str();
+}
+
+std::shared_ptr<ITCHEncoder::ITCHMessage> CrossTradeReport::makeITCHMessage() const {
+    return ITCHEncoder::encodeReport(*this);
+}
+
+std::optional<ITCHEncoder::ITCHMessageValue> CrossTradeReport::makeITCHMessageValue() const {
+    return ITCHEncoder::encodeReportAsValue(*this);
+}
+
+std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> CrossTradeReport::makeLobsterMessage() const {
+    return std::make_shared<Parser::LobsterDataParser::OrderBookMessage>(*this);
+}
+
+std::string CrossTradeReport::getAsJson() const {
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{"
+        "\"ReportId\":"              << reportId             << ","
+        "\"Timestamp\":"             << timestamp            << ","
+        "\"CrossQuantity\":"         << crossQuantity        << ","
+        "\"CrossPrice\":"            << crossPrice           << ","
+        "\"CrossCode\":\""           << crossCode            << "\","
+        "\"OrderProcessingType\":\"" << orderProcessingType  << "\","
+        "\"Status\":\""              << status               << "\","
+        "\"AgentIdHash\":"           << agentIdHash.value_or(0) << ","
+        "\"Latency\":"               << latency.value_or(0)  << ","
+        "\"Message\":\""             << message.value_or("") << "\"";
+    buffer << "}";
+    return buffer.str();
 }
 
 void OrderPartialCancelReport::dispatchTo(Market::OrderEventManagerBase& orderEventManager) const {
@@ -336,13 +581,17 @@ std::shared_ptr<ITCHEncoder::ITCHMessage> OrderPartialCancelReport::makeITCHMess
     return ITCHEncoder::encodeReport(*this);
 }
 
+std::optional<ITCHEncoder::ITCHMessageValue> OrderPartialCancelReport::makeITCHMessageValue() const {
+    return ITCHEncoder::encodeReportAsValue(*this);
+}
+
 std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> OrderPartialCancelReport::makeLobsterMessage() const {
     return std::make_shared<Parser::LobsterDataParser::OrderBookMessage>(*this);
 }
 
 std::string OrderPartialCancelReport::getAsJson() const {
-    std::ostringstream oss;
-    oss << "{"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{"
         "\"ReportId\":"              << reportId             << ","
         "\"Timestamp\":"             << timestamp            << ","
         "\"OrderId\":"               << orderId              << ","
@@ -354,8 +603,8 @@ std::string OrderPartialCancelReport::getAsJson() const {
         "\"AgentIdHash\":"           << agentIdHash.value_or(0) << ","
         "\"Latency\":"               << latency.value_or(0)  << ","
         "\"Message\":\""             << message.value_or("") << "\"";
-    oss << "}";
-    return oss.str();
+    buffer << "}";
+    return buffer.str();
 }
 
 void OrderCancelAndReplaceReport::dispatchTo(Market::OrderEventManagerBase& orderEventManager) const {
@@ -387,13 +636,17 @@ std::shared_ptr<ITCHEncoder::ITCHMessage> OrderCancelAndReplaceReport::makeITCHM
     return ITCHEncoder::encodeReport(*this);
 }
 
+std::optional<ITCHEncoder::ITCHMessageValue> OrderCancelAndReplaceReport::makeITCHMessageValue() const {
+    return ITCHEncoder::encodeReportAsValue(*this);
+}
+
 std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> OrderCancelAndReplaceReport::makeLobsterMessage() const {
     return std::make_shared<Parser::LobsterDataParser::OrderBookMessage>(*this);
 }
 
 std::string OrderCancelAndReplaceReport::getAsJson() const {
-    std::ostringstream oss;
-    oss << "{"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{"
         "\"ReportId\":"              << reportId             << ","
         "\"Timestamp\":"             << timestamp            << ","
         "\"OrderId\":"               << orderId              << ","
@@ -407,8 +660,8 @@ std::string OrderCancelAndReplaceReport::getAsJson() const {
         "\"AgentIdHash\":"           << agentIdHash.value_or(0) << ","
         "\"Latency\":"               << latency.value_or(0)  << ","
         "\"Message\":\""             << message.value_or("") << "\"";
-    oss << "}";
-    return oss.str();
+    buffer << "}";
+    return buffer.str();
 }
 
 void OrderModifyPriceReport::dispatchTo(Market::OrderEventManagerBase& orderEventManager) const {
@@ -440,13 +693,17 @@ std::shared_ptr<ITCHEncoder::ITCHMessage> OrderModifyPriceReport::makeITCHMessag
     return ITCHEncoder::encodeReport(*this);
 }
 
+std::optional<ITCHEncoder::ITCHMessageValue> OrderModifyPriceReport::makeITCHMessageValue() const {
+    return ITCHEncoder::encodeReportAsValue(*this);
+}
+
 std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> OrderModifyPriceReport::makeLobsterMessage() const {
     return std::make_shared<Parser::LobsterDataParser::OrderBookMessage>(*this);
 }
 
 std::string OrderModifyPriceReport::getAsJson() const {
-    std::ostringstream oss;
-    oss << "{"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{"
         "\"ReportId\":"              << reportId             << ","
         "\"Timestamp\":"             << timestamp            << ","
         "\"OrderId\":"               << orderId              << ","
@@ -458,8 +715,8 @@ std::string OrderModifyPriceReport::getAsJson() const {
         "\"AgentIdHash\":"           << agentIdHash.value_or(0) << ","
         "\"Latency\":"               << latency.value_or(0)  << ","
         "\"Message\":\""             << message.value_or("") << "\"";
-    oss << "}";
-    return oss.str();
+    buffer << "}";
+    return buffer.str();
 }
 
 void OrderModifyQuantityReport::dispatchTo(Market::OrderEventManagerBase& orderEventManager) const {
@@ -491,13 +748,17 @@ std::shared_ptr<ITCHEncoder::ITCHMessage> OrderModifyQuantityReport::makeITCHMes
     return ITCHEncoder::encodeReport(*this);
 }
 
+std::optional<ITCHEncoder::ITCHMessageValue> OrderModifyQuantityReport::makeITCHMessageValue() const {
+    return ITCHEncoder::encodeReportAsValue(*this);
+}
+
 std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> OrderModifyQuantityReport::makeLobsterMessage() const {
     return std::make_shared<Parser::LobsterDataParser::OrderBookMessage>(*this);
 }
 
 std::string OrderModifyQuantityReport::getAsJson() const {
-    std::ostringstream oss;
-    oss << "{"
+    Utils::Format::ScopedFormatBuffer buffer;
+    buffer << "{"
         "\"ReportId\":"              << reportId             << ","
         "\"Timestamp\":"             << timestamp            << ","
         "\"OrderId\":"               << orderId              << ","
@@ -509,8 +770,8 @@ std::string OrderModifyQuantityReport::getAsJson() const {
         "\"AgentIdHash\":"           << agentIdHash.value_or(0) << ","
         "\"Latency\":"               << latency.value_or(0)  << ","
         "\"Message\":\""             << message.value_or("") << "\"";
-    oss << "}";
-    return oss.str();
+    buffer << "}";
+    return buffer.str();
 }
 }
 
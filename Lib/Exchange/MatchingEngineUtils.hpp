@@ -17,7 +17,7 @@ class MonitorOutputsAnalyzerBase;
 
 namespace Exchange {
 enum class OrderMatchingStrategy { FIFO, PRO_RATA, ICEBERG_SUPPORT, NONE };
-enum class OrderProcessingType   { EXECUTE, SUBMIT, PLACEMENT, CANCEL, PARTIAL_CANCEL, CANCEL_REPLACE, MODIFY_PRICE, MODIFY_QUANTITY, NONE };
+enum class OrderProcessingType   { EXECUTE, SUBMIT, PLACEMENT, CANCEL, PARTIAL_CANCEL, CANCEL_REPLACE, MODIFY_PRICE, MODIFY_QUANTITY, CROSS, NONE };
 enum class OrderProcessingStatus { SUCCESS, FAILURE, NONE };
 enum class OrderExecutionType    { FILLED, PARTIAL_FILLED, CANCELLED, REJECTED, NONE };
 
@@ -34,6 +34,37 @@ struct BestBidAsk {
     uint32_t bestAskSize = 0;
 };
 
+/* The call auction clearing price which maximizes the executable quantity, ties broken by the least imbalance, then
+   towards the surplus side, then by the closeness to the reference price. */
+struct AuctionEquilibrium {
+    double price = Utils::Consts::NAN_DOUBLE;
+    uint32_t matchedQuantity = 0;
+    uint32_t buyQuantity = 0; // cumulative demand at the price, market orders included
+    uint32_t sellQuantity = 0; // cumulative supply at the price, market orders included
+    bool isCrossed() const { return matchedQuantity > 0; }
+    uint32_t getImbalance() const { return buyQuantity > sellQuantity ? buyQuantity - sellQuantity : sellQuantity - buyQuantity; }
+};
+
+/* A fixed-size copy of the top of the book, published by the engine after every input event for readers on other threads. The
+   best bid and ask are the first of the levels, the rest of the arrays past the level counts is left empty. */
+struct TopOfBookSnapshot {
+    static constexpr size_t MAX_LEVELS = 10;
+    uint64_t sequence = 0; // number of snapshots published before this one
+    uint64_t timestamp = 0;
+    double lastTradePrice = Utils::Consts::NAN_DOUBLE;
+    uint32_t numBidLevels = 0;
+    uint32_t numAskLevels = 0;
+    std::array<OrderLevel, MAX_LEVELS> bidLevels{};
+    std::array<OrderLevel, MAX_LEVELS> askLevels{};
+    double getBestBidPrice() const { return numBidLevels ? bidLevels[0].price : Utils::Consts::NAN_DOUBLE; }
+    double getBestAskPrice() const { return numAskLevels ? askLevels[0].price : Utils::Consts::NAN_DOUBLE; }
+    uint32_t getBestBidSize() const { return numBidLevels ? bidLevels[0].size : 0; }
+    uint32_t getBestAskSize() const { return numAskLevels ? askLevels[0].size : 0; }
+    double getSpread() const { return getBestAskPrice() - getBestBidPrice(); }
+    double getMidPrice() const { return (getBestBidPrice() + getBestAskPrice()) / 2; }
+    BestBidAsk getBestBidAsk() const { return {true, getBestBidPrice(), getBestBidSize(), getBestAskPrice(), getBestAskSize()}; }
+};
+
 std::string generateBar(const uint32_t size, const uint32_t maxSize, const size_t maxWidth, const char symbol = 'o');
 
 std::string getOrderBookASCII(
@@ -42,6 +73,68 @@ std::string getOrderBookASCII(
     const size_t barWidth = 40,
     const size_t maxDepth = 10);
 
+/* Cumulative depth index over the integer tick ladder of one side of the book. Two Fenwick trees hold the resting
+   size and the number of price levels per tick, so that depth-within-distance range sums, the k-th level lookup and
+   the depth walk of a large market order take O(log N) in the ladder span N. The ladder is cut into blocks of
+   BLOCK_SPAN ticks, each with its own pair of trees, under a pair of trees over the block totals. The blocks are
+   allocated upon first touch and shared copy-on-write between copies of the ladder, so that copying (e.g. forking
+   the engine) takes O(N / BLOCK_SPAN) and growing the ladder to cover a new price only adds empty blocks. The ladder
+   stops growing at maxSpan ticks - the far-away ticks a wider ladder would need (e.g. a fat-finger price) are kept
+   in a sparse overflow map and walked in O(K) instead. */
+class PriceLadderIndex {
+public:
+    static constexpr size_t BLOCK_SPAN = 1024;
+    static constexpr size_t DEFAULT_MAX_SPAN = 1 << 18;
+    PriceLadderIndex(const double priceTick = 0.01, const size_t maxSpan = DEFAULT_MAX_SPAN) : myPriceTick(priceTick), myMaxSpan(std::max(maxSpan, BLOCK_SPAN)) {}
+    double getPriceTick() const { return myPriceTick; }
+    size_t getMaxSpan() const { return myMaxSpan; }
+    uint64_t getTotalSize() const { return myTotalSize; }
+    size_t getNumLevels() const { return myNumLevels; }
+    long long getBaseTick() const { return myBaseTick; }
+    size_t getSpan() const { return myBlocks.size() * BLOCK_SPAN; }
+    size_t getNumAllocatedBlocks() const;
+    size_t getNumOverflowTicks() const { return myOverflowTicks.size(); }
+    long long getTick(const double price) const { return Utils::Maths::countPriceTicks(price, myPriceTick); }
+    void update(const double price, const int64_t sizeDelta, const int32_t levelDelta);
+    uint64_t getSizeAt(const long long tick) const { return getSizeInTickRange(tick, tick); }
+    uint64_t getSizeInTickRange(const long long tickFrom, const long long tickTo) const; // both ends inclusive
+    uint64_t getSizeBelowTick(const long long tick) const; // strictly below the tick
+    size_t getNumLevelsAt(const long long tick) const;
+    size_t getNumLevelsBelowTick(const long long tick) const;
+    long long findTickOfNthLevel(const size_t n) const; // tick holding the n-th level (1-based) counting up from the lowest price
+    long long findTickOfNthUnit(const uint64_t n) const; // tick holding the n-th unit of size (1-based) counting up from the lowest price
+    void clear();
+private:
+    struct Block {
+        Utils::Maths::FenwickTree<int64_t> sizeTree{BLOCK_SPAN};
+        Utils::Maths::FenwickTree<int32_t> levelTree{BLOCK_SPAN};
+        int64_t totalSize = 0;
+        int32_t numLevels = 0;
+    };
+    struct OverflowTick {
+        int64_t size = 0;
+        int32_t numLevels = 0;
+    };
+    bool recenter(const long long tick); // grows the ladder so that it covers the tick, false if that takes more than maxSpan
+    void addToLadder(const long long tick, const int64_t sizeDelta, const int32_t levelDelta);
+    Block& getMutableBlock(const size_t block); // copies a block shared with another ladder before it is written to
+    int64_t getLadderSizePrefix(const size_t slot) const; // over the slots [0, slot]
+    int32_t getLadderLevelsPrefix(const size_t slot) const;
+    long long findTickOfNth(uint64_t n, const bool countLevels) const;
+    bool isCovered(const long long tick) const { return !myBlocks.empty() && tick >= myBaseTick && tick < myBaseTick + static_cast<long long>(getSpan()); }
+    static constexpr size_t ourInitialNumBlocks = 1;
+    double myPriceTick;
+    size_t myMaxSpan;
+    long long myBaseTick = 0; // tick of the ladder slot 0, a multiple of BLOCK_SPAN
+    uint64_t myTotalSize = 0;
+    size_t myNumLevels = 0;
+    std::vector<std::shared_ptr<Block>> myBlocks; // null for the blocks never touched
+    Utils::Maths::FenwickTree<int64_t> myBlockSizeTree;
+    Utils::Maths::FenwickTree<int32_t> myBlockLevelTree;
+    std::map<long long, OverflowTick> myOverflowTicks; // ticks outside of the ladder span, normally empty
+    size_t myNumOverflowLevels = 0;
+};
+
 class OrderBookDisplayConfig {
 public:
     OrderBookDisplayConfig() = default;
@@ -122,6 +215,7 @@ struct OrderProcessingReport {
     // for information purposes and may be derived from order submits.
     virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const = 0;
     virtual std::shared_ptr<ITCHEncoder::ITCHMessage> makeITCHMessage() const = 0;
+    virtual std::optional<ITCHEncoder::ITCHMessageValue> makeITCHMessageValue() const = 0; // the same message held by value
     virtual std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> makeLobsterMessage() const = 0;
     virtual std::shared_ptr<OrderProcessingReport> clone() const = 0;
     virtual std::string getAsJson() const = 0;
@@ -163,6 +257,7 @@ struct OrderExecutionReport : public OrderProcessingReport {
     virtual void dispatchTo(Analytics::MonitorOutputsAnalyzerBase& monitorOutputsAnalyzer) const override;
     virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
     virtual std::shared_ptr<ITCHEncoder::ITCHMessage> makeITCHMessage() const override;
+    virtual std::optional<ITCHEncoder::ITCHMessageValue> makeITCHMessageValue() const override;
     virtual std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> makeLobsterMessage() const override;
     virtual std::shared_ptr<OrderProcessingReport> clone() const override { return std::make_shared<OrderExecutionReport>(*this); }
     virtual std::string getAsJson() const override;
@@ -196,6 +291,7 @@ struct LimitOrderSubmitReport : public OrderProcessingReport {
     virtual void dispatchTo(Analytics::MonitorOutputsAnalyzerBase& monitorOutputsAnalyzer) const override;
     virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
     virtual std::shared_ptr<ITCHEncoder::ITCHMessage> makeITCHMessage() const override;
+    virtual std::optional<ITCHEncoder::ITCHMessageValue> makeITCHMessageValue() const override;
     virtual std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> makeLobsterMessage() const override;
     virtual std::shared_ptr<OrderProcessingReport> clone() const override { return std::make_shared<LimitOrderSubmitReport>(*this); }
     virtual std::string getAsJson() const override;
@@ -223,6 +319,7 @@ struct LimitOrderPlacementReport : public OrderProcessingReport {
     virtual void dispatchTo(Analytics::MonitorOutputsAnalyzerBase& monitorOutputsAnalyzer) const override;
     virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override { return nullptr; }
     virtual std::shared_ptr<ITCHEncoder::ITCHMessage> makeITCHMessage() const override { return nullptr; }
+    virtual std::optional<ITCHEncoder::ITCHMessageValue> makeITCHMessageValue() const override { return std::nullopt; }
     virtual std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> makeLobsterMessage() const override;
     virtual std::shared_ptr<OrderProcessingReport> clone() const override { return std::make_shared<LimitOrderPlacementReport>(*this); }
     virtual std::string getAsJson() const override;
@@ -249,6 +346,7 @@ struct MarketOrderSubmitReport : public OrderProcessingReport {
     virtual void dispatchTo(Analytics::MonitorOutputsAnalyzerBase& monitorOutputsAnalyzer) const override;
     virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
     virtual std::shared_ptr<ITCHEncoder::ITCHMessage> makeITCHMessage() const override;
+    virtual std::optional<ITCHEncoder::ITCHMessageValue> makeITCHMessageValue() const override;
     virtual std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> makeLobsterMessage() const override;
     virtual std::shared_ptr<OrderProcessingReport> clone() const override { return std::make_shared<MarketOrderSubmitReport>(*this); }
     virtual std::string getAsJson() const override;
@@ -276,6 +374,7 @@ struct OrderCancelReport : public OrderProcessingReport {
     virtual void dispatchTo(Analytics::MonitorOutputsAnalyzerBase& monitorOutputsAnalyzer) const override;
     virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
     virtual std::shared_ptr<ITCHEncoder::ITCHMessage> makeITCHMessage() const override;
+    virtual std::optional<ITCHEncoder::ITCHMessageValue> makeITCHMessageValue() const override;
     virtual std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> makeLobsterMessage() const override;
     virtual std::shared_ptr<OrderProcessingReport> clone() const override { return std::make_shared<OrderCancelReport>(*this); }
     virtual std::string getAsJson() const override;
@@ -306,6 +405,7 @@ struct OrderPartialCancelReport : public OrderProcessingReport {
     virtual void dispatchTo(Analytics::MonitorOutputsAnalyzerBase& monitorOutputsAnalyzer) const override;
     virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
     virtual std::shared_ptr<ITCHEncoder::ITCHMessage> makeITCHMessage() const override;
+    virtual std::optional<ITCHEncoder::ITCHMessageValue> makeITCHMessageValue() const override;
     virtual std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> makeLobsterMessage() const override;
     virtual std::shared_ptr<OrderProcessingReport> clone() const override { return std::make_shared<OrderPartialCancelReport>(*this); }
     virtual std::string getAsJson() const override;
@@ -338,6 +438,7 @@ struct OrderCancelAndReplaceReport : public OrderProcessingReport {
     virtual std::vector<std::shared_ptr<const OrderProcessingReport>> decomposeIntoAtomicReports() const override;
     virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
     virtual std::shared_ptr<ITCHEncoder::ITCHMessage> makeITCHMessage() const override;
+    virtual std::optional<ITCHEncoder::ITCHMessageValue> makeITCHMessageValue() const override;
     virtual std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> makeLobsterMessage() const override;
     virtual std::shared_ptr<OrderProcessingReport> clone() const override { return std::make_shared<OrderCancelAndReplaceReport>(*this); }
     virtual std::string getAsJson() const override;
@@ -368,6 +469,7 @@ struct OrderModifyPriceReport : public OrderProcessingReport {
     virtual std::vector<std::shared_ptr<const OrderProcessingReport>> decomposeIntoAtomicReports() const override;
     virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
     virtual std::shared_ptr<ITCHEncoder::ITCHMessage> makeITCHMessage() const override;
+    virtual std::optional<ITCHEncoder::ITCHMessageValue> makeITCHMessageValue() const override;
     virtual std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> makeLobsterMessage() const override;
     virtual std::shared_ptr<OrderProcessingReport> clone() const override { return std::make_shared<OrderModifyPriceReport>(*this); }
     virtual std::string getAsJson() const override;
@@ -396,6 +498,7 @@ struct OrderModifyQuantityReport : public OrderProcessingReport {
     virtual std::vector<std::shared_ptr<const OrderProcessingReport>> decomposeIntoAtomicReports() const override;
     virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override;
     virtual std::shared_ptr<ITCHEncoder::ITCHMessage> makeITCHMessage() const override;
+    virtual std::optional<ITCHEncoder::ITCHMessageValue> makeITCHMessageValue() const override;
     virtual std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> makeLobsterMessage() const override;
     virtual std::shared_ptr<OrderProcessingReport> clone() const override { return std::make_shared<OrderModifyQuantityReport>(*this); }
     virtual std::string getAsJson() const override;
@@ -403,6 +506,35 @@ struct OrderModifyQuantityReport : public OrderProcessingReport {
     uint32_t modifiedQuantity;
 };
 
+/* The single print of a call auction uncrossing, the individual fills are reported as executions beforehand. */
+struct CrossTradeReport : public OrderProcessingReport {
+    CrossTradeReport() = delete;
+    CrossTradeReport(
+        const uint64_t reportId,
+        const uint64_t timestamp,
+        const uint32_t crossQuantity,
+        const double crossPrice,
+        const ITCHEncoder::CrossCode crossCode,
+        const OrderProcessingStatus status,
+        const std::optional<uint64_t> latency = std::nullopt,
+        const std::optional<std::string> message = std::nullopt) :
+        OrderProcessingReport(reportId, timestamp, 0 /* orderId */, Market::Side::NONE, OrderProcessingType::CROSS, status, latency, message),
+        crossQuantity(crossQuantity), crossPrice(crossPrice), crossCode(crossCode) {}
+    virtual ~CrossTradeReport() = default;
+    virtual void dispatchTo(Market::OrderEventManagerBase& /* orderEventManager */) const override {}
+    virtual void dispatchTo(Analytics::MatchingEngineMonitor& /* matchingEngineMonitor */) const override {}
+    virtual void dispatchTo(Analytics::MonitorOutputsAnalyzerBase& /* monitorOutputsAnalyzer */) const override {}
+    virtual std::shared_ptr<Market::OrderEventBase> makeEvent() const override { return nullptr; }
+    virtual std::shared_ptr<ITCHEncoder::ITCHMessage> makeITCHMessage() const override;
+    virtual std::optional<ITCHEncoder::ITCHMessageValue> makeITCHMessageValue() const override;
+    virtual std::shared_ptr<Parser::LobsterDataParser::OrderBookMessage> makeLobsterMessage() const override;
+    virtual std::shared_ptr<OrderProcessingReport> clone() const override { return std::make_shared<CrossTradeReport>(*this); }
+    virtual std::string getAsJson() const override;
+    uint32_t crossQuantity;
+    double crossPrice;
+    ITCHEncoder::CrossCode crossCode;
+};
+
 /* The net delta change in order book size after a certain report has been processed. */
 struct OrderBookSizeDelta {
     enum class DeltaType { ADD, REMOVE, NONE }; // either +, - or no change
@@ -422,9 +554,11 @@ struct OrderBookSizeDelta {
     double price;
     DeltaType type;
     uint32_t sizeDelta;
+    bool isLastInBatch = false; // closes the batch of net level deltas of an input event in coalescing mode
 };
 
 std::ostream& operator<<(std::ostream& out, const OrderProcessingReport& report);
+std::ostream& operator<<(std::ostream& out, const TopOfBookSnapshot& snapshot);
 }
 
 template<>
@@ -434,7 +568,7 @@ struct Utils::EnumStrings<Exchange::OrderMatchingStrategy> {
 
 template<>
 struct Utils::EnumStrings<Exchange::OrderProcessingType> {
-    inline static constexpr std::array<const char*, 9> names = { "Execution", "Submission", "Placement", "Cancel", "PartialCancel", "CancelReplace", "ModifyPrice", "ModifyQuantity", "None" };
+    inline static constexpr std::array<const char*, 10> names = { "Execution", "Submission", "Placement", "Cancel", "PartialCancel", "CancelReplace", "ModifyPrice", "ModifyQuantity", "Cross", "None" };
 };
 
 template<>
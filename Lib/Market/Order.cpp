@@ -91,7 +91,8 @@ LimitOrder::LimitOrder() :
 LimitOrder::LimitOrder(const LimitOrder& order) :
     OrderBase(order),
     myPrice(order.myPrice),
-    myIntPrice(order.myIntPrice) {}
+    myIntPrice(order.myIntPrice),
+    myTimeInForce(order.myTimeInForce) {}
 
 LimitOrder::LimitOrder(const uint64_t id, const uint64_t timestamp, const Side side, const uint32_t quantity, const double price, const std::shared_ptr<OrderMetaInfo>& metaInfo) :
     OrderBase(id, timestamp, side, quantity, metaInfo),
@@ -117,6 +118,8 @@ void LimitOrder::init() {
         Utils::Error::LIB_THROW("[LimitOrder::init] Side cannot be null.");
     if (myPrice < 0)
         Utils::Error::LIB_THROW("[LimitOrder::init] Price cannot be negative.");
+    if (myTimeInForce == TimeInForce::NONE)
+        Utils::Error::LIB_THROW("[LimitOrder::init] Time in force cannot be null.");
     setOrderState(OrderState::ACTIVE);
     setOrderType(OrderType::LIMIT);
 }
@@ -136,6 +139,8 @@ std::string LimitOrder::getAsJson() const {
     "\"Price\":"        << getPrice()      << ","
     "\"OrderType\":\""  << getOrderType()  << "\","
     "\"OrderState\":\"" << getOrderState() << "\"";
+    if (myTimeInForce != TimeInForce::GTC) // left out for the default resting orders
+        oss << ",\"TimeInForce\":\"" << myTimeInForce << "\"";
     if (getMetaInfo())
         oss << ",\"MetaInfo\":" << *getMetaInfo();
     else
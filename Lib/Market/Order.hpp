@@ -61,11 +61,14 @@ public:
     virtual ~LimitOrder() = default;
     double getPrice() const override { return myPrice; }
     uint32_t getIntPrice() const { return myIntPrice; }
+    TimeInForce getTimeInForce() const { return myTimeInForce; }
+    bool canRest() const { return myTimeInForce == TimeInForce::GTC || myTimeInForce == TimeInForce::POST_ONLY; } // IOC and FOK remainders are never placed
     void setPrice(const double price) {
         myPrice = price;
         myIntPrice = Utils::Maths::castDoublePriceAsInt<uint32_t>(price);
     }
-    std::shared_ptr<LimitOrder> copy() const { return std::make_shared<LimitOrder>(*this); }
+    void setTimeInForce(const TimeInForce timeInForce) { myTimeInForce = timeInForce; }
+    std::shared_ptr<LimitOrder> copy(const std::shared_ptr<Utils::Memory::ObjectPool>& pool = nullptr) const { return Utils::Memory::makePooledShared<LimitOrder>(pool, *this); }
     virtual std::shared_ptr<OrderBase> clone() const override { return std::make_shared<LimitOrder>(*this); }
     virtual void executeOrderEvent(const OrderEventBase& event) override;
     virtual void submit(Exchange::IMatchingEngine& matchingEngine) const override;
@@ -76,6 +79,7 @@ public:
 private:
     double myPrice;
     uint32_t myIntPrice; // for ITCH encoding
+    TimeInForce myTimeInForce = TimeInForce::GTC;
 };
 
 class MarketOrder : public OrderBase {
@@ -84,7 +88,7 @@ public:
     MarketOrder(const MarketOrder& order);
     MarketOrder(const uint64_t id, const uint64_t timestamp, const Side side, const uint32_t quantity, const std::shared_ptr<OrderMetaInfo>& metaInfo = nullptr);
     virtual ~MarketOrder() = default;
-    std::shared_ptr<MarketOrder> copy() const { return std::make_shared<MarketOrder>(*this); }
+    std::shared_ptr<MarketOrder> copy(const std::shared_ptr<Utils::Memory::ObjectPool>& pool = nullptr) const { return Utils::Memory::makePooledShared<MarketOrder>(pool, *this); }
     virtual std::shared_ptr<OrderBase> clone() const override { return std::make_shared<MarketOrder>(*this); }
     virtual void executeOrderEvent(const OrderEventBase& event) override;
     virtual void submit(Exchange::IMatchingEngine& matchingEngine) const override;
@@ -20,12 +20,14 @@ OrderEventManagerBase::OrderEventManagerBase(const std::shared_ptr<Exchange::IMa
     myMatchingEngine = matchingEngine;
     myWorldClock = matchingEngine->getWorldClock();
     myDebugMode = matchingEngine->isDebugMode();
-    myOrderProcessingCallback = std::make_shared<Exchange::OrderProcessingCallback>(
-        [this](const std::shared_ptr<const Exchange::OrderProcessingReport>& report) {
-            if (report)
-                report->dispatchTo(*this);
-        });
-    matchingEngine->addOrderProcessingCallback(myOrderProcessingCallback);
+    // placements and cross trades carry nothing for the manager
+    myOrderProcessingSubscriptionId = matchingEngine->subscribeOrderProcessingReports(
+        [this](const std::shared_ptr<const Exchange::OrderProcessingReport>& report) { report->dispatchTo(*this); },
+        Exchange::OrderProcessingReportFilter::allExcept({Exchange::OrderProcessingType::PLACEMENT, Exchange::OrderProcessingType::CROSS, Exchange::OrderProcessingType::NONE}));
+}
+
+OrderEventManagerBase::~OrderEventManagerBase() {
+    myMatchingEngine->unsubscribe(myOrderProcessingSubscriptionId);
 }
 
 void OrderEventManagerBase::submitOrderEventToMatchingEngine(const std::shared_ptr<OrderEventBase>& event) {
@@ -50,14 +52,15 @@ void OrderEventManagerBase::submitOrderEventToMatchingEngine(const std::shared_p
     }
 }
 
-std::shared_ptr<OrderSubmitEvent> OrderEventManagerBase::createLimitOrderSubmitEvent(const Side side, const uint32_t quantity, const double price) {
-    const auto& order = std::make_shared<LimitOrder>(myOrderIdHandler.generateId(), clockTick(), side, quantity, Utils::Maths::roundPriceToTick(price, myMinimumPriceTick));
-    return std::make_shared<OrderSubmitEvent>(myEventIdHandler.generateId(), order->getId(), order->getTimestamp(), order);
+std::shared_ptr<OrderSubmitEvent> OrderEventManagerBase::createLimitOrderSubmitEvent(const Side side, const uint32_t quantity, const double price, const TimeInForce timeInForce) {
+    const auto& order = Utils::Memory::makePooledShared<LimitOrder>(myEventPool, myOrderIdHandler.generateId(), clockTick(), side, quantity, Utils::Maths::roundPriceToTick(price, myMinimumPriceTick));
+    order->setTimeInForce(timeInForce);
+    return Utils::Memory::makePooledShared<OrderSubmitEvent>(myEventPool, myEventIdHandler.generateId(), order->getId(), order->getTimestamp(), order);
 }
 
 std::shared_ptr<OrderSubmitEvent> OrderEventManagerBase::createMarketOrderSubmitEvent(const Side side, const uint32_t quantity) {
-    const auto& order = std::make_shared<MarketOrder>(myOrderIdHandler.generateId(), clockTick(), side, quantity);
-    return std::make_shared<OrderSubmitEvent>(myEventIdHandler.generateId(), order->getId(), order->getTimestamp(), order);
+    const auto& order = Utils::Memory::makePooledShared<MarketOrder>(myEventPool, myOrderIdHandler.generateId(), clockTick(), side, quantity);
+    return Utils::Memory::makePooledShared<OrderSubmitEvent>(myEventPool, myEventIdHandler.generateId(), order->getId(), order->getTimestamp(), order);
 }
 
 std::shared_ptr<OrderCancelEvent> OrderEventManagerBase::createOrderCancelEvent(const uint64_t orderId) {
@@ -66,7 +69,7 @@ std::shared_ptr<OrderCancelEvent> OrderEventManagerBase::createOrderCancelEvent(
         *myLogger << Utils::Logger::LogLevel::WARNING << "[OrderEventManagerBase::createOrderCancelEvent] Order not found - orderId = " << orderId << ".";
         return nullptr;
     }
-    return std::make_shared<OrderCancelEvent>(myEventIdHandler.generateId(), order->getId(), clockTick());
+    return Utils::Memory::makePooledShared<OrderCancelEvent>(myEventPool, myEventIdHandler.generateId(), order->getId(), clockTick());
 }
 
 std::shared_ptr<OrderPartialCancelEvent> OrderEventManagerBase::createOrderPartialCancelEvent(const uint64_t orderId, const uint32_t cancelQuantity) {
@@ -75,7 +78,7 @@ std::shared_ptr<OrderPartialCancelEvent> OrderEventManagerBase::createOrderParti
         *myLogger << Utils::Logger::LogLevel::WARNING << "[OrderEventManagerBase::createOrderPartialCancelEvent] Order not found - orderId = " << orderId << ".";
         return nullptr;
     }
-    return std::make_shared<OrderPartialCancelEvent>(myEventIdHandler.generateId(), order->getId(), clockTick(), cancelQuantity);
+    return Utils::Memory::makePooledShared<OrderPartialCancelEvent>(myEventPool, myEventIdHandler.generateId(), order->getId(), clockTick(), cancelQuantity);
 }
 
 std::shared_ptr<OrderCancelAndReplaceEvent> OrderEventManagerBase::createOrderCancelAndReplaceEvent(const uint64_t orderId,
@@ -86,7 +89,7 @@ std::shared_ptr<OrderCancelAndReplaceEvent> OrderEventManagerBase::createOrderCa
         return nullptr;
     }
     const auto& roundedModifiedPrice = modifiedPrice ? std::make_optional(Utils::Maths::roundPriceToTick(*modifiedPrice, myMinimumPriceTick)) : std::nullopt;
-    return std::make_shared<OrderCancelAndReplaceEvent>(myEventIdHandler.generateId(), order->getId(), clockTick(), myOrderIdHandler.generateId(), modifiedQuantity, roundedModifiedPrice);
+    return Utils::Memory::makePooledShared<OrderCancelAndReplaceEvent>(myEventPool, myEventIdHandler.generateId(), order->getId(), clockTick(), myOrderIdHandler.generateId(), modifiedQuantity, roundedModifiedPrice);
 }
 
 std::shared_ptr<OrderModifyPriceEvent> OrderEventManagerBase::createOrderModifyPriceEvent(const uint64_t orderId, const double modifiedPrice) {
@@ -95,7 +98,7 @@ std::shared_ptr<OrderModifyPriceEvent> OrderEventManagerBase::createOrderModifyP
         *myLogger << Utils::Logger::LogLevel::WARNING << "[OrderEventManagerBase::createOrderModifyPriceEvent] Order not found - orderId = " << orderId << ".";
         return nullptr;
     }
-    return std::make_shared<OrderModifyPriceEvent>(myEventIdHandler.generateId(), order->getId(), clockTick(), Utils::Maths::roundPriceToTick(modifiedPrice, myMinimumPriceTick));
+    return Utils::Memory::makePooledShared<OrderModifyPriceEvent>(myEventPool, myEventIdHandler.generateId(), order->getId(), clockTick(), Utils::Maths::roundPriceToTick(modifiedPrice, myMinimumPriceTick));
 }
 
 std::shared_ptr<OrderModifyQuantityEvent> OrderEventManagerBase::createOrderModifyQuantityEvent(const uint64_t orderId, const double modifiedQuantity) {
@@ -104,7 +107,7 @@ std::shared_ptr<OrderModifyQuantityEvent> OrderEventManagerBase::createOrderModi
         *myLogger << Utils::Logger::LogLevel::WARNING << "[OrderEventManagerBase::createOrderModifyQuantityEvent] Order not found - orderId = " << orderId << ".";
         return nullptr;
     }
-    return std::make_shared<OrderModifyQuantityEvent>(myEventIdHandler.generateId(), order->getId(), clockTick(), modifiedQuantity);
+    return Utils::Memory::makePooledShared<OrderModifyQuantityEvent>(myEventPool, myEventIdHandler.generateId(), order->getId(), clockTick(), modifiedQuantity);
 }
 
 std::shared_ptr<OrderBase> OrderEventManagerBase::fetchOrder(const uint64_t orderId) const {
@@ -148,8 +151,8 @@ void OrderEventManagerBase::setLoggerLogFile(const std::string& logFileName, con
     *myLogger << Utils::Logger::LogLevel::INFO << "[OrderEventManagerBase::setLoggerLogFile] Logger log file set to: " << logFileName;
 }
 
-std::shared_ptr<const OrderSubmitEvent> OrderEventManagerBase::submitLimitOrderEvent(const Side side, const uint32_t quantity, const double price) {
-    const auto& event = createLimitOrderSubmitEvent(side, quantity, price);
+std::shared_ptr<const OrderSubmitEvent> OrderEventManagerBase::submitLimitOrderEvent(const Side side, const uint32_t quantity, const double price, const TimeInForce timeInForce) {
+    const auto& event = createLimitOrderSubmitEvent(side, quantity, price, timeInForce);
     submitOrderEventToMatchingEngine(event);
     return event;
 }
@@ -14,12 +14,14 @@ class OrderEventManagerBase {
 public:
     OrderEventManagerBase() = delete; // only permits construction from matching engine
     OrderEventManagerBase(const std::shared_ptr<Exchange::IMatchingEngine>& matchingEngine);
-    virtual ~OrderEventManagerBase() = default;
+    OrderEventManagerBase(const OrderEventManagerBase&) = delete; // the engine subscription is bound to this instance
+    virtual ~OrderEventManagerBase();
     const Utils::Counter::IdHandlerBase& getOrderIdHandler() const { return myOrderIdHandler; }
     const Utils::Counter::IdHandlerBase& getEventIdHandler() const { return myEventIdHandler; }
     std::shared_ptr<Utils::Counter::TimestampHandlerBase> getWorldClock() const { return myWorldClock; }
     std::shared_ptr<Utils::Logger::LoggerBase> getLogger() const { return myLogger; }
     std::shared_ptr<const Exchange::IMatchingEngine> getMatchingEngine() const { return myMatchingEngine; }
+    std::shared_ptr<Utils::Memory::ObjectPool> getEventPool() const { return myEventPool; }
     const LimitOrderIndex& getActiveLimitOrders() const { return myActiveLimitOrders; }
     const MarketOrderIndex& getQueuedMarketOrders() const { return myQueuedMarketOrders; }
     double getMinimumPriceTick() const { return myMinimumPriceTick; }
@@ -33,6 +35,7 @@ public:
     void setWorldClock(const std::shared_ptr<Utils::Counter::TimestampHandlerBase>& worldClock) { myWorldClock = worldClock; }
     void setLogger(const std::shared_ptr<Utils::Logger::LoggerBase>& logger) { myLogger = logger; }
     void setMatchingEngine(const std::shared_ptr<Exchange::IMatchingEngine>& matchingEngine) { myMatchingEngine = matchingEngine; }
+    void setEventPool(const std::shared_ptr<Utils::Memory::ObjectPool>& eventPool) { myEventPool = eventPool; } // null allocates from the heap
     void setMinimumPriceTick(const double minimumPriceTick) { myMinimumPriceTick = minimumPriceTick; }
     void setMillisecondsToPauseBeforeEventSubmit(const long long millisecondsToPauseBeforeEventSubmit) { myMillisecondsToPauseBeforeEventSubmit = millisecondsToPauseBeforeEventSubmit; }
     void setTimeEngineOrderEventsProcessing(const bool timeEngineOrderEventsProcessing) { myTimeEngineOrderEventsProcessing = timeEngineOrderEventsProcessing; }
@@ -41,7 +44,7 @@ public:
     void setPrintOrderBookPerOrderSubmit(const bool printOrderBookPerOrderSubmit) { myPrintOrderBookPerOrderSubmit = printOrderBookPerOrderSubmit; }
     void setLoggerLogFile(const std::string& logFileName, const bool logToConsole = false, const bool showLogTimestamp = true);
     uint64_t clockTick(const uint64_t elapsedTimeUnit = 1) { return myWorldClock->tick(elapsedTimeUnit); }
-    std::shared_ptr<const OrderSubmitEvent> submitLimitOrderEvent(const Side side, const uint32_t quantity, const double price);
+    std::shared_ptr<const OrderSubmitEvent> submitLimitOrderEvent(const Side side, const uint32_t quantity, const double price, const TimeInForce timeInForce = TimeInForce::GTC);
     std::shared_ptr<const OrderSubmitEvent> submitMarketOrderEvent(const Side side, const uint32_t quantity);
     std::shared_ptr<const OrderCancelEvent> cancelOrder(const uint64_t orderId);
     std::shared_ptr<const OrderPartialCancelEvent> partialCancelOrder(const uint64_t orderId, const uint32_t cancelQuantity);
@@ -65,7 +68,7 @@ public:
     virtual void reset();
 private:
     void submitOrderEventToMatchingEngine(const std::shared_ptr<OrderEventBase>& event);
-    virtual std::shared_ptr<OrderSubmitEvent> createLimitOrderSubmitEvent(const Side side, const uint32_t quantity, const double price);
+    virtual std::shared_ptr<OrderSubmitEvent> createLimitOrderSubmitEvent(const Side side, const uint32_t quantity, const double price, const TimeInForce timeInForce = TimeInForce::GTC);
     virtual std::shared_ptr<OrderSubmitEvent> createMarketOrderSubmitEvent(const Side side, const uint32_t quantity);
     virtual std::shared_ptr<OrderCancelEvent> createOrderCancelEvent(const uint64_t orderId);
     virtual std::shared_ptr<OrderPartialCancelEvent> createOrderPartialCancelEvent(const uint64_t orderId, const uint32_t cancelQuantity);
@@ -81,8 +84,10 @@ private:
     Utils::Counter::IdHandlerBase myEventIdHandler = Utils::Counter::IdHandlerBase();
     std::shared_ptr<Utils::Counter::TimestampHandlerBase> myWorldClock = std::make_shared<Utils::Counter::TimestampHandlerBase>();
     std::shared_ptr<Utils::Logger::LoggerBase> myLogger = std::make_shared<Utils::Logger::LoggerBase>();
-    Exchange::CallbackSharedPtr<Exchange::OrderProcessingReport> myOrderProcessingCallback;
+    Exchange::SubscriptionId myOrderProcessingSubscriptionId = 0;
     std::shared_ptr<Exchange::IMatchingEngine> myMatchingEngine;
+    // the events and orders created here are drawn from and recycled into this pool, which may be shared between managers driven from one thread
+    std::shared_ptr<Utils::Memory::ObjectPool> myEventPool = std::make_shared<Utils::Memory::ObjectPool>();
     LimitOrderIndex myActiveLimitOrders;
     MarketOrderIndex myQueuedMarketOrders; // empty most of the time
     double myMinimumPriceTick = 0.01;
@@ -7,6 +7,7 @@ enum class Side           { BUY, SELL, NONE };
 enum class OrderType      { LIMIT, MARKET, NONE };
 enum class OrderState     { ACTIVE, FILLED, PARTIAL_FILLED, CANCELLED, INVALID, NONE }; // order filling goes from ACTIVE to PARTIAL_FILLED to FILLED
 enum class OrderEventType { SUBMIT, FILL, CANCEL, PARTIAL_CANCEL, CANCEL_REPLACE, MODIFY_PRICE, MODIFY_QUANTITY, BROKEN_TRADE, NONE };
+enum class TimeInForce    { GTC, IOC, FOK, POST_ONLY, NONE }; // good-till-cancel rests, immediate-or-cancel drops the remainder, fill-or-kill fills entirely or not at all, post-only never takes
 }
 
 template<>
@@ -29,4 +30,9 @@ struct Utils::EnumStrings<Market::OrderEventType> {
     inline static constexpr std::array<const char*, 9> names = { "Submit", "Fill", "Cancel", "PartialCancel", "CancelReplace", "ModifyPrice", "ModifyQuantity", "BrokenTrade", "None" };
 };
 
+template<>
+struct Utils::EnumStrings<Market::TimeInForce> {
+    inline static constexpr std::array<const char*, 5> names = { "GTC", "IOC", "FOK", "PostOnly", "None" };
+};
+
 #endif
@@ -0,0 +1,336 @@
+#ifndef LOBSTER_COLUMNAR_FILE_CPP
+#define LOBSTER_COLUMNAR_FILE_CPP
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Utils/Utils.hpp"
+#include "Parser/LobsterDataParser.hpp"
+#include "Parser/LobsterColumnarFile.hpp"
+
+namespace Parser {
+static_assert(std::endian::native == std::endian::little, "The raw columns are read in place as little-endian values.");
+static_assert(sizeof(LobsterColumnarFormat::FileHeader) == 32 && sizeof(LobsterColumnarFormat::ColumnHeader) == 24 &&
+    sizeof(LobsterColumnarFormat::BlockHeader) == 8, "The headers keep the columns 8-byte aligned.");
+
+namespace {
+constexpr std::array<const char*, LobsterColumnarFormat::NUM_MESSAGE_COLUMNS> MESSAGE_COLUMN_NAMES = { "time", "type", "oid", "qty", "px", "dir" };
+constexpr std::array<uint8_t, LobsterColumnarFormat::NUM_MESSAGE_COLUMNS> MESSAGE_COLUMN_WIDTHS = { 8, 1, 8, 4, 4, 1 };
+constexpr std::array<const char*, LobsterColumnarFormat::FIELDS_PER_LEVEL> LEVEL_FIELD_NAMES = { "ap", "as", "bp", "bs" };
+
+uint8_t getColumnWidth(const size_t column) {
+    return column < LobsterColumnarFormat::NUM_MESSAGE_COLUMNS ? MESSAGE_COLUMN_WIDTHS[column] : sizeof(uint32_t);
+}
+}
+
+LobsterColumnarWriter::LobsterColumnarWriter(const LobsterColumnarConfig& config) :
+    myConfig(config) {
+    if (myConfig.filePath.empty())
+        Utils::Error::LIB_THROW("[LobsterColumnarWriter] File path is empty.");
+    if (myConfig.blockSize == 0)
+        Utils::Error::LIB_THROW("[LobsterColumnarWriter] Block size is zero.");
+    const size_t numColumns = LobsterColumnarFormat::getNumColumns(myConfig.numLevels);
+    for (size_t column = 0; column < numColumns; ++column) {
+        LobsterColumnarFormat::ColumnHeader header{};
+        std::string name;
+        bool isPrice = column == LobsterColumnarFormat::PRICE;
+        if (column < LobsterColumnarFormat::NUM_MESSAGE_COLUMNS) {
+            name = MESSAGE_COLUMN_NAMES[column];
+        } else {
+            const size_t field = (column - LobsterColumnarFormat::NUM_MESSAGE_COLUMNS) % LobsterColumnarFormat::FIELDS_PER_LEVEL;
+            name = LEVEL_FIELD_NAMES[field] + std::to_string((column - LobsterColumnarFormat::NUM_MESSAGE_COLUMNS) / LobsterColumnarFormat::FIELDS_PER_LEVEL + 1);
+            isPrice = field % 2 == 0;
+        }
+        std::copy_n(name.begin(), std::min(name.size(), LobsterColumnarFormat::COLUMN_NAME_SIZE), header.name.begin());
+        header.width = getColumnWidth(column);
+        const bool isCompressed = (column == LobsterColumnarFormat::TIME && myConfig.isCompressTimes) || (isPrice && myConfig.isCompressPrices);
+        header.encoding = isCompressed ? LobsterColumnarFormat::Encoding::DELTA_VARINT : LobsterColumnarFormat::Encoding::RAW;
+        myColumnHeaders.push_back(header);
+    }
+    myColumns.resize(numColumns);
+    for (size_t column = 0; column < numColumns; ++column)
+        myColumns[column].reserve(myConfig.blockSize * myColumnHeaders[column].width);
+    myColumnSizes.resize(numColumns);
+    mySnapshotRow.resize(LobsterColumnarFormat::FIELDS_PER_LEVEL * myConfig.numLevels);
+    myFd = ::open(myConfig.filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (myFd < 0)
+        Utils::Error::LIB_THROW("[LobsterColumnarWriter] Cannot open file " + myConfig.filePath + ": " + std::strerror(errno));
+    // the counts are filled in on close
+    const LobsterColumnarFormat::FileHeader header{LobsterColumnarFormat::MAGIC, static_cast<uint32_t>(myConfig.numLevels), static_cast<uint32_t>(numColumns), 0, 0};
+    writeBytes(&header, sizeof(header));
+    writeBytes(myColumnHeaders.data(), myColumnHeaders.size() * sizeof(LobsterColumnarFormat::ColumnHeader));
+}
+
+LobsterColumnarWriter::~LobsterColumnarWriter() {
+    try {
+        close();
+    } catch (const std::exception&) {
+    }
+}
+
+void LobsterColumnarWriter::write(const OrderBookMessage& message, const OrderBookSnapshot* snapshot) {
+    if (!snapshot) {
+        if (!isOpen())
+            Utils::Error::LIB_THROW("[LobsterColumnarWriter::write] Writer is closed.");
+        myPendingMessages.push_back(message);
+        return;
+    }
+    for (size_t level = 0; level < myConfig.numLevels; ++level) {
+        uint32_t* row = mySnapshotRow.data() + LobsterColumnarFormat::FIELDS_PER_LEVEL * level;
+        const bool hasAsk = level < snapshot->askPrice.size(), hasBid = level < snapshot->bidPrice.size();
+        row[0] = hasAsk ? snapshot->askPrice[level] : 0;
+        row[1] = hasAsk ? snapshot->askSize[level] : 0;
+        row[2] = hasBid ? snapshot->bidPrice[level] : 0;
+        row[3] = hasBid ? snapshot->bidSize[level] : 0;
+    }
+    write(message, mySnapshotRow);
+}
+
+void LobsterColumnarWriter::write(const OrderBookMessage& message, std::span<const uint32_t> snapshotRow) {
+    if (!isOpen())
+        Utils::Error::LIB_THROW("[LobsterColumnarWriter::write] Writer is closed.");
+    for (const auto& pendingMessage : myPendingMessages)
+        writeRecord(pendingMessage, snapshotRow);
+    myPendingMessages.clear();
+    writeRecord(message, snapshotRow);
+}
+
+void LobsterColumnarWriter::close() {
+    if (!isOpen())
+        return;
+    std::exception_ptr error;
+    try {
+        for (const auto& pendingMessage : myPendingMessages)
+            writeRecord(pendingMessage, {}); // their levels left empty
+        myPendingMessages.clear();
+        writeBlock();
+        const LobsterColumnarFormat::FileHeader header{LobsterColumnarFormat::MAGIC, static_cast<uint32_t>(myConfig.numLevels),
+            static_cast<uint32_t>(myColumnHeaders.size()), myNumRecords, myNumBlocks};
+        if (::pwrite(myFd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)))
+            Utils::Error::LIB_THROW("[LobsterColumnarWriter] Cannot write the header of file " + myConfig.filePath + ": " + std::strerror(errno));
+    } catch (...) {
+        error = std::current_exception(); // the file is closed all the same
+    }
+    ::close(myFd);
+    myFd = -1;
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void LobsterColumnarWriter::writeRecord(const OrderBookMessage& message, std::span<const uint32_t> snapshotRow) {
+    for (size_t column = 0; column < myColumns.size(); ++column)
+        myColumns[column].resize(myColumns[column].size() + myColumnHeaders[column].width, 0);
+    const size_t row = myBlockNumRecords++;
+    setValue(LobsterColumnarFormat::TIME, row, message.timestamp);
+    setValue(LobsterColumnarFormat::TYPE, row, static_cast<uint8_t>(message.messageType));
+    setValue(LobsterColumnarFormat::ORDER_ID, row, message.orderId);
+    setValue(LobsterColumnarFormat::QUANTITY, row, message.quantity);
+    setValue(LobsterColumnarFormat::PRICE, row, message.price);
+    setValue(LobsterColumnarFormat::DIRECTION, row, message.isBuy);
+    const size_t numFields = std::min(snapshotRow.size(), LobsterColumnarFormat::FIELDS_PER_LEVEL * myConfig.numLevels);
+    for (size_t i = 0; i < numFields; ++i)
+        setValue(LobsterColumnarFormat::NUM_MESSAGE_COLUMNS + i, row, snapshotRow[i]);
+    ++myNumRecords;
+    if (myBlockNumRecords >= myConfig.blockSize)
+        writeBlock();
+}
+
+void LobsterColumnarWriter::setValue(const size_t column, const size_t row, const uint64_t value) {
+    const size_t width = myColumnHeaders[column].width;
+    std::memcpy(myColumns[column].data() + row * width, &value, width); // the low bytes on a little-endian host
+}
+
+void LobsterColumnarWriter::writeBlock() {
+    if (myBlockNumRecords == 0)
+        return;
+    myEncoded.clear();
+    for (size_t column = 0; column < myColumns.size(); ++column)
+        encodeColumn(column);
+    const LobsterColumnarFormat::BlockHeader header{static_cast<uint32_t>(myBlockNumRecords), 0};
+    writeBytes(&header, sizeof(header));
+    writeBytes(myColumnSizes.data(), myColumnSizes.size() * sizeof(uint64_t));
+    writeBytes(myEncoded.data(), myEncoded.size());
+    for (auto& values : myColumns)
+        values.clear();
+    myBlockNumRecords = 0;
+    ++myNumBlocks;
+}
+
+void LobsterColumnarWriter::encodeColumn(const size_t column) {
+    const auto& values = myColumns[column];
+    const size_t start = myEncoded.size();
+    if (myColumnHeaders[column].encoding == LobsterColumnarFormat::Encoding::RAW) {
+        myEncoded.insert(myEncoded.end(), values.begin(), values.end());
+    } else {
+        const size_t width = myColumnHeaders[column].width;
+        uint64_t previous = 0;
+        for (size_t offset = 0; offset < values.size(); offset += width) {
+            uint64_t value = 0;
+            std::memcpy(&value, values.data() + offset, width);
+            const int64_t delta = static_cast<int64_t>(value - previous);
+            uint64_t zigzag = (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63);
+            for (; zigzag >= 0x80; zigzag >>= 7)
+                myEncoded.push_back(static_cast<uint8_t>(zigzag | 0x80));
+            myEncoded.push_back(static_cast<uint8_t>(zigzag));
+            previous = value;
+        }
+    }
+    myColumnSizes[column] = myEncoded.size() - start;
+    myEncoded.resize(start + LobsterColumnarFormat::getPaddedSize(myColumnSizes[column]), 0);
+}
+
+void LobsterColumnarWriter::writeBytes(const void* data, const size_t size) {
+    Utils::IO::writeAll(myFd, data, size, myConfig.filePath);
+    myNumBytesWritten += size;
+}
+
+LobsterColumnarReader::LobsterColumnarReader(const std::string& filePath) :
+    myFile(std::make_unique<const Utils::IO::MappedFile>(filePath)) {
+    const uint8_t* data = myFile->getData();
+    const size_t size = myFile->getSize();
+    LobsterColumnarFormat::FileHeader header;
+    if (size < sizeof(header))
+        throwMalformed("too short for the file header");
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != LobsterColumnarFormat::MAGIC)
+        throwMalformed("not a LOBSTER columnar file");
+    myNumLevels = header.numLevels;
+    myNumRecords = header.numRecords;
+    const size_t numColumns = LobsterColumnarFormat::getNumColumns(myNumLevels);
+    if (header.numColumns != numColumns)
+        throwMalformed(std::to_string(header.numColumns) + " columns for " + std::to_string(myNumLevels) + " levels");
+    size_t offset = sizeof(header);
+    if (size < offset + numColumns * sizeof(LobsterColumnarFormat::ColumnHeader))
+        throwMalformed("too short for the column headers");
+    myColumnHeaders.resize(numColumns);
+    std::memcpy(myColumnHeaders.data(), data + offset, numColumns * sizeof(LobsterColumnarFormat::ColumnHeader));
+    offset += numColumns * sizeof(LobsterColumnarFormat::ColumnHeader);
+    for (size_t column = 0; column < numColumns; ++column)
+        if (myColumnHeaders[column].width != getColumnWidth(column) || myColumnHeaders[column].encoding > LobsterColumnarFormat::Encoding::DELTA_VARINT)
+            throwMalformed("unexpected width or encoding of column " + getColumnName(column));
+    // the blocks are indexed up front, reading only their headers
+    uint64_t numBlockRecords = 0;
+    for (uint64_t block = 0; block < header.numBlocks; ++block) {
+        const size_t columnsOffset = offset + sizeof(LobsterColumnarFormat::BlockHeader) + numColumns * sizeof(uint64_t);
+        if (size < columnsOffset)
+            throwMalformed("block " + std::to_string(block) + " is cut short");
+        LobsterColumnarFormat::BlockHeader blockHeader;
+        std::memcpy(&blockHeader, data + offset, sizeof(blockHeader));
+        size_t blockSize = columnsOffset - offset;
+        for (size_t column = 0; column < numColumns; ++column) {
+            uint64_t columnSize;
+            std::memcpy(&columnSize, data + offset + sizeof(blockHeader) + column * sizeof(uint64_t), sizeof(columnSize));
+            blockSize += LobsterColumnarFormat::getPaddedSize(columnSize);
+        }
+        if (size < offset + blockSize)
+            throwMalformed("block " + std::to_string(block) + " is cut short");
+        myBlockOffsets.push_back(offset);
+        numBlockRecords += blockHeader.numRecords;
+        offset += blockSize;
+    }
+    if (numBlockRecords != myNumRecords)
+        throwMalformed(std::to_string(numBlockRecords) + " records in the blocks, " + std::to_string(myNumRecords) + " in the header");
+    myColumnData.resize(numColumns);
+    myDecodedColumns.resize(numColumns);
+    rewind();
+}
+
+std::string LobsterColumnarReader::getColumnName(const size_t column) const {
+    const auto& name = myColumnHeaders.at(column).name;
+    return std::string(name.data(), std::find(name.begin(), name.end(), '\0'));
+}
+
+void LobsterColumnarReader::loadBlock(const size_t blockIndex) {
+    if (blockIndex >= myBlockOffsets.size())
+        Utils::Error::LIB_THROW("[LobsterColumnarReader::loadBlock] Block " + std::to_string(blockIndex) + " is out of " + std::to_string(myBlockOffsets.size()) + ".");
+    const uint8_t* data = myFile->getData() + myBlockOffsets[blockIndex];
+    LobsterColumnarFormat::BlockHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    const uint8_t* columnSizes = data + sizeof(header);
+    const uint8_t* columnData = columnSizes + myColumnHeaders.size() * sizeof(uint64_t);
+    for (size_t column = 0; column < myColumnHeaders.size(); ++column) {
+        uint64_t columnSize;
+        std::memcpy(&columnSize, columnSizes + column * sizeof(uint64_t), sizeof(columnSize));
+        const size_t width = myColumnHeaders[column].width;
+        if (myColumnHeaders[column].encoding == LobsterColumnarFormat::Encoding::RAW) {
+            if (columnSize != header.numRecords * width)
+                throwMalformed("column " + getColumnName(column) + " of block " + std::to_string(blockIndex) + " has " + std::to_string(columnSize) + " bytes");
+            myColumnData[column] = columnData;
+        } else {
+            auto& decoded = myDecodedColumns[column];
+            decoded.resize(header.numRecords * width);
+            const uint8_t* p = columnData;
+            const uint8_t* end = columnData + columnSize;
+            uint64_t value = 0;
+            for (size_t row = 0; row < header.numRecords; ++row) {
+                uint64_t zigzag = 0;
+                for (int shift = 0; ; shift += 7) {
+                    if (p == end || shift > 63)
+                        throwMalformed("column " + getColumnName(column) + " of block " + std::to_string(blockIndex) + " ends in a varint");
+                    const uint8_t byte = *p++;
+                    zigzag |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    if (!(byte & 0x80))
+                        break;
+                }
+                value += (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+                std::memcpy(decoded.data() + row * width, &value, width);
+            }
+            myColumnData[column] = decoded.data();
+        }
+        columnData += LobsterColumnarFormat::getPaddedSize(columnSize);
+    }
+    myBlockIndex = blockIndex;
+    myBlockNumRecords = header.numRecords;
+}
+
+LobsterColumnarReader::OrderBookMessage LobsterColumnarReader::getMessage(const size_t row) const {
+    return OrderBookMessage(
+        getValue<uint64_t>(LobsterColumnarFormat::TIME, row),
+        static_cast<LobsterDataParser::MessageType>(getValue<uint8_t>(LobsterColumnarFormat::TYPE, row)),
+        getValue<uint64_t>(LobsterColumnarFormat::ORDER_ID, row),
+        getValue<uint32_t>(LobsterColumnarFormat::QUANTITY, row),
+        getValue<uint32_t>(LobsterColumnarFormat::PRICE, row),
+        getValue<uint8_t>(LobsterColumnarFormat::DIRECTION, row) != 0);
+}
+
+void LobsterColumnarReader::getSnapshotRow(const size_t row, std::span<uint32_t> snapshotRow) const {
+    const size_t snapshotSize = getSnapshotSize();
+    for (size_t i = 0; i < snapshotRow.size(); ++i)
+        snapshotRow[i] = i < snapshotSize ? getValue<uint32_t>(LobsterColumnarFormat::NUM_MESSAGE_COLUMNS + i, row) : 0;
+}
+
+size_t LobsterColumnarReader::read(std::span<OrderBookMessage> messages, std::span<uint32_t> snapshots) {
+    const size_t snapshotSize = getSnapshotSize();
+    const bool isReadSnapshots = !snapshots.empty() && snapshotSize > 0;
+    const size_t numToRead = isReadSnapshots ? std::min(messages.size(), snapshots.size() / snapshotSize) : messages.size();
+    size_t numRead = 0;
+    for (; numRead < numToRead && !isExhausted(); ++numRead) {
+        while (myBlockRow == myBlockNumRecords) {
+            loadBlock(myBlockIndex + 1);
+            myBlockRow = 0;
+        }
+        messages[numRead] = getMessage(myBlockRow);
+        if (isReadSnapshots)
+            getSnapshotRow(myBlockRow, snapshots.subspan(numRead * snapshotSize, snapshotSize));
+        ++myBlockRow;
+        ++myNumRecordsRead;
+    }
+    return numRead;
+}
+
+void LobsterColumnarReader::rewind() {
+    myBlockRow = 0;
+    myNumRecordsRead = 0;
+    if (myBlockOffsets.empty())
+        myBlockNumRecords = 0;
+    else
+        loadBlock(0);
+}
+
+void LobsterColumnarReader::throwMalformed(const std::string& reason) const {
+    throw Utils::Error::LibException("[LobsterColumnarReader] Malformed file " + myFile->getFilePath() + ": " + reason + ".");
+}
+}
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef LOBSTER_COLUMNAR_FILE_HPP
+#define LOBSTER_COLUMNAR_FILE_HPP
+#include "Utils/Utils.hpp"
+#include "Parser/LobsterDataParser.hpp"
+
+namespace Parser {
+/* A binary columnar file of LOBSTER messages and their snapshots. The file header names its columns - time, type, oid, qty, px and
+   dir of the message, then ap, as, bp and bs of each level - with the width and the encoding of each, and the records follow in
+   blocks of a column after the other. A column is either raw, fixed-width in the byte order of the host and 8-byte aligned so that
+   it is read in place from the mapped file, or delta+varint, each value stored as the zigzag varint of its difference to the one
+   before, which the times and prices are by default as they move little from row to row. Missing levels are stored as 0, as
+   LobsterDataReader reads them. */
+struct LobsterColumnarFormat {
+    static constexpr std::array<char, 8> MAGIC = { 'L', 'O', 'B', 'C', 'O', 'L', 'v', '1' };
+    static constexpr size_t FIELDS_PER_LEVEL = 4;
+    static constexpr size_t NUM_MESSAGE_COLUMNS = 6;
+    static constexpr size_t COLUMN_NAME_SIZE = 16;
+    enum Column : size_t { TIME, TYPE, ORDER_ID, QUANTITY, PRICE, DIRECTION };
+    enum class Encoding : uint8_t { RAW, DELTA_VARINT };
+
+    struct FileHeader {
+        std::array<char, 8> magic;
+        uint32_t numLevels;
+        uint32_t numColumns;
+        uint64_t numRecords;
+        uint64_t numBlocks;
+    };
+
+    struct ColumnHeader {
+        std::array<char, COLUMN_NAME_SIZE> name;
+        uint8_t width; // bytes of a value
+        Encoding encoding;
+        std::array<uint8_t, 6> padding;
+    };
+
+    struct BlockHeader {
+        uint32_t numRecords;
+        uint32_t padding;
+        // followed by the byte size of each column, then the columns
+    };
+
+    static size_t getNumColumns(const size_t numLevels) { return NUM_MESSAGE_COLUMNS + FIELDS_PER_LEVEL * numLevels; }
+    static size_t getLevelColumn(const size_t level, const size_t field) { return NUM_MESSAGE_COLUMNS + FIELDS_PER_LEVEL * level + field; }
+    static size_t getPaddedSize(const size_t size) { return (size + 7) & ~size_t(7); }
+};
+
+struct LobsterColumnarConfig {
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 1 << 16;
+
+    std::string filePath;
+    size_t numLevels = 10;
+    size_t blockSize = DEFAULT_BLOCK_SIZE; // records held in memory before they are written as a block
+    bool isCompressTimes = true;
+    bool isCompressPrices = true; // of the messages and the levels
+};
+
+/* Writes records to a columnar file block by block. A message with no snapshot of its own takes that of the message after it, as in
+   LobsterDataWriter, so that the CSV written from the file is that of LobsterDataWriter. */
+class LobsterColumnarWriter {
+public:
+    using OrderBookMessage = LobsterDataParser::OrderBookMessage;
+    using OrderBookSnapshot = LobsterDataParser::OrderBookSnapshot;
+
+    LobsterColumnarWriter() = delete;
+    LobsterColumnarWriter(const LobsterColumnarConfig& config);
+    LobsterColumnarWriter(const LobsterColumnarWriter&) = delete;
+    virtual ~LobsterColumnarWriter();
+
+    const LobsterColumnarConfig& getConfig() const { return myConfig; }
+    bool isOpen() const { return myFd >= 0; }
+    uint64_t getNumRecords() const { return myNumRecords; } // in the blocks so far
+    uint64_t getNumBlocks() const { return myNumBlocks; }
+    uint64_t getNumBytesWritten() const { return myNumBytesWritten; }
+
+    void write(const OrderBookMessage& message, const OrderBookSnapshot* snapshot);
+    // a flat snapshot row as LobsterDataReader reads it, the levels beyond it empty
+    void write(const OrderBookMessage& message, std::span<const uint32_t> snapshotRow);
+    void close(); // writes the last block and the record count, with empty levels for a message left waiting
+
+private:
+    void writeRecord(const OrderBookMessage& message, std::span<const uint32_t> snapshotRow);
+    void setValue(const size_t column, const size_t row, const uint64_t value);
+    void writeBlock();
+    void encodeColumn(const size_t column);
+    void writeBytes(const void* data, const size_t size);
+
+    const LobsterColumnarConfig myConfig;
+    int myFd = -1;
+    std::vector<LobsterColumnarFormat::ColumnHeader> myColumnHeaders;
+    std::vector<std::vector<uint8_t>> myColumns; // the raw values of the block
+    size_t myBlockNumRecords = 0;
+    std::vector<OrderBookMessage> myPendingMessages; // waiting for the snapshot of the next message
+    std::vector<uint32_t> mySnapshotRow;
+    std::vector<uint64_t> myColumnSizes; // encoded, of the block being written
+    std::vector<uint8_t> myEncoded;
+    uint64_t myNumRecords = 0;
+    uint64_t myNumBlocks = 0;
+    uint64_t myNumBytesWritten = 0;
+};
+
+/* Reads a columnar file from the mapped bytes, a block at a time. The raw columns of the loaded block are spans into the file, the
+   delta+varint ones are decoded into buffers of the reader reused from block to block. read() takes the records in chunks the
+   way LobsterDataReader::read does. */
+class LobsterColumnarReader {
+public:
+    using OrderBookMessage = LobsterDataParser::OrderBookMessage;
+    using OrderBookSnapshot = LobsterDataParser::OrderBookSnapshot;
+
+    LobsterColumnarReader() = delete;
+    LobsterColumnarReader(const std::string& filePath);
+    LobsterColumnarReader(const LobsterColumnarReader&) = delete;
+    virtual ~LobsterColumnarReader() = default;
+
+    const std::string& getFilePath() const { return myFile->getFilePath(); }
+    size_t getNumLevels() const { return myNumLevels; }
+    size_t getSnapshotSize() const { return LobsterColumnarFormat::FIELDS_PER_LEVEL * myNumLevels; }
+    uint64_t getNumRecords() const { return myNumRecords; }
+    size_t getNumBlocks() const { return myBlockOffsets.size(); }
+    size_t getNumColumns() const { return myColumnHeaders.size(); }
+    std::string getColumnName(const size_t column) const;
+    LobsterColumnarFormat::Encoding getColumnEncoding(const size_t column) const { return myColumnHeaders.at(column).encoding; }
+
+    void loadBlock(const size_t blockIndex);
+    size_t getBlockIndex() const { return myBlockIndex; }
+    size_t getBlockNumRecords() const { return myBlockNumRecords; }
+    template<typename T>
+    std::span<const T> getColumn(const size_t column) const { // of the loaded block
+        if (sizeof(T) != myColumnHeaders.at(column).width)
+            Utils::Error::LIB_THROW("[LobsterColumnarReader::getColumn] Column " + getColumnName(column) + " is not " + std::to_string(sizeof(T)) + " bytes wide.");
+        return std::span<const T>(reinterpret_cast<const T*>(myColumnData[column]), myBlockNumRecords);
+    }
+    std::span<const uint32_t> getLevelColumn(const size_t level, const size_t field) const { return getColumn<uint32_t>(LobsterColumnarFormat::getLevelColumn(level, field)); }
+    OrderBookMessage getMessage(const size_t row) const; // of the loaded block
+    void getSnapshotRow(const size_t row, std::span<uint32_t> snapshotRow) const;
+
+    size_t read(std::span<OrderBookMessage> messages, std::span<uint32_t> snapshots = {});
+    bool isExhausted() const { return myNumRecordsRead == myNumRecords; }
+    void rewind();
+
+private:
+    template<typename T>
+    T getValue(const size_t column, const size_t row) const {
+        T value;
+        std::memcpy(&value, myColumnData[column] + row * sizeof(T), sizeof(T));
+        return value;
+    }
+    [[noreturn]] void throwMalformed(const std::string& reason) const;
+
+    std::unique_ptr<const Utils::IO::MappedFile> myFile;
+    size_t myNumLevels = 0;
+    uint64_t myNumRecords = 0;
+    std::vector<LobsterColumnarFormat::ColumnHeader> myColumnHeaders;
+    std::vector<size_t> myBlockOffsets;
+    size_t myBlockIndex = 0;
+    size_t myBlockNumRecords = 0;
+    std::vector<const uint8_t*> myColumnData;
+    std::vector<std::vector<uint8_t>> myDecodedColumns;
+    size_t myBlockRow = 0; // of the next record to read
+    uint64_t myNumRecordsRead = 0;
+};
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define LOBSTER_DATA_PARSER_CPP
 #include "Utils/Utils.hpp"
 #include "LobsterDataParser.hpp"
+#include "LobsterDataWriter.hpp"
 #include "Exchange/MatchingEngineUtils.hpp"
 
 namespace Parser {
@@ -66,24 +67,38 @@ LobsterDataParser::OrderBookMessage::OrderBookMessage(const Exchange::OrderParti
 // represented as delete + add in Lobster format
 LobsterDataParser::OrderBookMessage::OrderBookMessage(const Exchange::OrderCancelAndReplaceReport& /* report */) : OrderBookMessage(true) {}
 
+// the cross print carries no order id, the side is not meaningful
+LobsterDataParser::OrderBookMessage::OrderBookMessage(const Exchange::CrossTradeReport& report) : OrderBookMessage() {
+    if (report.status != Exchange::OrderProcessingStatus::SUCCESS)
+        return;
+    timestamp = report.timestamp;
+    messageType = MessageType::CROSS_TRADE;
+    quantity = report.crossQuantity;
+    price = Utils::Maths::castDoublePriceAsInt<uint32_t>(report.crossPrice);
+}
+
 std::string LobsterDataParser::OrderBookMessage::getAsCsv(bool aligned) const {
-    std::ostringstream oss;
+    Utils::Format::ScopedFormatBuffer buffer;
+    appendAsCsv(*buffer, aligned);
+    return buffer.str();
+}
+
+void LobsterDataParser::OrderBookMessage::appendAsCsv(Utils::Format::FormatBuffer& buffer, bool aligned) const {
     if (aligned) {
-        oss << std::setw(8) << timestamp << ","
-            << std::setw(8) << +static_cast<uint8_t>(messageType) << ","
-            << std::setw(8) << orderId << ","
-            << std::setw(8) << quantity << ","
-            << std::setw(8) << price << ","
-            << std::setw(8) << (isBuy ? 1 : -1);
+        buffer << Utils::Format::aligned(timestamp, 8) << ","
+               << Utils::Format::aligned(+static_cast<uint8_t>(messageType), 8) << ","
+               << Utils::Format::aligned(orderId, 8) << ","
+               << Utils::Format::aligned(quantity, 8) << ","
+               << Utils::Format::aligned(price, 8) << ","
+               << Utils::Format::aligned(isBuy ? 1 : -1, 8);
     } else {
-        oss << timestamp << ","
-            << +static_cast<uint8_t>(messageType) << ","
-            << orderId << ","
-            << quantity << ","
-            << price << ","
-            << (isBuy ? 1 : -1);
+        buffer << timestamp << ","
+               << +static_cast<uint8_t>(messageType) << ","
+               << orderId << ","
+               << quantity << ","
+               << price << ","
+               << (isBuy ? 1 : -1);
     }
-    return oss.str();
 }
 
 std::string LobsterDataParser::OrderBookMessage::getHeaderCsv(bool aligned) {
@@ -95,36 +110,39 @@ std::string LobsterDataParser::OrderBookMessage::getHeaderCsv(bool aligned) {
 }
 
 std::string LobsterDataParser::OrderBookSnapshot::getAsCsv(size_t levels, bool aligned) const {
-    // TODO: costly dynamic allocations, use pre-reserved string buffer
-    std::ostringstream oss;
+    Utils::Format::ScopedFormatBuffer buffer;
+    appendAsCsv(*buffer, levels, aligned);
+    return buffer.str();
+}
+
+void LobsterDataParser::OrderBookSnapshot::appendAsCsv(Utils::Format::FormatBuffer& buffer, size_t levels, bool aligned) const {
     if (aligned) {
         for (size_t i = 0; i < levels; ++i) {
             if (i < askPrice.size())
-                oss << std::setw(8) << askPrice[i] << "," << std::setw(8) << askSize[i] << ",";
+                buffer << Utils::Format::aligned(askPrice[i], 8) << "," << Utils::Format::aligned(askSize[i], 8) << ",";
             else
-                oss << std::setw(8) << "" << "," << std::setw(8) << "" << ",";
+                buffer << Utils::Format::aligned("", 8) << "," << Utils::Format::aligned("", 8) << ",";
             if (i < bidPrice.size())
-                oss << std::setw(8) << bidPrice[i] << "," << std::setw(8) << bidSize[i];
+                buffer << Utils::Format::aligned(bidPrice[i], 8) << "," << Utils::Format::aligned(bidSize[i], 8);
             else
-                oss << std::setw(8) << "" << "," << std::setw(8) << "";
+                buffer << Utils::Format::aligned("", 8) << "," << Utils::Format::aligned("", 8);
             if (i != levels - 1)
-                oss << ",";
+                buffer << ",";
         }
     } else {
         for (size_t i = 0; i < levels; ++i) {
             if (i < askPrice.size())
-                oss << askPrice[i] << "," << askSize[i] << ",";
+                buffer << askPrice[i] << "," << askSize[i] << ",";
             else
-                oss << ",,";
+                buffer << ",,";
             if (i < bidPrice.size())
-                oss << bidPrice[i] << "," << bidSize[i];
+                buffer << bidPrice[i] << "," << bidSize[i];
             else
-                oss << ",";
+                buffer << ",";
             if (i != levels - 1)
-                oss << ",";
+                buffer << ",";
         }
     }
-    return oss.str();
 }
 
 std::string LobsterDataParser::OrderBookSnapshot::getHeaderCsv(size_t levels, bool aligned) {
@@ -144,6 +162,13 @@ std::string LobsterDataParser::OrderBookSnapshot::getHeaderCsv(size_t levels, bo
     }
     return oss.str();
 }
+
+void LobsterDataParser::writeOrderBookMessagesAndSnapshots(LobsterDataWriter& writer) const {
+    const auto& messages = myOrderBookMessagesCollector.getSamples();
+    const auto& snapshots = myOrderBookSnapshotsCollector.getSamples();
+    for (size_t i = 0; i < messages.size(); ++i)
+        writer.write(messages[i], i < snapshots.size() ? snapshots[i] : nullptr);
+}
 }
 
 #endif
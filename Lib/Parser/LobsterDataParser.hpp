@@ -12,9 +12,12 @@ struct OrderModifyQuantityReport;
 struct OrderCancelReport;
 struct OrderPartialCancelReport;
 struct OrderCancelAndReplaceReport;
+struct CrossTradeReport;
 }
 
 namespace Parser {
+class LobsterDataWriter;
+
 class LobsterDataParser {
 public:
     enum class MessageType : uint8_t {
@@ -23,6 +26,7 @@ public:
         ORDER_DELETE = 3,             // 3. Deletion (Total deletion of a limit order)
         ORDER_EXECUTE_VISIBLE = 4,    // 4. Execution of a visible limit order
         ORDER_EXECUTE_HIDDEN = 5,     // 5. Execution of a hidden limit order
+        CROSS_TRADE = 6,              // 6. Cross trade, e.g. auction trade
         TRADING_HALT = 7,             // 7. Trading halt indicator
         NONE = 0
     };
@@ -52,9 +56,11 @@ public:
         OrderBookMessage(const Exchange::OrderCancelReport& report);
         OrderBookMessage(const Exchange::OrderPartialCancelReport& report);
         OrderBookMessage(const Exchange::OrderCancelAndReplaceReport& report);
+        OrderBookMessage(const Exchange::CrossTradeReport& report);
         bool isValid() const { return messageType != MessageType::NONE; }
         bool toSplitIntoDeleteAndAdd() const { return isOrderDeleteAndAdd; }
         std::string getAsCsv(bool aligned = false) const;
+        void appendAsCsv(Utils::Format::FormatBuffer& buffer, bool aligned = false) const;
         static std::string getHeaderCsv(bool aligned = false);
     };
 
@@ -71,11 +77,14 @@ public:
                           const std::vector<uint32_t>& bidSize, const std::vector<uint32_t>& askSize) :
             bidPrice(bidPrice), askPrice(askPrice), bidSize(bidSize), askSize(askSize) {}
         std::string getAsCsv(size_t levels, bool aligned = false) const;
+        void appendAsCsv(Utils::Format::FormatBuffer& buffer, size_t levels, bool aligned = false) const;
         static std::string getHeaderCsv(size_t levels, bool aligned = false);
     };
 
     bool isDebugMode() const { return myDebugMode; }
     void setDebugMode(const bool debugMode) { myDebugMode = debugMode; }
+    const std::deque<std::shared_ptr<const OrderBookMessage>>& getOrderBookMessages() const { return myOrderBookMessagesCollector.getSamples(); }
+    const std::deque<std::shared_ptr<const OrderBookSnapshot>>& getOrderBookSnapshots() const { return myOrderBookSnapshotsCollector.getSamples(); } // null where a message has none
 
     void addOrderBookMessageAndSnapshot(
         const std::shared_ptr<const OrderBookMessage>& message,
@@ -85,21 +94,28 @@ public:
     }
 
     std::pair<std::string, std::string> getOrderBookMessagesAndSnapshotsAsCsv(size_t snapshotLevels, bool aligned = false) const {
-        std::ostringstream messagesOss;
-        messagesOss << OrderBookMessage::getHeaderCsv(aligned) << "\n";
+        Utils::Format::FormatBuffer messagesBuffer;
+        messagesBuffer << OrderBookMessage::getHeaderCsv(aligned) << "\n";
         for (const auto& message : myOrderBookMessagesCollector.getSamples()) {
-            if (message)
-                messagesOss << message->getAsCsv(aligned) << "\n";
+            if (message) {
+                message->appendAsCsv(messagesBuffer, aligned);
+                messagesBuffer << "\n";
+            }
         }
-        std::ostringstream snapshotsOss;
-        snapshotsOss << OrderBookSnapshot::getHeaderCsv(snapshotLevels, aligned) << "\n";
+        Utils::Format::FormatBuffer snapshotsBuffer;
+        snapshotsBuffer << OrderBookSnapshot::getHeaderCsv(snapshotLevels, aligned) << "\n";
         for (const auto& snapshot : myOrderBookSnapshotsCollector.getSamples()) {
-            if (snapshot)
-                snapshotsOss << snapshot->getAsCsv(snapshotLevels, aligned) << "\n";
+            if (snapshot) {
+                snapshot->appendAsCsv(snapshotsBuffer, snapshotLevels, aligned);
+                snapshotsBuffer << "\n";
+            }
         }
-        return {messagesOss.str(), snapshotsOss.str()};
+        return {messagesBuffer.str(), snapshotsBuffer.str()};
     }
 
+    // streams the records to files in the bounded buffers of the writer, rather than the whole day as strings
+    void writeOrderBookMessagesAndSnapshots(LobsterDataWriter& writer) const;
+
 private:
     bool myDebugMode = false;
     Utils::Statistics::TimeSeriesCollector<OrderBookMessage> myOrderBookMessagesCollector;
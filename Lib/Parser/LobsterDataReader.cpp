@@ -0,0 +1,223 @@
+#ifndef LOBSTER_DATA_READER_CPP
+#define LOBSTER_DATA_READER_CPP
+#include <cstring>
+#include <limits>
+#include "Utils/Utils.hpp"
+#include "Parser/LobsterDataParser.hpp"
+#include "Parser/LobsterDataReader.hpp"
+
+namespace Parser {
+LobsterDataReader::LobsterDataReader(const std::string& messageFilePath, const std::string& orderBookFilePath, const size_t numLevels) :
+    myMessageFile(std::make_unique<const Utils::IO::MappedFile>(messageFilePath)) {
+    if (!orderBookFilePath.empty())
+        myOrderBookFile = std::make_unique<const Utils::IO::MappedFile>(orderBookFilePath);
+    rewind();
+    if (hasOrderBook()) {
+        const size_t numFields = countFields(myOrderBookCursor);
+        if (numFields % FIELDS_PER_LEVEL != 0)
+            throwMalformed(myOrderBookCursor, std::to_string(numFields) + " fields do not make whole levels");
+        myNumFileLevels = numFields / FIELDS_PER_LEVEL;
+    }
+    myNumLevels = numLevels ? numLevels : myNumFileLevels;
+}
+
+size_t LobsterDataReader::read(std::span<OrderBookMessage> messages, std::span<uint32_t> snapshots) {
+    const size_t snapshotSize = getSnapshotSize();
+    const bool isReadSnapshots = hasOrderBook() && !snapshots.empty() && snapshotSize > 0;
+    if (isReadSnapshots && !messages.empty() && snapshots.size() < snapshotSize)
+        Utils::Error::LIB_THROW("[LobsterDataReader::read] Snapshots buffer too small - " + std::to_string(snapshots.size()) +
+            " fields for a row of " + std::to_string(snapshotSize) + ".");
+    const size_t numToRead = isReadSnapshots ? std::min(messages.size(), snapshots.size() / snapshotSize) : messages.size();
+    size_t numRead = 0;
+    for (; numRead < numToRead && !isExhausted(); ++numRead) {
+        parseMessage(messages[numRead]);
+        if (hasOrderBook())
+            parseSnapshot(isReadSnapshots ? snapshots.data() + numRead * snapshotSize : nullptr);
+    }
+    myNumRecords += numRead;
+    return numRead;
+}
+
+void LobsterDataReader::rewind() {
+    myMessageCursor = makeCursor(*myMessageFile);
+    skipHeader(myMessageCursor);
+    if (hasOrderBook()) {
+        myOrderBookCursor = makeCursor(*myOrderBookFile);
+        skipHeader(myOrderBookCursor);
+    }
+    myNumRecords = 0;
+}
+
+LobsterDataReader::OrderBookSnapshot LobsterDataReader::makeSnapshot(std::span<const uint32_t> row) {
+    const size_t numLevels = row.size() / FIELDS_PER_LEVEL;
+    size_t numAskLevels = numLevels, numBidLevels = numLevels;
+    while (numAskLevels > 0 && !row[FIELDS_PER_LEVEL * (numAskLevels - 1)] && !row[FIELDS_PER_LEVEL * (numAskLevels - 1) + 1])
+        --numAskLevels;
+    while (numBidLevels > 0 && !row[FIELDS_PER_LEVEL * (numBidLevels - 1) + 2] && !row[FIELDS_PER_LEVEL * (numBidLevels - 1) + 3])
+        --numBidLevels;
+    OrderBookSnapshot snapshot;
+    for (size_t i = 0; i < numAskLevels; ++i) {
+        snapshot.askPrice.push_back(row[FIELDS_PER_LEVEL * i]);
+        snapshot.askSize.push_back(row[FIELDS_PER_LEVEL * i + 1]);
+    }
+    for (size_t i = 0; i < numBidLevels; ++i) {
+        snapshot.bidPrice.push_back(row[FIELDS_PER_LEVEL * i + 2]);
+        snapshot.bidSize.push_back(row[FIELDS_PER_LEVEL * i + 3]);
+    }
+    return snapshot;
+}
+
+LobsterDataReader::Cursor LobsterDataReader::makeCursor(const Utils::IO::MappedFile& file) {
+    const char* data = reinterpret_cast<const char*>(file.getData());
+    Cursor cursor{data, data + file.getSize(), 1, &file.getFilePath()};
+    skipBlankLines(cursor);
+    return cursor;
+}
+
+const char* LobsterDataReader::getLineEnd(const Cursor& cursor) {
+    const void* lineEnd = std::memchr(cursor.position, '\n', static_cast<size_t>(cursor.end - cursor.position));
+    return lineEnd ? static_cast<const char*>(lineEnd) : cursor.end;
+}
+
+void LobsterDataReader::nextLine(Cursor& cursor, const char* lineEnd) {
+    cursor.position = lineEnd < cursor.end ? lineEnd + 1 : cursor.end;
+    ++cursor.lineNumber;
+    skipBlankLines(cursor);
+}
+
+void LobsterDataReader::skipBlankLines(Cursor& cursor) {
+    const char* p = cursor.position;
+    while (p < cursor.end) {
+        if (*p == '\n') {
+            cursor.position = ++p;
+            ++cursor.lineNumber;
+        } else if (*p == ' ' || *p == '\t' || *p == '\r') {
+            ++p;
+        } else {
+            return;
+        }
+    }
+    cursor.position = cursor.end;
+}
+
+void LobsterDataReader::skipHeader(Cursor& cursor) {
+    // LOBSTER files have none, those of LobsterDataParser name the columns
+    const char* lineEnd = getLineEnd(cursor);
+    if (std::any_of(cursor.position, lineEnd, [](const char c) { return std::isalpha(static_cast<unsigned char>(c)); }))
+        nextLine(cursor, lineEnd);
+}
+
+size_t LobsterDataReader::countFields(const Cursor& cursor) {
+    if (cursor.position == cursor.end)
+        return 0;
+    return static_cast<size_t>(std::count(cursor.position, getLineEnd(cursor), ',')) + 1;
+}
+
+void LobsterDataReader::throwMalformed(const Cursor& cursor, const std::string& reason) {
+    throw Utils::Error::LibException("[LobsterDataReader] Malformed line " + std::to_string(cursor.lineNumber) + " of " + *cursor.filePath + ": " + reason + ".");
+}
+
+int64_t LobsterDataReader::parseInteger(Cursor& cursor, const char* lineEnd, const bool isRequired) {
+    const char* p = cursor.position;
+    while (p < lineEnd && (*p == ' ' || *p == '\t'))
+        ++p;
+    const bool isNegative = p < lineEnd && *p == '-';
+    if (isNegative)
+        ++p;
+    uint64_t value = 0; // 19 digits do not overflow it
+    const char* digits = p;
+    while (p < lineEnd && static_cast<unsigned>(*p - '0') < 10) {
+        if (p - digits == MAX_INTEGER_DIGITS)
+            throwMalformed(cursor, "an integer of more than " + std::to_string(MAX_INTEGER_DIGITS) + " digits");
+        value = 10 * value + static_cast<uint64_t>(*p++ - '0');
+    }
+    if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+        throwMalformed(cursor, "an integer out of range");
+    if (isNegative && p == digits)
+        throwMalformed(cursor, "a sign with no digits");
+    if (isRequired && p == digits)
+        throwMalformed(cursor, cursor.position == lineEnd ? "a missing field" : "an empty field");
+    while (p < lineEnd && (*p == ' ' || *p == '\t' || *p == '\r'))
+        ++p;
+    if (p < lineEnd && *p++ != ',')
+        throwMalformed(cursor, std::string("unexpected '") + p[-1] + "'");
+    cursor.position = p;
+    return isNegative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+}
+
+uint64_t LobsterDataReader::parseTimestamp(Cursor& cursor, const char* lineEnd) {
+    const char* p = cursor.position;
+    while (p < lineEnd && (*p == ' ' || *p == '\t'))
+        ++p;
+    const char* point = std::find(p, std::find(p, lineEnd, ','), '.');
+    if (point == lineEnd || *point != '.')
+        return static_cast<uint64_t>(std::max<int64_t>(parseInteger(cursor, lineEnd, true), 0));
+    // seconds after midnight with up to nanosecond decimals
+    if (p == point && (point + 1 == lineEnd || static_cast<unsigned>(point[1] - '0') >= 10))
+        throwMalformed(cursor, "a timestamp that is not a number");
+    uint64_t seconds = 0;
+    for (; p < point; ++p) {
+        if (static_cast<unsigned>(*p - '0') >= 10)
+            throwMalformed(cursor, "a timestamp that is not a number");
+        seconds = 10 * seconds + static_cast<uint64_t>(*p - '0');
+    }
+    uint64_t nanoseconds = 0;
+    int numDigits = 0;
+    for (p = point + 1; p < lineEnd && static_cast<unsigned>(*p - '0') < 10; ++p)
+        if (numDigits < 9) {
+            nanoseconds = 10 * nanoseconds + static_cast<uint64_t>(*p - '0');
+            ++numDigits;
+        }
+    for (; numDigits < 9; ++numDigits)
+        nanoseconds *= 10;
+    cursor.position = p;
+    parseInteger(cursor, lineEnd); // the rest of the field must be empty
+    return seconds * 1000000000 + nanoseconds;
+}
+
+uint32_t LobsterDataReader::parsePrice(Cursor& cursor, const char* lineEnd, const bool isRequired) {
+    const int64_t price = parseInteger(cursor, lineEnd, isRequired);
+    return price < 0 || price > std::numeric_limits<uint32_t>::max() ? 0 : static_cast<uint32_t>(price);
+}
+
+void LobsterDataReader::parseMessage(OrderBookMessage& message) {
+    Cursor& cursor = myMessageCursor;
+    const char* lineEnd = getLineEnd(cursor);
+    message.timestamp = parseTimestamp(cursor, lineEnd);
+    // every field of a message is required, a short row must not read as zeros
+    const int64_t messageType = parseInteger(cursor, lineEnd, true);
+    if (messageType < static_cast<int64_t>(LobsterDataParser::MessageType::ORDER_ADD) || messageType > static_cast<int64_t>(LobsterDataParser::MessageType::TRADING_HALT))
+        throwMalformed(cursor, "message type " + std::to_string(messageType));
+    message.messageType = static_cast<LobsterDataParser::MessageType>(messageType);
+    message.orderId = static_cast<uint64_t>(std::max<int64_t>(parseInteger(cursor, lineEnd, true), 0));
+    message.quantity = static_cast<uint32_t>(std::max<int64_t>(parseInteger(cursor, lineEnd, true), 0));
+    message.price = parsePrice(cursor, lineEnd, true);
+    message.isBuy = parseInteger(cursor, lineEnd, true) > 0;
+    message.isOrderDeleteAndAdd = false;
+    if (cursor.position != lineEnd)
+        throwMalformed(cursor, "more than 6 fields");
+    nextLine(cursor, lineEnd);
+}
+
+void LobsterDataReader::parseSnapshot(uint32_t* row) {
+    Cursor& cursor = myOrderBookCursor;
+    if (cursor.position == cursor.end)
+        throwMalformed(cursor, "the order book file ends before the message file " + getMessageFilePath());
+    const char* lineEnd = getLineEnd(cursor);
+    if (row) {
+        // a trailing run of empty fields, or a row of fewer levels, reads as empty levels
+        const size_t snapshotSize = getSnapshotSize();
+        for (size_t i = 0; i < snapshotSize; ++i) {
+            if (cursor.position == lineEnd)
+                row[i] = 0;
+            else if (i % 2 == 0)
+                row[i] = parsePrice(cursor, lineEnd);
+            else
+                row[i] = static_cast<uint32_t>(std::max<int64_t>(parseInteger(cursor, lineEnd), 0));
+        }
+    }
+    nextLine(cursor, lineEnd);
+}
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef LOBSTER_DATA_READER_HPP
+#define LOBSTER_DATA_READER_HPP
+#include "Utils/Utils.hpp"
+#include "Parser/LobsterDataParser.hpp"
+
+namespace Parser {
+/* Reads LOBSTER data back - a message file and, optionally, the order book file paired with it row by row - straight from the mapped
+   bytes, in chunks of records into buffers of the caller, so that a day of tens of millions of rows is read without allocating. Lines
+   are split with memchr, which the C library vectorizes, and the fields are parsed by hand with no locale and no copy. Either flavour
+   is read: that of LobsterDataParser (a header line, integer timestamps, the fields optionally space-aligned, empty fields for missing
+   levels) and that of LOBSTER itself (no header, timestamps in seconds after midnight with decimals, read in nanoseconds, and the
+   dummy prices +/-9999999999 for missing levels, read as 0). A snapshot row is kept flat in the column order of the file - ask price,
+   ask size, bid price, bid size for each level - and makeSnapshot turns it into an OrderBookSnapshot. */
+class LobsterDataReader {
+public:
+    using OrderBookMessage = LobsterDataParser::OrderBookMessage;
+    using OrderBookSnapshot = LobsterDataParser::OrderBookSnapshot;
+    static constexpr size_t FIELDS_PER_LEVEL = 4;
+    static constexpr long MAX_INTEGER_DIGITS = 19; // those of the largest int64
+
+    LobsterDataReader() = delete;
+    // numLevels 0 takes all the levels of the order book file, fewer are read as the top ones and more are padded with empty levels
+    LobsterDataReader(const std::string& messageFilePath, const std::string& orderBookFilePath = "", const size_t numLevels = 0);
+    LobsterDataReader(const LobsterDataReader&) = delete;
+    virtual ~LobsterDataReader() = default;
+
+    const std::string& getMessageFilePath() const { return myMessageFile->getFilePath(); }
+    bool hasOrderBook() const { return myOrderBookFile != nullptr; }
+    size_t getNumLevels() const { return myNumLevels; }
+    size_t getSnapshotSize() const { return FIELDS_PER_LEVEL * myNumLevels; } // the fields of a snapshot row
+    uint64_t getNumRecords() const { return myNumRecords; } // read so far
+    bool isExhausted() const { return myMessageCursor.position == myMessageCursor.end; }
+
+    /* Reads the next records into the messages, and their snapshot rows one after the other into the snapshots, and returns the
+       number read - as many as both buffers hold, 0 once the files are exhausted. With no snapshots buffer the order book rows are
+       skipped. Throws on a malformed field, a snapshots buffer too small for one row, or an order book file shorter than the message file. */
+    size_t read(std::span<OrderBookMessage> messages, std::span<uint32_t> snapshots = {});
+    void rewind(); // back to the first record
+    static OrderBookSnapshot makeSnapshot(std::span<const uint32_t> row); // the empty levels at the back of each side left out
+
+private:
+    struct Cursor {
+        const char* position = nullptr;
+        const char* end = nullptr;
+        uint64_t lineNumber = 0;
+        const std::string* filePath = nullptr;
+    };
+
+    static Cursor makeCursor(const Utils::IO::MappedFile& file);
+    static const char* getLineEnd(const Cursor& cursor);
+    static void nextLine(Cursor& cursor, const char* lineEnd); // moves past the line and any blank lines after
+    static void skipBlankLines(Cursor& cursor);
+    static void skipHeader(Cursor& cursor);
+    static size_t countFields(const Cursor& cursor);
+    [[noreturn]] static void throwMalformed(const Cursor& cursor, const std::string& reason);
+    // parses a field up to the comma or the line end, and moves past the comma; an empty field is 0 unless it is required
+    static int64_t parseInteger(Cursor& cursor, const char* lineEnd, const bool isRequired = false);
+    static uint64_t parseTimestamp(Cursor& cursor, const char* lineEnd); // always required
+    static uint32_t parsePrice(Cursor& cursor, const char* lineEnd, const bool isRequired = false); // 0 for the dummy prices of the missing levels
+    void parseMessage(OrderBookMessage& message);
+    void parseSnapshot(uint32_t* row); // skips the row if null
+
+    std::unique_ptr<const Utils::IO::MappedFile> myMessageFile;
+    std::unique_ptr<const Utils::IO::MappedFile> myOrderBookFile;
+    size_t myNumLevels = 0;
+    size_t myNumFileLevels = 0;
+    Cursor myMessageCursor;
+    Cursor myOrderBookCursor;
+    uint64_t myNumRecords = 0;
+};
+}
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef LOBSTER_DATA_WRITER_CPP
+#define LOBSTER_DATA_WRITER_CPP
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Utils/Utils.hpp"
+#include "Parser/LobsterDataParser.hpp"
+#include "Parser/LobsterDataWriter.hpp"
+
+namespace Parser {
+LobsterDataWriter::LobsterDataWriter(const LobsterDataWriterConfig& config) :
+    myConfig(config) {
+    if (myConfig.messageFilePath.empty())
+        Utils::Error::LIB_THROW("[LobsterDataWriter] Message file path is empty.");
+    if (hasOrderBook() && myConfig.numLevels == 0)
+        Utils::Error::LIB_THROW("[LobsterDataWriter] Number of order book levels is zero.");
+    openFile(myMessageFile, myConfig.messageFilePath);
+    if (myConfig.isWriteHeader)
+        myMessageFile.buffer << OrderBookMessage::getHeaderCsv(myConfig.aligned) << "\n";
+    if (hasOrderBook()) {
+        try {
+            openFile(myOrderBookFile, myConfig.orderBookFilePath);
+        } catch (...) {
+            ::close(myMessageFile.fd);
+            throw;
+        }
+        if (myConfig.isWriteHeader)
+            myOrderBookFile.buffer << OrderBookSnapshot::getHeaderCsv(myConfig.numLevels, myConfig.aligned) << "\n";
+    }
+}
+
+LobsterDataWriter::~LobsterDataWriter() {
+    try {
+        close();
+    } catch (const std::exception&) {
+    }
+}
+
+void LobsterDataWriter::write(const OrderBookMessage& message, const OrderBookSnapshot* snapshot) {
+    if (!isOpen())
+        Utils::Error::LIB_THROW("[LobsterDataWriter::write] Writer is closed.");
+    message.appendAsCsv(myMessageFile.buffer, myConfig.aligned);
+    myMessageFile.buffer << "\n";
+    ++myNumRecords;
+    if (hasOrderBook()) {
+        if (!snapshot) {
+            ++myNumPendingRows;
+        } else {
+            for (; myNumPendingRows > 0; --myNumPendingRows)
+                writeSnapshotRow(*snapshot);
+            writeSnapshotRow(*snapshot);
+        }
+    }
+    if (myMessageFile.buffer.size() >= myConfig.bufferSize)
+        writeBuffer(myMessageFile);
+    if (myOrderBookFile.buffer.size() >= myConfig.bufferSize)
+        writeBuffer(myOrderBookFile);
+}
+
+void LobsterDataWriter::flush() {
+    if (!isOpen())
+        return;
+    writeBuffer(myMessageFile);
+    if (hasOrderBook())
+        writeBuffer(myOrderBookFile);
+}
+
+void LobsterDataWriter::close() {
+    if (!isOpen())
+        return;
+    for (; myNumPendingRows > 0; --myNumPendingRows)
+        writeSnapshotRow(OrderBookSnapshot());
+    std::exception_ptr error;
+    try {
+        flush();
+    } catch (...) {
+        error = std::current_exception(); // the files are closed all the same
+    }
+    for (File* file : {&myMessageFile, &myOrderBookFile}) {
+        if (file->fd >= 0)
+            ::close(file->fd);
+        file->fd = -1;
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void LobsterDataWriter::openFile(File& file, const std::string& filePath) {
+    file.filePath = filePath;
+    file.fd = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (file.fd < 0)
+        Utils::Error::LIB_THROW("[LobsterDataWriter] Cannot open file " + filePath + ": " + std::strerror(errno));
+    file.buffer.reserve(myConfig.bufferSize + (1 << 12));
+}
+
+void LobsterDataWriter::writeBuffer(File& file) {
+    Utils::IO::writeAll(file.fd, file.buffer.data(), file.buffer.size(), file.filePath);
+    if (!file.buffer.empty())
+        ++myNumBuffersWritten;
+    file.numBytesWritten += file.buffer.size();
+    file.buffer.clear();
+}
+
+void LobsterDataWriter::writeSnapshotRow(const OrderBookSnapshot& snapshot) {
+    snapshot.appendAsCsv(myOrderBookFile.buffer, myConfig.numLevels, myConfig.aligned);
+    myOrderBookFile.buffer << "\n";
+}
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef LOBSTER_DATA_WRITER_HPP
+#define LOBSTER_DATA_WRITER_HPP
+#include "Utils/Utils.hpp"
+#include "Parser/LobsterDataParser.hpp"
+
+namespace Parser {
+struct LobsterDataWriterConfig {
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    std::string messageFilePath;
+    std::string orderBookFilePath; // empty writes the messages only
+    size_t numLevels = 10;
+    bool aligned = false;
+    bool isWriteHeader = true;
+    size_t bufferSize = DEFAULT_BUFFER_SIZE; // each of the two, written out to its file once filled past it
+};
+
+/* Appends LOBSTER message and order book rows to their files as they are produced, in the CSV format of
+   LobsterDataParser::getOrderBookMessagesAndSnapshotsAsCsv, holding no more than a buffer of each in memory however long the day.
+   A message with no snapshot of its own - the delete half of a modify split into a delete and an add - takes the snapshot of the
+   message after it, so that the two files stay aligned row by row as LobsterDataReader reads them. */
+class LobsterDataWriter {
+public:
+    using OrderBookMessage = LobsterDataParser::OrderBookMessage;
+    using OrderBookSnapshot = LobsterDataParser::OrderBookSnapshot;
+
+    LobsterDataWriter() = delete;
+    LobsterDataWriter(const LobsterDataWriterConfig& config);
+    LobsterDataWriter(const LobsterDataWriter&) = delete;
+    virtual ~LobsterDataWriter();
+
+    const LobsterDataWriterConfig& getConfig() const { return myConfig; }
+    bool isOpen() const { return myMessageFile.fd >= 0; }
+    bool hasOrderBook() const { return !myConfig.orderBookFilePath.empty(); }
+    uint64_t getNumRecords() const { return myNumRecords; }
+    uint64_t getNumBytesWritten() const { return myMessageFile.numBytesWritten + myOrderBookFile.numBytesWritten; } // to both files
+    uint64_t getNumBuffersWritten() const { return myNumBuffersWritten; }
+
+    void write(const OrderBookMessage& message, const OrderBookSnapshot* snapshot);
+    void write(const std::shared_ptr<const OrderBookMessage>& message, const std::shared_ptr<const OrderBookSnapshot>& snapshot) {
+        if (message)
+            write(*message, snapshot.get());
+    }
+    void flush(); // writes out both buffers
+    void close(); // flushes, with an empty snapshot row for a message left waiting
+
+private:
+    struct File {
+        std::string filePath;
+        int fd = -1;
+        Utils::Format::FormatBuffer buffer;
+        uint64_t numBytesWritten = 0;
+    };
+
+    void openFile(File& file, const std::string& filePath);
+    void writeBuffer(File& file);
+    void writeSnapshotRow(const OrderBookSnapshot& snapshot);
+
+    const LobsterDataWriterConfig myConfig;
+    File myMessageFile;
+    File myOrderBookFile;
+    size_t myNumPendingRows = 0; // messages waiting for the snapshot of the next one
+    uint64_t myNumRecords = 0;
+    uint64_t myNumBuffersWritten = 0;
+};
+}
+
+#endif
@@ -46,6 +46,8 @@ void ExchangeSimulatorBase::init() {
     myMatchingEngineMonitor->setOrderBookNumLevels(getConfig().monitoredLevels);
     myMatchingEngineMonitor->setMinimumPriceTick(getConfig().grid.minPriceTick);
     myOrderEventManager->setMinimumPriceTick(getConfig().grid.minPriceTick);
+    myMatchingEngine->setMinimumPriceTick(getConfig().grid.minPriceTick);
+    applyEngineThreadConfig();
     Utils::Statistics::RNG::setDeterministicSeed(getRandomSeed());
     setState(ExchangeSimulatorState::READY);
     if (isDebugMode())
@@ -73,12 +75,15 @@ void ExchangeSimulatorBase::setConfig(const ExchangeSimulatorConfig& config) {
     myMatchingEngineMonitor->setOrderBookNumLevels(getConfig().monitoredLevels);
     myMatchingEngineMonitor->setMinimumPriceTick(getConfig().grid.minPriceTick);
     myOrderEventManager->setMinimumPriceTick(getConfig().grid.minPriceTick);
+    myMatchingEngine->setMinimumPriceTick(getConfig().grid.minPriceTick);
+    applyEngineThreadConfig();
 }
 
 void ExchangeSimulatorBase::setMinPriceTick(const double minPriceTick) {
     IExchangeSimulator::setMinPriceTick(minPriceTick);
     myMatchingEngineMonitor->setMinimumPriceTick(minPriceTick);
     myOrderEventManager->setMinimumPriceTick(minPriceTick);
+    myMatchingEngine->setMinimumPriceTick(minPriceTick);
 }
 
 void ExchangeSimulatorBase::setMonitoredOrderBookNumLevels(const size_t numLevels) {
@@ -138,6 +143,9 @@ void ExchangeSimulatorBase::simulate() {
         *getLogger() << Utils::Logger::LogLevel::DEBUG << "[ExchangeSimulatorBase] Order book snapshot at initialization:\n" << *myMatchingEngine;
     if (config.resetMatchingEngineMonitorPreSimulation)
         myMatchingEngineMonitor->reset(true /* keepLastSnapshot */);
+    const Utils::Concurrency::ScopedThreadPin simulationThreadPin(config.simulationThread); // the caller's thread gets its affinity back on return
+    if (config.simulationThread.cpu >= 0 && !simulationThreadPin.pinned())
+        *getLogger() << Utils::Logger::LogLevel::WARNING << "[ExchangeSimulatorBase] Could not pin the simulation thread to cpu " << config.simulationThread.cpu << ".";
     setState(ExchangeSimulatorState::RUNNING);
     while (true) {
         if (checkStopCondition())
@@ -149,6 +157,19 @@ void ExchangeSimulatorBase::simulate() {
     setState(ExchangeSimulatorState::FINISHED);
 }
 
+void ExchangeSimulatorBase::applyEngineThreadConfig() {
+    // the consumer threads take the config on their next start
+    const auto& config = getConfig().engineConsumerThread;
+    if (const auto spscEngine = std::dynamic_pointer_cast<Exchange::MatchingEngineFIFOSpsc>(myMatchingEngine)) {
+        if (!spscEngine->isConsumerThreadRunning() && spscEngine->getConsumerThreadConfig() != config)
+            spscEngine->setConsumerThreadConfig(config);
+    } else if (const auto disruptorEngine = std::dynamic_pointer_cast<Exchange::MatchingEngineFIFODisruptor>(myMatchingEngine)) {
+        if (!disruptorEngine->isConsumerThreadsRunning())
+            for (size_t id = 0; id < disruptorEngine->getOutputRing().num_consumers(); ++id)
+                disruptorEngine->setConsumerThreadConfig(id, config);
+    }
+}
+
 void ExchangeSimulatorBase::buildSide(const Market::Side side, const VolumeProfile& profile) {
     const double sign = side == Market::Side::BUY ? -1.0 : 1.0;
     for (size_t i = 0; i < getNumGrids(); ++i) {
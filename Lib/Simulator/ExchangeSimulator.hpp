@@ -103,6 +103,7 @@ public:
 private:
     virtual void buildSide(const Market::Side side, const VolumeProfile& profile);
     virtual std::shared_ptr<IEventScheduler> makeEventScheduler() const { return nullptr; }
+    void applyEngineThreadConfig();
     OrderEventLog myOrderEventLog;
     std::shared_ptr<Exchange::IMatchingEngine> myMatchingEngine;
     std::shared_ptr<Market::OrderEventManagerBase> myOrderEventManager;
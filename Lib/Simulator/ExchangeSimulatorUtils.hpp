@@ -27,6 +27,8 @@ struct ExchangeSimulatorConfig {
     size_t monitoredLevels = 100; // passes down to matching engine monitor
     uint randomSeed = 42;
     OrderBookGridDefinition grid;
+    Utils::Concurrency::ThreadConfig simulationThread; // pins the thread calling simulate for the duration of the run
+    Utils::Concurrency::ThreadConfig engineConsumerThread; // passes down to the consumer threads of an SPSC or disruptor matching engine
 };
 
 struct ExchangeSimulatorStopCondition {
@@ -38,21 +38,23 @@ std::shared_ptr<OrderEventBase> ZeroIntelligenceSimulator::generateNextOrderEven
     const std::vector<double> orderEventRates = { marketOrderRate, limitOrderRate, cancelRate };
     // next tick must have one of the events happening, hence conditional sampling
     const size_t eventIndex = Utils::Statistics::drawIndexWithRelativeProbabilities(orderEventRates, true);
+    // the events are drawn from the pool of the order event manager, and recycled once the manager and the engine log let go of them
+    const auto& eventPool = getOrderEventManager() ? getOrderEventManager()->getEventPool() : nullptr;
     std::shared_ptr<OrderEventBase> event;
     if (eventIndex == 0) { // market order submit event
         const Market::Side side = myZIConfig.marketSideSampler->sample();
         const uint32_t size = myZIConfig.marketSizeSampler->sample(side);
-        event = std::make_shared<MarketOrderSubmitEvent>(getCurrentTimestamp() /* eventId */, getCurrentTimestamp(), side, size);
+        event = Utils::Memory::makePooledShared<MarketOrderSubmitEvent>(eventPool, getCurrentTimestamp() /* eventId */, getCurrentTimestamp(), side, size);
     } else if (eventIndex == 1) { // limit order submit event
         const Market::Side side = myZIConfig.limitSideSampler->sample();
         const uint32_t size = myZIConfig.limitSizeSampler->sample(side);
         const double price = myZIConfig.limitPriceSampler->sample(side);
-        event = std::make_shared<LimitOrderSubmitEvent>(getCurrentTimestamp() /* eventId */, getCurrentTimestamp(), side, size, price);
+        event = Utils::Memory::makePooledShared<LimitOrderSubmitEvent>(eventPool, getCurrentTimestamp() /* eventId */, getCurrentTimestamp(), side, size, price);
     } else if (eventIndex == 2) { // limit order cancel event
         const Market::Side side = myZIConfig.cancelSideSampler->sample();
         const std::optional<OrderCancelSpec> cancelSpec = myZIConfig.cancelSampler->sample(side);
         if (cancelSpec)
-            event = std::make_shared<OrderCancelEvent>(getCurrentTimestamp() /* eventId */, getCurrentTimestamp(), side, cancelSpec->quantity, cancelSpec->price);
+            event = Utils::Memory::makePooledShared<OrderCancelEvent>(eventPool, getCurrentTimestamp() /* eventId */, getCurrentTimestamp(), side, cancelSpec->quantity, cancelSpec->price);
     }
     if (isDebugMode() && event)
         *getLogger() << Utils::Logger::LogLevel::DEBUG << "[ZeroIntelligenceSimulator] Generated order event: " << *event;
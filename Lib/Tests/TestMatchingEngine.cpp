@@ -333,6 +333,66 @@ void testMatchingEngineRandomOrdersStressTest() {
     std::cout << *e << std::endl;
 }
 
+void testMatchingEngineTopOfBookSnapshotStressTest() {
+    // the random orders stress test with reader threads hammering the seqlock-protected top of book all along
+    const int numOrders = 10'000'000; // 10 million orders
+    const int numReaders = 4;
+    const std::vector<double> p{0, 1, 3, 5, 7, 9, 6, 3, 2, 1, 1, 1, 1}; // relative probabilities for order book levels
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.reserve(numOrders);
+    e->setTopOfBookSnapshotLevels(Exchange::TopOfBookSnapshot::MAX_LEVELS);
+    std::atomic<bool> done{false};
+    std::vector<uint64_t> numReads(numReaders, 0), numViolations(numReaders, 0);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < numReaders; ++r) {
+        readers.emplace_back([&, r]() {
+            const auto snapshotLock = e->getTopOfBookSnapshotLock();
+            uint64_t lastSequence = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                const auto s = snapshotLock->load();
+                bool valid = s.sequence >= lastSequence && (!s.numBidLevels || !s.numAskLevels || s.getBestBidPrice() < s.getBestAskPrice());
+                for (uint32_t i = 1; i < s.numBidLevels; ++i)
+                    valid = valid && s.bidLevels[i].price < s.bidLevels[i - 1].price;
+                for (uint32_t i = 1; i < s.numAskLevels; ++i)
+                    valid = valid && s.askLevels[i].price > s.askLevels[i - 1].price;
+                numViolations[r] += !valid;
+                lastSequence = s.sequence;
+                ++numReads[r];
+            }
+        });
+    }
+    const auto timeOrderSubmit = Utils::Counter::timeOperation<std::chrono::nanoseconds>([&em, &p]() {
+        for (int i = 0; i < numOrders; ++i) {
+            const double u0 = Utils::Statistics::getRandomUniform01(true);
+            const double u1 = Utils::Statistics::getRandomUniform01(true);
+            const int qty0 = Utils::Statistics::getRandomUniformInt(1, 3, true);
+            const int qty1 = Utils::Statistics::getRandomUniformInt(1, 5, true);
+            const size_t j = Utils::Statistics::drawIndexWithRelativeProbabilities(p, true);
+            if (u0 < 0.7) {
+                if (u1 < 0.5)
+                    em.submitLimitOrderEvent(Market::Side::BUY, qty0, 100.0 - j);
+                else
+                    em.submitLimitOrderEvent(Market::Side::SELL, qty0, 100.0 + j);
+            } else {
+                if (u1 < 0.5)
+                    em.submitMarketOrderEvent(Market::Side::BUY, qty1);
+                else
+                    em.submitMarketOrderEvent(Market::Side::SELL, qty1);
+            }
+        }
+    });
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers)
+        reader.join();
+    std::cout << "Time taken for bulk order submission: " << timeOrderSubmit / 1e9 << " secs / " << numOrders << " orders" << std::endl;
+    std::cout << "Snapshots published: " << e->getTopOfBookSnapshotLock()->version()
+        << ", reader retries: " << e->getTopOfBookSnapshotLock()->num_retries() << std::endl;
+    for (int r = 0; r < numReaders; ++r)
+        std::cout << "Reader " << r << ": " << numReads[r] << " reads, " << numViolations[r] << " violations" << std::endl;
+    std::cout << "Final snapshot: " << e->getTopOfBookSnapshot() << std::endl;
+}
+
 void testMatchingEngineSpeedProfiling() {
     // detailed speed profiling of matching engine operations - set numerous timers inside MatchingEngine::process(event)
     const int numOrders = 250;
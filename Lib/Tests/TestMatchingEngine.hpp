@@ -11,6 +11,7 @@ void testMatchingEngineOrderCancelModify();
 void testMatchingEngineOrderCancelReplace();
 void testMatchingEngineRandomOrdersSpeedTest();
 void testMatchingEngineRandomOrdersStressTest();
+void testMatchingEngineTopOfBookSnapshotStressTest();
 void testMatchingEngineSpeedProfiling();
 void testMatchingEngineConstructFromEventsStream();
 void testMatchingEngineGetAsJson();
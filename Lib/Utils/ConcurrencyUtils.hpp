@@ -1,37 +1,650 @@
 #ifndef CONCURRENCY_UTILS_HPP
 #define CONCURRENCY_UTILS_HPP
+#include <array>
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <vector>
+#include <string>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <filesystem>
+#include <exception>
+#include "Utils/ErrorUtils.hpp"
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace Utils {
 namespace Concurrency {
+enum class OverflowPolicy { BLOCK, DROP_OLDEST, SPILL };
+// what a worker thread does when it finds nothing to do: BUSY_SPIN keeps the core hot (isolated cores only), YIELD gives it up to
+// the scheduler, FUTEX spins for a while then sleeps in the kernel until the producer signals (std::atomic::wait, a futex on Linux)
+enum class WaitStrategy { BUSY_SPIN, YIELD, FUTEX };
+
+/* Where a worker thread runs and how it idles. A negative cpu leaves the thread to the scheduler. With numa_local the buffers the
+   thread mostly touches are allocated from a thread pinned to the same cpu, so that the first touch places their pages on its NUMA
+   node. Pinning is only supported on Linux and is a no-op elsewhere. */
+struct ThreadConfig {
+    int cpu = -1;
+    WaitStrategy wait_strategy = WaitStrategy::YIELD;
+    uint32_t spin_limit = 1 << 10; // empty polls before a FUTEX worker goes to sleep
+    bool numa_local = true;
+    bool operator==(const ThreadConfig&) const = default;
+};
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+inline size_t num_cpus() { return std::max(std::thread::hardware_concurrency(), 1u); }
+
+inline int current_cpu() {
+#if defined(__linux__)
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+// the NUMA node the kernel lists the cpu under, -1 if unknown
+inline int numa_node_of_cpu(const int cpu) {
+#if defined(__linux__)
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/cpu/cpu" + std::to_string(cpu), error)) {
+        const std::string name = entry.path().filename().string();
+        if (name.size() > 4 && name.compare(0, 4, "node") == 0 && std::all_of(name.begin() + 4, name.end(), [](const char c) { return c >= '0' && c <= '9'; }))
+            return std::stoi(name.substr(4));
+    }
+#else
+    (void)cpu;
+#endif
+    return -1;
+}
+
+// returns whether the calling thread is now bound to the cpu
+inline bool pin_current_thread(const int cpu) {
+#if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+        return false;
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+inline bool apply_thread_config(const ThreadConfig& config) { return config.cpu >= 0 && pin_current_thread(config.cpu); }
+
+// pins the calling thread for its scope and gives it back its previous affinity on exit, for threads the pinning code does not own
+class ScopedThreadPin {
+public:
+    explicit ScopedThreadPin(const ThreadConfig& config) {
+#if defined(__linux__)
+        if (config.cpu >= 0)
+            saved_ = pthread_getaffinity_np(pthread_self(), sizeof(saved_cpus_), &saved_cpus_) == 0;
+#endif
+        pinned_ = saved_ && apply_thread_config(config);
+    }
+    ScopedThreadPin(const ScopedThreadPin&) = delete;
+    ScopedThreadPin& operator=(const ScopedThreadPin&) = delete;
+    ~ScopedThreadPin() {
+#if defined(__linux__)
+        if (pinned_)
+            pthread_setaffinity_np(pthread_self(), sizeof(saved_cpus_), &saved_cpus_);
+#endif
+    }
+    bool pinned() const { return pinned_; }
+private:
+#if defined(__linux__)
+    cpu_set_t saved_cpus_;
+#endif
+    bool saved_ = false;
+    bool pinned_ = false;
+};
+
+// runs fn on a thread pinned to the cpu and waits for it, so that whatever memory fn first touches lands on the NUMA node of the cpu
+template<typename F>
+void run_on_cpu(const int cpu, F&& fn) {
+    if (cpu < 0) {
+        fn();
+        return;
+    }
+    std::exception_ptr error;
+    std::thread([&]() {
+        pin_current_thread(cpu);
+        try {
+            fn();
+        } catch (...) {
+            error = std::current_exception();
+        }
+    }).join();
+    if (error)
+        std::rethrow_exception(error);
+}
+
+/* The doorbell of FUTEX workers. A worker reads the epoch before it looks for work and sleeps on it if it found none, and producers
+   bump the epoch after they publish, so that a wake-up between the look and the sleep is never lost. Producers only make the wake
+   syscall while some worker sleeps. */
+class WakeSignal {
+public:
+    uint32_t epoch() const { return epoch_.load(std::memory_order_seq_cst); }
+    uint64_t num_sleeps() const { return num_sleeps_.load(std::memory_order_relaxed); }
+
+    void notify() {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        if (num_sleepers_.load(std::memory_order_seq_cst) > 0)
+            epoch_.notify_all();
+    }
+
+    void wait(const uint32_t epoch) {
+        num_sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        num_sleeps_.fetch_add(1, std::memory_order_relaxed);
+        epoch_.wait(epoch, std::memory_order_seq_cst);
+        num_sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+private:
+    alignas(64) std::atomic<uint32_t> epoch_{0};
+    std::atomic<uint32_t> num_sleepers_{0};
+    std::atomic<uint64_t> num_sleeps_{0};
+};
+
+// the idle loop of one worker thread under its wait strategy
+class IdleStrategy {
+public:
+    IdleStrategy(const ThreadConfig& config, WakeSignal* signal) : config_(config), signal_(signal) {}
+
+    void reset() { num_spins_ = 0; } // after some work was found
+
+    // epoch is what the signal read before the worker looked for work
+    void idle(const uint32_t epoch) {
+        switch (config_.wait_strategy) {
+        case WaitStrategy::BUSY_SPIN:
+            cpu_relax();
+            return;
+        case WaitStrategy::YIELD:
+            std::this_thread::yield();
+            return;
+        case WaitStrategy::FUTEX:
+            if (!signal_ || ++num_spins_ < config_.spin_limit) {
+                cpu_relax();
+                return;
+            }
+            num_spins_ = 0;
+            signal_->wait(epoch);
+            return;
+        }
+    }
+
+private:
+    const ThreadConfig config_;
+    WakeSignal* const signal_;
+    uint32_t num_spins_ = 0;
+};
+
+/* A bounded wrap-around SPSC ring sized at construction (rounded up to a power of two). What happens to a push on a full ring
+   is up to the overflow policy: BLOCK spins the producer until the consumer frees a slot, DROP_OLDEST discards the oldest unread
+   item and counts it, SPILL diverts the item into a mutex-guarded overflow arena that is drained after the ring so the order is
+   preserved. The consumer claims an index before reading its slot so that a producer dropping the oldest item never overwrites
+   a slot that is being read. */
+template<typename T>
+class SpscBoundedRingBuffer {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+
+    explicit SpscBoundedRingBuffer(size_t capacity = DEFAULT_CAPACITY, OverflowPolicy policy = OverflowPolicy::BLOCK) :
+        buffer_(roundUpToPowerOfTwo(capacity)), mask_(buffer_.size() - 1), policy_(policy) {}
+
+    size_t capacity() const { return buffer_.size(); }
+    OverflowPolicy policy() const { return policy_; }
+    size_t size() const { return write_.load(std::memory_order_acquire) - read_.load(std::memory_order_acquire) + spilled_size_.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+    bool full() const { return write_.load(std::memory_order_relaxed) - read_.load(std::memory_order_acquire) >= buffer_.size(); }
+    size_t high_water_mark() const { return high_water_mark_.load(std::memory_order_relaxed); }
+    uint64_t num_dropped() const { return num_dropped_.load(std::memory_order_acquire); }
+    uint64_t num_spilled() const { return num_spilled_.load(std::memory_order_relaxed); }
+    uint64_t num_blocked() const { return num_blocked_.load(std::memory_order_relaxed); }
+
+    void push(T&& item) {
+        if (spilled_size_.load(std::memory_order_acquire) > 0) {
+            spill(std::move(item)); // keeps the order until the consumer has caught up with the arena
+            return;
+        }
+        const size_t w = write_.load(std::memory_order_relaxed);
+        bool blocked = false;
+        while (true) {
+            const size_t r = read_.load(std::memory_order_seq_cst);
+            if (w - r < buffer_.size())
+                break;
+            if (policy_ == OverflowPolicy::SPILL) {
+                spill(std::move(item));
+                return;
+            }
+            if (policy_ == OverflowPolicy::DROP_OLDEST) {
+                size_t expected = r;
+                if (read_.compare_exchange_strong(expected, r + 1, std::memory_order_seq_cst)) {
+                    num_dropped_.fetch_add(1, std::memory_order_release);
+                    break;
+                }
+                continue;
+            }
+            blocked = true;
+            std::this_thread::yield();
+        }
+        if (blocked)
+            num_blocked_.fetch_add(1, std::memory_order_relaxed);
+        if (w >= buffer_.size())
+            while (busy_.load(std::memory_order_seq_cst) == w - buffer_.size()) // the consumer is still reading the slot
+                std::this_thread::yield();
+        buffer_[w & mask_] = std::move(item);
+        write_.store(w + 1, std::memory_order_release);
+        const size_t depth = w + 1 - read_.load(std::memory_order_relaxed);
+        if (depth > high_water_mark_.load(std::memory_order_relaxed))
+            high_water_mark_.store(depth, std::memory_order_relaxed);
+    }
+
+    bool try_pop(T& out) {
+        while (true) {
+            const size_t r = read_.load(std::memory_order_seq_cst);
+            if (r == write_.load(std::memory_order_acquire)) {
+                if (spilled_size_.load(std::memory_order_acquire) == 0)
+                    return false;
+                std::lock_guard<std::mutex> lock(spilled_mutex_);
+                // the ring is drained first as whatever got there was pushed before the spill started
+                if (read_.load(std::memory_order_seq_cst) != write_.load(std::memory_order_acquire))
+                    continue;
+                out = std::move(spilled_.front());
+                spilled_.pop_front();
+                spilled_size_.fetch_sub(1, std::memory_order_release);
+                return true;
+            }
+            busy_.store(r, std::memory_order_seq_cst);
+            size_t expected = r;
+            if (read_.compare_exchange_strong(expected, r + 1, std::memory_order_seq_cst)) {
+                out = std::move(buffer_[r & mask_]);
+                busy_.store(NOT_BUSY, std::memory_order_release);
+                return true;
+            }
+            busy_.store(NOT_BUSY, std::memory_order_release); // the producer dropped it in between
+        }
+    }
+
+private:
+    static constexpr size_t NOT_BUSY = static_cast<size_t>(-1);
+
+    static size_t roundUpToPowerOfTwo(size_t n) {
+        size_t p = 2;
+        while (p < n)
+            p <<= 1;
+        return p;
+    }
+
+    void spill(T&& item) {
+        std::lock_guard<std::mutex> lock(spilled_mutex_);
+        spilled_.push_back(std::move(item));
+        spilled_size_.fetch_add(1, std::memory_order_release);
+        num_spilled_.fetch_add(1, std::memory_order_relaxed);
+        const size_t depth = size();
+        if (depth > high_water_mark_.load(std::memory_order_relaxed))
+            high_water_mark_.store(depth, std::memory_order_relaxed);
+    }
+
+    std::vector<T> buffer_;
+    const size_t mask_;
+    const OverflowPolicy policy_;
+    alignas(64) std::atomic<size_t> write_{0};
+    alignas(64) std::atomic<size_t> read_{0}; // advanced by the consumer, or by the producer when dropping the oldest
+    alignas(64) std::atomic<size_t> busy_{NOT_BUSY}; // index being read by the consumer
+    std::atomic<size_t> high_water_mark_{0};
+    std::atomic<uint64_t> num_dropped_{0};
+    std::atomic<uint64_t> num_spilled_{0};
+    std::atomic<uint64_t> num_blocked_{0};
+    std::mutex spilled_mutex_;
+    std::deque<T> spilled_;
+    std::atomic<size_t> spilled_size_{0};
+};
+
+/* A disruptor-style single-producer multi-consumer ring. Every consumer runs its handler on its own thread against its own sequence
+   (the number of items it has handled) and reads the payload in place, so nothing is copied per consumer. A consumer may depend on
+   earlier consumers and then only sees an item once all of them are past it, e.g. a journal writer ahead of the acknowledgements.
+   The producer reuses a slot once the slowest consumer is past it, and resets the payloads of the slots every consumer is past as it
+   publishes, so that a ring of e.g. shared pointers does not keep up to a whole ring of items alive. Before start the handlers run inline on the producer thread in
+   the order of registration, which the dependencies (on earlier consumers only) make a valid order. Every consumer thread has its own
+   thread config - FUTEX consumers are woken by the producer and by the consumers they depend on. */
+template<typename T>
+class SpmcDisruptorRing {
+public:
+    using Handler = std::function<void(const T&)>;
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+
+    explicit SpmcDisruptorRing(size_t capacity = DEFAULT_CAPACITY) : buffer_(roundUpToPowerOfTwo(capacity)), mask_(buffer_.size() - 1) {}
+    SpmcDisruptorRing(const SpmcDisruptorRing&) = delete;
+    SpmcDisruptorRing& operator=(const SpmcDisruptorRing&) = delete;
+    ~SpmcDisruptorRing() { stop(); }
+
+    size_t capacity() const { return buffer_.size(); }
+    size_t num_consumers() const { return consumers_.size(); }
+    bool running() const { return running_; }
+    uint64_t published() const { return cursor_.load(std::memory_order_acquire); }
+    uint64_t consumed(size_t consumer) const { return consumers_.at(consumer)->sequence.load(std::memory_order_acquire); }
+    const ThreadConfig& thread_config(size_t consumer) const { return consumers_.at(consumer)->config; }
+    const WakeSignal& wake_signal() const { return wake_; }
+
+    void set_thread_config(size_t consumer, const ThreadConfig& config) {
+        if (running_)
+            Error::LIB_THROW("[SpmcDisruptorRing::set_thread_config] Cannot configure a consumer while running.");
+        consumers_.at(consumer)->config = config;
+    }
+
+    size_t add_consumer(Handler handler, const std::vector<size_t>& dependencies = {}) {
+        if (running_)
+            Error::LIB_THROW("[SpmcDisruptorRing::add_consumer] Cannot add a consumer while running.");
+        const size_t id = consumers_.size();
+        for (const size_t dependency : dependencies)
+            if (dependency >= id)
+                Error::LIB_THROW("[SpmcDisruptorRing::add_consumer] Consumer " + std::to_string(id) + " can only depend on earlier consumers.");
+        auto consumer = std::make_unique<Consumer>();
+        consumer->handler = std::move(handler);
+        consumer->dependencies = dependencies;
+        consumer->sequence.store(cursor_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        consumers_.push_back(std::move(consumer));
+        return id;
+    }
+
+    void start() {
+        if (running_)
+            return;
+        stop_requested_.store(false, std::memory_order_release);
+        running_ = true;
+        released_ = cursor_.load(std::memory_order_relaxed); // the inline items never took a slot
+        any_futex_ = std::any_of(consumers_.begin(), consumers_.end(), [](const auto& consumer) { return consumer->config.wait_strategy == WaitStrategy::FUTEX; });
+        for (size_t id = 0; id < consumers_.size(); ++id)
+            consumers_[id]->thread = std::thread(&SpmcDisruptorRing::run, this, id);
+    }
+
+    // consumers finish everything published so far before their threads are joined
+    void stop() {
+        if (!running_)
+            return;
+        stop_requested_.store(true, std::memory_order_release);
+        wake_.notify();
+        for (auto& consumer : consumers_)
+            consumer->thread.join();
+        running_ = false;
+        release_consumed(cursor_.load(std::memory_order_relaxed));
+    }
+
+    // blocks until every consumer has handled everything published so far
+    void flush() const {
+        const uint64_t cursor = cursor_.load(std::memory_order_relaxed);
+        for (const auto& consumer : consumers_)
+            while (consumer->sequence.load(std::memory_order_acquire) < cursor)
+                std::this_thread::yield();
+    }
+
+    void publish(T&& item) {
+        const uint64_t sequence = cursor_.load(std::memory_order_relaxed);
+        if (!running_) {
+            for (auto& consumer : consumers_) {
+                consumer->handler(item);
+                consumer->sequence.store(sequence + 1, std::memory_order_release);
+            }
+            cursor_.store(sequence + 1, std::memory_order_release);
+            return;
+        }
+        uint64_t minimum;
+        while (sequence - (minimum = minimumSequence()) >= buffer_.size()) // the slowest consumer still holds the slot
+            std::this_thread::yield();
+        release_consumed(minimum);
+        buffer_[sequence & mask_] = std::move(item);
+        cursor_.store(sequence + 1, std::memory_order_release);
+        if (any_futex_)
+            wake_.notify();
+    }
+
+private:
+    struct Consumer {
+        Handler handler;
+        std::vector<size_t> dependencies;
+        ThreadConfig config;
+        alignas(64) std::atomic<uint64_t> sequence{0};
+        std::thread thread;
+    };
+
+    static size_t roundUpToPowerOfTwo(size_t n) {
+        size_t p = 2;
+        while (p < n)
+            p <<= 1;
+        return p;
+    }
+
+    // resets the payloads of the slots every consumer is past, producer only
+    void release_consumed(const uint64_t minimum) {
+        for (; released_ < minimum; ++released_)
+            buffer_[released_ & mask_] = T{};
+    }
+
+    uint64_t minimumSequence() const {
+        uint64_t minimum = cursor_.load(std::memory_order_relaxed);
+        for (const auto& consumer : consumers_)
+            minimum = std::min(minimum, consumer->sequence.load(std::memory_order_acquire));
+        return minimum;
+    }
+
+    // the barrier of a consumer is the cursor and the sequences of the consumers it depends on
+    uint64_t available(const Consumer& consumer) const {
+        uint64_t barrier = cursor_.load(std::memory_order_acquire);
+        for (const size_t dependency : consumer.dependencies)
+            barrier = std::min(barrier, consumers_[dependency]->sequence.load(std::memory_order_acquire));
+        return barrier;
+    }
+
+    void run(const size_t id) {
+        Consumer& consumer = *consumers_[id];
+        apply_thread_config(consumer.config);
+        IdleStrategy idle_strategy(consumer.config, &wake_);
+        uint64_t next = consumer.sequence.load(std::memory_order_relaxed);
+        while (true) {
+            const uint32_t epoch = wake_.epoch(); // read ahead of the look for work
+            const bool stopping = stop_requested_.load(std::memory_order_acquire);
+            const uint64_t barrier = available(consumer);
+            if (next == barrier) {
+                if (stopping && barrier == cursor_.load(std::memory_order_acquire))
+                    return;
+                idle_strategy.idle(epoch);
+                continue;
+            }
+            idle_strategy.reset();
+            for (; next < barrier; ++next)
+                consumer.handler(buffer_[next & mask_]);
+            consumer.sequence.store(next, std::memory_order_release); // batches the sequence update over what was available
+            if (any_futex_)
+                wake_.notify(); // the consumers depending on this one may be asleep
+        }
+    }
+
+    std::vector<T> buffer_;
+    const size_t mask_;
+    std::vector<std::unique_ptr<Consumer>> consumers_;
+    alignas(64) std::atomic<uint64_t> cursor_{0}; // number of items published
+    std::atomic<bool> stop_requested_{false};
+    bool running_ = false; // producer only
+    bool any_futex_ = false; // set before the consumer threads start
+    uint64_t released_ = 0; // producer only, the slots below are reset
+    WakeSignal wake_;
+};
+
+/* A bounded MPSC queue after Vyukov: every cell carries a sequence that tells the producers whether it is free for the lap they are on
+   and the consumer whether it holds an item, so producers only contend on a single CAS of the enqueue index and never on each other's
+   cells. Cells are padded to a cache line. A full queue fails try_push, while push spins with a yield until the consumer frees a cell. */
 template<typename T>
-class SpscPreallocatedBuffer {
+class MpscBoundedQueue {
 public:
-    explicit SpscPreallocatedBuffer() = default;
-    explicit SpscPreallocatedBuffer(size_t capacity) : buffer_(capacity) {}
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
 
-    void reserve(size_t capacity) {
-        buffer_.reserve(capacity);
+    explicit MpscBoundedQueue(size_t capacity = DEFAULT_CAPACITY) :
+        capacity_(roundUpToPowerOfTwo(capacity)), mask_(capacity_ - 1), cells_(std::make_unique<Cell[]>(capacity_)) {
+        for (size_t i = 0; i < capacity_; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    MpscBoundedQueue(const MpscBoundedQueue&) = delete;
+    MpscBoundedQueue& operator=(const MpscBoundedQueue&) = delete;
+
+    size_t capacity() const { return capacity_; }
+    size_t size() const { return enqueue_.load(std::memory_order_acquire) - dequeue_.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+    uint64_t num_blocked() const { return num_blocked_.load(std::memory_order_relaxed); }
+
+    bool try_push(T&& item) {
+        size_t pos = enqueue_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells_[pos & mask_];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false; // full - the consumer has not freed the cell from the previous lap
+            } else {
+                pos = enqueue_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->item = std::move(item);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
     }
 
     void push(T&& item) {
-        size_t idx = write_.fetch_add(1, std::memory_order_relaxed);
-        buffer_[idx] = std::move(item);
+        if (try_push(std::move(item))) // the item is only moved from on success
+            return;
+        num_blocked_.fetch_add(1, std::memory_order_relaxed);
+        while (!try_push(std::move(item)))
+            std::this_thread::yield();
     }
 
+    // consumer only
     bool try_pop(T& out) {
-        if (read_ == write_.load(std::memory_order_acquire))
+        const size_t pos = dequeue_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[pos & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+            return false; // empty, or the producer that claimed the cell has not finished writing it
+        out = std::move(cell.item);
+        cell.sequence.store(pos + capacity_, std::memory_order_release);
+        dequeue_.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer only, appends up to maxItems in order and returns the number popped
+    size_t pop_batch(std::vector<T>& out, const size_t maxItems) {
+        size_t n = 0;
+        T item;
+        while (n < maxItems && try_pop(item)) {
+            out.push_back(std::move(item));
+            ++n;
+        }
+        return n;
+    }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence{0};
+        T item{};
+    };
+
+    static size_t roundUpToPowerOfTwo(size_t n) {
+        size_t p = 2;
+        while (p < n)
+            p <<= 1;
+        return p;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<size_t> enqueue_{0};
+    alignas(64) std::atomic<size_t> dequeue_{0};
+    std::atomic<uint64_t> num_blocked_{0};
+};
+
+/* A single-writer seqlock over a trivially copyable value: the writer bumps the sequence to odd, rewrites the value and bumps it to
+   even again, and a reader retries its copy until it sees the same even sequence on both ends. Readers never block the writer nor
+   each other, and many of them may poll at once. The value is kept as relaxed atomic words so that the torn copies a reader throws
+   away are not data races. */
+template<typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable value.");
+public:
+    SeqLock() : SeqLock(T{}) {}
+    explicit SeqLock(const T& value) { write_words(value); } // the initial value is not counted as a store
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    uint64_t version() const { return sequence_.load(std::memory_order_acquire) >> 1; } // number of stores so far
+    uint64_t num_retries() const { return num_retries_.load(std::memory_order_relaxed); }
+
+    // writer only
+    void store(const T& value) {
+        const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        write_words(value);
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    // a single attempt, fails if the writer was midway through a store
+    bool try_load(T& out) const {
+        const uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1)
+            return false;
+        uint64_t words[NUM_WORDS];
+        for (size_t i = 0; i < NUM_WORDS; ++i)
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != before)
             return false;
-        out = std::move(buffer_[read_++]);
+        std::memcpy(&out, words, sizeof(T));
         return true;
     }
 
+    T load() const {
+        T out;
+        while (!try_load(out)) {
+            num_retries_.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+        return out;
+    }
+
 private:
-    std::vector<T> buffer_;
-    std::atomic<size_t> write_{0};
-    size_t read_{0}; // consumer only
+    static constexpr size_t NUM_WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    void write_words(const T& value) {
+        uint64_t words[NUM_WORDS] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < NUM_WORDS; ++i)
+            words_[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    alignas(64) std::atomic<uint64_t> sequence_{0};
+    std::array<std::atomic<uint64_t>, NUM_WORDS> words_{};
+    mutable std::atomic<uint64_t> num_retries_{0};
 };
 
 template<typename T, size_t N>
@@ -0,0 +1,216 @@
+#ifndef FORMAT_UTILS_HPP
+#define FORMAT_UTILS_HPP
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "Utils/EnumStrings.hpp"
+
+namespace Utils {
+namespace Format {
+template<typename T>
+struct Aligned {
+    const T& value;
+    size_t width;
+    char fill;
+};
+
+struct Fixed {
+    double value;
+    int precision;
+};
+
+struct JsonEscaped {
+    std::string_view text;
+};
+
+// std::setw(width) << std::setfill(fill) << value, right-aligned
+template<typename T>
+Aligned<T> aligned(const T& value, const size_t width, const char fill = ' ') { return {value, width, fill}; }
+
+// std::fixed << std::setprecision(precision) << value
+inline Fixed fixed(const double value, const int precision) { return {value, precision}; }
+
+// the text with the quotes, the backslashes and the control chars escaped, to go between the quotes of a JSON string
+inline JsonEscaped jsonEscaped(const std::string_view text) { return {text}; }
+
+/* An append-only text buffer for the serializers on the hot paths - the ITCH text, the report JSON and the CSV records. Numbers are
+   written with std::to_chars, hence with no locale lookup and no virtual streambuf call, in the format a default std::ostream gives
+   them: integers in decimal, bools as 0/1, chars as themselves and floating points to 6 significant digits, unless a fixed precision
+   is asked for with fixed. Enums are written by their EnumStrings names. The storage is kept on clear(), so a buffer that is
+   reused stops allocating once it has grown to the largest record. */
+class FormatBuffer {
+public:
+    static constexpr int DEFAULT_PRECISION = 6; // that of std::ostream
+    static constexpr size_t MAX_NUMBER_SIZE = 64; // room for any integer, a double in fixed notation may need more
+
+    FormatBuffer() = default;
+    FormatBuffer(const size_t capacity) { reserve(capacity); }
+
+    size_t size() const { return mySize; }
+    size_t capacity() const { return myData.size(); }
+    bool empty() const { return mySize == 0; }
+    const char* data() const { return myData.data(); }
+    std::string_view view() const { return std::string_view(myData.data(), mySize); }
+    std::string str() const { return std::string(myData.data(), mySize); }
+
+    void clear() { mySize = 0; }
+    void reserve(const size_t capacity) {
+        if (capacity > myData.size())
+            myData.resize(capacity);
+    }
+
+    FormatBuffer& append(const char* text, const size_t length) {
+        std::memcpy(grow(length), text, length);
+        mySize += length;
+        return *this;
+    }
+
+    FormatBuffer& operator<<(const std::string_view text) { return append(text.data(), text.size()); }
+    FormatBuffer& operator<<(const char* text) { return append(text, std::strlen(text)); }
+    FormatBuffer& operator<<(const std::string& text) { return append(text.data(), text.size()); }
+    FormatBuffer& operator<<(const char c) {
+        *grow(1) = c;
+        ++mySize;
+        return *this;
+    }
+    FormatBuffer& operator<<(const bool value) { return *this << (value ? '1' : '0'); }
+
+    template<typename T>
+        requires std::is_integral_v<T>
+    FormatBuffer& operator<<(const T value) {
+        if constexpr (std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>)
+            return *this << static_cast<char>(value); // as std::ostream does
+        else
+            return appendChars(value);
+    }
+
+    template<typename T>
+        requires std::is_floating_point_v<T>
+    FormatBuffer& operator<<(const T value) { return appendChars(static_cast<double>(value), std::chars_format::general, DEFAULT_PRECISION); }
+
+    template<typename E>
+        requires std::is_enum_v<E>
+    FormatBuffer& operator<<(const E value) {
+        using U = std::underlying_type_t<E>;
+        constexpr auto& names = EnumStrings<E>::names;
+        const auto idx = static_cast<U>(value);
+        if (idx < 0 || static_cast<size_t>(idx) >= names.size())
+            return *this << "<INVALID_ENUM>";
+        return *this << names[idx];
+    }
+
+    FormatBuffer& operator<<(const Fixed fixed) { return appendChars(fixed.value, std::chars_format::fixed, fixed.precision); }
+
+    FormatBuffer& operator<<(const JsonEscaped escaped) {
+        static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+        for (const char c : escaped.text) {
+            switch (c) {
+                case '"':
+                    *this << "\\\"";
+                    break;
+                case '\\':
+                    *this << "\\\\";
+                    break;
+                case '\n':
+                    *this << "\\n";
+                    break;
+                case '\r':
+                    *this << "\\r";
+                    break;
+                case '\t':
+                    *this << "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                        *this << "\\u00" << HEX_DIGITS[c >> 4] << HEX_DIGITS[c & 0xf];
+                    else
+                        *this << c;
+            }
+        }
+        return *this;
+    }
+
+    template<typename T>
+    FormatBuffer& operator<<(const Aligned<T> aligned) {
+        const size_t start = mySize;
+        *this << aligned.value;
+        const size_t length = mySize - start;
+        if (length < aligned.width) {
+            const size_t padding = aligned.width - length;
+            grow(padding);
+            std::memmove(myData.data() + start + padding, myData.data() + start, length);
+            std::memset(myData.data() + start, aligned.fill, padding);
+            mySize += padding;
+        }
+        return *this;
+    }
+
+private:
+    char* grow(const size_t length) {
+        if (mySize + length > myData.size())
+            myData.resize(std::max(2 * myData.size(), mySize + length));
+        return myData.data() + mySize;
+    }
+
+    template<typename T, typename... Args>
+    FormatBuffer& appendChars(const T value, const Args... args) {
+        // only a large double in fixed notation overflows the first try
+        for (size_t room = MAX_NUMBER_SIZE; ; room *= 2) {
+            char* first = grow(room);
+            const auto result = std::to_chars(first, first + room, value, args...);
+            if (result.ec == std::errc()) {
+                mySize += static_cast<size_t>(result.ptr - first);
+                return *this;
+            }
+        }
+    }
+
+    std::string myData; // sized to the capacity, the text is the first mySize chars
+    size_t mySize = 0;
+};
+
+/* A FormatBuffer borrowed for the scope from a per-thread stack, so that a serializer formats into warm storage rather than a fresh
+   stream. Nested serializers, such as a report writing out the JSON of its order, each take the next buffer down the stack. */
+class ScopedFormatBuffer {
+public:
+    ScopedFormatBuffer() : myBuffer(acquire()) {}
+    ScopedFormatBuffer(const ScopedFormatBuffer&) = delete;
+    ScopedFormatBuffer& operator=(const ScopedFormatBuffer&) = delete;
+    ~ScopedFormatBuffer() { --getDepth(); }
+
+    FormatBuffer& operator*() { return myBuffer; }
+    FormatBuffer* operator->() { return &myBuffer; }
+    std::string str() const { return myBuffer.str(); }
+
+    template<typename T>
+    FormatBuffer& operator<<(const T& value) { return myBuffer << value; }
+
+private:
+    static size_t& getDepth() {
+        thread_local size_t depth = 0;
+        return depth;
+    }
+
+    static FormatBuffer& acquire() {
+        thread_local std::vector<std::unique_ptr<FormatBuffer>> buffers;
+        const size_t depth = getDepth()++;
+        if (depth == buffers.size())
+            buffers.push_back(std::make_unique<FormatBuffer>());
+        FormatBuffer& buffer = *buffers[depth];
+        buffer.clear();
+        return buffer;
+    }
+
+    FormatBuffer& myBuffer;
+};
+}
+}
+
+#endif
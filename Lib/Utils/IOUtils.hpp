@@ -1,6 +1,16 @@
 #ifndef IO_UTILS_HPP
 #define IO_UTILS_HPP
 #include <iostream>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Utils/ErrorUtils.hpp"
 
 namespace Utils {
 namespace IO {
@@ -43,6 +53,66 @@ inline void printLineSeperator(std::ostream& out, const int lines = 1, const int
     for (int i = 0; i < lines; ++i)
         out << std::string(length, line[0]) << "\n";
 }
+
+/* A file mapped read-only into memory, for parsing large files in place rather than through a stream. The kernel is told the file
+   is read front to back, so that pages are read ahead and dropped behind. An empty file maps to no bytes. */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filePath) : myFilePath(filePath) {
+        const int fd = ::open(myFilePath.c_str(), O_RDONLY);
+        if (fd < 0)
+            Error::LIB_THROW("[MappedFile] Cannot open file " + myFilePath + ": " + std::strerror(errno));
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            Error::LIB_THROW("[MappedFile] Cannot stat file " + myFilePath + ": " + std::strerror(errno));
+        }
+        mySize = static_cast<size_t>(st.st_size);
+        if (mySize > 0) {
+            void* base = ::mmap(nullptr, mySize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (base == MAP_FAILED) {
+                ::close(fd);
+                Error::LIB_THROW("[MappedFile] Cannot map file " + myFilePath + ": " + std::strerror(errno));
+            }
+            ::madvise(base, mySize, MADV_SEQUENTIAL);
+            myData = static_cast<const uint8_t*>(base);
+        }
+        ::close(fd);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() {
+        if (myData)
+            ::munmap(const_cast<uint8_t*>(myData), mySize);
+    }
+
+    const std::string& getFilePath() const { return myFilePath; }
+    const uint8_t* getData() const { return myData; }
+    size_t getSize() const { return mySize; }
+
+private:
+    const std::string myFilePath;
+    const uint8_t* myData = nullptr;
+    size_t mySize = 0;
+};
+
+/* Writes all the bytes to the file descriptor, resuming after partial writes and interrupts, and throws on any other failure. The
+   buffered file writers flush through it, and their destructors swallow what it throws as there is nowhere to report a write error
+   from a destructor - close the writers explicitly to see it. */
+inline void writeAll(const int fd, const void* data, const size_t size, const std::string& filePath = "") {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    size_t offset = 0;
+    while (offset < size) {
+        const ssize_t n = ::write(fd, bytes + offset, size - offset);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            Error::LIB_THROW("[writeAll] Cannot write file " + (filePath.empty() ? "descriptor " + std::to_string(fd) : filePath) + ": " +
+                std::strerror(errno));
+        }
+        offset += static_cast<size_t>(n);
+    }
+}
 }
 }
 
@@ -1,6 +1,9 @@
 #ifndef MATHS_UTILS_HPP
 #define MATHS_UTILS_HPP
 #include <cmath>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
 
 namespace Utils {
 namespace Maths {
@@ -22,6 +25,77 @@ template <typename T>
 inline double castIntPriceAsDouble(T price, double multiplier = 10000.0) {
     return price / multiplier;
 }
+
+inline uint64_t mixHash64(uint64_t x) {
+    // splitmix64 finalizer - cheap avalanche of all input bits into the 64-bit output
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+inline uint64_t combineHash64(uint64_t seed, uint64_t value) {
+    return mixHash64(seed ^ (mixHash64(value) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+}
+
+/* Binary indexed tree over the slots [0, size) supporting point updates, prefix sums and the prefix sum lower bound
+   search in O(log N). Slots are 0-based in the interface and 1-based internally. */
+template <typename T>
+class FenwickTree {
+public:
+    FenwickTree() = default;
+    FenwickTree(const size_t size) : myTree(size + 1, T{}) {}
+    size_t size() const { return myTree.empty() ? 0 : myTree.size() - 1; }
+    void add(size_t slot, const T delta) {
+        for (++slot; slot < myTree.size(); slot += slot & (~slot + 1))
+            myTree[slot] += delta;
+    }
+    T prefixSum(size_t slot) const { // sum over the slots [0, slot]
+        T sum{};
+        for (slot = std::min(slot + 1, size()); slot > 0; slot -= slot & (~slot + 1))
+            sum += myTree[slot];
+        return sum;
+    }
+    T rangeSum(const size_t slotFrom, const size_t slotTo) const { // sum over the slots [slotFrom, slotTo]
+        if (slotFrom > slotTo)
+            return T{};
+        return slotFrom == 0 ? prefixSum(slotTo) : prefixSum(slotTo) - prefixSum(slotFrom - 1);
+    }
+    size_t lowerBound(T target) const { // smallest slot whose prefix sum reaches target for non-negative slot values, size() if none
+        size_t pos = 0;
+        size_t step = 1;
+        while (step * 2 <= size())
+            step *= 2;
+        for (; step > 0; step /= 2) {
+            if (pos + step <= size() && myTree[pos + step] < target) {
+                pos += step;
+                target -= myTree[pos];
+            }
+        }
+        return pos;
+    }
+    std::vector<T> getValues() const { // recovers the slot values in O(N) by reverting the linear-time construction
+        std::vector<T> values(myTree);
+        for (size_t i = size(); i > 0; --i) {
+            const size_t parent = i + (i & (~i + 1));
+            if (parent < values.size())
+                values[parent] -= values[i];
+        }
+        return std::vector<T>(values.begin() + 1, values.end());
+    }
+    void build(const std::vector<T>& values) { // linear-time construction from the slot values
+        myTree.assign(values.size() + 1, T{});
+        for (size_t i = 1; i < myTree.size(); ++i) {
+            myTree[i] += values[i - 1];
+            const size_t parent = i + (i & (~i + 1));
+            if (parent < myTree.size())
+                myTree[parent] += myTree[i];
+        }
+    }
+    void clear() { myTree.clear(); }
+private:
+    std::vector<T> myTree;
+};
 }
 }
 
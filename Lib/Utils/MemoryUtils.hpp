@@ -0,0 +1,195 @@
+#ifndef MEMORY_UTILS_HPP
+#define MEMORY_UTILS_HPP
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace Utils {
+namespace Memory {
+/* A recycling pool of small blocks in size classes of 16 bytes. Blocks are carved out of slabs, and on release go back to their class
+   rather than to the heap, to be handed out again before anything new is carved. Only released blocks are ever recycled - objects
+   kept alive for the session, such as the events held in the event log of a matching engine, keep taking new blocks until their
+   owner lets go of them (e.g. upon an engine reset, or once the logs are cleared). The slabs are therefore capped at maxBytesReserved:
+   once a slab would go past it no slab is added any more, and the blocks that cannot be carved come from the heap and go back to it
+   on release. Blocks larger than the largest class go to the heap as well.
+   The pool has a single owner - blocks are handed out by one thread at a time (e.g. the thread driving an order event manager or a
+   matching engine) with no lock. They may be released from any thread, as the last owner of a pooled object may well live on another
+   one: a release pushes the block onto a lock-free list of its class, which the owner takes over whole once its own free list runs
+   dry. The counts may be read from any thread. Slabs are only returned to the heap with the pool. */
+class ObjectPool {
+public:
+    static constexpr size_t BLOCK_ALIGNMENT = 16;
+    static constexpr size_t MAX_BLOCK_SIZE = 512;
+    static constexpr size_t DEFAULT_BLOCKS_PER_SLAB = 256;
+    static constexpr size_t DEFAULT_MAX_BYTES_RESERVED = 64 << 20;
+
+    ObjectPool(const size_t blocksPerSlab = DEFAULT_BLOCKS_PER_SLAB, const size_t maxBytesReserved = DEFAULT_MAX_BYTES_RESERVED) :
+        myBlocksPerSlab(blocksPerSlab ? blocksPerSlab : 1), myMaxBytesReserved(maxBytesReserved) {}
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    size_t getBlocksPerSlab() const { return myBlocksPerSlab; }
+    size_t getMaxBytesReserved() const { return myMaxBytesReserved; }
+    uint64_t getNumAllocations() const { return myNumAllocations.load(std::memory_order_relaxed); }
+    uint64_t getNumRecycled() const { return myNumRecycled.load(std::memory_order_relaxed); } // allocations served from a released block
+    uint64_t getNumOversized() const { return myNumOversized.load(std::memory_order_relaxed); }
+    uint64_t getNumBeyondCap() const { return myNumBeyondCap.load(std::memory_order_relaxed); } // small blocks taken from the heap past the slab cap
+    uint64_t getNumInUse() const { // pooled blocks only, the releases are read first so that they never outnumber the blocks handed out
+        const uint64_t numReleased = myNumReleased.load(std::memory_order_acquire);
+        return myNumPooled.load(std::memory_order_acquire) - numReleased;
+    }
+    size_t getNumSlabs() const { return myNumSlabs.load(std::memory_order_relaxed); }
+    size_t getBytesReserved() const { return myBytesReserved.load(std::memory_order_relaxed); }
+    bool isCapped() const { return myIsCapped.load(std::memory_order_acquire); }
+
+    // owner only
+    void* allocate(const size_t bytes) {
+        increment(myNumAllocations);
+        if (bytes > MAX_BLOCK_SIZE) {
+            increment(myNumOversized);
+            return ::operator new(bytes);
+        }
+        const size_t sizeClass = getSizeClass(bytes);
+        FreeBlock*& head = myFreeLists[sizeClass];
+        if (!head && myReleasedLists[sizeClass].load(std::memory_order_relaxed))
+            head = myReleasedLists[sizeClass].exchange(nullptr, std::memory_order_acquire);
+        if (head) {
+            increment(myNumRecycled);
+            increment(myNumPooled);
+            FreeBlock* block = head;
+            head = block->next;
+            return block;
+        }
+        Carve& carve = myCarves[sizeClass];
+        if (carve.next == carve.end && !addSlab(sizeClass)) {
+            increment(myNumBeyondCap);
+            return ::operator new(bytes);
+        }
+        increment(myNumPooled);
+        void* block = carve.next;
+        carve.next += (sizeClass + 1) * BLOCK_ALIGNMENT;
+        return block;
+    }
+
+    // from any thread
+    void deallocate(void* p, const size_t bytes) {
+        if (!p)
+            return;
+        if (bytes > MAX_BLOCK_SIZE || (isCapped() && !isInSlab(p))) { // the range lookup is only paid for once the cap is hit
+            ::operator delete(p);
+            return;
+        }
+        std::atomic<FreeBlock*>& head = myReleasedLists[getSizeClass(bytes)];
+        FreeBlock* block = new (p) FreeBlock{head.load(std::memory_order_relaxed)};
+        while (!head.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed)) {}
+        myNumReleased.fetch_add(1, std::memory_order_release);
+    }
+
+    // adds a slab for each class of the given block sizes ahead of the hot path, within the slab cap, owner only
+    void reserve(const std::vector<size_t>& blockSizes) {
+        for (const size_t bytes : blockSizes) {
+            if (bytes > MAX_BLOCK_SIZE)
+                continue;
+            const size_t sizeClass = getSizeClass(bytes);
+            if (!myFreeLists[sizeClass] && myCarves[sizeClass].next == myCarves[sizeClass].end)
+                addSlab(sizeClass);
+        }
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+    struct Carve { // the part of the last slab of a class never handed out
+        std::byte* next = nullptr;
+        std::byte* end = nullptr;
+    };
+    static constexpr size_t NUM_SIZE_CLASSES = MAX_BLOCK_SIZE / BLOCK_ALIGNMENT;
+
+    static size_t getSizeClass(const size_t bytes) { return bytes ? (bytes - 1) / BLOCK_ALIGNMENT : 0; }
+    // a counter written by the owner only, hence with no read-modify-write
+    template<typename T>
+    static void increment(std::atomic<T>& counter) { counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+    bool addSlab(const size_t sizeClass) {
+        if (isCapped())
+            return false;
+        const size_t blockSize = (sizeClass + 1) * BLOCK_ALIGNMENT;
+        const size_t bytesReserved = myBytesReserved.load(std::memory_order_relaxed);
+        if (bytesReserved + blockSize * myBlocksPerSlab > myMaxBytesReserved) {
+            myIsCapped.store(true, std::memory_order_release); // the slab ranges are final from here on, for the releasing threads to read
+            return false;
+        }
+        auto slab = std::make_unique<std::byte[]>(blockSize * myBlocksPerSlab); // new[] aligns to at least 16 bytes
+        myCarves[sizeClass] = {slab.get(), slab.get() + blockSize * myBlocksPerSlab};
+        mySlabRanges.emplace(slab.get(), slab.get() + blockSize * myBlocksPerSlab);
+        myBytesReserved.store(bytesReserved + blockSize * myBlocksPerSlab, std::memory_order_relaxed);
+        mySlabs.push_back(std::move(slab));
+        increment(myNumSlabs);
+        return true;
+    }
+
+    bool isInSlab(const void* p) const {
+        const std::byte* block = static_cast<const std::byte*>(p);
+        auto it = mySlabRanges.upper_bound(block);
+        return it != mySlabRanges.begin() && block < (--it)->second;
+    }
+
+    const size_t myBlocksPerSlab;
+    const size_t myMaxBytesReserved;
+    std::array<FreeBlock*, NUM_SIZE_CLASSES> myFreeLists{}; // owner only
+    std::array<std::atomic<FreeBlock*>, NUM_SIZE_CLASSES> myReleasedLists{}; // pushed onto by any thread, taken over whole by the owner
+    std::array<Carve, NUM_SIZE_CLASSES> myCarves{};
+    std::vector<std::unique_ptr<std::byte[]>> mySlabs;
+    std::map<const std::byte*, const std::byte*> mySlabRanges; // slab begin to end, tells the heap blocks past the cap apart
+    std::atomic<bool> myIsCapped{false};
+    std::atomic<size_t> myNumSlabs{0};
+    std::atomic<size_t> myBytesReserved{0};
+    std::atomic<uint64_t> myNumAllocations{0};
+    std::atomic<uint64_t> myNumRecycled{0};
+    std::atomic<uint64_t> myNumOversized{0};
+    std::atomic<uint64_t> myNumBeyondCap{0};
+    std::atomic<uint64_t> myNumPooled{0}; // pooled blocks handed out
+    std::atomic<uint64_t> myNumReleased{0}; // pooled blocks released, by any thread
+};
+
+/* An allocator drawing from an ObjectPool, to be handed to std::allocate_shared - the control block and the object then share a
+   single pooled block, and the copy of the allocator kept in the control block keeps the pool alive for as long as the object. */
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator(const std::shared_ptr<ObjectPool>& pool) : myPool(pool) {}
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>& other) : myPool(other.getPool()) {}
+
+    const std::shared_ptr<ObjectPool>& getPool() const { return myPool; }
+    T* allocate(const size_t n) { return static_cast<T*>(myPool->allocate(n * sizeof(T))); }
+    void deallocate(T* p, const size_t n) { myPool->deallocate(p, n * sizeof(T)); }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>& other) const { return myPool == other.getPool(); }
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>& other) const { return myPool != other.getPool(); }
+
+private:
+    std::shared_ptr<ObjectPool> myPool;
+};
+
+// a pooled std::make_shared, falls back to the heap without a pool
+template<typename T, typename... Args>
+std::shared_ptr<T> makePooledShared(const std::shared_ptr<ObjectPool>& pool, Args&&... args) {
+    if (!pool)
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    return std::allocate_shared<T>(PoolAllocator<T>(pool), std::forward<Args>(args)...);
+}
+}
+}
+
+#endif
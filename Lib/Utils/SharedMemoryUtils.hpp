@@ -0,0 +1,202 @@
+#ifndef SHARED_MEMORY_UTILS_HPP
+#define SHARED_MEMORY_UTILS_HPP
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <cerrno>
+#include <string>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Utils/ErrorUtils.hpp"
+
+namespace Utils {
+namespace Concurrency {
+enum class ShmReadStatus { OK, EMPTY, OVERRUN };
+
+/* The layout of a broadcast ring in a POSIX shared-memory object, shared by the writer and the readers of all processes: a header
+   followed by a power-of-two number of slots. The records are numbered from 1 and the n-th record goes to the slot (n - 1) & mask,
+   which carries the number of the record it holds (0 before the first lap, BUSY while it is being written). */
+template<typename T>
+struct ShmRingLayout {
+    static_assert(std::is_trivially_copyable_v<T>, "Records in shared memory must be trivially copyable.");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory sequences need lock-free 64-bit atomics.");
+    static constexpr uint64_t MAGIC = 0x4C69624F42524E47; // "LibOBRNG"
+    static constexpr uint64_t BUSY = ~uint64_t{0};
+
+    struct Header {
+        uint64_t magic;
+        uint64_t record_size;
+        uint64_t capacity;
+        alignas(64) std::atomic<uint64_t> write_sequence; // number of the last record published
+    };
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> sequence;
+        T record;
+    };
+
+    static size_t bytes(size_t capacity) { return sizeof(Header) + capacity * sizeof(Slot); }
+    static Slot* slots(void* base) { return reinterpret_cast<Slot*>(static_cast<char*>(base) + sizeof(Header)); }
+    static const Slot* slots(const void* base) { return reinterpret_cast<const Slot*>(static_cast<const char*>(base) + sizeof(Header)); }
+};
+
+/* The single writer of a shared-memory broadcast ring. Publishing never blocks and never enters the kernel: the writer laps the
+   slowest reader, which then detects the overrun from the record numbers. The object is created (or reset) on construction and
+   unlinked on destruction unless told otherwise, while readers that still have it mapped keep reading the last records. */
+template<typename T>
+class ShmBroadcastRingWriter {
+public:
+    using Layout = ShmRingLayout<T>;
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+
+    explicit ShmBroadcastRingWriter(const std::string& name, size_t capacity = DEFAULT_CAPACITY, bool unlink_on_close = true) :
+        name_(name), capacity_(roundUpToPowerOfTwo(capacity)), mask_(capacity_ - 1), bytes_(Layout::bytes(capacity_)), unlink_on_close_(unlink_on_close) {
+        const int fd = ::shm_open(name_.c_str(), O_CREAT | O_RDWR, 0600);
+        if (fd < 0)
+            Error::LIB_THROW("[ShmBroadcastRingWriter] Cannot open shared memory " + name_ + ": " + std::strerror(errno));
+        if (::ftruncate(fd, 0) != 0 || ::ftruncate(fd, static_cast<off_t>(bytes_)) != 0) { // zero-fills any earlier content
+            ::close(fd);
+            Error::LIB_THROW("[ShmBroadcastRingWriter] Cannot size shared memory " + name_ + ": " + std::strerror(errno));
+        }
+        base_ = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base_ == MAP_FAILED)
+            Error::LIB_THROW("[ShmBroadcastRingWriter] Cannot map shared memory " + name_ + ": " + std::strerror(errno));
+        header_ = new (base_) typename Layout::Header{Layout::MAGIC, sizeof(T), capacity_, {0}};
+        slots_ = Layout::slots(base_);
+        for (size_t i = 0; i < capacity_; ++i)
+            new (&slots_[i].sequence) std::atomic<uint64_t>(0);
+    }
+    ShmBroadcastRingWriter(const ShmBroadcastRingWriter&) = delete;
+    ShmBroadcastRingWriter& operator=(const ShmBroadcastRingWriter&) = delete;
+    ~ShmBroadcastRingWriter() {
+        ::munmap(base_, bytes_);
+        if (unlink_on_close_)
+            ::shm_unlink(name_.c_str());
+    }
+
+    const std::string& name() const { return name_; }
+    size_t capacity() const { return capacity_; }
+    uint64_t published() const { return next_sequence_ - 1; }
+
+    // returns the number given to the record
+    uint64_t publish(const T& record) {
+        const uint64_t sequence = next_sequence_++;
+        auto& slot = slots_[(sequence - 1) & mask_];
+        slot.sequence.store(Layout::BUSY, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release); // a reader seeing the new record also sees BUSY
+        std::memcpy(&slot.record, &record, sizeof(T));
+        slot.sequence.store(sequence, std::memory_order_release);
+        header_->write_sequence.store(sequence, std::memory_order_release);
+        return sequence;
+    }
+
+private:
+    static size_t roundUpToPowerOfTwo(size_t n) {
+        size_t p = 2;
+        while (p < n)
+            p <<= 1;
+        return p;
+    }
+
+    const std::string name_;
+    const size_t capacity_;
+    const size_t mask_;
+    const size_t bytes_;
+    const bool unlink_on_close_;
+    void* base_ = nullptr;
+    typename Layout::Header* header_ = nullptr;
+    typename Layout::Slot* slots_ = nullptr;
+    uint64_t next_sequence_ = 1;
+};
+
+/* A reader of a shared-memory broadcast ring, mapped read-only and with its own cursor so that any number of them may follow the
+   writer from any process. A reader that falls more than a ring behind is told so once with OVERRUN, and resumes from the oldest
+   record still in the ring with the lost records added to num_missed. A reader attaching late starts from the oldest record. */
+template<typename T>
+class ShmBroadcastRingReader {
+public:
+    using Layout = ShmRingLayout<T>;
+
+    explicit ShmBroadcastRingReader(const std::string& name) : name_(name) {
+        const int fd = ::shm_open(name_.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+            Error::LIB_THROW("[ShmBroadcastRingReader] Cannot open shared memory " + name_ + ": " + std::strerror(errno));
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(typename Layout::Header)) {
+            ::close(fd);
+            Error::LIB_THROW("[ShmBroadcastRingReader] Shared memory " + name_ + " is not a ring.");
+        }
+        bytes_ = static_cast<size_t>(st.st_size);
+        base_ = ::mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base_ == MAP_FAILED)
+            Error::LIB_THROW("[ShmBroadcastRingReader] Cannot map shared memory " + name_ + ": " + std::strerror(errno));
+        header_ = static_cast<const typename Layout::Header*>(base_);
+        if (header_->magic != Layout::MAGIC || header_->record_size != sizeof(T) || Layout::bytes(header_->capacity) != bytes_) {
+            ::munmap(const_cast<void*>(base_), bytes_);
+            Error::LIB_THROW("[ShmBroadcastRingReader] Shared memory " + name_ + " does not hold a ring of the expected records.");
+        }
+        capacity_ = header_->capacity;
+        mask_ = capacity_ - 1;
+        slots_ = Layout::slots(base_);
+        next_sequence_ = oldest(header_->write_sequence.load(std::memory_order_acquire));
+    }
+    ShmBroadcastRingReader(const ShmBroadcastRingReader&) = delete;
+    ShmBroadcastRingReader& operator=(const ShmBroadcastRingReader&) = delete;
+    ~ShmBroadcastRingReader() { ::munmap(const_cast<void*>(base_), bytes_); }
+
+    const std::string& name() const { return name_; }
+    size_t capacity() const { return capacity_; }
+    uint64_t next_sequence() const { return next_sequence_; }
+    uint64_t published() const { return header_->write_sequence.load(std::memory_order_acquire); }
+    uint64_t lag() const { return published() + 1 - next_sequence_; }
+    uint64_t num_overruns() const { return num_overruns_; }
+    uint64_t num_missed() const { return num_missed_; }
+
+    ShmReadStatus poll(T& out) {
+        const uint64_t written = header_->write_sequence.load(std::memory_order_acquire);
+        if (next_sequence_ > written)
+            return ShmReadStatus::EMPTY;
+        if (written - next_sequence_ < capacity_) {
+            const auto& slot = slots_[(next_sequence_ - 1) & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) == next_sequence_) {
+                std::memcpy(&out, &slot.record, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == next_sequence_) { // not overwritten while copying
+                    ++next_sequence_;
+                    return ShmReadStatus::OK;
+                }
+            }
+        }
+        // the writer has lapped the cursor: skip to the oldest record that is still safe to read
+        const uint64_t resume = oldest(header_->write_sequence.load(std::memory_order_acquire)) + 1;
+        ++num_overruns_;
+        num_missed_ += resume - next_sequence_;
+        next_sequence_ = resume;
+        return ShmReadStatus::OVERRUN;
+    }
+
+private:
+    uint64_t oldest(const uint64_t written) const { return written >= capacity_ ? written - capacity_ + 1 : 1; }
+
+    const std::string name_;
+    size_t bytes_ = 0;
+    size_t capacity_ = 0;
+    size_t mask_ = 0;
+    const void* base_ = nullptr;
+    const typename Layout::Header* header_ = nullptr;
+    const typename Layout::Slot* slots_ = nullptr;
+    uint64_t next_sequence_ = 1;
+    uint64_t num_overruns_ = 0;
+    uint64_t num_missed_ = 0;
+};
+}
+}
+
+#endif
@@ -4,12 +4,15 @@
 #include <sstream>
 #include <iomanip>
 #include <string>
+#include <string_view>
 #include <set>
 #include <map>
 #include <list>
 #include <array>
 #include <vector>
+#include <span>
 #include <unordered_map>
+#include <unordered_set>
 #include <cmath>
 #include <random>
 #include <limits>
@@ -31,6 +34,8 @@
 #include "Utils/StatisticsUtils.hpp"
 #include "Utils/VectorUtils.hpp"
 #include "Utils/ConcurrencyUtils.hpp"
+#include "Utils/MemoryUtils.hpp"
+#include "Utils/FormatUtils.hpp"
 #include "Utils/RegressionTestsUtils.hpp"
 
 namespace Utils {
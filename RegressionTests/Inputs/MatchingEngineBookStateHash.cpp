@@ -0,0 +1,47 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineBookStateHash";
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    auto logHashes = [&em](const std::string& label, const std::shared_ptr<Exchange::MatchingEngineFIFO>& engine) {
+        *em.getLogger() << label << ": incremental=" << engine->getBookStateHash() << ", recomputed=" << engine->computeBookStateHash()
+            << ", consistent=" << (engine->getBookStateHash() == engine->computeBookStateHash());
+    };
+    logHashes("Empty book", e);
+    // initial book state
+    for (int i = 0; i < 10; ++i) {
+        em.submitLimitOrderEvent(Market::Side::BUY, 5 + i, 99.0 - i);
+        em.submitLimitOrderEvent(Market::Side::SELL, 5 + i, 101.0 + i);
+    }
+    logHashes("Initial book", e);
+    // partial fills, full fills, cancels and modifications
+    em.submitMarketOrderEvent(Market::Side::BUY, 3);
+    em.submitMarketOrderEvent(Market::Side::SELL, 12);
+    em.submitLimitOrderEvent(Market::Side::BUY, 20, 102.0);
+    em.cancelOrder(4);
+    em.modifyOrderPrice(6, 95.5);
+    em.modifyOrderQuantity(7, 2);
+    logHashes("Mutated book", e);
+    // clone and replayed engines must agree with the original
+    const auto e1 = std::dynamic_pointer_cast<Exchange::MatchingEngineFIFO>(e->clone());
+    logHashes("Cloned book", e1);
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e2 = std::make_shared<Exchange::MatchingEngineFIFO>();
+    e2->build(e->getOrderEventLog());
+    logHashes("Replayed book", e2);
+    *em.getLogger() << "Original vs cloned equal: " << (e->getBookStateHash() == e1->getBookStateHash());
+    *em.getLogger() << "Original vs replayed equal: " << (e->getBookStateHash() == e2->getBookStateHash());
+    // any further divergence is reflected in the hash
+    em.cancelOrder(9);
+    logHashes("Diverged book", e);
+    *em.getLogger() << "Original vs cloned equal after divergence: " << (e->getBookStateHash() == e1->getBookStateHash());
+    // emptying the book restores the empty hash
+    e->reset();
+    logHashes("Reset book", e);
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineCallAuction";
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    auto& config = e->getOrderBookDisplayConfig();
+    config.setAggregateOrderBook(false);
+    config.setShowOrderLookup(false);
+    auto logEquilibrium = [&em](const std::string& label, const Exchange::AuctionEquilibrium& equilibrium) {
+        *em.getLogger() << label << ": price=" << equilibrium.price << ", matched=" << equilibrium.matchedQuantity
+            << ", buy=" << equilibrium.buyQuantity << ", sell=" << equilibrium.sellQuantity << ", imbalance=" << equilibrium.getImbalance();
+    };
+    // opening auction: crossing orders accumulate in the book without matching
+    e->startAuction(Exchange::ITCHEncoder::CrossCode::OPENING);
+    em.submitLimitOrderEvent(Market::Side::BUY, 10, 101.0);
+    em.submitLimitOrderEvent(Market::Side::BUY, 15, 100.5);
+    em.submitLimitOrderEvent(Market::Side::BUY, 20, 100.0);
+    em.submitLimitOrderEvent(Market::Side::BUY, 25, 99.5);
+    em.submitLimitOrderEvent(Market::Side::SELL, 12, 99.0);
+    em.submitLimitOrderEvent(Market::Side::SELL, 18, 99.5);
+    em.submitLimitOrderEvent(Market::Side::SELL, 10, 100.0);
+    em.submitLimitOrderEvent(Market::Side::SELL, 30, 101.5);
+    em.submitMarketOrderEvent(Market::Side::BUY, 5);
+    em.submitLimitOrderEvent(Market::Side::SELL, 5, 100.0, Market::TimeInForce::IOC); // rejected during the auction
+    em.cancelOrder(3); // buy 25 at 99.5
+    *em.getLogger() << "In auction: " << e->isInAuction() << ", trades so far: " << e->getTradeLog().size();
+    *em.getLogger() << "Crossed order book state:\n" << *e;
+    logEquilibrium("Indicative equilibrium", e->computeAuctionEquilibrium());
+    // the uncrossing fills everything at the single equilibrium price and prints a single cross trade
+    const size_t numReports = e->getOrderProcessingReportLog().size();
+    logEquilibrium("Uncrossed equilibrium", e->uncrossAuction());
+    const auto& reportLog = e->getOrderProcessingReportLog();
+    for (size_t i = numReports; i < reportLog.size(); ++i)
+        if (reportLog[i])
+            *em.getLogger() << *reportLog[i];
+    const auto& itchLog = e->getITCHMessageLog();
+    if (!itchLog.empty() && itchLog.back())
+        *em.getLogger() << "Last ITCH message: " << *itchLog.back();
+    *em.getLogger() << "Uncrossed order book state:\n" << *e;
+    e->stateConsistencyCheck();
+    // continuous matching resumes after the uncrossing
+    em.submitLimitOrderEvent(Market::Side::SELL, 3, 100.0);
+    *em.getLogger() << "In auction: " << e->isInAuction() << ", last trade: " << e->getLastTradeSize() << " at " << e->getLastTradePrice();
+    // closing auction with a buy surplus at equal volume pushes the price up
+    e->startAuction(Exchange::ITCHEncoder::CrossCode::CLOSING);
+    em.submitLimitOrderEvent(Market::Side::BUY, 40, 102.0);
+    logEquilibrium("Closing equilibrium", e->uncrossAuction());
+    *em.getLogger() << "Closing order book state:\n" << *e;
+    e->stateConsistencyCheck();
+    // an auction without any cross prints nothing
+    e->startAuction(Exchange::ITCHEncoder::CrossCode::HALT);
+    logEquilibrium("Uncrossed book equilibrium", e->uncrossAuction());
+    *em.getLogger() << "Active limit orders tracked by the manager: " << em.getActiveLimitOrders().size()
+        << " vs resting in the book: " << e->getLimitOrderLookup().size();
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineCoalescedDeltas";
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    std::shared_ptr<Exchange::MatchingEngineFIFO> c = std::make_shared<Exchange::MatchingEngineFIFO>();
+    c->setCoalesceBookDeltas(true);
+    Market::OrderEventManagerBase em{e};
+    Market::OrderEventManagerBase cm{c};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    e->getOrderBookDisplayConfig().setShowOrderLookup(false);
+    // an L2 book rebuilt from the deltas alone, as a market-data consumer would
+    std::map<std::pair<Market::Side, double>, int64_t> perFillBook, coalescedBook;
+    size_t numPerFillDeltas = 0, numCoalescedDeltas = 0, numBatches = 0;
+    std::vector<std::string> lastBatch;
+    bool logBatches = false;
+    auto applyDelta = [](auto& book, const Exchange::OrderBookSizeDelta& delta) {
+        auto& size = book[{delta.side, delta.price}];
+        size += delta.type == Exchange::OrderBookSizeDelta::DeltaType::ADD ? delta.sizeDelta : -static_cast<int64_t>(delta.sizeDelta);
+        if (size == 0)
+            book.erase({delta.side, delta.price});
+    };
+    e->subscribeOrderBookDeltas([&](const std::shared_ptr<const Exchange::OrderBookSizeDelta>& delta) {
+        if (!delta)
+            return;
+        ++numPerFillDeltas;
+        applyDelta(perFillBook, *delta);
+    });
+    c->subscribeOrderBookDeltas([&](const std::shared_ptr<const Exchange::OrderBookSizeDelta>& delta) {
+        if (!delta)
+            return;
+        ++numCoalescedDeltas;
+        applyDelta(coalescedBook, *delta);
+        std::ostringstream oss;
+        oss << Utils::toString(delta->side) << " " << delta->price << " " << (delta->type == Exchange::OrderBookSizeDelta::DeltaType::ADD ? "+" : "-") << delta->sizeDelta;
+        lastBatch.push_back(oss.str());
+        if (delta->isLastInBatch) {
+            ++numBatches;
+            if (logBatches)
+                *em.getLogger() << "Batch " << numBatches << ": " << Utils::toString(lastBatch);
+            lastBatch.clear();
+        }
+    });
+    auto bookMatches = [](const auto& book, const auto& engine) {
+        std::map<std::pair<Market::Side, double>, int64_t> engineBook;
+        for (const auto& [price, size] : engine->getBidBookSize())
+            engineBook[{Market::Side::BUY, price}] = size;
+        for (const auto& [price, size] : engine->getAskBookSize())
+            engineBook[{Market::Side::SELL, price}] = size;
+        return engineBook == book;
+    };
+    auto both = [&](auto&& action) { action(em); action(cm); };
+    // a deep level of small orders on each side
+    for (int i = 0; i < 50; ++i) {
+        both([i](auto& m) { m.submitLimitOrderEvent(Market::Side::BUY, 1 + i % 3, 99.0); });
+        both([i](auto& m) { m.submitLimitOrderEvent(Market::Side::SELL, 1 + i % 3, 101.0); });
+    }
+    both([](auto& m) { m.submitLimitOrderEvent(Market::Side::SELL, 20, 101.5); });
+    both([](auto& m) { m.submitLimitOrderEvent(Market::Side::BUY, 20, 98.5); });
+    *em.getLogger() << "Per-fill deltas: " << numPerFillDeltas << ", coalesced deltas: " << numCoalescedDeltas << ", batches: " << numBatches;
+    // aggressive flow sweeping the levels, a price modify and a cancel
+    logBatches = true;
+    both([](auto& m) { m.submitMarketOrderEvent(Market::Side::BUY, 110); });
+    both([](auto& m) { m.submitLimitOrderEvent(Market::Side::SELL, 90, 98.5); });
+    both([](auto& m) { m.modifyOrderPrice(101, 98.0); });
+    both([](auto& m) { m.modifyOrderQuantity(101, 10); });
+    both([](auto& m) { m.cancelOrder(100); });
+    *em.getLogger() << "Per-fill deltas: " << numPerFillDeltas << ", coalesced deltas: " << numCoalescedDeltas << ", batches: " << numBatches;
+    *em.getLogger() << "Per-fill rebuilt book matches the engine: " << bookMatches(perFillBook, e)
+        << ", coalesced rebuilt book matches the engine: " << bookMatches(coalescedBook, c);
+    auto countReports = [](const auto& engine) {
+        return std::count_if(engine->getOrderProcessingReportLog().begin(), engine->getOrderProcessingReportLog().end(), [](const auto& report) { return report != nullptr; });
+    };
+    *em.getLogger() << "Same book state: " << (e->getBookStateHash() == c->getBookStateHash())
+        << ", same reports: " << (countReports(e) == countReports(c));
+    *em.getLogger() << "Coalesced order book state:\n" << *c;
+    c->stateConsistencyCheck();
+    return 0;
+}
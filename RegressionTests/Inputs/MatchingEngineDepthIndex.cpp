@@ -0,0 +1,111 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineDepthIndex";
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    auto& config = e->getOrderBookDisplayConfig();
+    config.setShowOrderLookup(false);
+    // linear scans over the size maps as the reference for the ladder queries
+    auto scanBidDepth = [&e](const double priceFrom, const double priceTo) {
+        uint32_t depth = 0;
+        for (const auto& [price, size] : e->getBidBookSize())
+            if (price >= priceFrom - 0.005 && price < priceTo + 0.005) depth += size;
+        return depth;
+    };
+    auto scanAskDepth = [&e](const double priceFrom, const double priceTo) {
+        uint32_t depth = 0;
+        for (const auto& [price, size] : e->getAskBookSize())
+            if (price >= priceFrom - 0.005 && price < priceTo + 0.005) depth += size;
+        return depth;
+    };
+    auto scanPriceToFill = [](const auto& bookSize, uint32_t quantity) {
+        for (const auto& [price, size] : bookSize) {
+            if (size >= quantity) return price;
+            quantity -= size;
+        }
+        return Utils::Consts::NAN_DOUBLE;
+    };
+    auto logQueries = [&](const std::string& label) {
+        *em.getLogger() << label << ":\n" << *e;
+        bool consistent = true;
+        for (uint32_t k : {0, 1, 5, 50, 1000}) {
+            const uint32_t bidDepth = e->getBidDepthWithinTicks(k);
+            const uint32_t askDepth = e->getAskDepthWithinTicks(k);
+            *em.getLogger() << "Depth within " << k << " ticks: bid=" << bidDepth << ", ask=" << askDepth;
+            if (!e->getBidBookSize().empty())
+                consistent &= bidDepth == scanBidDepth(e->getBestBidPrice() - k * 0.01, e->getBestBidPrice());
+            if (!e->getAskBookSize().empty())
+                consistent &= askDepth == scanAskDepth(e->getBestAskPrice(), e->getBestAskPrice() + k * 0.01);
+        }
+        *em.getLogger() << "Depth in [95.0, 97.5]: bid=" << e->getBidDepthInRange(95.0, 97.5) << ", ask=" << e->getAskDepthInRange(95.0, 97.5);
+        *em.getLogger() << "Depth in [101.0, 104.0]: bid=" << e->getBidDepthInRange(101.0, 104.0) << ", ask=" << e->getAskDepthInRange(101.0, 104.0);
+        consistent &= e->getBidDepthInRange(95.0, 97.5) == scanBidDepth(95.0, 97.5) && e->getAskDepthInRange(101.0, 104.0) == scanAskDepth(101.0, 104.0);
+        for (uint32_t q : {1, 10, 25, 60, 85, 10000}) {
+            const double bidPrice = e->getBidPriceToFill(q);
+            const double askPrice = e->getAskPriceToFill(q);
+            *em.getLogger() << "Price to fill " << q << ": bid=" << bidPrice << ", ask=" << askPrice;
+            const double bidScan = scanPriceToFill(e->getBidBookSize(), q);
+            const double askScan = scanPriceToFill(e->getAskBookSize(), q);
+            consistent &= (std::isnan(bidPrice) && std::isnan(bidScan)) || bidPrice == bidScan;
+            consistent &= (std::isnan(askPrice) && std::isnan(askScan)) || askPrice == askScan;
+        }
+        size_t level = 0;
+        for (const auto& [price, size] : e->getBidBookSize())
+            consistent &= e->getBidPriceAtLevel(level++) == price;
+        level = 0;
+        for (const auto& [price, size] : e->getAskBookSize())
+            consistent &= e->getAskPriceAtLevel(level++) == price;
+        *em.getLogger() << "Bid levels 0, 3: " << e->getBidPriceAtLevel(0) << ", " << e->getBidPriceAtLevel(3)
+            << " | Ask levels 0, 3: " << e->getAskPriceAtLevel(0) << ", " << e->getAskPriceAtLevel(3);
+        *em.getLogger() << "Index consistent with linear scans: " << consistent;
+    };
+    // initial book state, including off-tick prices sharing a tick with an on-tick level
+    for (int i = 0; i < 10; ++i) {
+        em.submitLimitOrderEvent(Market::Side::BUY, 5 + i, 99.0 - 0.5 * i);
+        em.submitLimitOrderEvent(Market::Side::SELL, 5 + i, 101.0 + 0.5 * i);
+    }
+    em.submitLimitOrderEvent(Market::Side::BUY, 3, 97.001);
+    em.submitLimitOrderEvent(Market::Side::SELL, 4, 102.004);
+    logQueries("Initial book");
+    // fills sweeping whole levels, cancels and modifications
+    em.submitMarketOrderEvent(Market::Side::BUY, 12);
+    em.submitMarketOrderEvent(Market::Side::SELL, 8);
+    em.cancelOrder(7);
+    em.modifyOrderPrice(10, 95.25);
+    em.modifyOrderQuantity(12, 2);
+    logQueries("Mutated book");
+    // far away prices force the ladder to grow and re-center
+    em.submitLimitOrderEvent(Market::Side::BUY, 7, 40.0);
+    em.submitLimitOrderEvent(Market::Side::SELL, 9, 250.0);
+    logQueries("Extended book");
+    e->stateConsistencyCheck();
+    *em.getLogger() << "Bid ladder span: " << e->getBidPriceLadder().getSpan() << ", ask ladder span: " << e->getAskPriceLadder().getSpan();
+    // fat-finger prices beyond the maximum ladder span are kept out of the ladder as overflow ticks
+    const auto fatFingerBid = em.submitLimitOrderEvent(Market::Side::BUY, 2, 0.01);
+    const auto fatFingerAsk = em.submitLimitOrderEvent(Market::Side::SELL, 3, 999999.0);
+    logQueries("Fat-finger book");
+    e->stateConsistencyCheck();
+    *em.getLogger() << "Bid ladder span: " << e->getBidPriceLadder().getSpan() << ", overflow ticks: " << e->getBidPriceLadder().getNumOverflowTicks()
+        << " | Ask ladder span: " << e->getAskPriceLadder().getSpan() << ", overflow ticks: " << e->getAskPriceLadder().getNumOverflowTicks();
+    const uint32_t totalAskSize = static_cast<uint32_t>(e->getAskPriceLadder().getTotalSize());
+    *em.getLogger() << "Price to fill the whole ask side of " << totalAskSize << ": " << e->getAskPriceToFill(totalAskSize)
+        << " vs scan " << scanPriceToFill(e->getAskBookSize(), totalAskSize);
+    em.cancelOrder(fatFingerBid->getOrderId());
+    em.cancelOrder(fatFingerAsk->getOrderId());
+    e->stateConsistencyCheck();
+    *em.getLogger() << "Overflow ticks after the cancels: bid=" << e->getBidPriceLadder().getNumOverflowTicks() << ", ask=" << e->getAskPriceLadder().getNumOverflowTicks();
+    // the ladders are rebuilt on the tick taken from the engine
+    e->setMinimumPriceTick(0.05);
+    e->stateConsistencyCheck();
+    *em.getLogger() << "Minimum price tick: " << e->getMinimumPriceTick() << ", bid ladder span: " << e->getBidPriceLadder().getSpan()
+        << ", ask ladder span: " << e->getAskPriceLadder().getSpan() << ", depth within 10 ticks: bid=" << e->getBidDepthWithinTicks(10)
+        << " vs scan " << scanBidDepth(e->getBestBidPrice() - 0.5, e->getBestBidPrice()) << ", ask=" << e->getAskDepthWithinTicks(10)
+        << " vs scan " << scanAskDepth(e->getBestAskPrice(), e->getBestAskPrice() + 0.5);
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEvent.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineDisruptorBookDeltas";
+
+int main() {
+    std::shared_ptr<Utils::Logger::LoggerBase> logger = std::make_shared<Utils::Logger::LoggerBase>();
+    logger->setLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    auto toString = [](const Exchange::OrderBookSizeDelta& delta) {
+        std::ostringstream oss;
+        oss << Utils::toString(delta.side) << " " << delta.price << " " << (delta.type == Exchange::OrderBookSizeDelta::DeltaType::ADD ? "+" : "-")
+            << delta.sizeDelta << (delta.isLastInBatch ? " |" : "");
+        return oss.str();
+    };
+    // the per-fill and the coalesced delta streams of the disruptor engine, including the delta-only replace entries, match the FIFO engine
+    for (const bool coalesce : {false, true}) {
+        std::shared_ptr<Exchange::MatchingEngineFIFO> s = std::make_shared<Exchange::MatchingEngineFIFO>();
+        std::shared_ptr<Exchange::MatchingEngineFIFODisruptor> e = std::make_shared<Exchange::MatchingEngineFIFODisruptor>();
+        s->setCoalesceBookDeltas(coalesce);
+        e->setCoalesceBookDeltas(coalesce);
+        e->setOutputRingCapacity(16);
+        e->addEngineLogConsumer();
+        std::vector<std::string> referenceDeltas, deltas;
+        s->subscribeOrderBookDeltas([&](const std::shared_ptr<const Exchange::OrderBookSizeDelta>& delta) {
+            if (delta)
+                referenceDeltas.push_back(toString(*delta));
+        });
+        e->subscribeOrderBookDeltas([&](const std::shared_ptr<const Exchange::OrderBookSizeDelta>& delta) {
+            if (delta)
+                deltas.push_back(toString(*delta));
+        });
+        auto submitAll = [&](const uint64_t idFrom, const uint64_t idTo) {
+            for (uint64_t id = idFrom; id < idTo; ++id) {
+                const Market::Side side = id % 2 ? Market::Side::BUY : Market::Side::SELL;
+                const double price = id % 2 ? 100.0 - 0.01 * (id % 7) : 100.01 + 0.01 * (id % 5);
+                for (const auto& engine : {std::static_pointer_cast<Exchange::MatchingEngineFIFO>(e), s}) {
+                    if (id % 17 == 0)
+                        engine->process(std::make_shared<Market::MarketOrder>(id, 0, side, 5 + id % 9));
+                    else if (id % 7 == 0)
+                        engine->process(std::make_shared<const Market::OrderModifyPriceEvent>(id, id - 4, 0, id % 2 ? 99.9 : 100.1));
+                    else if (id % 11 == 0)
+                        engine->process(std::make_shared<const Market::OrderModifyQuantityEvent>(id, id - 2, 0, 1 + id % 4));
+                    else if (id % 13 == 0)
+                        engine->process(std::make_shared<const Market::OrderCancelAndReplaceEvent>(id, id - 6, 0, id, 2 + id % 3));
+                    else
+                        engine->process(std::make_shared<Market::LimitOrder>(id, 0, side, 1 + id % 9, price));
+                }
+            }
+        };
+        // inline before the consumer threads start, then on the consumer threads
+        submitAll(1, 40);
+        e->startConsumerThreads();
+        submitAll(40, 1000);
+        e->stopConsumerThreads();
+        size_t numDeltaOnlyEntries = 0;
+        for (size_t i = 0; i < s->getOrderProcessingReportLog().size(); ++i)
+            numDeltaOnlyEntries += !s->getOrderProcessingReportLog()[i] && s->getOrderBookSizeDeltaLog()[i];
+        *logger << "Coalescing: " << coalesce << ", deltas: " << deltas.size() << " vs FIFO engine: " << referenceDeltas.size()
+            << ", delta-only entries: " << numDeltaOnlyEntries;
+        *logger << "Delta streams match the FIFO engine: " << (deltas == referenceDeltas);
+        *logger << "Engine logs match the FIFO engine: " << (e->getOrderBookSizeDeltaLog().size() == s->getOrderBookSizeDeltaLog().size());
+        *logger << "Last deltas: " << Utils::toString(std::vector<std::string>(deltas.end() - std::min<size_t>(deltas.size(), 6), deltas.end()));
+        *logger << "Books match the FIFO engine: " << (e->getBidBookSize() == s->getBidBookSize() && e->getAskBookSize() == s->getAskBookSize());
+        e->stateConsistencyCheck();
+    }
+    return 0;
+}
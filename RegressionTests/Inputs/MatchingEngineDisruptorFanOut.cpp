@@ -0,0 +1,103 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEvent.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineDisruptorFanOut";
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> s = std::make_shared<Exchange::MatchingEngineFIFO>();
+    std::shared_ptr<Exchange::MatchingEngineFIFODisruptor> e = std::make_shared<Exchange::MatchingEngineFIFODisruptor>();
+    e->getLogger()->setLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    e->getOrderBookDisplayConfig().setShowOrderLookup(false);
+    e->setOutputRingCapacity(16);
+    // a journal writer ahead of the engine logs and callbacks, and an independent risk consumer
+    std::vector<uint64_t> journal;
+    std::atomic<size_t> numJournaled{0};
+    const size_t journalId = e->addOutputConsumer([&](const Exchange::LoggedEngineOutput& output) {
+        if (!output.loggedReport.report)
+            return;
+        journal.push_back(output.loggedReport.report->orderId);
+        numJournaled.fetch_add(1, std::memory_order_release);
+    });
+    uint64_t numRiskReports = 0, riskFilledQuantity = 0;
+    const size_t riskId = e->addOutputConsumer([&](const Exchange::LoggedEngineOutput& output) {
+        if (!output.loggedReport.report)
+            return;
+        ++numRiskReports;
+        if (const auto& fill = std::dynamic_pointer_cast<const Exchange::OrderExecutionReport>(output.loggedReport.report))
+            riskFilledQuantity += fill->filledQuantity;
+    });
+    const size_t engineLogId = e->addEngineLogConsumer({journalId});
+    // stands in for the order event manager acknowledgement, which must never get ahead of the journal
+    size_t numAcks = 0, numAcksAheadOfJournal = 0;
+    e->addOrderProcessingCallback(std::make_shared<Exchange::OrderProcessingCallback>([&](const auto&) {
+        ++numAcks;
+        numAcksAheadOfJournal += numJournaled.load(std::memory_order_acquire) < numAcks;
+    }));
+    *e->getLogger() << "Consumers: journal=" << journalId << ", risk=" << riskId << ", engine log=" << engineLogId
+        << ", ring capacity=" << e->getOutputRing().capacity();
+    auto submitAll = [&](const uint64_t idFrom, const uint64_t idTo) {
+        for (uint64_t id = idFrom; id < idTo; ++id) {
+            const Market::Side side = id % 2 ? Market::Side::BUY : Market::Side::SELL;
+            const double price = id % 2 ? 100.0 - 0.01 * (id % 7) : 99.97 + 0.01 * (id % 5);
+            for (const auto& engine : {std::static_pointer_cast<Exchange::MatchingEngineFIFO>(e), s}) {
+                if (id % 11 == 0)
+                    engine->process(std::make_shared<Market::MarketOrder>(id, 0, side, 1 + id % 9));
+                else if (id % 13 == 0)
+                    engine->process(std::make_shared<const Market::OrderCancelEvent>(id, id - 3, 0));
+                else
+                    engine->process(std::make_shared<Market::LimitOrder>(id, 0, side, 1 + id % 9, price));
+            }
+        }
+    };
+    // inline before the consumer threads start
+    submitAll(1, 30);
+    *e->getLogger() << "Inline - published: " << e->getOutputRing().published() << ", journal: " << e->getOutputRing().consumed(journalId)
+        << ", risk: " << e->getOutputRing().consumed(riskId) << ", engine log: " << e->getOutputRing().consumed(engineLogId);
+    // each consumer on its own thread
+    e->startConsumerThreads();
+    submitAll(30, 2000);
+    e->flush();
+    *e->getLogger() << "Flushed - published: " << e->getOutputRing().published() << ", journal: " << e->getOutputRing().consumed(journalId)
+        << ", risk: " << e->getOutputRing().consumed(riskId) << ", engine log: " << e->getOutputRing().consumed(engineLogId);
+    submitAll(2000, 2100);
+    e->stopConsumerThreads();
+    const auto& reportLog = e->getOrderProcessingReportLog();
+    const auto& referenceLog = s->getOrderProcessingReportLog();
+    bool sameReports = reportLog.size() == referenceLog.size() && journal.size() == referenceLog.size();
+    uint64_t referenceFilledQuantity = 0;
+    for (size_t i = 0; sameReports && i < reportLog.size(); ++i) {
+        sameReports &= reportLog[i]->orderId == referenceLog[i]->orderId && journal[i] == referenceLog[i]->orderId;
+        if (const auto& fill = std::dynamic_pointer_cast<const Exchange::OrderExecutionReport>(referenceLog[i]))
+            referenceFilledQuantity += fill->filledQuantity;
+    }
+    *e->getLogger() << "Stopped - published: " << e->getOutputRing().published() << ", running: " << e->isConsumerThreadsRunning();
+    *e->getLogger() << "Reports in the engine log and journal match the synchronous engine: " << sameReports;
+    *e->getLogger() << "Risk reports: " << numRiskReports << ", filled quantity: " << riskFilledQuantity << " vs synchronous engine: " << referenceFilledQuantity;
+    *e->getLogger() << "Acks: " << numAcks << ", acks ahead of the journal: " << numAcksAheadOfJournal;
+    *e->getLogger() << "Order book state:\n" << *e;
+    e->stateConsistencyCheck();
+    // the ring lets go of the payloads every consumer is past, rather than keeping them alive until the slots are reused
+    {
+        Utils::Concurrency::SpmcDisruptorRing<std::shared_ptr<const int>> ring(8);
+        size_t numHandled = 0;
+        ring.add_consumer([&](const std::shared_ptr<const int>&) { ++numHandled; });
+        ring.start();
+        std::vector<std::weak_ptr<const int>> payloads;
+        auto publishOne = [&](const int value) {
+            auto payload = std::make_shared<const int>(value);
+            payloads.push_back(payload);
+            ring.publish(std::move(payload));
+        };
+        for (int i = 0; i < 5; ++i)
+            publishOne(i);
+        ring.flush();
+        publishOne(5);
+        const size_t numAliveBeforeStop = std::count_if(payloads.begin(), payloads.end(), [](const auto& payload) { return !payload.expired(); });
+        ring.stop();
+        const size_t numAliveAfterStop = std::count_if(payloads.begin(), payloads.end(), [](const auto& payload) { return !payload.expired(); });
+        *e->getLogger() << "Ring payloads alive once consumed: " << numAliveBeforeStop << ", after stop: " << numAliveAfterStop << ", handled: " << numHandled;
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEvent.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineFork";
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    auto& config = e->getOrderBookDisplayConfig();
+    config.setAggregateOrderBook(false);
+    config.setShowOrderLookup(false);
+    // initial book state
+    for (int i = 0; i < 10; ++i) {
+        em.submitLimitOrderEvent(Market::Side::BUY, 5 + i, 99.0 - i);
+        em.submitLimitOrderEvent(Market::Side::SELL, 5 + i, 101.0 + i);
+        em.submitLimitOrderEvent(Market::Side::SELL, 2, 101.0 + i);
+    }
+    const uint64_t parentHash = e->getBookStateHash();
+    *em.getLogger() << "Parent order book state:\n" << *e;
+    // what-if evaluation on a fork: sweep the ask book, cancel and modify orders owned by the parent
+    const auto f = std::dynamic_pointer_cast<Exchange::MatchingEngineFIFO>(e->fork());
+    f->setLogger(em.getLogger());
+    f->setOrderBookDisplayConfig(config);
+    *em.getLogger() << "Fork is fork: " << f->isFork() << ", trade log size: " << f->getTradeLog().size() << ", event log size: " << f->getOrderEventLog().size();
+    f->process(std::make_shared<Market::LimitOrder>(1000, 0, Market::Side::BUY, 20, 102.0));
+    f->process(std::make_shared<Market::MarketOrder>(1001, 0, Market::Side::SELL, 8));
+    f->process(std::make_shared<const Market::OrderCancelEvent>(2000, 9, 0)); // buy 8 at 96.0
+    f->process(std::make_shared<const Market::OrderModifyPriceEvent>(2001, 12, 0, 95.5)); // buy 9 at 95.0
+    f->process(std::make_shared<const Market::OrderModifyQuantityEvent>(2002, 15, 0, 1)); // buy 10 at 94.0
+    *em.getLogger() << "Fork materialized bid levels: " << f->getBidBook().size() << " of " << f->getNumberOfBidPriceLevels()
+        << ", ask levels: " << f->getAskBook().size() << " of " << f->getNumberOfAskPriceLevels();
+    *em.getLogger() << "Fork order book state:\n" << *f;
+    f->stateConsistencyCheck();
+    *em.getLogger() << "Fork book state hash consistent: " << (f->getBookStateHash() == f->computeBookStateHash());
+    // the parent must be left untouched by the fork
+    e->stateConsistencyCheck();
+    *em.getLogger() << "Parent book state hash unchanged: " << (e->getBookStateHash() == parentHash);
+    *em.getLogger() << "Parent order book state:\n" << *e;
+    // a fork with logs carries over the parent history
+    const auto g = std::dynamic_pointer_cast<Exchange::MatchingEngineFIFO>(e->fork(true));
+    *em.getLogger() << "Fork with logs event log size: " << g->getOrderEventLog().size() << " vs parent: " << e->getOrderEventLog().size();
+    // levels far apart in price, whose 32-bit integer prices would collide, are materialized independently
+    std::shared_ptr<Exchange::MatchingEngineFIFO> h = std::make_shared<Exchange::MatchingEngineFIFO>();
+    h->process(std::make_shared<Market::LimitOrder>(1, 0, Market::Side::BUY, 5, 10737419.24));
+    h->process(std::make_shared<Market::LimitOrder>(2, 0, Market::Side::BUY, 7, 1.0));
+    const auto k = std::dynamic_pointer_cast<Exchange::MatchingEngineFIFO>(h->fork());
+    k->process(std::make_shared<const Market::OrderCancelEvent>(3, 1, 0));
+    const auto topOrder = k->getBestBidTopOrder();
+    *em.getLogger() << "High price fork best bid: " << topOrder.first << ", top order id: " << (topOrder.second ? topOrder.second->getId() : 0)
+        << ", materialized bid levels: " << k->getBidBook().size() << " of " << k->getNumberOfBidPriceLevels();
+    k->stateConsistencyCheck();
+    // the fork shares the ladder blocks with the parent and copies a block only upon its first write, leaving the parent depth untouched
+    const uint64_t parentBidDepth = e->getBidDepthWithinTicks(1000);
+    const auto m = std::dynamic_pointer_cast<Exchange::MatchingEngineFIFO>(e->fork());
+    m->process(std::make_shared<Market::MarketOrder>(3000, 0, Market::Side::SELL, 30));
+    *em.getLogger() << "Fork bid depth: " << m->getBidDepthWithinTicks(1000) << ", parent bid depth: " << e->getBidDepthWithinTicks(1000)
+        << " (before the fork: " << parentBidDepth << "), high price fork bid depth: " << k->getBidPriceLadder().getTotalSize()
+        << " vs parent: " << h->getBidPriceLadder().getTotalSize();
+    return 0;
+}
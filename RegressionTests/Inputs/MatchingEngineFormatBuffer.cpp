@@ -0,0 +1,65 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineFormatBuffer";
+
+int main() {
+    using Utils::operator<<;
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    const auto& logger = em.getLogger();
+    // the buffer writes what a default std::ostream writes
+    const std::vector<double> doubles = {0.0, -0.0, 1.0, 99.99, 100.0 / 3.0, 123456.0, 1234567.0, 1e-5, 1.5e-7, -2.5e300,
+        Utils::Consts::NAN_DOUBLE, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+    size_t numSame = 0;
+    for (const double value : doubles) {
+        std::ostringstream oss;
+        oss << value << "|" << std::fixed << std::setprecision(2) << value << "|" << std::setprecision(4) << value;
+        Utils::Format::FormatBuffer buffer;
+        buffer << value << "|" << Utils::Format::fixed(value, 2) << "|" << Utils::Format::fixed(value, 4);
+        numSame += oss.str() == buffer.view();
+        *logger << buffer.view();
+    }
+    *logger << "Doubles as std::ostream writes them: " << numSame << " of " << doubles.size();
+    {
+        std::ostringstream oss;
+        oss << -42 << "," << uint64_t(18446744073709551615ull) << "," << true << "," << 'x' << "," << static_cast<uint8_t>('y') << ","
+            << Market::Side::BUY << "," << std::string("str") << "," << std::setw(8) << 123 << "," << std::setw(8) << ""
+            << "," << std::setfill('0') << std::setw(3) << 7 << "," << std::setw(2) << 1234;
+        Utils::Format::FormatBuffer buffer(4);
+        buffer << -42 << "," << uint64_t(18446744073709551615ull) << "," << true << "," << 'x' << "," << static_cast<uint8_t>('y') << ","
+            << Market::Side::BUY << "," << std::string("str") << "," << Utils::Format::aligned(123, 8) << "," << Utils::Format::aligned("", 8)
+            << "," << Utils::Format::aligned(7, 3, '0') << "," << Utils::Format::aligned(1234, 2);
+        *logger << buffer.view() << " - as std::ostream writes it: " << (oss.str() == buffer.view()) << ", grown from 4: " << (buffer.capacity() > 4);
+        const size_t capacity = buffer.capacity();
+        buffer.clear();
+        buffer << "reused";
+        *logger << "Cleared and reused: " << buffer.str() << ", capacity kept: " << (buffer.capacity() == capacity);
+    }
+    {
+        // nested scoped buffers each take their own storage
+        Utils::Format::ScopedFormatBuffer outer;
+        outer << "outer[";
+        const std::string inner = [] {
+            Utils::Format::ScopedFormatBuffer buffer;
+            buffer << "inner," << Utils::Format::fixed(1.005, 2);
+            return buffer.str();
+        }();
+        outer << inner << "]";
+        *logger << "Nested scoped buffers: " << outer.str();
+    }
+    // the serializers routed through the buffer
+    em.submitLimitOrderEvent(Market::Side::BUY, 10, 99.5);
+    em.submitLimitOrderEvent(Market::Side::SELL, 10, 100.25);
+    em.submitMarketOrderEvent(Market::Side::BUY, 4);
+    for (const auto& message : e->getITCHMessageLog())
+        if (message)
+            *logger << message->toString();
+    for (const auto& report : e->getOrderProcessingReportLog())
+        if (report)
+            *logger << report->getAsJson();
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+#include "Exchange/MatchingEngineGateway.hpp"
+
+const std::string TEST_NAME = "MatchingEngineGateway";
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e}; // only used for logging, the gateway is the only entry to the engine
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    auto& config = e->getOrderBookDisplayConfig();
+    config.setAggregateOrderBook(false);
+    config.setShowOrderLookup(false);
+    Exchange::MatchingEngineGateway gateway{e, 64};
+    gateway.setMaxBatchSize(8);
+    auto logReports = [&em](const std::string& label, Exchange::MatchingEngineGateway::Session& session) {
+        *em.getLogger() << label << " (session " << session.getSessionId() << ", processed " << session.getNumProcessed()
+            << ", rejected " << session.getNumRejected() << "):";
+        std::shared_ptr<const Exchange::OrderProcessingReport> report;
+        while (session.pollReport(report))
+            *em.getLogger() << *report;
+    };
+    // deterministic run on the calling thread: each session only hears about its own orders
+    const auto maker = gateway.openSession();
+    const auto taker = gateway.openSession();
+    for (int i = 0; i < 3; ++i) {
+        maker->submitLimitOrder(Market::Side::BUY, 5 + i, 99.0 - i);
+        maker->submitLimitOrder(Market::Side::SELL, 5 + i, 101.0 + i);
+    }
+    maker->flush();
+    *em.getLogger() << "Ingress queue capacity: " << gateway.getIngressQueue().capacity() << ", processed: " << gateway.getNumProcessed()
+        << ", batches: " << gateway.getNumBatches();
+    logReports("Maker acks", *maker);
+    taker->submitMarketOrder(Market::Side::BUY, 8);
+    taker->cancelOrder(0); // owned by the maker, rejected at the gateway
+    taker->submitLimitOrder(Market::Side::SELL, 4, 98.5);
+    taker->flush();
+    logReports("Taker acks", *taker);
+    logReports("Maker fills", *maker);
+    maker->modifyOrderPrice(2, 98.5);
+    maker->cancelOrder(4);
+    maker->flush();
+    logReports("Maker modify and cancel", *maker);
+    *em.getLogger() << "Order book state:\n" << *e;
+    *em.getLogger() << "Gateway rejected: " << gateway.getNumRejected();
+    // the filled and cancelled orders are no longer owned, and a submission must not take over a live order of another session
+    *em.getLogger() << "Owned orders: " << gateway.getNumOwnedOrders() << ", resting orders: " << e->getLimitOrderLookup().size();
+    const auto takeover = std::make_shared<Market::LimitOrder>(0, 0, Market::Side::SELL, 1, 99.0);
+    taker->submit(std::make_shared<const Market::OrderSubmitEvent>(1000, takeover->getId(), 0, takeover));
+    taker->flush();
+    logReports("Taker submission of a live order id", *taker);
+    *em.getLogger() << "Gateway rejected: " << gateway.getNumRejected() << ", best bid size: " << e->getBestBidSize();
+    // many producer threads against the matching thread
+    constexpr int numProducers = 4;
+    constexpr int numOrdersPerProducer = 2000;
+    std::vector<std::shared_ptr<Exchange::MatchingEngineGateway::Session>> sessions;
+    for (int p = 0; p < numProducers; ++p)
+        sessions.push_back(gateway.openSession());
+    std::vector<size_t> numSubmitAcks(numProducers, 0), numForeignReports(numProducers, 0);
+    std::vector<std::set<uint64_t>> ownOrderIds(numProducers);
+    const uint64_t numProcessedBefore = gateway.getNumProcessed();
+    gateway.start();
+    std::vector<std::thread> producers;
+    for (int p = 0; p < numProducers; ++p) {
+        producers.emplace_back([&, p]() {
+            auto& session = *sessions[p];
+            std::shared_ptr<const Exchange::OrderProcessingReport> report;
+            auto pollAll = [&]() {
+                while (session.pollReport(report)) {
+                    if (!ownOrderIds[p].count(report->orderId))
+                        ++numForeignReports[p];
+                    else if (report->orderProcessingType == Exchange::OrderProcessingType::SUBMIT)
+                        ++numSubmitAcks[p];
+                }
+            };
+            for (int i = 0; i < numOrdersPerProducer; ++i) {
+                const auto side = (i + p) % 2 ? Market::Side::BUY : Market::Side::SELL;
+                const double price = side == Market::Side::BUY ? 99.0 + 0.01 * (i % 150) : 101.0 - 0.01 * (i % 150);
+                const auto event = session.submitLimitOrder(side, 1 + i % 7, price);
+                ownOrderIds[p].insert(event->getOrderId());
+                if (i % 10 == 9)
+                    session.cancelOrder(event->getOrderId());
+                if (i % 100 == 0)
+                    pollAll();
+            }
+            session.flush();
+            pollAll();
+        });
+    }
+    for (auto& producer : producers)
+        producer.join();
+    gateway.stop();
+    bool routed = true, acked = true;
+    uint64_t numSubmitted = 0;
+    for (int p = 0; p < numProducers; ++p) {
+        routed &= numForeignReports[p] == 0;
+        acked &= numSubmitAcks[p] == numOrdersPerProducer;
+        numSubmitted += sessions[p]->getNumSubmitted();
+    }
+    *em.getLogger() << "Producers: " << numProducers << ", submitted: " << numSubmitted << ", processed: " << gateway.getNumProcessed() - numProcessedBefore
+        << ", running after stop: " << gateway.isRunning();
+    *em.getLogger() << "Every report routed to its owner: " << routed << ", every submit acknowledged: " << acked;
+    *em.getLogger() << "Batches within the max batch size: " << (gateway.getNumBatches() * gateway.getMaxBatchSize() >= gateway.getNumProcessed());
+    e->stateConsistencyCheck();
+    *em.getLogger() << "Engine state consistent after the concurrent run, sessions: " << gateway.getNumSessions();
+    *em.getLogger() << "Owned orders match the live orders: " << (gateway.getNumOwnedOrders() == e->getLimitOrderLookup().size() + e->getMarketQueue().size());
+    // many producer threads flushing without the matching thread take turns to drain the ingress queue
+    producers.clear();
+    const uint64_t numProcessedBeforeInline = gateway.getNumProcessed();
+    for (int p = 0; p < numProducers; ++p) {
+        producers.emplace_back([&, p]() {
+            auto& session = *sessions[p];
+            for (int i = 0; i < numOrdersPerProducer / 4; ++i) {
+                const auto event = session.submitLimitOrder((i + p) % 2 ? Market::Side::BUY : Market::Side::SELL, 1 + i % 5, 100.0 + 0.01 * (i % 21 - 10));
+                if (i % 3 == 2)
+                    session.cancelOrder(event->getOrderId());
+                if (i % 5 == 4) // without the matching thread the producers must drain before the ingress queue fills up
+                    session.flush();
+            }
+            session.flush();
+        });
+    }
+    for (auto& producer : producers)
+        producer.join();
+    e->stateConsistencyCheck();
+    *em.getLogger() << "Inline drains processed: " << gateway.getNumProcessed() - numProcessedBeforeInline << ", running: " << gateway.isRunning()
+        << ", owned orders match the live orders: " << (gateway.getNumOwnedOrders() == e->getLimitOrderLookup().size() + e->getMarketQueue().size());
+    // a session that outlives its gateway is closed and throws rather than reaching into the destroyed gateway
+    std::shared_ptr<Exchange::MatchingEngineGateway::Session> orphan;
+    {
+        Exchange::MatchingEngineGateway shortLived(std::make_shared<Exchange::MatchingEngineFIFO>());
+        orphan = shortLived.openSession();
+        orphan->submitLimitOrder(Market::Side::BUY, 1, 99.0);
+        orphan->flush();
+    }
+    bool orphanThrew = false;
+    try {
+        orphan->submitLimitOrder(Market::Side::BUY, 1, 99.0);
+    } catch (const Utils::Error::LibException& ex) {
+        orphanThrew = true;
+        *em.getLogger() << "Orphaned session: " << ex.what();
+    }
+    *em.getLogger() << "Orphaned session closed: " << orphan->isClosed() << ", threw: " << orphanThrew << ", submitted: " << orphan->getNumSubmitted()
+        << ", processed: " << orphan->getNumProcessed();
+    return 0;
+}
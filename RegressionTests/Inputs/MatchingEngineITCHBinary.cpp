@@ -0,0 +1,82 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineITCHBinary";
+
+int main() {
+    using Exchange::ITCHEncoder;
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    auto toHex = [](const uint8_t* bytes, const size_t numBytes) {
+        std::ostringstream oss;
+        oss << std::hex << std::setfill('0');
+        for (size_t i = 0; i < numBytes; ++i)
+            oss << (i ? " " : "") << std::setw(2) << static_cast<int>(bytes[i]);
+        return oss.str();
+    };
+    // one message of each type, every field distinct enough to be spotted in the dump
+    const char symbol[8] = "AAPL";
+    const char mpid[4] = {'M', 'P', 'I', 'D'};
+    const std::vector<std::shared_ptr<const ITCHEncoder::ITCHMessage>> messages{
+        std::make_shared<ITCHEncoder::ITCHSystemMessage>(1, 0x010203040506, ITCHEncoder::EventCode::MARKET_OPEN),
+        std::make_shared<ITCHEncoder::ITCHOrderAddMessage>(2, 1000, 7, symbol, 0x1122334455667788, true, 300, 1234500),
+        std::make_shared<ITCHEncoder::ITCHOrderAddWithMPIDMessage>(3, 1001, 7, symbol, 42, false, 100, 1235000, mpid),
+        std::make_shared<ITCHEncoder::ITCHOrderExecuteMessage>(4, 1002, 7, 42, 43, 50),
+        std::make_shared<ITCHEncoder::ITCHOrderExecuteWithPriceMessage>(5, 1003, 7, 42, 44, 25, 1235000),
+        std::make_shared<ITCHEncoder::ITCHOrderDeleteMessage>(6, 1004, 7, 42),
+        std::make_shared<ITCHEncoder::ITCHOrderCancelMessage>(7, 1005, 7, 42, 10),
+        std::make_shared<ITCHEncoder::ITCHOrderReplaceMessage>(8, 1006, 7, 42, 45, 80, 1236000),
+        std::make_shared<ITCHEncoder::ITCHTradeMessage>(9, 1007, 7, 46, 42, 5, 1235000),
+        std::make_shared<ITCHEncoder::ITCHCrossTradeMessage>(10, 1008, symbol, 5000, 1234000, ITCHEncoder::CrossCode::OPENING),
+        std::make_shared<ITCHEncoder::ITCHBrokenTradeMessage>(0x10011, 0x1FFFFFFFFFFFF, 99),
+    };
+    std::array<uint8_t, ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE + ITCHEncoder::MAX_BINARY_MESSAGE_SIZE> slot{};
+    *em.getLogger() << "Binary ITCH 5.0 layouts (length prefix, type, stock locate, tracking number, timestamp, body):";
+    for (const auto& message : messages) {
+        const size_t n = message->toBinary(slot.data(), slot.size());
+        *em.getLogger() << message->toString() << " -> " << n << " bytes, " << message->getBinarySize() << " after the prefix: " << toHex(slot.data(), n);
+    }
+    *em.getLogger() << "Trade message into a buffer one byte short: " << messages[8]->toBinary(slot.data(), ITCHEncoder::ITCHTradeMessage::ourBinarySize + 1)
+        << ", into a null buffer: " << messages[0]->toBinary(nullptr, 64);
+    // the ITCH log of an engine session, written back to back into a fixed buffer
+    for (int i = 0; i < 50; ++i) {
+        em.submitLimitOrderEvent(Market::Side::BUY, 1 + i % 5, 99.0 - 0.01 * (i % 10));
+        em.submitLimitOrderEvent(Market::Side::SELL, 1 + i % 5, 101.0 + 0.01 * (i % 10));
+    }
+    for (int i = 0; i < 10; ++i) {
+        em.submitMarketOrderEvent(i % 2 ? Market::Side::BUY : Market::Side::SELL, 4);
+        em.cancelOrder(60 + 2 * i);
+        em.cancelAndReplaceOrder(61 + 2 * i, std::nullopt, 98.5);
+    }
+    const auto& itchLog = e->getITCHMessageLog();
+    size_t numMessages = 0, numTextBytes = 0, numExpectedBytes = 0;
+    for (const auto& message : itchLog) {
+        if (!message)
+            continue;
+        ++numMessages;
+        numTextBytes += message->toString().size() + 1; // newline-delimited
+        numExpectedBytes += ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE + message->getBinarySize();
+    }
+    std::vector<uint8_t> buffer(1 << 16);
+    size_t numEncoded = 0;
+    const size_t numBytes = ITCHEncoder::encodeBinary(itchLog, buffer.data(), buffer.size(), numEncoded);
+    *em.getLogger() << "Session messages: " << numMessages << ", encoded: " << numEncoded << ", binary bytes: " << numBytes
+        << ", as expected from the layouts: " << (numBytes == numExpectedBytes) << ", text bytes: " << numTextBytes;
+    // walk the frames back by their length prefixes
+    std::map<char, size_t> numByType;
+    for (size_t offset = 0; offset < numBytes;) {
+        const size_t length = (static_cast<size_t>(buffer[offset]) << 8) | buffer[offset + 1];
+        ++numByType[static_cast<char>(buffer[offset + 2])];
+        offset += ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE + length;
+    }
+    std::ostringstream oss;
+    for (const auto& [type, count] : numByType)
+        oss << type << "=" << count << " ";
+    *em.getLogger() << "Frames by type: " << oss.str();
+    const size_t numPartialBytes = ITCHEncoder::encodeBinary(itchLog, buffer.data(), 500, numEncoded);
+    *em.getLogger() << "Into a 500-byte buffer: " << numEncoded << " messages, " << numPartialBytes << " bytes";
+    return 0;
+}
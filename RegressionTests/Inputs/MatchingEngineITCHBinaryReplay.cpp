@@ -0,0 +1,119 @@
+#include <filesystem>
+#include <fstream>
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineITCHBinaryReplay";
+
+int main() {
+    using Exchange::ITCHDecoder;
+    using Exchange::ITCHEncoder;
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    const auto& logger = em.getLogger();
+    for (int i = 0; i < 300; ++i) {
+        em.submitLimitOrderEvent(Market::Side::BUY, 1 + i % 7, 99.0 - 0.01 * (i % 25));
+        em.submitLimitOrderEvent(Market::Side::SELL, 1 + i % 7, 101.0 + 0.01 * (i % 25));
+    }
+    for (int i = 0; i < 40; ++i) {
+        em.cancelOrder(100 + 3 * i);
+        em.modifyOrderQuantity(101 + 3 * i, 1);
+        em.cancelAndReplaceOrder(102 + 3 * i, 2, 98.5);
+    }
+    for (uint64_t id = 400; id < 440; ++id)
+        em.partialCancelOrder(id, 1);
+    // the binary stream of the session
+    const auto& itchLog = e->getITCHMessageLog();
+    std::vector<uint8_t> bytes(1 << 16);
+    size_t numEncoded = 0;
+    bytes.resize(ITCHEncoder::encodeBinary(itchLog, bytes.data(), bytes.size(), numEncoded));
+    *logger << "Encoded messages: " << numEncoded << ", bytes: " << bytes.size();
+    // views of the first frames, decoded in place
+    ITCHDecoder::BinaryStreamDecoder decoder;
+    std::ostringstream oss;
+    decoder.decode(bytes.data(), 120, [&oss](const auto& message) {
+        using View = std::decay_t<decltype(message)>;
+        oss << message.getType() << " tracking " << message.getTrackingNumber() << " at " << message.getTimestamp();
+        if constexpr (std::is_base_of_v<ITCHDecoder::ITCHOrderAddView, View>)
+            oss << ": order " << message.getOrderId() << (message.isBuy() ? " B " : " S ") << message.getQuantity() << "@" << message.getPrice()
+                << " [" << message.getSymbol() << "]";
+        oss << "; ";
+    });
+    *logger << "First frames: " << oss.str() << "frame cut at 120 bytes carried over: " << decoder.hasPartialFrame();
+    // the message-log replay is the reference
+    std::shared_ptr<Exchange::MatchingEngineFIFO> reference = std::make_shared<Exchange::MatchingEngineFIFO>();
+    reference->build(itchLog);
+    auto compare = [&](const std::string& label, const std::shared_ptr<Exchange::MatchingEngineFIFO>& replayed, const uint64_t numDecoded) {
+        *logger << label << " - decoded: " << numDecoded << ", events: " << replayed->getOrderEventLog().size()
+            << ", same book as the message log replay: " << (replayed->getBookStateHash() == reference->getBookStateHash())
+            << ", resting orders: " << replayed->getLimitOrderLookup().size();
+        replayed->stateConsistencyCheck();
+    };
+    *logger << "Message log replay - events: " << reference->getOrderEventLog().size();
+    {
+        std::shared_ptr<Exchange::MatchingEngineFIFO> r = std::make_shared<Exchange::MatchingEngineFIFO>();
+        compare("Single span", r, r->buildFromITCHBinary({bytes}));
+    }
+    {
+        // chunks of 1 to 13 bytes, so that frames and length prefixes are cut everywhere
+        std::vector<std::span<const uint8_t>> chunks;
+        for (size_t offset = 0, n = 1; offset < bytes.size(); offset += n, n = n % 13 + 1)
+            chunks.emplace_back(bytes.data() + offset, std::min(n, bytes.size() - offset));
+        std::shared_ptr<Exchange::MatchingEngineFIFO> r = std::make_shared<Exchange::MatchingEngineFIFO>();
+        compare(std::to_string(chunks.size()) + " small chunks", r, r->buildFromITCHBinary(chunks));
+    }
+    {
+        // foreign frames in between - a stock directory message and a frame longer than any ITCH message, cut across chunks
+        std::vector<uint8_t> directory(2 + 39, ' '), oversized(2 + 100, 0);
+        directory[0] = 0;
+        directory[1] = 39;
+        directory[2] = 'R';
+        oversized[1] = 100;
+        oversized[2] = 'Z';
+        size_t boundary = 0;
+        while (boundary < 1000)
+            boundary += ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE + ITCHDecoder::getBinary(bytes.data() + boundary, ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE);
+        std::vector<uint8_t> mixed(bytes.begin(), bytes.begin() + boundary);
+        mixed.insert(mixed.end(), directory.begin(), directory.end());
+        mixed.insert(mixed.end(), oversized.begin(), oversized.end());
+        mixed.insert(mixed.end(), bytes.begin() + boundary, bytes.end());
+        ITCHDecoder::BinaryStreamDecoder counter;
+        size_t numVisited = 0;
+        for (size_t offset = 0; offset < mixed.size(); offset += 50)
+            numVisited += counter.decode(mixed.data() + offset, std::min<size_t>(50, mixed.size() - offset), [](const auto&) {});
+        *logger << "Foreign frames - visited: " << numVisited << ", skipped: " << counter.getNumSkipped() << ", bytes: " << counter.getNumBytes()
+            << ", partial frame left: " << counter.hasPartialFrame();
+        std::shared_ptr<Exchange::MatchingEngineFIFO> r = std::make_shared<Exchange::MatchingEngineFIFO>();
+        compare("Foreign frames", r, r->buildFromITCHBinary({mixed}));
+    }
+    {
+        const std::string filePath = (std::filesystem::temp_directory_path() / (TEST_NAME + ".itch")).string();
+        std::ofstream(filePath, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        std::shared_ptr<Exchange::MatchingEngineFIFO> r = std::make_shared<Exchange::MatchingEngineFIFO>();
+        compare("Mapped file", r, r->buildFromITCHBinaryFile(filePath));
+        std::filesystem::remove(filePath);
+    }
+    try {
+        std::shared_ptr<Exchange::MatchingEngineFIFO> r = std::make_shared<Exchange::MatchingEngineFIFO>();
+        r->buildFromITCHBinary({std::span<const uint8_t>(bytes.data(), bytes.size() - 3)});
+    } catch (const std::exception& ex) {
+        *logger << "Truncated stream rejected: " << ex.what();
+    }
+    try {
+        const std::vector<uint8_t> shortFrame{0, 20, 'A', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+        std::shared_ptr<Exchange::MatchingEngineFIFO> r = std::make_shared<Exchange::MatchingEngineFIFO>();
+        r->buildFromITCHBinary({shortFrame});
+    } catch (const std::exception& ex) {
+        *logger << "Short frame rejected: " << ex.what();
+    }
+    try {
+        std::shared_ptr<Exchange::MatchingEngineFIFO> r = std::make_shared<Exchange::MatchingEngineFIFO>();
+        r->buildFromITCHBinaryFile("/nonexistent/" + TEST_NAME + ".itch");
+    } catch (const std::exception& ex) {
+        *logger << "Missing file rejected: " << (std::string(ex.what()).find("Cannot open file") != std::string::npos);
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <filesystem>
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+#include "Exchange/ITCHJournal.hpp"
+
+const std::string TEST_NAME = "MatchingEngineITCHJournal";
+
+int main() {
+    using Exchange::ITCHEncoder;
+    using Exchange::ITCHJournalConfig;
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    const auto& logger = em.getLogger();
+    const auto directory = std::filesystem::temp_directory_path() / TEST_NAME;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    // the books never cross, so the orders submitted in a session stay live until it cancels them
+    auto runSession = [](Market::OrderEventManagerBase& m, const int numOrders) {
+        std::vector<std::shared_ptr<const Market::OrderSubmitEvent>> liveOrders;
+        for (int i = 0; i < numOrders; ++i) {
+            const Market::Side side = i % 2 ? Market::Side::BUY : Market::Side::SELL;
+            if (i % 11 == 0 && !liveOrders.empty()) {
+                const size_t k = i % liveOrders.size();
+                m.cancelOrder(liveOrders[k]->getOrderId());
+                liveOrders[k] = liveOrders.back();
+                liveOrders.pop_back();
+            } else if (i % 13 == 0 && !liveOrders.empty()) {
+                const auto& order = liveOrders[i % liveOrders.size()]->getOrder();
+                m.modifyOrderPrice(order->getId(), order->getSide() == Market::Side::BUY ? 98.0 : 102.0);
+            } else
+                liveOrders.push_back(m.submitLimitOrderEvent(side, 1 + i % 5, side == Market::Side::BUY ? 99.0 - 0.01 * (i % 30) : 101.0 + 0.01 * (i % 30)));
+        }
+    };
+    // a small pair of buffers and files, so that both the hand-offs and the rotation happen many times over
+    ITCHJournalConfig config;
+    config.filePath = (directory / "session.itch").string();
+    config.bufferSize = 4096;
+    config.maxFileSize = 16384;
+    config.syncPolicy = ITCHJournalConfig::SyncPolicy::ON_ROTATE;
+    auto journal = std::make_unique<Exchange::ITCHJournalWriter>(config);
+    journal->attach(e);
+    *logger << "Journal open: " << journal->isOpen() << ", attached: " << journal->isAttached() << ", sync policy: "
+        << Utils::EnumStrings<ITCHJournalConfig::SyncPolicy>::names[static_cast<size_t>(journal->getConfig().syncPolicy)];
+    runSession(em, 1000);
+    journal->flush();
+    *logger << "After a flush - messages: " << journal->getNumMessages() << ", encoded: " << journal->getNumBytesEncoded()
+        << ", written: " << journal->getNumBytesWritten() << ", on disk: " << (journal->getNumBytesWritten() == journal->getNumBytesEncoded());
+    runSession(em, 1000);
+    journal->close();
+    const auto filePaths = journal->getFilePaths();
+    // the journal holds exactly the binary encoding of the engine log
+    const auto& itchLog = e->getITCHMessageLog();
+    std::vector<uint8_t> expected(1 << 20);
+    size_t numEncoded = 0;
+    expected.resize(ITCHEncoder::encodeBinary(itchLog, expected.data(), expected.size(), numEncoded));
+    std::vector<uint8_t> journaled;
+    bool withinMaxSize = true;
+    for (const auto& filePath : filePaths) {
+        const Utils::IO::MappedFile file(filePath);
+        withinMaxSize = withinMaxSize && file.getSize() <= config.maxFileSize;
+        journaled.insert(journaled.end(), file.getData(), file.getData() + file.getSize());
+    }
+    *logger << "Closed - open: " << journal->isOpen() << ", attached: " << journal->isAttached() << ", messages: " << journal->getNumMessages()
+        << " of " << numEncoded << ", bytes: " << journaled.size() << ", same bytes as encodeBinary: " << (journaled == expected);
+    *logger << "Files: " << filePaths.size() << ", each within " << config.maxFileSize << " bytes: " << withinMaxSize << ", last: "
+        << std::filesystem::path(filePaths.back()).filename().string() << ", buffers written: " << (journal->getNumBuffersWritten() >= filePaths.size());
+    // each file decodes on its own, and replaying them in order rebuilds the book of the message log
+    std::shared_ptr<Exchange::MatchingEngineFIFO> reference = std::make_shared<Exchange::MatchingEngineFIFO>();
+    reference->build(itchLog);
+    std::shared_ptr<Exchange::MatchingEngineFIFO> replayed = std::make_shared<Exchange::MatchingEngineFIFO>();
+    uint64_t numDecoded = 0;
+    for (const auto& filePath : filePaths)
+        numDecoded += replayed->buildFromITCHBinaryFile(filePath);
+    *logger << "Replayed file by file - decoded: " << numDecoded << ", same book as the message log replay: "
+        << (replayed->getBookStateHash() == reference->getBookStateHash());
+    replayed->stateConsistencyCheck();
+    // the log of an engine that ran without a journal, no rotation
+    {
+        std::shared_ptr<Exchange::MatchingEngineFIFO> s = std::make_shared<Exchange::MatchingEngineFIFO>();
+        Market::OrderEventManagerBase sm{s};
+        runSession(sm, 500);
+        Exchange::ITCHJournalWriter offline({(directory / "offline.itch").string(), 1024, 0, ITCHJournalConfig::SyncPolicy::EVERY_BUFFER, {}});
+        offline.write(s->getITCHMessageLog());
+        offline.flush();
+        *logger << "Offline journal - messages: " << offline.getNumMessages() << ", files: " << offline.getFilePaths().size()
+            << ", file size: " << std::filesystem::file_size(offline.getFilePaths().front()) << " of " << offline.getNumBytesEncoded();
+    } // closed on destruction
+    try {
+        Exchange::ITCHJournalWriter tooSmall({(directory / "small.itch").string(), 16, 0, ITCHJournalConfig::SyncPolicy::NONE, {}});
+    } catch (const std::exception& ex) {
+        *logger << "Small buffer rejected: " << ex.what();
+    }
+    try {
+        Exchange::ITCHJournalWriter missing({(directory / "missing" / "session.itch").string(), ITCHJournalConfig::DEFAULT_BUFFER_SIZE, 0,
+            ITCHJournalConfig::SyncPolicy::ON_ROTATE, {}});
+    } catch (const std::exception& ex) {
+        *logger << "Missing directory rejected: " << (std::string(ex.what()).find("Cannot open file") != std::string::npos);
+    }
+    try {
+        journal->write(*itchLog.back());
+    } catch (const std::exception& ex) {
+        *logger << "Write after close rejected: " << ex.what();
+    }
+    std::filesystem::remove_all(directory);
+    return 0;
+}
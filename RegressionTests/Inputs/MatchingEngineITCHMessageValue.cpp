@@ -0,0 +1,126 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineITCHMessageValue";
+
+int main() {
+    using Exchange::ITCHEncoder;
+    auto runSession = [](Market::OrderEventManagerBase& m, const std::shared_ptr<Exchange::MatchingEngineFIFO>& engine) {
+        engine->startAuction(ITCHEncoder::CrossCode::OPENING);
+        m.submitLimitOrderEvent(Market::Side::BUY, 5, 100.0);
+        m.submitLimitOrderEvent(Market::Side::SELL, 3, 99.5);
+        engine->uncrossAuction();
+        auto getRestingOrderId = [&engine](const uint64_t above) {
+            // the lowest resting id above the given one, so that only orders on the book are acted on
+            std::optional<uint64_t> orderId;
+            for (const auto& [id, entry] : engine->getLimitOrderLookup())
+                if (id > above && (!orderId || id < *orderId))
+                    orderId = id;
+            return orderId;
+        };
+        for (int i = 0; i < 200; ++i) {
+            const Market::Side side = i % 2 ? Market::Side::BUY : Market::Side::SELL;
+            const auto orderId = getRestingOrderId(i / 3);
+            if (i % 17 == 0)
+                m.submitMarketOrderEvent(side, 1 + i % 4);
+            else if (i % 11 == 0 && orderId)
+                m.cancelOrder(*orderId);
+            else if (i % 13 == 0 && orderId)
+                m.modifyOrderPrice(*orderId, 100.0 + (i % 2 ? -2.0 : 2.0));
+            else if (i % 7 == 0 && orderId)
+                m.partialCancelOrder(*orderId, 1);
+            else
+                m.submitLimitOrderEvent(side, 1 + i % 5, side == Market::Side::BUY ? 99.0 - 0.01 * (i % 30) : 101.0 + 0.01 * (i % 30));
+        }
+    };
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    const auto& logger = em.getLogger();
+    runSession(em, e);
+    // the same session on an engine that logs the ITCH messages by value, with a subscriber that still gets the polymorphic messages
+    std::shared_ptr<Exchange::MatchingEngineFIFO> c = std::make_shared<Exchange::MatchingEngineFIFO>();
+    c->setCompactITCHMessageLog(true);
+    Market::OrderEventManagerBase cm{c};
+    size_t numSubscribed = 0;
+    std::string subscribedText;
+    c->subscribeITCHMessages([&](const auto& message) {
+        if (message) {
+            ++numSubscribed;
+            subscribedText += message->toString();
+        }
+    });
+    runSession(cm, c);
+    const auto& messageLog = e->getITCHMessageLog();
+    const auto& valueLog = c->getITCHMessageValueLog();
+    size_t numMessages = 0;
+    std::string messageText;
+    for (const auto& message : messageLog)
+        if (message) {
+            ++numMessages;
+            messageText += message->toString();
+        }
+    *logger << "Value size: " << sizeof(ITCHEncoder::ITCHMessageValue) << ", compact mode: " << c->isCompactITCHMessageLog()
+        << ", message log: " << messageLog.size() << " with " << numMessages << " messages, value log: " << valueLog.size()
+        << ", message log in compact mode: " << c->getITCHMessageLog().size() << ", subscribed: " << numSubscribed
+        << ", same text as subscribed: " << (subscribedText == messageText);
+    // every operation of a value agrees with the polymorphic message
+    std::map<std::string, size_t> numByType;
+    size_t numAgreed = 0, index = 0;
+    for (const auto& message : messageLog) {
+        if (!message)
+            continue;
+        const auto& value = valueLog[index++];
+        std::array<uint8_t, ITCHEncoder::BINARY_LENGTH_PREFIX_SIZE + ITCHEncoder::MAX_BINARY_MESSAGE_SIZE> messageBytes{}, valueBytes{};
+        message->toBinary(messageBytes.data(), messageBytes.size());
+        value.toBinary(valueBytes.data(), valueBytes.size());
+        const auto messageEvent = message->makeEvent();
+        const auto valueEvent = value.makeEvent();
+        const bool agreed = value.messageType == message->messageType && value.toString() == message->toString() && valueBytes == messageBytes
+            && value.getBinarySize() == message->getBinarySize() && value.isOrderOperation() == message->isOrderOperation()
+            && value.getOrderId() == message->getOrderId() && value.getMatchOrderId() == message->getMatchOrderId()
+            && (messageEvent ? valueEvent && valueEvent->getAsJson() == messageEvent->getAsJson() : !valueEvent);
+        numAgreed += agreed;
+        ++numByType[Utils::toString(value.messageType)];
+        if (!agreed)
+            *logger << "Disagreement: " << message->toString() << " vs " << value.toString();
+    }
+    *logger << "Values agreeing with the messages: " << numAgreed << " of " << valueLog.size() << ", by type: " << [&numByType] {
+        std::ostringstream oss;
+        for (const auto& [type, count] : numByType)
+            oss << type << "=" << count << " ";
+        return oss.str();
+    }();
+    {
+        std::vector<uint8_t> messageBytes(1 << 16), valueBytes(1 << 16);
+        size_t numMessageEncoded = 0, numValueEncoded = 0;
+        messageBytes.resize(ITCHEncoder::encodeBinary(messageLog, messageBytes.data(), messageBytes.size(), numMessageEncoded));
+        valueBytes.resize(ITCHEncoder::encodeBinary(valueLog, valueBytes.data(), valueBytes.size(), numValueEncoded));
+        *logger << "Binary stream - messages: " << numValueEncoded << " of " << numMessageEncoded << ", same bytes: " << (valueBytes == messageBytes);
+    }
+    // the replay of the value log rebuilds the same book as that of the message log
+    std::shared_ptr<Exchange::MatchingEngineFIFO> fromMessages = std::make_shared<Exchange::MatchingEngineFIFO>();
+    fromMessages->build(messageLog);
+    std::shared_ptr<Exchange::MatchingEngineFIFO> fromValues = std::make_shared<Exchange::MatchingEngineFIFO>();
+    fromValues->build(valueLog);
+    fromValues->stateConsistencyCheck();
+    *logger << "Replayed from the value log - events: " << fromValues->getOrderEventLog().size() << " of " << fromMessages->getOrderEventLog().size()
+        << ", same book: " << (fromValues->getBookStateHash() == fromMessages->getBookStateHash());
+    // the message types the engine does not emit, round-tripped through the value
+    const char mpid[4] = {'M', 'P', 'I', 'D'};
+    const std::vector<std::shared_ptr<ITCHEncoder::ITCHMessage>> others = {
+        std::make_shared<ITCHEncoder::ITCHSystemMessage>(1, 10, ITCHEncoder::EventCode::MARKET_OPEN),
+        std::make_shared<ITCHEncoder::ITCHOrderAddWithMPIDMessage>(2, 11, 7, "ABCDEFGH", 42, false, 100, 1015000, mpid),
+        std::make_shared<ITCHEncoder::ITCHOrderExecuteMessage>(3, 12, 7, 42, 43, 25),
+        std::make_shared<ITCHEncoder::ITCHBrokenTradeMessage>(4, 13, 99)
+    };
+    for (const auto& message : others) {
+        const ITCHEncoder::ITCHMessageValue value(*message);
+        const auto adapter = value.makeMessage();
+        *logger << value.toString() << " - round trip: " << (adapter->toString() == message->toString()) << ", binary size: " << value.getBinarySize()
+            << ", order operation: " << value.isOrderOperation() << ", order id: " << value.getOrderId().value_or(0);
+    }
+    return 0;
+}
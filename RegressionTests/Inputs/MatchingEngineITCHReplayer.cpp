@@ -0,0 +1,177 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+#include "Exchange/ITCHReplayer.hpp"
+
+const std::string TEST_NAME = "MatchingEngineITCHReplayer";
+
+int main() {
+    using Exchange::ITCHEncoder;
+    using Exchange::ITCHExecution;
+    using Exchange::ITCHReplayConfig;
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    const auto& logger = em.getLogger();
+    auto getRestingOrderId = [&e](const uint64_t above) {
+        // the lowest resting id above the given one, so that only orders on the book are acted on
+        std::optional<uint64_t> orderId;
+        for (const auto& [id, entry] : e->getLimitOrderLookup())
+            if (id > above && (!orderId || id < *orderId))
+                orderId = id;
+        return orderId;
+    };
+    // a deep book, so that no market order is left queued, then a flow of every kind of order event
+    for (int i = 0; i < 40; ++i) {
+        em.submitLimitOrderEvent(Market::Side::BUY, 20 + i % 7, 99.0 - 0.05 * (i % 10));
+        em.submitLimitOrderEvent(Market::Side::SELL, 20 + i % 7, 101.0 + 0.05 * (i % 10));
+    }
+    for (int i = 0; i < 400; ++i) {
+        const Market::Side side = i % 2 ? Market::Side::BUY : Market::Side::SELL;
+        const auto orderId = getRestingOrderId(i / 2);
+        if (i % 9 == 0)
+            em.submitMarketOrderEvent(side, 1 + i % 6);
+        else if (i % 23 == 0)
+            em.submitLimitOrderEvent(side, 5 + i % 4, side == Market::Side::BUY ? 101.1 : 98.9); // crosses the spread
+        else if (i % 11 == 0 && orderId)
+            em.cancelOrder(*orderId);
+        else if (i % 13 == 0 && orderId)
+            em.modifyOrderPrice(*orderId, i % 2 ? 98.5 : 101.5);
+        else if (i % 17 == 0 && orderId)
+            em.modifyOrderQuantity(*orderId, 3 + i % 5);
+        else if (i % 7 == 0 && orderId)
+            em.partialCancelOrder(*orderId, 1);
+        else
+            em.submitLimitOrderEvent(side, 1 + i % 5, side == Market::Side::BUY ? 99.5 - 0.01 * (i % 30) : 100.5 + 0.01 * (i % 30));
+    }
+    const auto& messageLog = e->getITCHMessageLog();
+    auto getTrades = [](const Exchange::MatchingEngineBase& engine) {
+        std::vector<std::pair<uint32_t, uint32_t>> trades; // in integer ticks, as ITCH carries the prices
+        for (const auto& trade : engine.getTradeLog())
+            trades.emplace_back(trade->getQuantity(), Utils::Maths::castDoublePriceAsInt<uint32_t>(trade->getPrice()));
+        return trades;
+    };
+    *logger << "Session - trades: " << e->getTradeLog().size() << ", resting orders: " << e->getLimitOrderLookup().size();
+    // the plain build drops the market orders, as their trade messages make no event
+    std::shared_ptr<Exchange::MatchingEngineFIFO> built = std::make_shared<Exchange::MatchingEngineFIFO>();
+    built->build(messageLog);
+    *logger << "Built from the message log - same book: " << (built->getBookStateHash() == e->getBookStateHash()) << ", trades: " << built->getTradeLog().size();
+    // the replayer resolves them against its order reference table
+    std::shared_ptr<Exchange::MatchingEngineFIFO> replayed = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Exchange::ITCHReplayer replayer(replayed);
+    replayer.replay(messageLog);
+    replayed->stateConsistencyCheck();
+    *logger << "Replayed from the message log - messages: " << replayer.getNumMessages() << ", events: " << replayer.getNumEvents()
+        << ", same book: " << (replayed->getBookStateHash() == e->getBookStateHash()) << ", same trades: " << (getTrades(*replayed) == getTrades(*e))
+        << ", unknown orders: " << replayer.getNumUnknownOrders();
+    *logger << "Executions - logged: " << replayer.getExecutionLog().size() << ", implied: " << replayer.getNumExecutions(ITCHExecution::Resolution::IMPLIED)
+        << ", market order: " << replayer.getNumExecutions(ITCHExecution::Resolution::MARKET_ORDER) << ", cancel: "
+        << replayer.getNumExecutions(ITCHExecution::Resolution::CANCEL) << ", off book: " << replayer.getNumExecutions(ITCHExecution::Resolution::OFF_BOOK);
+    {
+        // the table holds exactly the resting orders of the engine
+        const auto& table = replayer.getOrderReferenceTable();
+        size_t numAgreed = 0;
+        table.forEach([&](const auto& entry) {
+            const auto it = e->getLimitOrderLookup().find(entry.orderId);
+            if (it == e->getLimitOrderLookup().end())
+                return;
+            const auto& order = *it->second.second;
+            numAgreed += order->getQuantity() == entry.quantity && order->isBuy() == static_cast<bool>(entry.isBuy) && order->getIntPrice() == entry.price;
+        });
+        *logger << "Order reference table - orders: " << table.size() << ", agreeing with the book: " << numAgreed << ", capacity: " << table.capacity();
+    }
+    // the value log and the binary stream replay to the same book
+    {
+        std::shared_ptr<Exchange::MatchingEngineFIFO> fromValues = std::make_shared<Exchange::MatchingEngineFIFO>();
+        Exchange::ITCHReplayer valueReplayer(fromValues);
+        {
+            Exchange::ITCHMessageValueLog valueLog;
+            for (const auto& message : messageLog)
+                if (message)
+                    valueLog.emplace_back(*message);
+            valueReplayer.replay(valueLog);
+        }
+        std::vector<uint8_t> bytes(1 << 20);
+        size_t numEncoded = 0;
+        bytes.resize(ITCHEncoder::encodeBinary(messageLog, bytes.data(), bytes.size(), numEncoded));
+        std::shared_ptr<Exchange::MatchingEngineFIFO> fromBinary = std::make_shared<Exchange::MatchingEngineFIFO>();
+        Exchange::ITCHReplayer binaryReplayer(fromBinary);
+        const size_t half = bytes.size() / 2 + 7; // cut mid-frame
+        const uint64_t numDecoded = binaryReplayer.replayBinary({std::span<const uint8_t>(bytes.data(), half), std::span<const uint8_t>(bytes.data() + half, bytes.size() - half)});
+        *logger << "Replayed from the value log - same book: " << (fromValues->getBookStateHash() == e->getBookStateHash()) << ", same trades: "
+            << (getTrades(*fromValues) == getTrades(*e)) << "; from the binary stream - decoded: " << numDecoded << " of " << numEncoded
+            << ", same book: " << (fromBinary->getBookStateHash() == e->getBookStateHash()) << ", same trades: " << (getTrades(*fromBinary) == getTrades(*e));
+    }
+    // a venue stream, where a fill is reported once on the resting order and trade messages are off the book
+    {
+        const char symbol[8] = "LIBOB";
+        auto add = [&](const uint64_t id, const bool isBuy, const uint32_t quantity, const uint32_t price) {
+            return std::make_shared<const ITCHEncoder::ITCHOrderAddMessage>(id, id, 1, symbol, id, isBuy, quantity, price);
+        };
+        const Exchange::ITCHMessageLog venueLog = {
+            add(1, true, 100, 990000),
+            add(2, true, 50, 990000),
+            add(3, true, 70, 985000),
+            add(4, false, 80, 1010000),
+            add(5, false, 60, 1015000),
+            std::make_shared<const ITCHEncoder::ITCHOrderExecuteMessage>(6, 6, 1, 1, 9001, 30), // the top of the bids
+            std::make_shared<const ITCHEncoder::ITCHOrderExecuteWithPriceMessage>(7, 7, 1, 2, 9002, 20, 990000), // behind order 1
+            std::make_shared<const ITCHEncoder::ITCHOrderCancelMessage>(8, 8, 1, 3, 20),
+            std::make_shared<const ITCHEncoder::ITCHOrderReplaceMessage>(9, 9, 1, 4, 6, 40, 1007500), // a new reference, the side kept
+            std::make_shared<const ITCHEncoder::ITCHOrderExecuteMessage>(10, 10, 1, 6, 9003, 40),
+            std::make_shared<const ITCHEncoder::ITCHTradeMessage>(11, 11, 1, 0, 9004, 25, 1000000),
+            std::make_shared<const ITCHEncoder::ITCHOrderDeleteMessage>(12, 12, 1, 5),
+            std::make_shared<const ITCHEncoder::ITCHOrderExecuteMessage>(13, 13, 1, 77, 9005, 10) // never added
+        };
+        std::shared_ptr<Exchange::MatchingEngineFIFO> venue = std::make_shared<Exchange::MatchingEngineFIFO>();
+        Exchange::ITCHReplayer venueReplayer(venue, {ITCHReplayConfig::Source::VENUE});
+        venueReplayer.replay(venueLog);
+        venue->stateConsistencyCheck();
+        *logger << "Venue replay - source: " << Utils::EnumStrings<ITCHReplayConfig::Source>::names[static_cast<size_t>(venueReplayer.getConfig().source)]
+            << ", messages: " << venueReplayer.getNumMessages() << ", events: " << venueReplayer.getNumEvents() << ", engine trades: "
+            << venue->getTradeLog().size() << ", unknown orders: " << venueReplayer.getNumUnknownOrders();
+        for (const auto& execution : venueReplayer.getExecutionLog())
+            *logger << "Execution - order: " << execution.orderId << ", match: " << execution.matchNumber << ", " << (execution.isBuy ? "BUY " : "SELL ")
+                << execution.quantity << " @ " << Utils::Maths::castIntPriceAsDouble(execution.price) << ", "
+                << Utils::EnumStrings<ITCHExecution::Resolution>::names[static_cast<size_t>(execution.resolution)];
+        std::vector<std::string> entries;
+        venueReplayer.getOrderReferenceTable().forEach([&entries](const auto& entry) {
+            std::ostringstream oss;
+            oss << entry.orderId << ":" << (entry.isBuy ? "B" : "S") << entry.quantity << "@" << entry.price;
+            entries.push_back(oss.str());
+        });
+        std::sort(entries.begin(), entries.end());
+        *logger << "Venue table: " << Utils::toString(entries) << ", bids: " << Utils::toString(venue->getBidBookSizeVector())
+            << ", asks: " << Utils::toString(venue->getAskBookSizeVector());
+    }
+    // the table under churn - every other order erased, then the rest found and the erased ones not
+    {
+        Exchange::ITCHOrderReferenceTable table(16);
+        std::mt19937_64 rng(42);
+        std::vector<uint64_t> orderIds(100000);
+        for (size_t i = 0; i < orderIds.size(); ++i) {
+            orderIds[i] = i % 3 ? rng() : i; // random and sequential references mixed
+            table.insert(orderIds[i], i % 2, 1 + i % 100, static_cast<uint32_t>(i));
+        }
+        const size_t capacity = table.capacity();
+        for (size_t i = 0; i < orderIds.size(); i += 2)
+            table.erase(orderIds[i]);
+        size_t numFound = 0, numErasedFound = 0;
+        for (size_t i = 0; i < orderIds.size(); ++i) {
+            const auto* entry = table.find(orderIds[i]);
+            if (i % 2 == 0)
+                numErasedFound += entry != nullptr;
+            else
+                numFound += entry && entry->quantity == 1 + i % 100 && entry->price == i && entry->isBuy;
+        }
+        *logger << "Table churn - size: " << table.size() << ", found: " << numFound << ", erased yet found: " << numErasedFound
+            << ", capacity: " << capacity << ", entry size: " << sizeof(Exchange::ITCHOrderReferenceTable::Entry);
+    }
+    try {
+        Exchange::ITCHReplayer nullReplayer(nullptr);
+    } catch (const std::exception& ex) {
+        *logger << "Null engine rejected: " << ex.what();
+    }
+    return 0;
+}
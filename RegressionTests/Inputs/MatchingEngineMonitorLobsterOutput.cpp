@@ -35,6 +35,9 @@ int main() {
                 em.submitMarketOrderEvent(Market::Side::SELL, qty);
         }
     }
+    // modify two orders within the top levels, the price modify is exported as a delete followed by an add
+    em.modifyOrderPrice(2, 98.5);
+    em.modifyOrderQuantity(3, 4);
     // export data in lobster format
     m.exportToLobsterDataParser(p);
     const auto data = p.getOrderBookMessagesAndSnapshotsAsCsv(5, true);
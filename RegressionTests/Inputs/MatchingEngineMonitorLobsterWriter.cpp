@@ -0,0 +1,129 @@
+#include <filesystem>
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+#include "Analytics/MatchingEngineMonitor.hpp"
+#include "Parser/LobsterDataParser.hpp"
+#include "Parser/LobsterDataReader.hpp"
+#include "Parser/LobsterDataWriter.hpp"
+
+const std::string TEST_NAME = "MatchingEngineMonitorLobsterWriter";
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    Analytics::MatchingEngineMonitor m{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    const auto& logger = em.getLogger();
+    const auto directory = std::filesystem::temp_directory_path() / TEST_NAME;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    auto makeConfig = [&directory](const std::string& name) {
+        Parser::LobsterDataWriterConfig config;
+        config.messageFilePath = (directory / (name + "_message.csv")).string();
+        config.orderBookFilePath = (directory / (name + "_orderbook.csv")).string();
+        config.numLevels = 5;
+        config.aligned = true;
+        config.bufferSize = 1 << 12; // small, so that the day is written out in many buffers
+        return config;
+    };
+    auto readFile = [](const std::string& filePath) {
+        std::ifstream file(filePath, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+    // the rows are streamed to the files as the monitor logs them
+    const auto streamConfig = makeConfig("stream");
+    auto writer = std::make_shared<Parser::LobsterDataWriter>(streamConfig);
+    m.setLobsterDataWriter(writer);
+    for (int i = 0; i < 20; ++i) {
+        em.submitLimitOrderEvent(Market::Side::BUY, std::min(5 + i, 10), 99.0 - i);
+        em.submitLimitOrderEvent(Market::Side::SELL, std::min(5 + i, 10), 101.0 + i);
+    }
+    std::mt19937 rng(42);
+    for (int i = 0; i < 300; ++i) {
+        const Market::Side side = rng() % 2 ? Market::Side::BUY : Market::Side::SELL;
+        const uint32_t qty = 1 + rng() % 3;
+        const uint32_t u = rng() % 10;
+        if (u < 5) {
+            const double offset = 1.0 + rng() % 5;
+            em.submitLimitOrderEvent(side, qty, side == Market::Side::BUY ? e->getBestAskPrice() - offset : e->getBestBidPrice() + offset);
+        } else if (u < 7) {
+            em.submitMarketOrderEvent(side, qty);
+        } else if (!e->getLimitOrderLookup().empty()) {
+            // a modify of the newest resting order, which LOBSTER writes as a delete and an add
+            uint64_t orderId = 0;
+            for (const auto& [id, entry] : e->getLimitOrderLookup())
+                orderId = std::max(orderId, id);
+            if (u < 9)
+                em.modifyOrderQuantity(orderId, qty + 5);
+            else
+                em.cancelOrder(orderId);
+        }
+    }
+    writer->close();
+    m.setLobsterDataWriter(nullptr);
+    const std::string streamedMessages = readFile(streamConfig.messageFilePath);
+    const std::string streamedOrderBook = readFile(streamConfig.orderBookFilePath);
+    *logger << "Streamed - records: " << writer->getNumRecords() << ", bytes: " << writer->getNumBytesWritten() << ", buffers written: "
+        << writer->getNumBuffersWritten() << ", bytes as on disk: " << (streamedMessages.size() + streamedOrderBook.size() == writer->getNumBytesWritten());
+    // the same records exported afterwards, through the parser and straight from the collectors
+    Parser::LobsterDataParser p;
+    m.exportToLobsterDataParser(p);
+    const auto data = p.getOrderBookMessagesAndSnapshotsAsCsv(5, true);
+    const auto parserConfig = makeConfig("parser");
+    {
+        Parser::LobsterDataWriter parserWriter(parserConfig);
+        p.writeOrderBookMessagesAndSnapshots(parserWriter);
+    }
+    const auto monitorConfig = makeConfig("monitor");
+    {
+        Parser::LobsterDataWriter monitorWriter(monitorConfig);
+        m.exportToLobsterDataWriter(monitorWriter);
+    }
+    *logger << "Exported - parser messages as streamed: " << (data.first == streamedMessages) << ", parser writer as streamed: "
+        << (readFile(parserConfig.messageFilePath) == streamedMessages && readFile(parserConfig.orderBookFilePath) == streamedOrderBook)
+        << ", monitor writer as streamed: " << (readFile(monitorConfig.messageFilePath) == streamedMessages && readFile(monitorConfig.orderBookFilePath) == streamedOrderBook);
+    // the files are aligned row by row - a delete split from a modify takes the snapshot of its add, which the in-memory export leaves out
+    Parser::LobsterDataReader reader(streamConfig.messageFilePath, streamConfig.orderBookFilePath);
+    std::vector<Parser::LobsterDataParser::OrderBookMessage> messages(1 << 12);
+    std::vector<uint32_t> rows(messages.size() * reader.getSnapshotSize());
+    const size_t numRead = reader.read(messages, rows);
+    size_t numDeletesOfModifies = 0, numSharedRows = 0;
+    Utils::Format::FormatBuffer orderBook;
+    orderBook << Parser::LobsterDataParser::OrderBookSnapshot::getHeaderCsv(5, true) << "\n";
+    for (size_t i = 0; i < numRead; ++i) {
+        const auto row = std::span<const uint32_t>(rows).subspan(i * reader.getSnapshotSize(), reader.getSnapshotSize());
+        const bool isDeleteOfModify = i + 1 < numRead && messages[i].messageType == Parser::LobsterDataParser::MessageType::ORDER_DELETE &&
+            messages[i + 1].messageType == Parser::LobsterDataParser::MessageType::ORDER_ADD && messages[i].orderId == messages[i + 1].orderId;
+        if (isDeleteOfModify) {
+            ++numDeletesOfModifies;
+            numSharedRows += std::equal(row.begin(), row.end(), rows.begin() + (i + 1) * reader.getSnapshotSize());
+            continue;
+        }
+        Parser::LobsterDataReader::makeSnapshot(row).appendAsCsv(orderBook, 5, true);
+        orderBook << "\n";
+    }
+    *logger << "Read back - records: " << numRead << ", exhausted: " << reader.isExhausted() << ", deletes of modifies: " << numDeletesOfModifies
+        << ", sharing the row of their add: " << numSharedRows << ", other rows as exported in memory: " << (orderBook.view() == data.second);
+    *logger << "Lobster messages (head):\n" << data.first.substr(0, data.first.find('\n', 1000));
+    // a message with no snapshot left at the close gets an empty row
+    {
+        const auto config = makeConfig("pending");
+        Parser::LobsterDataWriter pendingWriter(config);
+        pendingWriter.write(messages[0], nullptr);
+        pendingWriter.close();
+        *logger << "Pending at close:\n" << readFile(config.orderBookFilePath);
+    }
+    try {
+        auto config = makeConfig("missing");
+        config.messageFilePath = (directory / "missing" / "message.csv").string();
+        Parser::LobsterDataWriter missingWriter(config);
+    } catch (const std::exception& ex) {
+        std::string what = ex.what();
+        what.erase(what.find(directory.string()), directory.string().size() + 1); // no temporary directory in the baseline
+        *logger << "Bad path rejected: " << what;
+    }
+    std::filesystem::remove_all(directory);
+    return 0;
+}
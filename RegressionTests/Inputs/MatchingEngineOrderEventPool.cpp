@@ -0,0 +1,124 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineOrderEventPool";
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    std::shared_ptr<Exchange::MatchingEngineFIFO> h = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    Market::OrderEventManagerBase hm{h};
+    hm.setEventPool(nullptr); // heap-allocated reference
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    const auto& pool = em.getEventPool();
+    auto logPool = [&em, &pool](const std::string& label) {
+        *em.getLogger() << label << ": allocations=" << pool->getNumAllocations() << ", recycled=" << pool->getNumRecycled()
+            << ", in use=" << pool->getNumInUse() << ", slabs=" << pool->getNumSlabs() << ", oversized=" << pool->getNumOversized();
+    };
+    auto runSession = [](Market::OrderEventManagerBase& m) {
+        for (int i = 0; i < 200; ++i) {
+            m.submitLimitOrderEvent(Market::Side::BUY, 1 + i % 5, 99.0 - 0.01 * (i % 40));
+            m.submitLimitOrderEvent(Market::Side::SELL, 1 + i % 5, 101.0 + 0.01 * (i % 40));
+        }
+        for (int i = 0; i < 20; ++i) {
+            m.submitMarketOrderEvent(i % 2 ? Market::Side::BUY : Market::Side::SELL, 3 + i % 4);
+            m.modifyOrderPrice(40 + 2 * i, 98.5); // deep orders that the market orders never reach
+            m.modifyOrderQuantity(41 + 2 * i, 2);
+            m.cancelOrder(120 + 2 * i);
+        }
+    };
+    *em.getLogger() << "Pool blocks per slab: " << pool->getBlocksPerSlab() << ", largest pooled block: " << Utils::Memory::ObjectPool::MAX_BLOCK_SIZE;
+    logPool("Empty pool");
+    runSession(em);
+    runSession(hm);
+    logPool("After the first session");
+    *em.getLogger() << "Same book as the heap-allocated manager: " << (e->getBookStateHash() == h->getBookStateHash())
+        << ", same number of trades: " << (e->getTradeLog().size() == h->getTradeLog().size());
+    // the engine event log and the active orders keep the events and orders alive, releasing them hands the blocks back
+    e->reset();
+    em.reset();
+    logPool("After the reset");
+    const uint64_t numRecycledBefore = pool->getNumRecycled();
+    const size_t numSlabsBefore = pool->getNumSlabs();
+    runSession(em);
+    logPool("After the second session");
+    *em.getLogger() << "Second session served from recycled blocks: " << pool->getNumRecycled() - numRecycledBefore
+        << ", new slabs: " << pool->getNumSlabs() - numSlabsBefore;
+    // a pool shared between managers
+    std::shared_ptr<Exchange::MatchingEngineFIFO> s = std::make_shared<Exchange::MatchingEngineFIFO>();
+    {
+        Market::OrderEventManagerBase sm{s};
+        sm.setEventPool(pool);
+        sm.submitLimitOrderEvent(Market::Side::BUY, 5, 99.0);
+        *em.getLogger() << "Shared pool in use with another manager: " << pool->getNumInUse();
+    }
+    s.reset(); // the manager and the engine holding its events are gone
+    *em.getLogger() << "Shared pool in use after the other manager is gone: " << pool->getNumInUse();
+    // a pooled object keeps its pool alive
+    std::shared_ptr<Market::LimitOrder> survivor;
+    {
+        auto localPool = std::make_shared<Utils::Memory::ObjectPool>(4);
+        survivor = Utils::Memory::makePooledShared<Market::LimitOrder>(localPool, 1, 0, Market::Side::BUY, 10, 100.0);
+    }
+    *em.getLogger() << "Order outliving the local pool: " << survivor->getId() << ", " << survivor->getQuantity() << " at " << survivor->getPrice();
+    // the slabs stop at the cap, the blocks past it come from the heap and go back to it on release
+    {
+        auto cappedPool = std::make_shared<Utils::Memory::ObjectPool>(4, 1024);
+        std::vector<std::shared_ptr<Market::LimitOrder>> orders;
+        for (int i = 0; i < 20; ++i)
+            orders.push_back(Utils::Memory::makePooledShared<Market::LimitOrder>(cappedPool, i, 0, Market::Side::BUY, 10, 100.0));
+        *em.getLogger() << "Capped pool - slabs within the cap: " << (cappedPool->getBytesReserved() <= cappedPool->getMaxBytesReserved())
+            << ", pooled plus beyond the cap: " << cappedPool->getNumInUse() + cappedPool->getNumBeyondCap();
+        orders.clear();
+        *em.getLogger() << "Capped pool in use after the release: " << cappedPool->getNumInUse();
+        for (int i = 0; i < 4; ++i)
+            orders.push_back(Utils::Memory::makePooledShared<Market::LimitOrder>(cappedPool, i, 0, Market::Side::BUY, 10, 100.0));
+        *em.getLogger() << "Capped pool recycled: " << cappedPool->getNumRecycled() << ", no new heap blocks: " << (cappedPool->getNumInUse() == 4);
+    }
+    // with the engine logs cleared between rounds, the reports, deltas, trades and order copies of the engine recycle their blocks
+    {
+        std::shared_ptr<Exchange::MatchingEngineFIFO> r = std::make_shared<Exchange::MatchingEngineFIFO>();
+        Market::OrderEventManagerBase rm{r};
+        const auto& reportPool = r->getReportPool();
+        auto runRound = [&]() {
+            for (int i = 0; i < 50; ++i) {
+                rm.submitLimitOrderEvent(Market::Side::BUY, 1 + i % 5, 99.0 - 0.01 * (i % 10));
+                rm.submitLimitOrderEvent(Market::Side::SELL, 1 + i % 5, 99.0 - 0.01 * (i % 10)); // fills the buy just placed
+            }
+            r->setTradeLog({});
+            r->setOrderEventLog({});
+            r->setOrderProcessingReportLog({});
+            r->setOrderBookSizeDeltaLog({});
+            r->setOrderEventLatencyLog({});
+            r->setITCHMessageLog({});
+            r->setRemovedLimitOrderLog({});
+        };
+        runRound();
+        const uint64_t numRecycledBefore = reportPool->getNumRecycled();
+        const size_t numSlabsBefore = reportPool->getNumSlabs();
+        const uint64_t numInUseBefore = reportPool->getNumInUse();
+        for (int round = 0; round < 5; ++round)
+            runRound();
+        *em.getLogger() << "Engine report pool in steady state - recycled: " << reportPool->getNumRecycled() - numRecycledBefore
+            << ", new slabs: " << reportPool->getNumSlabs() - numSlabsBefore << ", in use as after the first round: " << (reportPool->getNumInUse() == numInUseBefore)
+            << ", event pool recycled: " << (rm.getEventPool()->getNumRecycled() > 0) << ", empty book: " << (r->getNumberOfBidPriceLevels() + r->getNumberOfAskPriceLevels() == 0);
+        r->stateConsistencyCheck();
+    }
+    // blocks released on another thread are handed out again by the owner
+    {
+        auto sharedPool = std::make_shared<Utils::Memory::ObjectPool>(16);
+        std::vector<std::shared_ptr<Market::LimitOrder>> orders;
+        for (int i = 0; i < 100; ++i)
+            orders.push_back(Utils::Memory::makePooledShared<Market::LimitOrder>(sharedPool, i, 0, Market::Side::BUY, 10, 100.0));
+        std::thread([orders = std::move(orders)]() mutable { orders.clear(); }).join();
+        const uint64_t numInUseAfterRelease = sharedPool->getNumInUse();
+        for (int i = 0; i < 100; ++i)
+            orders.push_back(Utils::Memory::makePooledShared<Market::LimitOrder>(sharedPool, i, 0, Market::Side::BUY, 10, 100.0));
+        *em.getLogger() << "Released on another thread - in use after the release: " << numInUseAfterRelease << ", recycled: " << sharedPool->getNumRecycled()
+            << ", slabs: " << sharedPool->getNumSlabs();
+    }
+    e->stateConsistencyCheck();
+    return 0;
+}
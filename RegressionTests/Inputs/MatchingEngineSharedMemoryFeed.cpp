@@ -0,0 +1,138 @@
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+#include "Exchange/MarketDataFeed.hpp"
+
+const std::string TEST_NAME = "MatchingEngineSharedMemoryFeed";
+
+using L2Book = std::map<std::pair<Market::Side, int64_t>, int64_t>;
+
+// rebuilds the L2 book from the delta records alone, as an out-of-process consumer would
+void applyRecords(L2Book& book, const std::vector<Exchange::MarketDataRecord>& records) {
+    for (const auto& record : records) {
+        if (record.recordType != Exchange::MarketDataRecord::RecordType::BOOK_DELTA)
+            continue;
+        auto& size = book[{record.side, record.price}];
+        size += record.deltaType == Exchange::OrderBookSizeDelta::DeltaType::ADD ? record.size : -static_cast<int64_t>(record.size);
+        if (size == 0)
+            book.erase({record.side, record.price});
+    }
+}
+
+bool isGapless(const std::vector<Exchange::MarketDataRecord>& records, uint64_t first) {
+    for (const auto& record : records)
+        if (record.sequence != first++)
+            return false;
+    return true;
+}
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    e->getOrderBookDisplayConfig().setShowOrderLookup(false);
+    auto bookMatches = [&e](const L2Book& book) {
+        L2Book engineBook;
+        for (const auto& [price, size] : e->getBidBookSize())
+            engineBook[{Market::Side::BUY, Utils::Maths::castDoublePriceAsInt<int64_t>(price)}] = size;
+        for (const auto& [price, size] : e->getAskBookSize())
+            engineBook[{Market::Side::SELL, Utils::Maths::castDoublePriceAsInt<int64_t>(price)}] = size;
+        return engineBook == book;
+    };
+    const std::string suffix = std::to_string(::getpid());
+    const std::string feedName = "/LibOB-feed-" + suffix;
+    const std::string slowFeedName = "/LibOB-slow-" + suffix;
+    try {
+        Exchange::SharedMemoryMarketDataReader missing{"/LibOB-missing-" + suffix};
+    } catch (const std::exception&) {
+        *em.getLogger() << "Reader of a missing feed throws";
+    }
+    Exchange::SharedMemoryMarketDataPublisher publisher{feedName, 4096};
+    Exchange::SharedMemoryMarketDataPublisher slowPublisher{slowFeedName, 16};
+    publisher.attach(e);
+    slowPublisher.attach(e);
+    Exchange::SharedMemoryMarketDataReader reader{feedName};
+    Exchange::SharedMemoryMarketDataReader slowReader{slowFeedName};
+    *em.getLogger() << "Feed capacity: " << publisher.getCapacity() << ", slow feed capacity: " << slowPublisher.getCapacity()
+        << ", reader capacity: " << reader.getCapacity();
+    // book building, sweeps, cancels and modifications
+    for (int i = 0; i < 20; ++i) {
+        em.submitLimitOrderEvent(Market::Side::BUY, 5 + i % 4, 99.0 - 0.5 * (i % 5));
+        em.submitLimitOrderEvent(Market::Side::SELL, 5 + i % 4, 101.0 + 0.5 * (i % 5));
+    }
+    em.submitMarketOrderEvent(Market::Side::BUY, 17);
+    em.submitMarketOrderEvent(Market::Side::SELL, 9);
+    em.submitLimitOrderEvent(Market::Side::BUY, 30, 101.5);
+    em.cancelOrder(4);
+    em.modifyOrderPrice(6, 97.5);
+    em.modifyOrderQuantity(8, 2);
+    std::vector<Exchange::MarketDataRecord> records;
+    L2Book book;
+    size_t numOverruns = reader.drain(records);
+    applyRecords(book, records);
+    const auto numTrades = std::count_if(records.begin(), records.end(), [](const auto& record) { return record.recordType == Exchange::MarketDataRecord::RecordType::TRADE; });
+    *em.getLogger() << "Published: " << publisher.getNumPublished() << ", read: " << records.size() << ", overruns: " << numOverruns
+        << ", gapless: " << isGapless(records, 1) << ", lag: " << reader.getLag();
+    *em.getLogger() << "Trade records: " << numTrades << " vs engine trades: " << e->getTradeLog().size();
+    *em.getLogger() << "First records:";
+    for (size_t i = 0; i < 5; ++i)
+        *em.getLogger() << records[i];
+    *em.getLogger() << "Last records:";
+    for (size_t i = records.size() - 5; i < records.size(); ++i)
+        *em.getLogger() << records[i];
+    *em.getLogger() << "Rebuilt book matches the engine: " << bookMatches(book);
+    // the feed carries the net level deltas with their batch boundaries in coalescing mode
+    e->setCoalesceBookDeltas(true);
+    em.submitMarketOrderEvent(Market::Side::SELL, 25);
+    em.submitLimitOrderEvent(Market::Side::SELL, 40, 98.0);
+    const size_t numRead = records.size();
+    numOverruns = reader.drain(records);
+    std::vector<Exchange::MarketDataRecord> coalesced(records.begin() + numRead, records.end());
+    applyRecords(book, coalesced);
+    *em.getLogger() << "Coalesced records:";
+    for (const auto& record : coalesced)
+        *em.getLogger() << record;
+    *em.getLogger() << "Overruns: " << numOverruns << ", gapless: " << isGapless(records, 1) << ", rebuilt book matches the engine: " << bookMatches(book);
+    // a consumer in another process maps the same feed and sees the same records
+    int pipeFds[2];
+    if (::pipe(pipeFds) != 0)
+        Utils::Error::LIB_THROW("Cannot open pipe.");
+    const pid_t child = ::fork();
+    if (child == 0) {
+        ::close(pipeFds[0]);
+        Exchange::SharedMemoryMarketDataReader childReader{feedName};
+        std::vector<Exchange::MarketDataRecord> childRecords;
+        childReader.drain(childRecords);
+        L2Book childBook;
+        applyRecords(childBook, childRecords);
+        const uint64_t result[2] = {childRecords.size(), childBook == book && isGapless(childRecords, 1)};
+        [[maybe_unused]] const auto written = ::write(pipeFds[1], result, sizeof(result));
+        ::_exit(0);
+    }
+    ::close(pipeFds[1]);
+    uint64_t childResult[2] = {0, 0};
+    [[maybe_unused]] const auto read = ::read(pipeFds[0], childResult, sizeof(childResult));
+    ::close(pipeFds[0]);
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    *em.getLogger() << "Child process read: " << childResult[0] << ", same book and gapless: " << childResult[1]
+        << ", exit status: " << (WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+    // a reader lapped by the publisher detects the gap once and resumes from the oldest record still in the ring
+    std::vector<Exchange::MarketDataRecord> slowRecords;
+    numOverruns = slowReader.drain(slowRecords);
+    *em.getLogger() << "Slow feed published: " << slowPublisher.getNumPublished() << ", read: " << slowRecords.size() << ", overruns: " << numOverruns
+        << ", missed: " << slowReader.getNumMissedRecords() << ", resumed at: " << slowRecords.front().sequence
+        << ", gapless after resuming: " << isGapless(slowRecords, slowRecords.front().sequence);
+    em.submitLimitOrderEvent(Market::Side::BUY, 3, 96.0);
+    slowRecords.clear();
+    numOverruns = slowReader.drain(slowRecords);
+    *em.getLogger() << "Slow reader caught up, read: " << slowRecords.size() << ", overruns: " << numOverruns << ", lag: " << slowReader.getLag();
+    slowPublisher.detach();
+    em.submitLimitOrderEvent(Market::Side::BUY, 3, 96.0);
+    *em.getLogger() << "Detached feed published: " << slowPublisher.getNumPublished() << ", attached: " << slowPublisher.isAttached();
+    e->stateConsistencyCheck();
+    return 0;
+}
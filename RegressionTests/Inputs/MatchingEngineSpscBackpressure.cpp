@@ -0,0 +1,110 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEvent.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineSpscBackpressure";
+
+int main() {
+    using Utils::Concurrency::OverflowPolicy;
+    std::shared_ptr<Utils::Logger::LoggerBase> logger = std::make_shared<Utils::Logger::LoggerBase>();
+    logger->setLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    auto submitAll = [](Exchange::MatchingEngineFIFO& engine, const uint64_t numOrders) {
+        for (uint64_t id = 1; id <= numOrders; ++id) {
+            const Market::Side side = id % 2 ? Market::Side::BUY : Market::Side::SELL;
+            const double price = id % 2 ? 100.0 - 0.01 * (id % 7) : 99.97 + 0.01 * (id % 5);
+            if (id % 11 == 0)
+                engine.process(std::make_shared<Market::MarketOrder>(id, 0, side, 1 + id % 9));
+            else
+                engine.process(std::make_shared<Market::LimitOrder>(id, 0, side, 1 + id % 9, price));
+        }
+    };
+    auto sameReportIds = [](const auto& reportLog, const auto& referenceLog, const size_t offset) {
+        if (reportLog.size() + offset != referenceLog.size())
+            return false;
+        for (size_t i = 0; i < reportLog.size(); ++i)
+            if (reportLog[i]->orderId != referenceLog[i + offset]->orderId || reportLog[i]->orderProcessingType != referenceLog[i + offset]->orderProcessingType)
+                return false;
+        return true;
+    };
+    Exchange::MatchingEngineFIFO s;
+    submitAll(s, 300);
+    const auto& referenceLog = s.getOrderProcessingReportLog();
+    auto logQueueStats = [&logger](const std::string& label, const Exchange::MatchingEngineFIFOSpsc& e) {
+        const auto& queue = e.getOrderProcessingReportQueue();
+        *logger << label << ": capacity=" << queue.capacity() << ", depth=" << queue.size() << ", high water mark=" << queue.high_water_mark()
+            << ", dropped=" << queue.num_dropped() << ", spilled=" << queue.num_spilled() << ", queued=" << e.getNumQueued() << ", dispatched=" << e.getNumDispatched();
+    };
+    // blocking ring without a consumer thread is drained inline whenever it fills up
+    {
+        Exchange::MatchingEngineFIFOSpsc e;
+        e.setQueueCapacity(20, OverflowPolicy::BLOCK);
+        submitAll(e, 300);
+        logQueueStats("Block", e);
+        e.flush();
+        logQueueStats("Block flushed", e);
+        *logger << "Block reports match the synchronous engine: " << sameReportIds(e.getOrderProcessingReportLog(), referenceLog, 0);
+    }
+    // drop-oldest keeps only the most recent capacity worth of reports
+    {
+        Exchange::MatchingEngineFIFOSpsc e;
+        e.setQueueCapacity(20, OverflowPolicy::DROP_OLDEST);
+        submitAll(e, 300);
+        logQueueStats("Drop oldest", e);
+        e.flush();
+        logQueueStats("Drop oldest flushed", e);
+        *logger << "Drop oldest keeps the latest reports: " << sameReportIds(e.getOrderProcessingReportLog(), referenceLog, referenceLog.size() - e.getOrderProcessingReportLog().size());
+    }
+    // spill keeps everything in order past the ring capacity
+    {
+        Exchange::MatchingEngineFIFOSpsc e;
+        e.setQueueCapacity(20, OverflowPolicy::SPILL);
+        submitAll(e, 300);
+        logQueueStats("Spill", e);
+        e.flush();
+        logQueueStats("Spill flushed", e);
+        *logger << "Spill reports match the synchronous engine: " << sameReportIds(e.getOrderProcessingReportLog(), referenceLog, 0);
+    }
+    // every policy against a live consumer thread
+    for (const OverflowPolicy policy : {OverflowPolicy::BLOCK, OverflowPolicy::DROP_OLDEST, OverflowPolicy::SPILL}) {
+        Exchange::MatchingEngineFIFOSpsc e;
+        e.setQueueCapacity(8, policy);
+        e.startConsumerThread();
+        submitAll(e, 300);
+        e.flush();
+        e.stopConsumerThread();
+        const auto& queue = e.getOrderProcessingReportQueue();
+        const bool inOrder = sameReportIds(e.getOrderProcessingReportLog(), referenceLog, 0) || policy == OverflowPolicy::DROP_OLDEST;
+        *logger << "Consumer thread with policy " << static_cast<int>(policy) << ": all accounted for=" << (e.getNumDispatched() + e.getNumDropped() == e.getNumQueued())
+            << ", in order=" << inOrder << ", empty=" << queue.empty() << ", bounded=" << (policy == OverflowPolicy::SPILL || queue.high_water_mark() <= queue.capacity());
+    }
+    // raw ring under contention: the consumer must see a strictly increasing sequence and nothing may go missing
+    for (const OverflowPolicy policy : {OverflowPolicy::BLOCK, OverflowPolicy::DROP_OLDEST, OverflowPolicy::SPILL}) {
+        Utils::Concurrency::SpscBoundedRingBuffer<uint64_t> ring(64, policy);
+        const uint64_t numItems = 200000;
+        std::atomic<bool> done{false};
+        uint64_t numPopped = 0, last = 0;
+        bool increasing = true;
+        std::thread consumer([&]() {
+            uint64_t item;
+            while (true) {
+                if (ring.try_pop(item)) {
+                    increasing &= item > last;
+                    last = item;
+                    ++numPopped;
+                } else if (done.load(std::memory_order_acquire) && ring.empty()) {
+                    break;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        for (uint64_t i = 1; i <= numItems; ++i)
+            ring.push(uint64_t(i));
+        done.store(true, std::memory_order_release);
+        consumer.join();
+        *logger << "Ring with policy " << static_cast<int>(policy) << ": increasing=" << increasing
+            << ", all accounted for=" << (numPopped + ring.num_dropped() == numItems) << ", last=" << last;
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEvent.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineSpscConsumer";
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> s = std::make_shared<Exchange::MatchingEngineFIFO>();
+    std::shared_ptr<Exchange::MatchingEngineFIFOSpsc> e = std::make_shared<Exchange::MatchingEngineFIFOSpsc>();
+    e->getLogger()->setLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    e->getOrderBookDisplayConfig().setShowOrderLookup(false);
+    e->reserve(1000);
+    // the callbacks run on the consumer thread and only ever touch what the reports carry
+    size_t numReports = 0, numDeltas = 0, numITCHMessages = 0;
+    e->addOrderProcessingCallback(std::make_shared<Exchange::OrderProcessingCallback>([&](const auto&) { ++numReports; }));
+    e->addOrderBookDeltaCallback(std::make_shared<Exchange::OrderBookDeltaCallback>([&](const auto&) { ++numDeltas; }));
+    e->addITCHMessageCallback(std::make_shared<Exchange::ITCHMessageCallback>([&](const auto&) { ++numITCHMessages; }));
+    auto submitAll = [&](const uint64_t idFrom, const uint64_t idTo) {
+        for (uint64_t id = idFrom; id < idTo; ++id) {
+            const Market::Side side = id % 2 ? Market::Side::BUY : Market::Side::SELL;
+            const double price = id % 2 ? 100.0 - 0.01 * (id % 7) : 99.97 + 0.01 * (id % 5);
+            const uint32_t quantity = 1 + id % 9;
+            for (const auto& engine : {std::static_pointer_cast<Exchange::MatchingEngineFIFO>(e), s}) {
+                if (id % 11 == 0)
+                    engine->process(std::make_shared<Market::MarketOrder>(id, 0, side, quantity));
+                else if (id % 13 == 0)
+                    engine->process(std::make_shared<const Market::OrderCancelEvent>(id, id - 3, 0));
+                else
+                    engine->process(std::make_shared<Market::LimitOrder>(id, 0, side, quantity, price));
+            }
+        }
+    };
+    // manual drain on the calling thread
+    submitAll(1, 50);
+    *e->getLogger() << "Queued before drain: " << e->getNumQueued() << ", report log size: " << e->getOrderProcessingReportLog().size();
+    const size_t numDrained = e->drain();
+    *e->getLogger() << "Drained: " << numDrained << ", report log size: " << e->getOrderProcessingReportLog().size();
+    // dedicated consumer thread, flushed at the end of the burst
+    e->startConsumerThread();
+    *e->getLogger() << "Consumer thread running: " << e->isConsumerThreadRunning();
+    try {
+        e->drain(); // the consumer thread is the only consumer of the buffers
+    } catch (const std::exception& ex) {
+        *e->getLogger() << "Drain on a running consumer rejected: " << ex.what();
+    }
+    submitAll(50, 400);
+    e->flush();
+    *e->getLogger() << "Queued: " << e->getNumQueued() << ", dispatched: " << e->getNumDispatched();
+    *e->getLogger() << "Report log size: " << e->getOrderProcessingReportLog().size() << " vs synchronous engine: " << s->getOrderProcessingReportLog().size();
+    *e->getLogger() << "ITCH log size: " << e->getITCHMessageLog().size() << " vs synchronous engine: " << s->getITCHMessageLog().size();
+    *e->getLogger() << "Callbacks run - reports: " << numReports << ", deltas: " << numDeltas << ", ITCH messages: " << numITCHMessages;
+    // whatever is queued after the last flush is dispatched on stop
+    submitAll(400, 420);
+    e->stopConsumerThread();
+    *e->getLogger() << "Consumer thread running: " << e->isConsumerThreadRunning() << ", queued: " << e->getNumQueued() << ", dispatched: " << e->getNumDispatched();
+    *e->getLogger() << "Report log size: " << e->getOrderProcessingReportLog().size() << " vs synchronous engine: " << s->getOrderProcessingReportLog().size();
+    *e->getLogger() << "Order book state:\n" << *e;
+    e->stateConsistencyCheck();
+    return 0;
+}
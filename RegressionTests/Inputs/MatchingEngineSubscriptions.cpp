@@ -0,0 +1,56 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineSubscriptions";
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    e->getOrderBookDisplayConfig().setShowOrderLookup(false);
+    using Exchange::OrderProcessingType;
+    std::map<std::string, size_t> numCalls;
+    auto count = [&numCalls](const std::string& name) { return [&numCalls, name](const auto&) { ++numCalls[name]; }; };
+    e->subscribeOrderProcessingReports(count("all reports"));
+    e->subscribeOrderProcessingReports(count("executions"), Exchange::OrderProcessingReportFilter({OrderProcessingType::EXECUTE}));
+    e->subscribeOrderProcessingReports(count("buy executions"), Exchange::OrderProcessingReportFilter({OrderProcessingType::EXECUTE}, Market::Side::BUY));
+    e->subscribeOrderProcessingReports(count("cancels and modifies"), Exchange::OrderProcessingReportFilter(
+        {OrderProcessingType::CANCEL, OrderProcessingType::PARTIAL_CANCEL, OrderProcessingType::MODIFY_PRICE, OrderProcessingType::MODIFY_QUANTITY}));
+    e->subscribeOrderProcessingReports(count("all but placements"), Exchange::OrderProcessingReportFilter::allExcept({OrderProcessingType::PLACEMENT}));
+    e->subscribeOrderBookDeltas(count("sell deltas"), Exchange::OrderProcessingReportFilter::allExcept({}, Market::Side::SELL));
+    e->subscribeITCHMessages(count("execution ITCH messages"), Exchange::OrderProcessingReportFilter({OrderProcessingType::EXECUTE}));
+    const Exchange::SubscriptionId temporaryId = e->subscribeOrderProcessingReports(count("unsubscribed midway"));
+    for (int i = 0; i < 5; ++i) {
+        em.submitLimitOrderEvent(Market::Side::BUY, 5 + i, 99.0 - i);
+        em.submitLimitOrderEvent(Market::Side::SELL, 5 + i, 101.0 + i);
+    }
+    *em.getLogger() << "Unsubscribe: " << e->unsubscribe(temporaryId) << ", again: " << e->unsubscribe(temporaryId);
+    em.submitMarketOrderEvent(Market::Side::BUY, 12);
+    em.submitMarketOrderEvent(Market::Side::SELL, 7);
+    em.cancelOrder(6);
+    em.modifyOrderPrice(8, 97.5);
+    em.modifyOrderQuantity(7, 2);
+    em.partialCancelOrder(9, 1);
+    // reference counts from the report log
+    std::map<OrderProcessingType, size_t> numReportsByType;
+    size_t numBuyExecutions = 0, numSellReports = 0, numNullReports = 0;
+    for (const auto& report : e->getOrderProcessingReportLog()) {
+        if (!report) {
+            ++numNullReports;
+            continue;
+        }
+        ++numReportsByType[report->orderProcessingType];
+        numBuyExecutions += report->orderProcessingType == OrderProcessingType::EXECUTE && report->orderSide == Market::Side::BUY;
+        numSellReports += report->orderSide == Market::Side::SELL;
+    }
+    for (const auto& [type, num] : numReportsByType)
+        *em.getLogger() << "Reports of type " << Utils::toString(type) << ": " << num;
+    *em.getLogger() << "Buy executions: " << numBuyExecutions << ", sell side reports: " << numSellReports << ", null reports: " << numNullReports;
+    for (const auto& [name, num] : numCalls)
+        *em.getLogger() << "Calls to " << name << ": " << num;
+    *em.getLogger() << "Active limit orders tracked by the manager: " << em.getActiveLimitOrders().size()
+        << " vs resting in the book: " << e->getLimitOrderLookup().size();
+    return 0;
+}
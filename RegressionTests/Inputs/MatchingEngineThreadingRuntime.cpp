@@ -0,0 +1,143 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEvent.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+#include "Exchange/MatchingEngineGateway.hpp"
+
+const std::string TEST_NAME = "MatchingEngineThreadingRuntime";
+
+int main() {
+    using Utils::Concurrency::WaitStrategy;
+    std::shared_ptr<Exchange::MatchingEngineFIFO> s = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase sm{s};
+    sm.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    const auto& logger = sm.getLogger();
+    const std::vector<std::string> strategyNames{"BUSY_SPIN", "YIELD", "FUTEX"};
+    // placement primitives
+    *logger << "CPUs available: " << (Utils::Concurrency::num_cpus() >= 1) << ", NUMA node of a cpu that does not exist: "
+        << Utils::Concurrency::numa_node_of_cpu(1 << 20) << ", pinning to a negative cpu: " << Utils::Concurrency::pin_current_thread(-1);
+    int firstTouchCpu = -1;
+    Utils::Concurrency::run_on_cpu(0, [&]() { firstTouchCpu = Utils::Concurrency::current_cpu(); });
+    *logger << "First touch runs on the requested cpu: " << (firstTouchCpu == 0) << ", default config: cpu "
+        << Utils::Concurrency::ThreadConfig().cpu << ", " << strategyNames[static_cast<int>(Utils::Concurrency::ThreadConfig().wait_strategy)];
+    try {
+        Utils::Concurrency::run_on_cpu(0, []() { Utils::Error::LIB_THROW("Allocation failed on the pinned thread."); });
+    } catch (const std::exception& ex) {
+        *logger << "Exception handed back from the pinned thread: " << ex.what();
+    }
+    // a scoped pin hands the calling thread its previous affinity back, as the simulator does around simulate
+    std::thread([&]() {
+        cpu_set_t cpusBefore, cpusAfter;
+        pthread_getaffinity_np(pthread_self(), sizeof(cpusBefore), &cpusBefore);
+        Utils::Concurrency::ThreadConfig config;
+        config.cpu = 0;
+        bool pinned = false;
+        {
+            const Utils::Concurrency::ScopedThreadPin pin(config);
+            pinned = pin.pinned() && Utils::Concurrency::current_cpu() == 0;
+        }
+        pthread_getaffinity_np(pthread_self(), sizeof(cpusAfter), &cpusAfter);
+        *logger << "Scoped pin - pinned: " << pinned << ", affinity restored: " << CPU_EQUAL(&cpusBefore, &cpusAfter);
+    }).join();
+    auto submitRandom = [](Market::OrderEventManagerBase& m, const int numOrders) {
+        for (int i = 0; i < numOrders; ++i) {
+            const Market::Side side = i % 2 ? Market::Side::BUY : Market::Side::SELL;
+            if (i % 9 == 0)
+                m.submitMarketOrderEvent(side, 1 + i % 4);
+            else
+                m.submitLimitOrderEvent(side, 1 + i % 5, side == Market::Side::BUY ? 99.95 + 0.01 * (i % 6) : 100.0 - 0.01 * (i % 6) + 0.05);
+        }
+    };
+    submitRandom(sm, 3000);
+    // the SPSC consumer thread under each wait strategy
+    for (const auto strategy : {WaitStrategy::BUSY_SPIN, WaitStrategy::YIELD, WaitStrategy::FUTEX}) {
+        std::shared_ptr<Exchange::MatchingEngineFIFOSpsc> e = std::make_shared<Exchange::MatchingEngineFIFOSpsc>();
+        Market::OrderEventManagerBase em{e};
+        e->setQueueCapacity(256);
+        e->setConsumerThreadConfig({0, strategy, 16, true});
+        e->startConsumerThread();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)); // nothing to do, a FUTEX consumer goes to sleep
+        const bool sleptWhileIdle = e->getNumConsumerSleeps() > 0;
+        submitRandom(em, 3000);
+        e->flush(); // never returns if a wake-up is lost
+        e->stopConsumerThread();
+        *logger << strategyNames[static_cast<int>(strategy)] << " consumer - same book as the reference: " << (e->getBookStateHash() == s->getBookStateHash())
+            << ", same reports: " << (e->getOrderProcessingReportLog().size() == s->getOrderProcessingReportLog().size())
+            << ", slept while idle: " << sleptWhileIdle << ", capacity kept: " << e->getOrderProcessingReportQueue().capacity();
+    }
+    // FUTEX consumers of the disruptor ring, the second waking up on the progress of the first
+    {
+        std::shared_ptr<Exchange::MatchingEngineFIFODisruptor> e = std::make_shared<Exchange::MatchingEngineFIFODisruptor>();
+        e->setOutputRingCapacity(64, 0);
+        std::atomic<uint64_t> numJournaled{0};
+        uint64_t numOutOfOrder = 0;
+        const size_t journalId = e->addOutputConsumer([&](const Exchange::LoggedEngineOutput&) { numJournaled.fetch_add(1, std::memory_order_release); });
+        const size_t engineLogId = e->addEngineLogConsumer({journalId});
+        e->addOrderProcessingCallback(std::make_shared<Exchange::OrderProcessingCallback>([&](const auto&) {
+            numOutOfOrder += numJournaled.load(std::memory_order_acquire) < e->getOutputRing().consumed(engineLogId);
+        }));
+        for (const size_t id : {journalId, engineLogId})
+            e->setConsumerThreadConfig(id, {0, WaitStrategy::FUTEX, 16, true});
+        Market::OrderEventManagerBase em{e};
+        e->startConsumerThreads();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const bool sleptWhileIdle = e->getOutputRing().wake_signal().num_sleeps() > 0;
+        submitRandom(em, 3000);
+        e->stopConsumerThreads();
+        *logger << "FUTEX disruptor consumers - same book as the reference: " << (e->getBookStateHash() == s->getBookStateHash())
+            << ", same reports: " << (e->getOrderProcessingReportLog().size() == s->getOrderProcessingReportLog().size())
+            << ", journal never behind: " << (numOutOfOrder == 0) << ", slept while idle: " << sleptWhileIdle;
+    }
+    // a FUTEX matching thread behind the gateway
+    {
+        std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+        Exchange::MatchingEngineGateway gateway{e, 128};
+        gateway.setMatchingThreadConfig({0, WaitStrategy::FUTEX, 16, true});
+        constexpr int numProducers = 3;
+        constexpr int numOrdersPerProducer = 1000;
+        std::vector<std::shared_ptr<Exchange::MatchingEngineGateway::Session>> sessions;
+        for (int p = 0; p < numProducers; ++p)
+            sessions.push_back(gateway.openSession());
+        gateway.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const bool sleptWhileIdle = gateway.getNumMatchingThreadSleeps() > 0;
+        std::vector<std::thread> producers;
+        for (int p = 0; p < numProducers; ++p) {
+            producers.emplace_back([&, p]() {
+                auto& session = *sessions[p];
+                for (int i = 0; i < numOrdersPerProducer; ++i) {
+                    session.submitLimitOrder(i % 2 ? Market::Side::BUY : Market::Side::SELL, 1 + i % 3, i % 2 ? 99.0 - 0.01 * (i % 50) : 101.0 + 0.01 * (i % 50));
+                    if (i % 200 == 0)
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1)); // lets the matching thread fall asleep in between
+                }
+                session.flush();
+            });
+        }
+        for (auto& producer : producers)
+            producer.join();
+        gateway.stop();
+        *logger << "FUTEX matching thread - processed: " << gateway.getNumProcessed() << ", resting orders: " << e->getLimitOrderLookup().size()
+            << ", slept while idle: " << sleptWhileIdle << ", ingress capacity kept: " << gateway.getIngressQueue().capacity();
+        e->stateConsistencyCheck();
+    }
+    // moving the consumer between runs, as the simulator does, dispatches what the queues still hold rather than throwing
+    {
+        std::shared_ptr<Exchange::MatchingEngineFIFOSpsc> e = std::make_shared<Exchange::MatchingEngineFIFOSpsc>();
+        Market::OrderEventManagerBase em{e};
+        e->setQueueCapacity(256);
+        submitRandom(em, 100);
+        const size_t numPending = e->getOrderProcessingReportQueue().size();
+        e->setConsumerThreadConfig({0, WaitStrategy::YIELD, 16, true});
+        *logger << "Consumer moved with reports pending: " << (numPending > 0) << ", dispatched first: " << (e->getNumDispatched() == e->getNumQueued())
+            << ", queues empty: " << e->getOrderProcessingReportQueue().empty() << ", capacity kept: " << e->getOrderProcessingReportQueue().capacity();
+    }
+    try {
+        std::shared_ptr<Exchange::MatchingEngineFIFOSpsc> e = std::make_shared<Exchange::MatchingEngineFIFOSpsc>();
+        e->startConsumerThread();
+        e->setConsumerThreadConfig({});
+    } catch (const std::exception& ex) {
+        *logger << "Reconfiguring a running consumer rejected: " << ex.what();
+    }
+    return 0;
+}
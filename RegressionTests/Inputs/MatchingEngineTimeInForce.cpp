@@ -0,0 +1,53 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineTimeInForce";
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    auto& config = e->getOrderBookDisplayConfig();
+    config.setAggregateOrderBook(false);
+    config.setShowOrderLookup(false);
+    auto logReports = [&em, &e](const std::string& label, const size_t numReportsBefore) {
+        *em.getLogger() << label << ":";
+        const auto& reportLog = e->getOrderProcessingReportLog();
+        for (size_t i = numReportsBefore; i < reportLog.size(); ++i)
+            if (reportLog[i])
+                *em.getLogger() << *reportLog[i];
+    };
+    // initial book state
+    for (int i = 0; i < 5; ++i) {
+        em.submitLimitOrderEvent(Market::Side::BUY, 5 + i, 99.0 - i);
+        em.submitLimitOrderEvent(Market::Side::SELL, 5 + i, 101.0 + i);
+    }
+    *em.getLogger() << "Initial order book state:\n" << *e;
+    *em.getLogger() << "Fillable buy up to 102.0: " << e->getFillableQuantity(Market::Side::BUY, 102.0)
+        << ", fillable sell down to 97.0: " << e->getFillableQuantity(Market::Side::SELL, 97.0);
+    size_t numReports = e->getOrderProcessingReportLog().size();
+    // IOC takes what it can up to the limit and drops the remainder
+    em.submitLimitOrderEvent(Market::Side::BUY, 15, 102.0, Market::TimeInForce::IOC);
+    logReports("IOC buy 15 at 102.0", numReports);
+    numReports = e->getOrderProcessingReportLog().size();
+    // FOK is rejected without touching the book when the depth up to the limit is short
+    em.submitLimitOrderEvent(Market::Side::SELL, 30, 97.0, Market::TimeInForce::FOK);
+    logReports("FOK sell 30 at 97.0", numReports);
+    numReports = e->getOrderProcessingReportLog().size();
+    em.submitLimitOrderEvent(Market::Side::SELL, 12, 97.0, Market::TimeInForce::FOK);
+    logReports("FOK sell 12 at 97.0", numReports);
+    numReports = e->getOrderProcessingReportLog().size();
+    // post-only rests when passive and is rejected on cross
+    em.submitLimitOrderEvent(Market::Side::BUY, 4, 103.0, Market::TimeInForce::POST_ONLY);
+    logReports("Post-only buy 4 at 103.0", numReports);
+    numReports = e->getOrderProcessingReportLog().size();
+    em.submitLimitOrderEvent(Market::Side::BUY, 4, 100.0, Market::TimeInForce::POST_ONLY);
+    logReports("Post-only buy 4 at 100.0", numReports);
+    *em.getLogger() << "Final order book state:\n" << *e;
+    e->stateConsistencyCheck();
+    *em.getLogger() << "Active limit orders tracked by the manager: " << em.getActiveLimitOrders().size()
+        << " vs resting in the book: " << e->getLimitOrderLookup().size();
+    return 0;
+}
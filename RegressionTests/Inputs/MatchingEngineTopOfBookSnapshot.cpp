@@ -0,0 +1,131 @@
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+
+const std::string TEST_NAME = "MatchingEngineTopOfBookSnapshot";
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    *em.getLogger() << "Snapshot off by default: " << (e->getTopOfBookSnapshotLock() == nullptr) << ", levels: " << e->getTopOfBookSnapshotLevels();
+    // deterministic run on the calling thread
+    e->setTopOfBookSnapshotLevels(3);
+    *em.getLogger() << "Empty book snapshot: " << e->getTopOfBookSnapshot();
+    for (int i = 0; i < 5; ++i) {
+        em.submitLimitOrderEvent(Market::Side::BUY, 5 + i, 99.0 - i);
+        em.submitLimitOrderEvent(Market::Side::SELL, 5 + i, 101.0 + i);
+    }
+    *em.getLogger() << "Snapshot of the top 3 levels: " << e->getTopOfBookSnapshot();
+    em.submitMarketOrderEvent(Market::Side::BUY, 8);
+    const auto snapshot = e->getTopOfBookSnapshot();
+    *em.getLogger() << "Snapshot after a market buy: " << snapshot;
+    *em.getLogger() << "Best bid/ask: " << snapshot.getBestBidPrice() << "/" << snapshot.getBestAskPrice() << ", spread: " << snapshot.getSpread()
+        << ", mid: " << snapshot.getMidPrice() << ", same as the engine: "
+        << (snapshot.getBestBidPrice() == e->getBestBidPrice() && snapshot.getBestAskSize() == e->getBestAskSize());
+    e->setTopOfBookSnapshotLevels(1);
+    *em.getLogger() << "Snapshot of the top level: " << e->getTopOfBookSnapshot();
+    Exchange::MatchingEngineFIFO copy{*e};
+    *em.getLogger() << "Copy publishes its own snapshot: " << (copy.getTopOfBookSnapshotLock() != e->getTopOfBookSnapshotLock())
+        << ", levels: " << copy.getTopOfBookSnapshotLevels();
+    try {
+        e->setTopOfBookSnapshotLevels(Exchange::TopOfBookSnapshot::MAX_LEVELS + 1);
+    } catch (const std::exception& ex) {
+        *em.getLogger() << "Too many levels rejected: " << ex.what();
+    }
+    const auto lock = e->getTopOfBookSnapshotLock();
+    e->setTopOfBookSnapshotLevels(0);
+    *em.getLogger() << "Snapshot off: " << (e->getTopOfBookSnapshotLock() == nullptr) << ", last snapshot kept by its reader: " << lock->load();
+    // readers hammer the snapshot while the random orders flow in on the calling thread
+    constexpr int numReaders = 3;
+    constexpr int numOrders = 20000;
+    const std::vector<double> p{0, 1, 3, 5, 7, 9, 6, 3, 2, 1, 1, 1, 1}; // relative probabilities for order book levels
+    e->reset();
+    em.reset();
+    e->setTopOfBookSnapshotLevels(5);
+    std::vector<Exchange::TopOfBookSnapshot> published{e->getTopOfBookSnapshot()}; // indexed by the sequence
+    std::atomic<bool> done{false};
+    std::vector<std::vector<Exchange::TopOfBookSnapshot>> sampled(numReaders);
+    std::vector<bool> ordered(numReaders, true), monotonic(numReaders, true);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < numReaders; ++r) {
+        readers.emplace_back([&, r]() {
+            const auto snapshotLock = e->getTopOfBookSnapshotLock();
+            uint64_t lastSequence = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                const auto s = snapshotLock->load();
+                monotonic[r] = monotonic[r] && s.sequence >= lastSequence;
+                lastSequence = s.sequence;
+                for (uint32_t i = 0; i < s.numBidLevels; ++i)
+                    ordered[r] = ordered[r] && s.bidLevels[i].size > 0 && (i == 0 || s.bidLevels[i].price < s.bidLevels[i - 1].price);
+                for (uint32_t i = 0; i < s.numAskLevels; ++i)
+                    ordered[r] = ordered[r] && s.askLevels[i].size > 0 && (i == 0 || s.askLevels[i].price > s.askLevels[i - 1].price);
+                ordered[r] = ordered[r] && (!s.numBidLevels || !s.numAskLevels || s.getBestBidPrice() < s.getBestAskPrice());
+                if (sampled[r].empty() || sampled[r].back().sequence != s.sequence)
+                    sampled[r].push_back(s);
+                std::this_thread::yield();
+            }
+        });
+    }
+    auto record = [&]() { // an event that leaves the book untouched publishes nothing
+        const auto s = e->getTopOfBookSnapshot();
+        if (s.sequence != published.back().sequence)
+            published.push_back(s);
+    };
+    for (int i = 0; i < numOrders; ++i) {
+        const double u0 = Utils::Statistics::getRandomUniform01(true);
+        const double u1 = Utils::Statistics::getRandomUniform01(true);
+        const int qty0 = Utils::Statistics::getRandomUniformInt(1, 3, true);
+        const int qty1 = Utils::Statistics::getRandomUniformInt(1, 5, true);
+        const size_t j = Utils::Statistics::drawIndexWithRelativeProbabilities(p, true);
+        if (u0 < 0.7)
+            em.submitLimitOrderEvent(u1 < 0.5 ? Market::Side::BUY : Market::Side::SELL, qty0, u1 < 0.5 ? 100.0 - j : 100.0 + j);
+        else
+            em.submitMarketOrderEvent(u1 < 0.5 ? Market::Side::BUY : Market::Side::SELL, qty1);
+        record();
+    }
+    const auto& activeOrders = em.getActiveLimitOrders();
+    std::vector<uint64_t> activeOrderIds;
+    for (const auto& orderPair : activeOrders)
+        activeOrderIds.push_back(orderPair.first);
+    std::sort(activeOrderIds.begin(), activeOrderIds.end());
+    for (int i = 0; i < numOrders && !activeOrderIds.empty(); ++i) {
+        const double u = Utils::Statistics::getRandomUniform01(true);
+        const size_t randomIndex = Utils::Statistics::getRandomUniformInt(static_cast<size_t>(0), activeOrderIds.size() - 1, true);
+        const uint64_t orderId = activeOrderIds[randomIndex];
+        if (u < 0.2) {
+            em.cancelOrder(orderId);
+            activeOrderIds[randomIndex] = activeOrderIds.back();
+            activeOrderIds.pop_back();
+        } else if (u < 0.6) {
+            const size_t j = Utils::Statistics::drawIndexWithRelativeProbabilities(p, true);
+            em.modifyOrderPrice(orderId, activeOrders.at(orderId)->isBuy() ? 100.0 - j : 100.0 + j);
+        } else {
+            em.modifyOrderQuantity(orderId, Utils::Statistics::getRandomUniformInt(1, 3, true));
+        }
+        record();
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers)
+        reader.join();
+    // every snapshot a reader saw must be one the engine published whole
+    bool untorn = true, allOrdered = true, allMonotonic = true, sequenced = true;
+    for (size_t i = 0; i < published.size(); ++i)
+        sequenced = sequenced && published[i].sequence == i;
+    for (int r = 0; r < numReaders; ++r) {
+        allOrdered = allOrdered && ordered[r];
+        allMonotonic = allMonotonic && monotonic[r];
+        for (const auto& s : sampled[r])
+            untorn = untorn && s.sequence < published.size() && std::memcmp(&s, &published[s.sequence], sizeof(s)) == 0;
+    }
+    *em.getLogger() << "Events processed: " << e->getOrderEventLog().size() << ", snapshots published: " << e->getTopOfBookSnapshotLock()->version()
+        << ", each recorded in sequence: " << sequenced;
+    *em.getLogger() << "Readers: " << numReaders << ", every snapshot read whole: " << untorn << ", levels ordered and uncrossed: " << allOrdered
+        << ", sequence never went back: " << allMonotonic;
+    const auto last = e->getTopOfBookSnapshot();
+    *em.getLogger() << "Final snapshot matches the engine: " << (last.getBestBidAsk().bestBidPrice == e->getBestBidPrice()
+        && last.getBestAskSize() == e->getBestAskSize() && last.lastTradePrice == e->getLastTradePrice());
+    e->stateConsistencyCheck();
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include <filesystem>
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+#include "Analytics/MatchingEngineMonitor.hpp"
+#include "Analytics/MonitorOutputsAnalyzer.hpp"
+#include "Analytics/LobsterBatchAnalyzer.hpp"
+#include "Parser/LobsterDataParser.hpp"
+#include "Parser/LobsterDataWriter.hpp"
+
+const std::string TEST_NAME = "MonitorOutputsAnalyzerLobsterBatch";
+
+int main() {
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    const auto& logger = em.getLogger();
+    const auto directory = std::filesystem::temp_directory_path() / TEST_NAME;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    auto stripDirectory = [&directory](std::string text) {
+        for (size_t pos; (pos = text.find(directory.string())) != std::string::npos; )
+            text.erase(pos, directory.string().size() + 1); // no temporary directory in the baseline
+        return text;
+    };
+    // a few ticker-days simulated and written in LOBSTER files named the LOBSTER way
+    constexpr size_t numDays = 6, numLevels = 5;
+    std::vector<Analytics::LobsterFilePair> files;
+    std::shared_ptr<Parser::LobsterDataParser> firstDayParser;
+    for (size_t day = 0; day < numDays; ++day) {
+        std::shared_ptr<Exchange::MatchingEngineFIFO> dayEngine = std::make_shared<Exchange::MatchingEngineFIFO>();
+        Market::OrderEventManagerBase dayEm{dayEngine};
+        auto monitor = std::make_shared<Analytics::MatchingEngineMonitor>(dayEngine);
+        const std::string prefix = "TICKER" + std::to_string(day) + "_2012-06-21_34200000_57600000_";
+        Parser::LobsterDataWriterConfig config;
+        config.messageFilePath = (directory / (prefix + "message_5.csv")).string();
+        config.orderBookFilePath = (directory / (prefix + "orderbook_5.csv")).string();
+        config.numLevels = numLevels;
+        monitor->setLobsterDataWriter(std::make_shared<Parser::LobsterDataWriter>(config));
+        for (int i = 0; i < 20; ++i) {
+            dayEm.submitLimitOrderEvent(Market::Side::BUY, std::min(5 + i, 10), 99.0 - i);
+            dayEm.submitLimitOrderEvent(Market::Side::SELL, std::min(5 + i, 10), 101.0 + i);
+        }
+        std::mt19937 rng(42 + day);
+        for (size_t i = 0; i < 1000 + 200 * day; ++i) {
+            const Market::Side side = rng() % 2 ? Market::Side::BUY : Market::Side::SELL;
+            const uint32_t qty = 1 + rng() % 3;
+            const uint32_t u = rng() % 10;
+            if (u < 5) {
+                const double offset = 1.0 + rng() % 5;
+                dayEm.submitLimitOrderEvent(side, qty, side == Market::Side::BUY ? dayEngine->getBestAskPrice() - offset : dayEngine->getBestBidPrice() + offset);
+            } else if (u < 7) {
+                dayEm.submitMarketOrderEvent(side, qty);
+            } else if (!dayEngine->getLimitOrderLookup().empty()) {
+                uint64_t orderId = 0;
+                for (const auto& [id, entry] : dayEngine->getLimitOrderLookup())
+                    orderId = std::max(orderId, id);
+                if (u < 9)
+                    dayEm.modifyOrderQuantity(orderId, qty + 5);
+                else
+                    dayEm.cancelOrder(orderId);
+            }
+        }
+        monitor->getLobsterDataWriter()->close();
+        monitor->setLobsterDataWriter(nullptr);
+        if (day == 0) {
+            firstDayParser = std::make_shared<Parser::LobsterDataParser>();
+            monitor->exportToLobsterDataParser(*firstDayParser);
+        }
+        // every other day with its order book file left to be named after the message file
+        files.push_back({config.messageFilePath, day % 2 ? "" : config.orderBookFilePath});
+    }
+    files.push_back({(directory / "MISSING_2012-06-21_34200000_57600000_message_5.csv").string(), ""});
+    Analytics::OrderBookDerivedStatsConfig statsConfig;
+    statsConfig.orderDepthProfileConfig.minPriceTick = 1.0;
+    statsConfig.orderDepthProfileConfig.maxTicks = numLevels;
+    statsConfig.orderLifetimeStatsConfig.minPriceTick = 1.0;
+    statsConfig.orderImbalanceStatsConfig.minPriceTick = 1.0;
+    statsConfig.priceImpactStatsConfig.minPriceTick = 1.0;
+    statsConfig.spreadStatsConfig.maxSpread = 10.0;
+    statsConfig.spreadStatsConfig.numBins = 10;
+    // short lags, horizons and few bins for days this short
+    statsConfig.orderFlowMemoryStatsConfig.lags = {1, 2, 5, 10};
+    statsConfig.spreadStatsConfig.lags = {1, 2, 5, 10};
+    statsConfig.priceReturnScalingStatsConfig.horizons = {1, 2, 5, 10};
+    statsConfig.priceImpactStatsConfig.horizons = {1, 2, 5, 10};
+    statsConfig.priceImpactStatsConfig.numBins = 10;
+    statsConfig.eventTimeStatsConfig.numBins = 10;
+    statsConfig.orderLifetimeStatsConfig.numBins = 10;
+    statsConfig.orderImbalanceStatsConfig.numBins = 10;
+    // a day analysed from its traces in memory, streamed from the files in small chunks, and from the parser of the monitor
+    Analytics::FileMonitorOutputsAnalyzer fileAnalyzer(files[0].messageFilePath, Analytics::FileMonitorOutputsAnalyzer::MonitorOutputsFileFormat::LOBSTER);
+    fileAnalyzer.setStatsConfig(statsConfig);
+    fileAnalyzer.populateOrderBookTraces();
+    fileAnalyzer.runAnalytics();
+    const std::string dayReport = fileAnalyzer.getStatsReport();
+    const size_t numTraces = fileAnalyzer.getOrderBookTraces().orderBookStatisticsCollector.size();
+    Analytics::FileMonitorOutputsAnalyzer streamingAnalyzer(files[0].messageFilePath, Analytics::FileMonitorOutputsAnalyzer::MonitorOutputsFileFormat::LOBSTER);
+    streamingAnalyzer.setStatsConfig(statsConfig);
+    streamingAnalyzer.runStreamingAnalytics(64);
+    Analytics::LobsterDataParserOutputsAnalyzer parserAnalyzer(firstDayParser);
+    parserAnalyzer.setStatsConfig(statsConfig);
+    parserAnalyzer.populateOrderBookTraces();
+    parserAnalyzer.runAnalytics();
+    *logger << "Day 0 - records: " << fileAnalyzer.getNumRecords() << ", traces: " << numTraces << ", order book file named: "
+        << stripDirectory(fileAnalyzer.getOrderBookFilePath()) << ", streamed in chunks as in memory: " << (streamingAnalyzer.getStatsReport() == dayReport)
+        << ", from the parser as from the files: " << (parserAnalyzer.getStatsReport() == dayReport);
+    *logger << "Day 0 analytics:\n" << dayReport;
+    // the days on one worker, on a few, and on one per cpu come to the same results, in the order of the files
+    Analytics::LobsterBatchAnalyzerConfig batchConfig;
+    batchConfig.chunkSize = 256;
+    batchConfig.statsConfig = statsConfig;
+    std::string serialReport;
+    for (const size_t numWorkers : {1, 4, 0}) {
+        batchConfig.numWorkers = numWorkers;
+        Analytics::LobsterBatchAnalyzer batch(batchConfig);
+        batch.run(files);
+        const std::string report = batch.getStatsReport();
+        if (numWorkers == 1) {
+            serialReport = report;
+            *logger << "Batch of " << files.size() << " files - succeeded: " << batch.getNumSucceeded() << ", failed: " << batch.getNumFailed()
+                << ", records: " << batch.getNumRecords() << ", first day as analysed alone: " << (batch.getResults()[0].statsReport == dayReport);
+            for (const auto& result : batch.getResults())
+                *logger << stripDirectory(result.files.messageFilePath) << " - " << stripDirectory(result.files.orderBookFilePath) << ", records: "
+                    << result.numRecords << (result.isSuccess() ? "" : ", error: " + stripDirectory(result.error));
+        } else {
+            *logger << "Batch on " << (numWorkers ? std::to_string(numWorkers) + " workers" : "a worker per cpu") << " - results as on one: " << (report == serialReport)
+                << ", workers used: " << (numWorkers ? std::to_string(batch.getNumWorkers()) : "capped to the files");
+        }
+    }
+    // the paths and the error are free text, their quotes, backslashes and line breaks are escaped in the JSON
+    Analytics::LobsterBatchResult failed;
+    failed.files = {"day \"0\".csv", "C:\\day_0.csv"};
+    failed.error = "cannot read:\n\tline 1";
+    *logger << "Failed result as JSON:\n" << failed.getAsJson();
+    std::filesystem::remove_all(directory);
+    return 0;
+}
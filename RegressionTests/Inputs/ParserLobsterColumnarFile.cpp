@@ -0,0 +1,176 @@
+#include <filesystem>
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+#include "Parser/LobsterDataParser.hpp"
+#include "Parser/LobsterDataReader.hpp"
+#include "Parser/LobsterDataWriter.hpp"
+#include "Parser/LobsterColumnarFile.hpp"
+
+const std::string TEST_NAME = "ParserLobsterColumnarFile";
+
+int main() {
+    using Parser::LobsterDataParser;
+    using Parser::LobsterColumnarFormat;
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    const auto& logger = em.getLogger();
+    const auto directory = std::filesystem::temp_directory_path() / TEST_NAME;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    auto getPath = [&directory](const std::string& name) { return (directory / name).string(); };
+    auto readFile = [](const std::string& filePath) {
+        std::ifstream file(filePath, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+    // a day of records around a drifting mid, every 40th message with no snapshot of its own as the delete of a modify
+    constexpr size_t numRecords = 2000, numLevels = 5;
+    std::mt19937 rng(42);
+    std::vector<std::shared_ptr<const LobsterDataParser::OrderBookMessage>> messages;
+    std::vector<std::shared_ptr<const LobsterDataParser::OrderBookSnapshot>> snapshots;
+    uint32_t mid = 1000000;
+    for (size_t i = 0; i < numRecords; ++i) {
+        mid += 100 * (rng() % 3) - 100;
+        const auto messageType = static_cast<LobsterDataParser::MessageType>(1 + rng() % 5);
+        messages.push_back(std::make_shared<const LobsterDataParser::OrderBookMessage>(34200000000000 + 50000 * i + rng() % 50000, messageType,
+            1 + rng() % 100000, 1 + rng() % 500, mid + 100 * (rng() % 10) - 500, rng() % 2));
+        if (i % 40 == 39) {
+            snapshots.push_back(nullptr);
+            continue;
+        }
+        auto snapshot = std::make_shared<LobsterDataParser::OrderBookSnapshot>();
+        for (size_t level = 0, numAskLevels = 1 + rng() % numLevels; level < numAskLevels; ++level) {
+            snapshot->askPrice.push_back(mid + 100 * (level + 1));
+            snapshot->askSize.push_back(1 + rng() % 300);
+        }
+        for (size_t level = 0, numBidLevels = 1 + rng() % numLevels; level < numBidLevels; ++level) {
+            snapshot->bidPrice.push_back(mid - 100 * (level + 1));
+            snapshot->bidSize.push_back(1 + rng() % 300);
+        }
+        snapshots.push_back(std::move(snapshot));
+    }
+    auto makeCsvConfig = [&](const std::string& name) {
+        Parser::LobsterDataWriterConfig config;
+        config.messageFilePath = getPath(name + "_message.csv");
+        config.orderBookFilePath = getPath(name + "_orderbook.csv");
+        config.numLevels = numLevels;
+        return config;
+    };
+    auto makeColumnarConfig = [&](const std::string& name, const bool isCompress) {
+        Parser::LobsterColumnarConfig config;
+        config.filePath = getPath(name + ".lobcol");
+        config.numLevels = numLevels;
+        config.blockSize = 300;
+        config.isCompressTimes = isCompress;
+        config.isCompressPrices = isCompress;
+        return config;
+    };
+    // the same records written as CSV, and as columnar files with and without compression
+    const auto csvConfig = makeCsvConfig("csv");
+    const auto columnarConfig = makeColumnarConfig("compressed", true);
+    const auto rawConfig = makeColumnarConfig("raw", false);
+    {
+        Parser::LobsterDataWriter csvWriter(csvConfig);
+        Parser::LobsterColumnarWriter columnarWriter(columnarConfig);
+        Parser::LobsterColumnarWriter rawWriter(rawConfig);
+        for (size_t i = 0; i < numRecords; ++i) {
+            csvWriter.write(messages[i], snapshots[i]);
+            columnarWriter.write(*messages[i], snapshots[i].get());
+            rawWriter.write(*messages[i], snapshots[i].get());
+        }
+        columnarWriter.close();
+        rawWriter.close();
+        *logger << "Written - records: " << columnarWriter.getNumRecords() << ", blocks: " << columnarWriter.getNumBlocks();
+    }
+    const std::string csvMessages = readFile(csvConfig.messageFilePath), csvOrderBook = readFile(csvConfig.orderBookFilePath);
+    *logger << "File sizes - CSV: " << csvMessages.size() + csvOrderBook.size() << ", columnar raw: " << std::filesystem::file_size(rawConfig.filePath)
+        << ", columnar compressed: " << std::filesystem::file_size(columnarConfig.filePath);
+    // the columnar files back to CSV, chunk by chunk
+    for (const auto& config : {columnarConfig, rawConfig}) {
+        Parser::LobsterColumnarReader reader(config.filePath);
+        const auto outConfig = makeCsvConfig("from_" + std::filesystem::path(config.filePath).stem().string());
+        {
+            Parser::LobsterDataWriter writer(outConfig);
+            std::vector<LobsterDataParser::OrderBookMessage> messageChunk(64);
+            std::vector<uint32_t> rows(messageChunk.size() * reader.getSnapshotSize());
+            for (size_t numRead; (numRead = reader.read(messageChunk, rows)) > 0; )
+                for (size_t i = 0; i < numRead; ++i) {
+                    const auto snapshot = Parser::LobsterDataReader::makeSnapshot(std::span<const uint32_t>(rows).subspan(i * reader.getSnapshotSize(), reader.getSnapshotSize()));
+                    writer.write(messageChunk[i], &snapshot);
+                }
+        }
+        std::vector<std::string> columns;
+        for (size_t column = 0; column < 10; ++column)
+            columns.push_back(reader.getColumnName(column) + (reader.getColumnEncoding(column) == LobsterColumnarFormat::Encoding::RAW ? "" : "*"));
+        *logger << std::filesystem::path(config.filePath).filename().string() << " - levels: " << reader.getNumLevels() << ", records: " << reader.getNumRecords()
+            << ", blocks: " << reader.getNumBlocks() << ", columns: " << reader.getNumColumns() << " " << Utils::toString(columns) << ", exhausted: "
+            << reader.isExhausted() << ", to CSV as written: " << (readFile(outConfig.messageFilePath) == csvMessages && readFile(outConfig.orderBookFilePath) == csvOrderBook);
+    }
+    // the CSV files to a columnar file, the same bytes as written directly
+    {
+        const auto fromCsvConfig = makeColumnarConfig("from_csv", true);
+        Parser::LobsterDataReader reader(csvConfig.messageFilePath, csvConfig.orderBookFilePath);
+        {
+            Parser::LobsterColumnarWriter writer(fromCsvConfig);
+            std::vector<LobsterDataParser::OrderBookMessage> messageChunk(100);
+            std::vector<uint32_t> rows(messageChunk.size() * reader.getSnapshotSize());
+            for (size_t numRead; (numRead = reader.read(messageChunk, rows)) > 0; )
+                for (size_t i = 0; i < numRead; ++i)
+                    writer.write(messageChunk[i], std::span<const uint32_t>(rows).subspan(i * reader.getSnapshotSize(), reader.getSnapshotSize()));
+        }
+        *logger << "CSV to columnar as written: " << (readFile(fromCsvConfig.filePath) == readFile(columnarConfig.filePath));
+    }
+    // the columns of each block as spans, raw in place and compressed decoded
+    {
+        Parser::LobsterColumnarReader reader(columnarConfig.filePath);
+        Parser::LobsterColumnarReader rawReader(rawConfig.filePath);
+        uint64_t quantity = 0, bestAskSize = 0, expectedQuantity = 0, expectedBestAskSize = 0;
+        size_t numSameBlocks = 0;
+        for (size_t block = 0; block < reader.getNumBlocks(); ++block) {
+            reader.loadBlock(block);
+            rawReader.loadBlock(block);
+            for (const uint32_t q : reader.getColumn<uint32_t>(LobsterColumnarFormat::QUANTITY))
+                quantity += q;
+            for (const uint32_t s : reader.getLevelColumn(0, 1))
+                bestAskSize += s;
+            const auto times = reader.getColumn<uint64_t>(LobsterColumnarFormat::TIME), rawTimes = rawReader.getColumn<uint64_t>(LobsterColumnarFormat::TIME);
+            const auto bidPrices = reader.getLevelColumn(4, 2), rawBidPrices = rawReader.getLevelColumn(4, 2);
+            numSameBlocks += std::equal(times.begin(), times.end(), rawTimes.begin(), rawTimes.end()) &&
+                std::equal(bidPrices.begin(), bidPrices.end(), rawBidPrices.begin(), rawBidPrices.end());
+        }
+        std::shared_ptr<const LobsterDataParser::OrderBookSnapshot> next;
+        for (size_t i = numRecords; i-- > 0; ) {
+            expectedQuantity += messages[i]->quantity;
+            next = snapshots[i] ? snapshots[i] : next; // a message with no snapshot takes that of the next one
+            expectedBestAskSize += next && !next->askSize.empty() ? next->askSize[0] : 0;
+        }
+        *logger << "Column sums - quantity: " << (quantity == expectedQuantity) << ", best ask size: " << (bestAskSize == expectedBestAskSize)
+            << ", blocks alike raw and compressed: " << numSameBlocks << " of " << reader.getNumBlocks();
+        try {
+            reader.getColumn<uint64_t>(LobsterColumnarFormat::PRICE);
+        } catch (const std::exception& ex) {
+            *logger << "Wrong width rejected: " << ex.what();
+        }
+    }
+    // malformed files are rejected
+    auto logError = [&](const std::string& name, const std::string& bytes) {
+        const std::string filePath = getPath(name + ".lobcol");
+        std::ofstream(filePath, std::ios::binary) << bytes;
+        try {
+            Parser::LobsterColumnarReader reader(filePath);
+            *logger << "Not rejected: " << name;
+        } catch (const std::exception& ex) {
+            std::string what = ex.what();
+            what.erase(what.find(directory.string()), directory.string().size() + 1); // no temporary directory in the baseline
+            *logger << "Rejected " << name << ": " << what;
+        }
+    };
+    const std::string columnarBytes = readFile(columnarConfig.filePath);
+    logError("magic", "LOBCOLv0" + columnarBytes.substr(8));
+    logError("header", columnarBytes.substr(0, 20));
+    logError("truncated", columnarBytes.substr(0, columnarBytes.size() - 100));
+    std::filesystem::remove_all(directory);
+    return 0;
+}
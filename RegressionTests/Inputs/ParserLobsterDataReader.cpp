@@ -0,0 +1,172 @@
+#include <filesystem>
+#include "Utils/Utils.hpp"
+#include "Market/OrderUtils.hpp"
+#include "Market/OrderEventManager.hpp"
+#include "Exchange/MatchingEngine.hpp"
+#include "Parser/LobsterDataParser.hpp"
+#include "Parser/LobsterDataReader.hpp"
+
+const std::string TEST_NAME = "ParserLobsterDataReader";
+
+int main() {
+    using Parser::LobsterDataParser;
+    using Parser::LobsterDataReader;
+    std::shared_ptr<Exchange::MatchingEngineFIFO> e = std::make_shared<Exchange::MatchingEngineFIFO>();
+    Market::OrderEventManagerBase em{e};
+    em.setLoggerLogFile(Utils::RegressionTests::getBaselineFileName(TEST_NAME), false, false);
+    const auto& logger = em.getLogger();
+    const auto directory = std::filesystem::temp_directory_path() / TEST_NAME;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    // a day of records, each snapshot one to five levels deep on either side
+    constexpr size_t numRecords = 1000, numLevels = 5;
+    std::mt19937 rng(42);
+    std::vector<LobsterDataParser::OrderBookMessage> messages;
+    std::vector<LobsterDataParser::OrderBookSnapshot> snapshots;
+    for (size_t i = 0; i < numRecords; ++i) {
+        const auto messageType = static_cast<LobsterDataParser::MessageType>(1 + rng() % 7);
+        messages.emplace_back(34200000000000 + 1000 * i + rng() % 1000, messageType, 1 + rng() % 5000, 1 + rng() % 500, 990000 + 100 * (rng() % 200), rng() % 2);
+        LobsterDataParser::OrderBookSnapshot snapshot;
+        for (size_t level = 0, numAskLevels = 1 + rng() % numLevels; level < numAskLevels; ++level) {
+            snapshot.askPrice.push_back(1000000 + 100 * level);
+            snapshot.askSize.push_back(1 + rng() % 300);
+        }
+        for (size_t level = 0, numBidLevels = 1 + rng() % numLevels; level < numBidLevels; ++level) {
+            snapshot.bidPrice.push_back(999900 - 100 * level);
+            snapshot.bidSize.push_back(1 + rng() % 300);
+        }
+        snapshots.push_back(std::move(snapshot));
+    }
+    auto writeFile = [](const std::filesystem::path& path, const std::string_view text) {
+        std::ofstream file(path, std::ios::binary);
+        file << text;
+        return path.string();
+    };
+    auto writeFiles = [&](const std::string& name, const bool aligned) {
+        Utils::Format::FormatBuffer messageBuffer, snapshotBuffer;
+        messageBuffer << LobsterDataParser::OrderBookMessage::getHeaderCsv(aligned) << "\n";
+        snapshotBuffer << LobsterDataParser::OrderBookSnapshot::getHeaderCsv(numLevels, aligned) << "\n";
+        for (size_t i = 0; i < numRecords; ++i) {
+            messages[i].appendAsCsv(messageBuffer, aligned);
+            messageBuffer << "\n";
+            snapshots[i].appendAsCsv(snapshotBuffer, numLevels, aligned);
+            snapshotBuffer << "\n";
+        }
+        return std::make_pair(writeFile(directory / (name + "_message.csv"), messageBuffer.view()), writeFile(directory / (name + "_orderbook.csv"), snapshotBuffer.view()));
+    };
+    // reads the files back in chunks of the given size, and counts the records that round trip
+    auto readBack = [&](LobsterDataReader& reader, const size_t chunkSize, const bool isReadSnapshots) {
+        std::vector<LobsterDataParser::OrderBookMessage> messageChunk(chunkSize);
+        std::vector<uint32_t> snapshotChunk(isReadSnapshots ? chunkSize * reader.getSnapshotSize() : 0);
+        size_t numMatched = 0, numChunks = 0, numRead;
+        while ((numRead = reader.read(messageChunk, snapshotChunk)) > 0) {
+            for (size_t i = 0; i < numRead; ++i) {
+                const size_t record = reader.getNumRecords() - numRead + i;
+                const auto& message = messageChunk[i];
+                bool isMatched = message.getAsCsv() == messages[record].getAsCsv();
+                if (isReadSnapshots) {
+                    const auto row = std::span<const uint32_t>(snapshotChunk).subspan(i * reader.getSnapshotSize(), reader.getSnapshotSize());
+                    isMatched = isMatched && LobsterDataReader::makeSnapshot(row).getAsCsv(numLevels) == snapshots[record].getAsCsv(numLevels);
+                }
+                numMatched += isMatched;
+            }
+            ++numChunks;
+        }
+        return std::make_pair(numMatched, numChunks);
+    };
+    for (const bool aligned : {false, true}) {
+        const auto [messageFilePath, orderBookFilePath] = writeFiles(aligned ? "aligned" : "plain", aligned);
+        LobsterDataReader reader(messageFilePath, orderBookFilePath);
+        const auto [numMatched, numChunks] = readBack(reader, 7, true);
+        *logger << (aligned ? "Aligned" : "Plain") << " files - levels: " << reader.getNumLevels() << ", records: " << reader.getNumRecords()
+            << ", matched: " << numMatched << ", chunks: " << numChunks << ", exhausted: " << reader.isExhausted();
+        reader.rewind();
+        const auto [numMatchedAgain, numChunksAgain] = readBack(reader, 64, true);
+        *logger << "Rewound - records: " << reader.getNumRecords() << ", matched: " << numMatchedAgain << ", chunks: " << numChunksAgain;
+    }
+    {
+        const auto [messageFilePath, orderBookFilePath] = writeFiles("plain", false);
+        // the messages only, the order book rows skipped
+        LobsterDataReader messageReader(messageFilePath, orderBookFilePath);
+        const auto [numMatched, numChunks] = readBack(messageReader, 100, false);
+        LobsterDataReader messageFileReader(messageFilePath);
+        const auto [numFileMatched, numFileChunks] = readBack(messageFileReader, 100, false);
+        *logger << "Messages only - matched: " << numMatched << ", chunks: " << numChunks << "; with no order book file - matched: " << numFileMatched
+            << ", has order book: " << messageFileReader.hasOrderBook();
+        // the top two levels, and seven with the last two empty
+        LobsterDataReader topReader(messageFilePath, orderBookFilePath, 2);
+        std::vector<LobsterDataParser::OrderBookMessage> messageChunk(numRecords);
+        std::vector<uint32_t> topRows(numRecords * topReader.getSnapshotSize());
+        topReader.read(messageChunk, topRows);
+        LobsterDataReader deepReader(messageFilePath, orderBookFilePath, 7);
+        std::vector<uint32_t> deepRows(numRecords * deepReader.getSnapshotSize());
+        deepReader.read(messageChunk, deepRows);
+        size_t numTopMatched = 0, numDeepMatched = 0;
+        for (size_t i = 0; i < numRecords; ++i) {
+            numTopMatched += LobsterDataReader::makeSnapshot(std::span<const uint32_t>(topRows).subspan(i * 8, 8)).getAsCsv(2) == snapshots[i].getAsCsv(2);
+            numDeepMatched += LobsterDataReader::makeSnapshot(std::span<const uint32_t>(deepRows).subspan(i * 28, 28)).getAsCsv(7) == snapshots[i].getAsCsv(7)
+                && std::all_of(deepRows.begin() + i * 28 + 20, deepRows.begin() + i * 28 + 28, [](const uint32_t field) { return field == 0; });
+        }
+        *logger << "Levels - top " << topReader.getNumLevels() << " matched: " << numTopMatched << ", " << deepReader.getNumLevels() << " deep matched: " << numDeepMatched;
+    }
+    {
+        // as LOBSTER publishes it - no header, seconds after midnight, dummy prices for the missing levels, CRLF line ends
+        const std::string messageFilePath = writeFile(directory / "lobster_message.csv",
+            "34200.017459617,5,0,1,2238200,-1\r\n"
+            "34200.189607670,1,11885113,21,2238100,1\r\n"
+            "\r\n"
+            "34200.5,4,11885113,21,2238100,1\r\n"
+            "34201.000000001,3,11534792,100,2238400,-1\r\n");
+        const std::string orderBookFilePath = writeFile(directory / "lobster_orderbook.csv",
+            "2239500,100,2231800,100,2239900,100,2230700,200\r\n"
+            "2239500,100,2238100,21,2239900,100,2231800,100\r\n"
+            "\r\n"
+            "2239500,100,2231800,100,9999999999,0,2230700,200\r\n"
+            "2239500,100,2231800,100,9999999999,0,-9999999999,0\r\n");
+        LobsterDataReader reader(messageFilePath, orderBookFilePath);
+        std::array<LobsterDataParser::OrderBookMessage, 8> messageChunk;
+        std::vector<uint32_t> rows(messageChunk.size() * reader.getSnapshotSize());
+        const size_t numRead = reader.read(messageChunk, rows);
+        *logger << "LOBSTER files - levels: " << reader.getNumLevels() << ", records: " << numRead;
+        for (size_t i = 0; i < numRead; ++i)
+            *logger << messageChunk[i].getAsCsv() << " | " << LobsterDataReader::makeSnapshot(std::span<const uint32_t>(rows).subspan(i * 8, 8)).getAsCsv(2);
+    }
+    // malformed files are rejected with the line
+    auto logError = [&](const std::string& name, const std::string& messageText, const std::string& orderBookText) {
+        try {
+            const std::string messageFilePath = writeFile(directory / (name + "_message.csv"), messageText);
+            const std::string orderBookFilePath = orderBookText.empty() ? "" : writeFile(directory / (name + "_orderbook.csv"), orderBookText);
+            LobsterDataReader reader(messageFilePath, orderBookFilePath);
+            std::array<LobsterDataParser::OrderBookMessage, 4> messageChunk;
+            std::vector<uint32_t> rows(messageChunk.size() * reader.getSnapshotSize());
+            while (reader.read(messageChunk, rows) > 0) {}
+            *logger << "Not rejected: " << name;
+        } catch (const std::exception& ex) {
+            std::string what = ex.what();
+            for (size_t at; (at = what.find(directory.string())) != std::string::npos; )
+                what.erase(at, directory.string().size() + 1); // no temporary directory in the baseline
+            *logger << "Rejected " << name << ": " << what;
+        }
+    };
+    logError("type", "1,1,1,10,100,1\n2,9,2,10,100,1\n", "");
+    logError("field", "1,1,1,10,100,1\n2,1,2,10,1O0,1\n", "");
+    logError("fields", "1,1,1,10,100,1,0\n", "");
+    logError("missing", "1,1,1,10,100,1\n2,1,2,10\n", "");
+    logError("empty", "1,1,1,10,100,1\n2,1,,10,100,1\n", "");
+    logError("short", "1,1,1,10,100,1\n2,1,2,10,100,1\n", "101,1,100,1\n");
+    logError("levels", "1,1,1,10,100,1\n", "101,1,100\n");
+    logError("digits", "1,1,12345678901234567890,10,100,1\n", "");
+    logError("range", "1,1,9999999999999999999,10,100,1\n", "");
+    // a snapshots buffer that cannot hold a single row is an error rather than the end of the files
+    try {
+        LobsterDataReader reader(writeFile(directory / "buffer_message.csv", "1,1,1,10,100,1\n"), writeFile(directory / "buffer_orderbook.csv", "101,1,100,1\n"));
+        std::array<LobsterDataParser::OrderBookMessage, 4> messageChunk;
+        std::vector<uint32_t> rows(reader.getSnapshotSize() - 1);
+        const size_t numRead = reader.read(messageChunk, rows);
+        *logger << "Not rejected: buffer, records: " << numRead;
+    } catch (const std::exception& ex) {
+        *logger << "Rejected buffer: " << ex.what();
+    }
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -22,6 +22,7 @@ int main() {
     // Tests::MatchingEngine::testMatchingEngineOrderCancelReplace();
     // Tests::MatchingEngine::testMatchingEngineRandomOrdersSpeedTest();
     // Tests::MatchingEngine::testMatchingEngineRandomOrdersStressTest();
+    // Tests::MatchingEngine::testMatchingEngineTopOfBookSnapshotStressTest();
     // Tests::MatchingEngine::testMatchingEngineSpeedProfiling();
     // Tests::MatchingEngine::testMatchingEngineConstructFromEventsStream();
     // Tests::MatchingEngine::testMatchingEngineGetAsJson();